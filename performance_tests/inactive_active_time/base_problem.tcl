@@ -276,9 +276,9 @@ pfset Geom.infiltration.ICPressure.RefGeom                  domain
 # Phase sources:
 #-----------------------------------------------------------------------------
 
-pfset PhaseSources.Type                         Constant
-pfset PhaseSources.GeomNames                    background
-pfset PhaseSources.Geom.background.Value        0.0
+pfset PhaseSources.water.Type                   Constant
+pfset PhaseSources.water.GeomNames              background
+pfset PhaseSources.water.Geom.background.Value  0.0
 
 
 #-----------------------------------------------------------------------------
@@ -307,6 +307,11 @@ pfset Solver.Linear.Preconditioner                       MGSemi
 pfset Solver.Linear.Preconditioner.MGSemi.MaxIter        1
 pfset Solver.Linear.Preconditioner.MGSemi.MaxLevels      100
 
+# span_cache.tcl runs the problem with and without the GrGeom span cache
+if {[info exists span_cache]} {
+    pfset Solver.GrGeom.SpanCache                        $span_cache
+}
+
 #-----------------------------------------------------------------------------
 # Run and Unload the ParFlow output files
 #-----------------------------------------------------------------------------
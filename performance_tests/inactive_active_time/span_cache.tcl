@@ -0,0 +1,55 @@
+#
+# Times the scaling problem with GrGeomInLoop walking the octree of the
+# domain and with it using the cached spans of the domain
+# (Solver.GrGeom.SpanCache).
+#
+# Usage: tclsh span_cache.tcl <size>
+#
+# ParFlow must be configured with --enable-timing so the Solver timer
+# is written to the log file.
+#
+
+set size [lindex $argv 0]
+if {$size == ""} {
+    set size 1
+}
+
+proc SolverTime {logfile} {
+    set fileId [open $logfile r]
+    set found 0
+    set time 0.0
+    while {[gets $fileId line] >= 0} {
+	if {[string match "Solver:*" $line]} {
+	    set found 1
+	} elseif {$found && [regexp {wall clock time *= *([0-9.eE+-]+)} $line match t]} {
+	    set time $t
+	    break
+	}
+    }
+    close $fileId
+    return $time
+}
+
+set results {}
+foreach span_cache "False True" {
+    set name span_cache.$size.$span_cache
+    source base_problem.tcl
+
+    set time [SolverTime $name.out.log]
+    if {$time <= 0.0} {
+	puts "No Solver timing found in $name.out.log, configure ParFlow with --enable-timing"
+	exit 1
+    }
+
+    lappend results [list $span_cache $time]
+}
+
+puts "Size: $size"
+puts [format "%-12s %12s" "SpanCache" "Time (s)"]
+foreach r $results {
+    puts [format "%-12s %12.4f" [lindex $r 0] [lindex $r 1]]
+}
+
+set octree_time [lindex [lindex $results 0] 1]
+set spans_time  [lindex [lindex $results 1] 1]
+puts [format "Span cache speedup = %.2f" [expr $octree_time / $spans_time]]
@@ -0,0 +1,305 @@
+#  Box domain Richards problem used to time the matrix-vector product.
+#  The Jacobian is formed (UseJacobian True) and MGSemi is used as the
+#  preconditioner so most of the linear solver time is spent in Matvec.
+#
+#  Expects $size (cells per side), $name, $matvec_type and
+#  $matrix_layout to be set.
+#
+
+#
+# Import the ParFlow TCL package
+#
+lappend auto_path $env(PARFLOW_DIR)/bin 
+package require parflow
+namespace import Parflow::*
+
+pfset FileVersion 4
+
+pfset Process.Topology.P 1
+pfset Process.Topology.Q 1
+pfset Process.Topology.R 1
+
+#---------------------------------------------------------
+# Computational Grid
+#---------------------------------------------------------
+pfset ComputationalGrid.Lower.X           0.0
+pfset ComputationalGrid.Lower.Y           0.0
+pfset ComputationalGrid.Lower.Z           0.0
+
+pfset ComputationalGrid.NX                $size
+pfset ComputationalGrid.NY                $size
+pfset ComputationalGrid.NZ                $size
+
+pfset ComputationalGrid.DX	          1.0
+pfset ComputationalGrid.DY                1.0
+pfset ComputationalGrid.DZ	          1.0
+
+#---------------------------------------------------------
+# The Names of the GeomInputs
+#---------------------------------------------------------
+
+pfset GeomInput.Names                 "domain_input background"
+
+pfset GeomInput.domain_input.InputType  Box
+pfset GeomInput.domain_input.GeomName   domain
+
+pfset GeomInput.background.InputType  Box
+pfset GeomInput.background.GeomName   background
+
+#---------------------------------------------------------
+# Domain Geometry
+#---------------------------------------------------------
+pfset Geom.domain.Lower.X                 0.0
+pfset Geom.domain.Lower.Y                 0.0
+pfset Geom.domain.Lower.Z                 0.0
+
+pfset Geom.domain.Upper.X                 $size
+pfset Geom.domain.Upper.Y                 $size
+pfset Geom.domain.Upper.Z                 $size
+
+pfset Geom.background.Lower.X         -99999999.0
+pfset Geom.background.Lower.Y         -99999999.0
+pfset Geom.background.Lower.Z         -99999999.0
+pfset Geom.background.Upper.X         99999999.0
+pfset Geom.background.Upper.Y         99999999.0
+pfset Geom.background.Upper.Z         99999999.0
+
+pfset Geom.domain.Patches             "x-lower x-upper y-lower y-upper z-lower z-upper"
+
+
+#-----------------------------------------------------------------------------
+# Perm
+#-----------------------------------------------------------------------------
+pfset Geom.Perm.Names                 domain
+
+
+
+pfset Geom.domain.Perm.Type            Constant
+pfset Geom.domain.Perm.Value           1.0
+
+pfset Perm.TensorType               TensorByGeom
+
+pfset Geom.Perm.TensorByGeom.Names  "background"
+
+pfset Geom.background.Perm.TensorValX  1.0
+pfset Geom.background.Perm.TensorValY  1.0
+pfset Geom.background.Perm.TensorValZ  1.0
+
+#-----------------------------------------------------------------------------
+# Specific Storage
+#-----------------------------------------------------------------------------
+
+pfset SpecificStorage.Type            Constant
+pfset SpecificStorage.GeomNames       "domain"
+pfset Geom.domain.SpecificStorage.Value 1.0e-4
+
+#-----------------------------------------------------------------------------
+# Phases
+#-----------------------------------------------------------------------------
+
+pfset Phase.Names "water"
+
+pfset Phase.water.Density.Type	        Constant
+pfset Phase.water.Density.Value	        1.0
+
+pfset Phase.water.Viscosity.Type	Constant
+pfset Phase.water.Viscosity.Value	1.0
+
+#-----------------------------------------------------------------------------
+# Contaminants
+#-----------------------------------------------------------------------------
+
+pfset Contaminants.Names			""
+
+
+#-----------------------------------------------------------------------------
+# Retardation
+#-----------------------------------------------------------------------------
+
+pfset Geom.Retardation.GeomNames           ""
+
+
+#-----------------------------------------------------------------------------
+# Gravity
+#-----------------------------------------------------------------------------
+
+pfset Gravity				1.0
+
+#-----------------------------------------------------------------------------
+# Setup timing info
+#-----------------------------------------------------------------------------
+
+pfset TimingInfo.BaseUnit		1.0
+pfset TimingInfo.StartCount		0
+pfset TimingInfo.StartTime		0.0
+pfset TimingInfo.StopTime               [expr 30.0*1]
+pfset TimingInfo.DumpInterval	        0
+pfset TimeStep.Type                     Constant
+pfset TimeStep.Value                    10.0
+
+
+#-----------------------------------------------------------------------------
+# Porosity
+#-----------------------------------------------------------------------------
+
+pfset Geom.Porosity.GeomNames           domain
+
+pfset Geom.domain.Porosity.Type          Constant
+pfset Geom.domain.Porosity.Value         0.3680
+
+#-----------------------------------------------------------------------------
+# Domain
+#-----------------------------------------------------------------------------
+
+pfset Domain.GeomName domain
+
+#-----------------------------------------------------------------------------
+# Relative Permeability
+#-----------------------------------------------------------------------------
+
+pfset Phase.RelPerm.Type               VanGenuchten
+pfset Phase.RelPerm.GeomNames          domain
+
+pfset Geom.domain.RelPerm.Alpha         3.34
+pfset Geom.domain.RelPerm.N             1.982 
+
+#---------------------------------------------------------
+# Saturation
+#---------------------------------------------------------
+
+pfset Phase.Saturation.Type              VanGenuchten
+pfset Phase.Saturation.GeomNames         domain
+
+pfset Geom.domain.Saturation.Alpha        3.34
+pfset Geom.domain.Saturation.N            1.982
+pfset Geom.domain.Saturation.SRes         0.2771
+pfset Geom.domain.Saturation.SSat         1.0
+
+#-----------------------------------------------------------------------------
+# Wells
+#-----------------------------------------------------------------------------
+pfset Wells.Names                           ""
+
+#-----------------------------------------------------------------------------
+# Time Cycles
+#-----------------------------------------------------------------------------
+pfset Cycle.Names "constant"
+pfset Cycle.constant.Names		"alltime"
+pfset Cycle.constant.alltime.Length	 1
+pfset Cycle.constant.Repeat		-1
+
+#-----------------------------------------------------------------------------
+# Boundary Conditions: Pressure
+#-----------------------------------------------------------------------------
+pfset BCPressure.PatchNames                   [pfget Geom.domain.Patches]
+
+pfset Patch.x-lower.BCPressure.Type		      FluxConst
+pfset Patch.x-lower.BCPressure.Cycle		      "constant"
+pfset Patch.x-lower.BCPressure.alltime.Value	      0.0
+
+pfset Patch.y-lower.BCPressure.Type		      FluxConst
+pfset Patch.y-lower.BCPressure.Cycle		      "constant"
+pfset Patch.y-lower.BCPressure.alltime.Value	      0.0
+
+pfset Patch.z-lower.BCPressure.Type		      FluxConst
+pfset Patch.z-lower.BCPressure.Cycle		      "constant"
+pfset Patch.z-lower.BCPressure.alltime.Value	      0.0
+
+pfset Patch.x-upper.BCPressure.Type		      FluxConst
+pfset Patch.x-upper.BCPressure.Cycle		      "constant"
+pfset Patch.x-upper.BCPressure.alltime.Value	      0.0
+
+pfset Patch.y-upper.BCPressure.Type		      FluxConst
+pfset Patch.y-upper.BCPressure.Cycle		      "constant"
+pfset Patch.y-upper.BCPressure.alltime.Value	      0.0
+
+pfset Patch.z-upper.BCPressure.Type		      FluxConst
+pfset Patch.z-upper.BCPressure.Cycle		      "constant"
+pfset Patch.z-upper.BCPressure.alltime.Value	      -0.10
+
+#---------------------------------------------------------
+# Topo slopes in x-direction
+#---------------------------------------------------------
+
+pfset TopoSlopesX.Type "Constant"
+pfset TopoSlopesX.GeomNames ""
+
+pfset TopoSlopesX.Geom.domain.Value 0.0
+
+#---------------------------------------------------------
+# Topo slopes in y-direction
+#---------------------------------------------------------
+
+pfset TopoSlopesY.Type "Constant"
+pfset TopoSlopesY.GeomNames ""
+
+pfset TopoSlopesY.Geom.domain.Value 0.0
+
+#---------------------------------------------------------
+# Mannings coefficient 
+#---------------------------------------------------------
+
+pfset Mannings.Type "Constant"
+pfset Mannings.GeomNames ""
+pfset Mannings.Geom.domain.Value 0.
+
+#---------------------------------------------------------
+# Initial conditions: water pressure
+#---------------------------------------------------------
+
+pfset ICPressure.Type                                   HydroStaticPatch
+pfset ICPressure.GeomNames                              "domain"
+
+pfset Geom.domain.ICPressure.Value                      1.0
+pfset Geom.domain.ICPressure.RefPatch                  z-lower
+pfset Geom.domain.ICPressure.RefGeom                  domain
+
+#-----------------------------------------------------------------------------
+# Phase sources:
+#-----------------------------------------------------------------------------
+
+pfset PhaseSources.water.Type                         Constant
+pfset PhaseSources.water.GeomNames                    background
+pfset PhaseSources.water.Geom.background.Value        0.0
+
+
+#-----------------------------------------------------------------------------
+# Exact solution specification for error calculations
+#-----------------------------------------------------------------------------
+
+pfset KnownSolution                                    NoKnownSolution
+
+#-----------------------------------------------------------------------------
+# Set solver parameters
+#-----------------------------------------------------------------------------
+pfset Solver                                             Richards
+pfset Solver.MaxIter                                     10000
+
+pfset Solver.Nonlinear.MaxIter                           15
+pfset Solver.Nonlinear.ResidualTol                       1e-9
+pfset Solver.Nonlinear.StepTol                           1e-9
+pfset Solver.Nonlinear.EtaValue                          1e-5
+pfset Solver.Nonlinear.UseJacobian                       True
+pfset Solver.Nonlinear.DerivativeEpsilon                 1e-7
+
+pfset Solver.Linear.KrylovDimension                      25
+pfset Solver.Linear.MaxRestarts                          2
+
+pfset Solver.Linear.Preconditioner                       MGSemi
+pfset Solver.Linear.Preconditioner.MGSemi.MaxIter        1
+pfset Solver.Linear.Preconditioner.MGSemi.MaxLevels      100
+
+pfset Solver.Matvec.Type                                 $matvec_type
+pfset Solver.Matrix.Layout                               $matrix_layout
+
+pfset Solver.PrintSubsurfData                            False
+pfset Solver.PrintPressure                               False
+pfset Solver.PrintSaturation                             False
+pfset Solver.PrintMask                                   False
+
+#-----------------------------------------------------------------------------
+# Run and Unload the ParFlow output files
+#-----------------------------------------------------------------------------
+pfrun $name
+pfundist $name
+
@@ -0,0 +1,86 @@
+#
+# Compares the standard and fused Matvec kernels on a box domain.
+#
+# Usage: tclsh matvec.tcl <cells per side> [Planar|Interleaved]
+#
+# ParFlow must be configured with --enable-timing so the Matvec timer
+# is written to the log file.
+#
+# Bytes moved are estimated from the FLOP count using a streaming model
+# per cell for the 7-point stencil (2 FLOPs per stencil coefficient and
+# 2 for the vector terms, 16 FLOPs per cell):
+#
+#   Standard : y scaled in its own pass (16 bytes) plus for each of the
+#              7 coefficients a(8) + x(8) + y read/write(16), plus the
+#              alpha scaling pass (16 bytes)   = 256 bytes / cell
+#   Fused    : 7 coefficients (56) + x (8) + y read/write (16)
+#                                               =  80 bytes / cell
+#
+# The byte counts are the same for both matrix layouts; the Interleaved
+# layout reads the coefficients of a cell from one cache line instead of
+# 7 separate streams.
+#
+
+set size [lindex $argv 0]
+if {$size == ""} {
+    set size 64
+}
+
+set matrix_layout [lindex $argv 1]
+if {$matrix_layout == ""} {
+    set matrix_layout Planar
+}
+
+array set bytes_per_flop {Standard 16.0 Fused 5.0}
+
+proc MatvecTiming {logfile} {
+    set fileId [open $logfile r]
+    set found 0
+    set time 0.0
+    set flops 0.0
+    while {[gets $fileId line] >= 0} {
+	if {[string match "Matvec:*" $line]} {
+	    set found 1
+	} elseif {$found && [regexp {wall clock time *= *([0-9.eE+-]+)} $line match t]} {
+	    set time $t
+	} elseif {$found && [regexp {wall MFLOPS = [0-9.eE+-]+ \(([0-9.eE+-]+)\)} $line match f]} {
+	    set flops $f
+	    break
+	}
+    }
+    close $fileId
+    return [list $time $flops]
+}
+
+set results {}
+foreach matvec_type "Standard Fused" {
+    set name matvec.$size.$matrix_layout.$matvec_type
+    source base_problem.tcl
+
+    set timing [MatvecTiming $name.out.log]
+    set time  [lindex $timing 0]
+    set flops [lindex $timing 1]
+
+    if {$time <= 0.0} {
+	puts "No Matvec timing found in $name.out.log, configure ParFlow with --enable-timing"
+	exit 1
+    }
+
+    set bytes [expr $flops * $bytes_per_flop($matvec_type)]
+    lappend results [list $matvec_type $time $flops $bytes]
+}
+
+puts "Matrix layout: $matrix_layout"
+puts [format "%-10s %12s %12s %12s %12s" "Type" "Time (s)" "GFLOP/s" "GBytes" "GB/s"]
+foreach r $results {
+    set time  [lindex $r 1]
+    set flops [lindex $r 2]
+    set bytes [lindex $r 3]
+    puts [format "%-10s %12.4f %12.4f %12.4f %12.4f" [lindex $r 0] $time \
+	      [expr $flops / $time / 1.0e9] [expr $bytes / 1.0e9] \
+	      [expr $bytes / $time / 1.0e9]]
+}
+
+set standard_time [lindex [lindex $results 0] 1]
+set fused_time    [lindex [lindex $results 1] 1]
+puts [format "Fused speedup = %.2f" [expr $standard_time / $fused_time]]
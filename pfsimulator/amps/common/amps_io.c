@@ -121,34 +121,47 @@ void amps_ScanDouble(
 #ifndef CASC_HAVE_BIGENDIAN
 
 #include <stdio.h>
+#include <stdlib.h>
 
 /*---------------------------------------------------------------------------*/
 /* On the nCUBE2 nodes store numbers with wrong endian so we need to swap    */
 /*---------------------------------------------------------------------------*/
+/*---------------------------------------------------------------------------*/
+/* Doubles are byte swapped into a fixed staging buffer on the stack in      */
+/* chunks of AMPS_IO_BUFFER_DOUBLES values, one fwrite per chunk             */
+/*---------------------------------------------------------------------------*/
+#define AMPS_IO_BUFFER_DOUBLES 4096
+
 void amps_WriteDouble(amps_File file, double *ptr, int len)
 { 
    int i; 
-   double *data;
-   union
-   {
-      double number;
-      char buf[8];
-   } a, b;
+   int n;
+   double buffer[AMPS_IO_BUFFER_DOUBLES];
+   unsigned char *in, *out;
 
-   /* write out each double with bytes swaped                               */
-   for(i=len, data=ptr; i--;) 
-   { 
-      a.number = *data++;
-      b.buf[0] = a.buf[7];
-      b.buf[1] = a.buf[6];
-      b.buf[2] = a.buf[5];
-      b.buf[3] = a.buf[4];
-      b.buf[4] = a.buf[3];
-      b.buf[5] = a.buf[2];
-      b.buf[6] = a.buf[1];
-      b.buf[7] = a.buf[0];
-
-      fwrite( &b.number, sizeof(double), 1, (FILE *)file ); 
+   while(len > 0)
+   {
+      n = (len < AMPS_IO_BUFFER_DOUBLES) ? len : AMPS_IO_BUFFER_DOUBLES;
+
+      /* swap bytes of each double into the staging buffer                   */
+      in  = (unsigned char *)ptr;
+      out = (unsigned char *)buffer;
+      for(i = 0; i < n; i++, in += 8, out += 8)
+      {
+	 out[0] = in[7];
+	 out[1] = in[6];
+	 out[2] = in[5];
+	 out[3] = in[4];
+	 out[4] = in[3];
+	 out[5] = in[2];
+	 out[6] = in[1];
+	 out[7] = in[0];
+      }
+
+      fwrite( buffer, sizeof(double), (size_t)n, (FILE *)file ); 
+
+      ptr += n;
+      len -= n;
    } 
 } 
 
@@ -179,31 +192,23 @@ void amps_WriteInt(amps_File file, int *ptr, int len)
 void amps_ReadDouble(amps_File file, double *ptr, int len)
 { 
    int i; 
-   double *data;
-   union
+   unsigned char *buf;
+   unsigned char t;
+
+   /* read all the doubles with one fread and swap the bytes in place      */
+   if( fread( ptr, sizeof(double), (size_t)len, (FILE *)file ) 
+       != (size_t)len )
    {
-      double number;
-      char buf[8];
-   } a, b;
+      printf("AMPS Error: short read of %d doubles\n", len);
+      exit(1);
+   }
 
-   /* read in each double with bytes swaped                               */
-   for(i=len, data=ptr; i--;) 
+   for(i = 0, buf = (unsigned char *)ptr; i < len; i++, buf += 8) 
    { 
-      fread( &a.number, sizeof(double), 1, (FILE *)file ); 
-
-
-      b.buf[0] = a.buf[7];
-      b.buf[1] = a.buf[6];
-      b.buf[2] = a.buf[5];
-      b.buf[3] = a.buf[4];
-      b.buf[4] = a.buf[3];
-      b.buf[5] = a.buf[2];
-      b.buf[6] = a.buf[1];
-      b.buf[7] = a.buf[0];
-
-
-      *data++ = b.number;
-
+      t = buf[0]; buf[0] = buf[7]; buf[7] = t;
+      t = buf[1]; buf[1] = buf[6]; buf[6] = t;
+      t = buf[2]; buf[2] = buf[5]; buf[5] = t;
+      t = buf[3]; buf[3] = buf[4]; buf[4] = t;
    } 
 } 
 
@@ -64,6 +64,9 @@
 
 #include <mpi.h>
 
+/* MPI-IO can be used for parallel file access (see WritePFBinary) */
+#define AMPS_HAVE_MPI_IO 1
+
 #ifndef FALSE
 #define FALSE 0
 #endif
@@ -82,37 +82,37 @@ int amps_create_mpi_cont_send_type(
       case AMPS_INVOICE_CHAR_CTYPE:
 	 cur_pos += AMPS_CALL_CHAR_ALIGN(comm, NULL, cur_pos, len, 1);
 	 MPI_Type_vector(len, 1, 1, MPI_BYTE, &mpi_types[element]);
-	 MPI_Address(cur_pos, &mpi_displacements[element]);
+	 MPI_Get_address(cur_pos, &mpi_displacements[element]);
 	 cur_pos += AMPS_CALL_CHAR_SIZEOF(comm, cur_pos, NULL, len, 1);
 	 break;
       case AMPS_INVOICE_SHORT_CTYPE:
 	 cur_pos += AMPS_CALL_SHORT_ALIGN(comm, NULL, cur_pos, len, 1);
 	 MPI_Type_vector(len, 1, 1, MPI_SHORT, &mpi_types[element]);
-	 MPI_Address(cur_pos, &mpi_displacements[element]);
+	 MPI_Get_address(cur_pos, &mpi_displacements[element]);
 	 cur_pos += AMPS_CALL_SHORT_SIZEOF(comm, cur_pos, NULL, len, 1);
 	 break;
       case AMPS_INVOICE_INT_CTYPE:
 	 cur_pos += AMPS_CALL_INT_ALIGN(comm, NULL, cur_pos, len, 1);
 	 MPI_Type_vector(len, 1, 1, MPI_INT, &mpi_types[element]);
-	 MPI_Address(cur_pos, &mpi_displacements[element]);
+	 MPI_Get_address(cur_pos, &mpi_displacements[element]);
 	 cur_pos += AMPS_CALL_INT_SIZEOF(comm, cur_pos, NULL, len, 1);
 	 break;
       case AMPS_INVOICE_LONG_CTYPE:
 	 cur_pos += AMPS_CALL_LONG_ALIGN(comm, NULL, cur_pos, len, 1);
 	 MPI_Type_vector(len, 1, 1, MPI_LONG, &mpi_types[element]);
-	 MPI_Address(cur_pos, &mpi_displacements[element]);
+	 MPI_Get_address(cur_pos, &mpi_displacements[element]);
 	 cur_pos += AMPS_CALL_LONG_SIZEOF(comm, cur_pos, NULL, len, 1);
 	 break;
        case AMPS_INVOICE_FLOAT_CTYPE:
 	 cur_pos += AMPS_CALL_FLOAT_ALIGN(comm, NULL, cur_pos, len, 1);
 	 MPI_Type_vector(len, 1, 1, MPI_FLOAT, &mpi_types[element]);
-	 MPI_Address(cur_pos, &mpi_displacements[element]);
+	 MPI_Get_address(cur_pos, &mpi_displacements[element]);
 	 cur_pos += AMPS_CALL_FLOAT_SIZEOF(comm, cur_pos, NULL, len, 1);
 	 break;
       case AMPS_INVOICE_DOUBLE_CTYPE:
 	 cur_pos += AMPS_CALL_DOUBLE_ALIGN(comm, NULL, cur_pos, len, 1);
 	 MPI_Type_vector(len, 1, 1, MPI_DOUBLE, &mpi_types[element]);
-	 MPI_Address(cur_pos, &mpi_displacements[element]);
+	 MPI_Get_address(cur_pos, &mpi_displacements[element]);
 	 cur_pos += AMPS_CALL_DOUBLE_SIZEOF(comm, cur_pos, NULL, len, 1);
 	 break;
       default:
@@ -185,13 +185,13 @@ int amps_create_mpi_cont_send_type(
 	 {
 	    if(i == 0)
 	    {
-	       MPI_Type_hvector(ptr -> ptr_len[i], 1, 0,
+	       MPI_Type_create_hvector(ptr -> ptr_len[i], 1, 0,
 				*base_type, &mpi_types[element]);
 	       MPI_Type_free(base_type);
 	    }
 	    else
 	    {
-	       MPI_Type_hvector(ptr -> ptr_len[i], 1, 0,
+	       MPI_Type_create_hvector(ptr -> ptr_len[i], 1, 0,
 				*base_type, new_type);
 	       MPI_Type_free(base_type);
 	       temp_type = base_type;
@@ -373,7 +373,7 @@ void amps_create_mpi_type(
 	 {
 	    if(i == dim-1)
 	    {
-	       MPI_Type_hvector( ptr -> ptr_len[i], 1,
+	       MPI_Type_create_hvector( ptr -> ptr_len[i], 1,
 				base_size + 
 				(ptr -> ptr_stride[i]-1) * element_size,
 				*base_type, &mpi_types[element]);
@@ -384,7 +384,7 @@ void amps_create_mpi_type(
 	    }
 	    else
 	    {
-	       MPI_Type_hvector( ptr -> ptr_len[i], 1,
+	       MPI_Type_create_hvector( ptr -> ptr_len[i], 1,
 				base_size + 
 				(ptr -> ptr_stride[i]-1) * element_size,
 				*base_type, new_type);
@@ -408,14 +408,14 @@ void amps_create_mpi_type(
 	 break;
       }
       
-      MPI_Address(data, &mpi_displacements[element]);
+      MPI_Get_address(data, &mpi_displacements[element]);
 
       mpi_block_len[element] = 1;
       element++;
       ptr = ptr->next;
    }
 
-   MPI_Type_struct(inv -> num,
+   MPI_Type_create_struct(inv -> num,
 		   mpi_block_len,
 		   mpi_displacements,
 		   mpi_types, 
@@ -0,0 +1,157 @@
+/*BHEADER**********************************************************************
+
+  Copyright (c) 1995-2009, Lawrence Livermore National Security,
+  LLC. Produced at the Lawrence Livermore National Laboratory. Written
+  by the Parflow Team (see the CONTRIBUTORS file)
+  <parflow@lists.llnl.gov> CODE-OCEC-08-103. All rights reserved.
+
+  This file is part of Parflow. For details, see
+  http://www.llnl.gov/casc/parflow
+
+  Please read the COPYRIGHT file or Our Notice and the LICENSE file
+  for the GNU Lesser General Public License.
+
+  This program is free software; you can redistribute it and/or modify
+  it under the terms of the GNU General Public License (as published
+  by the Free Software Foundation) version 2.1 dated February 1999.
+
+  This program is distributed in the hope that it will be useful, but
+  WITHOUT ANY WARRANTY; without even the IMPLIED WARRANTY OF
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the terms
+  and conditions of the GNU General Public License for more details.
+
+  You should have received a copy of the GNU Lesser General Public
+  License along with this program; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307
+  USA
+**********************************************************************EHEADER*/
+
+/*
+ * PFB style binary read rate.
+ *
+ * Each node writes a block of doubles with amps_WriteDouble and reads it
+ * back two ways: one amps_ReadDouble call per value (how
+ * ReadPFBinary_Subvector used to read) and one amps_ReadDouble call for
+ * the whole block (how it reads now).
+ *
+ * Usage: timing2 <reps> <count> <start_len> <stride_len>
+ *        lengths are in bytes
+ */
+
+#include <amps.h>
+
+#define method "amps_ReadDouble"
+
+#define max_len 16*1024*1024
+#define word_size 8
+
+int main(int argc, char **argv)
+{
+   amps_File file;
+   char filename[255];
+
+   double *buf;
+
+   int reps, count, start_len, stride_len;
+
+   amps_Clock_t t_start;
+   amps_Clock_t t_single, t_bulk;
+   double r_single, r_bulk;
+
+   int c, r, i;
+   int len;
+
+   /* AMPS STUFF */
+   amps_Init(&argc, &argv);
+
+   if(argc != 5)
+   {
+      amps_Printf("Usage: %s reps count start_len stride_len\n", argv[0]);
+      exit(1);
+   }
+
+   reps=atoi(argv[1]);
+   count=atoi(argv[2]);
+   start_len=atoi(argv[3])/word_size;
+   stride_len=atoi(argv[4])/word_size;
+
+   sprintf(filename, "timing2.%d.pfb", amps_Rank(amps_CommWorld));
+
+   buf = amps_CTAlloc(double, max_len);
+   for(i = 0; i < max_len; i++)
+      buf[i] = (double) i;
+
+   if((file = amps_Fopen(filename, "wb")) == NULL)
+   {
+      amps_Printf("Error: can't open output file %s\n", filename);
+      exit(1);
+   }
+   amps_WriteDouble(file, buf, max_len);
+   amps_Fclose(file);
+
+   amps_Printf("PFB READ TIMING\n");
+   amps_Printf("---------------\n");
+   amps_Printf("        Method: %s\n", method);
+   amps_Printf("   Repetitions: %d\n", reps);
+   amps_Printf("==========  ==============  ==============  =======\n");
+   amps_Printf("  LENGTH    PER VALUE RATE     BULK RATE     SPEEDUP\n");
+   amps_Printf(" (bytes)        (MB/s)           (MB/s)\n");
+   amps_Printf("==========  ==============  ==============  =======\n");
+
+   for(c = 0; c < count; c++)
+   {
+      len = start_len + stride_len*c;
+
+      if (len > max_len)
+      {
+	 amps_Printf("Length too big\n");
+	 exit(1);
+      }
+
+      t_single = 0;
+      t_bulk   = 0;
+      for(r = 0; r < reps; r++)
+      {
+	 file = amps_Fopen(filename, "rb");
+	 t_start = amps_Clock();
+	 for(i = 0; i < len; i++)
+	    amps_ReadDouble(file, &buf[i], 1);
+	 t_single += amps_Clock() - t_start;
+	 amps_Fclose(file);
+
+	 file = amps_Fopen(filename, "rb");
+	 t_start = amps_Clock();
+	 amps_ReadDouble(file, buf, len);
+	 t_bulk += amps_Clock() - t_start;
+	 amps_Fclose(file);
+      }
+
+      for(i = 0; i < len; i++)
+      {
+	 if(buf[i] != (double) i)
+	 {
+	    amps_Printf("Error: value %d read back as %lg\n", i, buf[i]);
+	    exit(1);
+	 }
+      }
+
+      r_single = t_single ? ((double)(len*word_size)*reps /
+			     ((double)t_single/AMPS_TICKS_PER_SEC))/(1024*1024)
+	 : 0.0;
+      r_bulk   = t_bulk ? ((double)(len*word_size)*reps /
+			   ((double)t_bulk/AMPS_TICKS_PER_SEC))/(1024*1024)
+	 : 0.0;
+
+      amps_Printf(" %9d  %14.2lf  %14.2lf  %7.2lf\n",
+		  len*word_size, r_single, r_bulk,
+		  r_single ? r_bulk/r_single : 0.0);
+   }
+
+   amps_TFree(buf);
+
+   remove(filename);
+
+   amps_Finalize();
+
+   return 0;
+}
@@ -0,0 +1,10 @@
+#ifndef PARFLOW_VERSION_H
+#define PARFLOW_VERSION_H
+#define PARFLOW_VERSION_STRING ""
+#define PARFLOW_VERSION ""
+#define PARFLOW_VERSION_MAJOR 
+#define PARFLOW_VERSION_MINOR 
+#define PARFLOW_VERSION_PATCH 
+#define PARFLOW_VERSION_HASH ""
+#define PARFLOW_VERSION_EXTRA ""
+#endif
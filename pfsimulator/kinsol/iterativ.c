@@ -31,22 +31,30 @@ int ModifiedGS(N_Vector *v, real **h, int k, int p, real *new_vk_norm)
 {
   int  i, k_minus_1, i0;
   real new_norm_2, new_product, vk_norm, temp;
+  N_Vector first[2];
+  real dots[2];
   
-  vk_norm = RSqrt(N_VDotProd(v[k],v[k]));
   k_minus_1 = k - 1;
   i0 = MAX(k-p, 0);
   
-  /* Perform modified Gram-Schmidt */
+  /* Perform modified Gram-Schmidt.  The norm of v[k] and the first
+     projection are computed together, and the last update is fused
+     with the computation of the norm of the new vector at v[k]. */
+
+  first[0] = v[i0];
+  first[1] = v[k];
+  N_VDotProdMulti(2, first, v[k], dots);
+  vk_norm = RSqrt(dots[1]);
   
   for (i=i0; i < k; i++) {
-    h[i][k_minus_1] = N_VDotProd(v[i], v[k]);
-    N_VLinearSum(ONE, v[k], -h[i][k_minus_1], v[i], v[k]);
+    h[i][k_minus_1] = (i == i0) ? dots[0] : N_VDotProd(v[i], v[k]);
+    new_product = -h[i][k_minus_1];
+    if (i < k_minus_1)
+      N_VMultiAxpy(1, &new_product, &v[i], v[k]);
+    else
+      *new_vk_norm = RSqrt(N_VMultiAxpyDot(1, &new_product, &v[i], v[k]));
   }
 
-  /* Compute the norm of the new vector at v[k].  */
-
-  *new_vk_norm = RSqrt(N_VDotProd(v[k], v[k]));
-
   /* If the norm of the new vector at v[k] is less than
      FACTOR (== 1000) times unit roundoff times the norm of the
      input vector v[k], then the vector will be reorthogonalized
@@ -77,7 +85,8 @@ int ModifiedGS(N_Vector *v, real **h, int k, int p, real *new_vk_norm)
 
 /************************ ClassicalGS ********************************
  This implementation of ClassicalGS was contributed to by Homer Walker
- and Peter Brown.
+ and Peter Brown.  The dot products of each pass are summed in a single
+ global reduction.
 **********************************************************************/
 
 int ClassicalGS(N_Vector *v, real **h, int k, int p, real *new_vk_norm,
@@ -90,41 +99,80 @@ int ClassicalGS(N_Vector *v, real **h, int k, int p, real *new_vk_norm,
   
   /* Perform Classical Gram-Schmidt */
 
-  vk_norm = RSqrt(N_VDotProd(v[k], v[k]));
-
   i0 = MAX(k-p, 0);
-  for (i=i0; i < k; i++) {
-    h[i][k_minus_1] = N_VDotProd(v[i], v[k]);
-  }
+
+  /* v[i0..k] are contiguous, so one multi-dot gives the projections
+     in s[i0..k-1] and the norm of v[k] in s[k] */
+  N_VDotProdMulti(k-i0+1, &v[i0], v[k], &s[i0]);
+  vk_norm = RSqrt(s[k]);
 
   for (i=i0; i < k; i++) {
-    N_VLinearSum(ONE, v[k], -h[i][k_minus_1], v[i], v[k]);
+    h[i][k_minus_1] = s[i];
+    s[i] = -s[i];
   }
 
-  /* Compute the norm of the new vector at v[k].  */
+  /* Subtract the projections and compute the norm of the new vector
+     at v[k] in one sweep. */
 
-  *new_vk_norm = RSqrt(N_VDotProd(v[k], v[k]));
+  *new_vk_norm = RSqrt(N_VMultiAxpyDot(k-i0, &s[i0], &v[i0], v[k]));
 
   /* Reorthogonalize if necessary */
 
   if ((FACTOR * (*new_vk_norm)) < vk_norm) {
 
-    for (i=i0; i < k; i++) {
-      s[i] = N_VDotProd(v[i], v[k]);
-    }
+    N_VDotProdMulti(k-i0, &v[i0], v[k], &s[i0]);
 
-    if (i0 < k) {
-      N_VScale(s[i0], v[i0], temp);
-      h[i0][k_minus_1] += s[i0];
-    }
-    for (i=i0+1; i < k; i++) {
-      N_VLinearSum(s[i], v[i], ONE, temp, temp);
+    N_VLinearCombination(k-i0, &s[i0], &v[i0], temp);
+    for (i=i0; i < k; i++) {
       h[i][k_minus_1] += s[i];
     }
-    N_VLinearSum(ONE, v[k], -ONE, temp, v[k]);
 
-    *new_vk_norm = RSqrt(N_VDotProd(v[k],v[k]));
+    s[k] = -ONE;
+    *new_vk_norm = RSqrt(N_VMultiAxpyDot(1, &s[k], &temp, v[k]));
+  }
+
+  return(0);
+}
+
+/************************ ClassicalGS2 *******************************
+ Classical Gram-Schmidt with one unconditional reorthogonalization
+ pass (CGS2).  Each pass needs a single global reduction, and the norm
+ of the new vector is folded into the second one, so the routine costs
+ two reductions however large k is.
+**********************************************************************/
+
+int ClassicalGS2(N_Vector *v, real **h, int k, int p, real *new_vk_norm,
+		 real *s)
+{
+  int  i, k_minus_1, i0;
+  real new_norm_2;
+
+  k_minus_1 = k - 1;
+  i0 = MAX(k-p, 0);
+
+  /* First pass */
+
+  N_VDotProdMulti(k-i0, &v[i0], v[k], &s[i0]);
+
+  for (i=i0; i < k; i++) {
+    h[i][k_minus_1] = s[i];
+    s[i] = -s[i];
+  }
+  N_VMultiAxpy(k-i0, &s[i0], &v[i0], v[k]);
+
+  /* Second pass; s[k] is the squared norm of v[k] before it */
+
+  N_VDotProdMulti(k-i0+1, &v[i0], v[k], &s[i0]);
+
+  new_norm_2 = s[k];
+  for (i=i0; i < k; i++) {
+    h[i][k_minus_1] += s[i];
+    new_norm_2 -= SQR(s[i]);
+    s[i] = -s[i];
   }
+  N_VMultiAxpy(k-i0, &s[i0], &v[i0], v[k]);
+
+  *new_vk_norm = (new_norm_2 > ZERO) ? RSqrt(new_norm_2) : ZERO;
 
   return(0);
 }
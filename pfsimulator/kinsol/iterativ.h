@@ -60,9 +60,13 @@ enum precond_type { NONE, LEFT, RIGHT, BOTH };
  *                Gram-Schmidt routine ClassicalGS listed in this *
  *                file.                                           *
  *                                                                *
+ * CLASSICAL_GS2: The iterative solver uses the classical         *
+ *                Gram-Schmidt routine with reorthogonalization   *
+ *                ClassicalGS2 listed in this file.               *
+ *                                                                *
  ******************************************************************/
 
-enum gs_type { MODIFIED_GS, CLASSICAL_GS } ;
+enum gs_type { MODIFIED_GS, CLASSICAL_GS, CLASSICAL_GS2 } ;
 
 
 /******************************************************************
@@ -157,8 +161,8 @@ int ModifiedGS(N_Vector *v, real **h, int k, int p, real *new_vk_norm);
  * temp is an N_Vector which can be used as workspace by the      *
  * ClassicalGS routine.                                           *
  *                                                                *
- * s is a length k array of reals which can be used as workspace  *
- * by the ClassicalGS routine.                                    *
+ * s is a length k+1 array of reals which can be used as         *
+ * workspace by the ClassicalGS routine.                          *
  *                                                                * 
  * ClassicalGS returns 0 to indicate success. It cannot fail.     *
  *                                                                *
@@ -168,6 +172,25 @@ int ClassicalGS(N_Vector *v, real **h, int k, int p, real *new_vk_norm,
 		N_Vector temp, real *s);
 
 
+/******************************************************************
+ *                                                                *
+ * Function: ClassicalGS2                                         *
+ *----------------------------------------------------------------*
+ * ClassicalGS2 performs a classical Gram-Schmidt                 *
+ * orthogonalization of v[k] followed by a second, unconditional  *
+ * classical Gram-Schmidt pass (CGS2). Each pass computes all its *
+ * inner products in one global reduction, so the routine needs   *
+ * two reductions in total. The parameters are as described for   *
+ * ClassicalGS, except that no temp vector is needed.             *
+ *                                                                * 
+ * ClassicalGS2 returns 0 to indicate success. It cannot fail.    *
+ *                                                                *
+ ******************************************************************/
+
+int ClassicalGS2(N_Vector *v, real **h, int k, int p, real *new_vk_norm,
+		 real *s);
+
+
 /******************************************************************
  *                                                                *
  * Function: QRfact                                               *
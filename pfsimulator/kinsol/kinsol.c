@@ -206,10 +206,9 @@ static boole KINInitialStop(KINMem kin_mem);
 
 static int  KINLinSolDrv(KINMem kinmem , N_Vector bb , N_Vector xx );
 
-static real KINScFNorm(N_Vector vv , N_Vector scale , N_Vector wrkv);
+static real KINScFNorm(N_Vector vv , N_Vector scale);
 
-static real KINScSteplength(KINMem kin_mem,
-			    N_Vector ucur, N_Vector ss, N_Vector usc);
+static real KINScSteplength(N_Vector ucur, N_Vector ss, N_Vector usc);
 
 static int KINStop(KINMem kinmem,  boole maxStepTaken, int globalstratret);
       
@@ -1062,7 +1061,7 @@ static boole KINInitialStop(KINMem kin_mem)
   real fmax;
 
   func(Neq, uu, fval, f_data);    nfe++;
-  fmax = KINScFNorm(fval, fscale, vtemp1);
+  fmax = KINScFNorm(fval, fscale);
   if(printfl>1)fprintf(kin_mem->kin_msgfp,
 	    " KINInitialStop:scaled f norm (for stopping): %12.3g\n",fmax);
   return(fmax <= POINTOH1 * fnormtol );
@@ -1189,7 +1188,7 @@ static int  KINLineSearch(KINMem kin_mem, real *fnormp, real *f1normp,
  }
 
  slpi = sfdotJp * ratio;
- rlength=KINScSteplength(kin_mem, uu, pp, uscale);
+ rlength=KINScSteplength(uu, pp, uscale);
  rlmin = scsteptol / rlength;
  rl = ONE;
 
@@ -1385,11 +1384,9 @@ static int KINLinSolDrv(KINMem kin_mem , N_Vector bb , N_Vector xx )
 
     ****************************************************************/
 
-static real KINScFNorm(N_Vector vv , N_Vector scale , N_Vector wrkv)
+static real KINScFNorm(N_Vector vv , N_Vector scale)
 {
-  N_VAbs(vv, wrkv);
-  N_VProd(scale, wrkv, wrkv);
-  return(N_VMaxNorm(wrkv));
+  return(N_VWMaxNorm(vv, scale));
 }
 
 /************************KINScSteplength ***************************
@@ -1397,14 +1394,9 @@ static real KINScFNorm(N_Vector vv , N_Vector scale , N_Vector wrkv)
   This routine computes the max norm of the scaled steplength, ss
   ucur is the current step      usc is the u scale factor  .*/
 
-static real KINScSteplength(KINMem kin_mem, N_Vector ucur, 
-			    N_Vector ss, N_Vector usc)
+static real KINScSteplength(N_Vector ucur, N_Vector ss, N_Vector usc)
 {
-  N_VInv(usc, vtemp1);
-  N_VAbs(ucur, vtemp2);
-  N_VLinearSum(ONE, vtemp1, ONE, vtemp2, vtemp1);
-  N_VDiv(ss, vtemp1, vtemp1);
-  return(N_VMaxNorm(vtemp1));
+  return(N_VStepMaxNorm(ucur, ss, usc));
 }
 
   /************** KINStop ***********************************
@@ -1433,7 +1425,7 @@ static int KINStop(KINMem kinmem,  boole maxStepTaken, int globalstratret)
 
   /*  check tolerance on scaled norm of func  at the current iterate */
 
-  fmax = KINScFNorm(fval, fscale, vtemp1);
+  fmax = KINScFNorm(fval, fscale);
   if(printfl>1)fprintf(kin_mem->kin_msgfp,
 		 " scaled f norm (for stopping): %12.3g\n",fmax);
 
@@ -1442,7 +1434,7 @@ static int KINStop(KINMem kinmem,  boole maxStepTaken, int globalstratret)
   /*  check for the scaled distance between the last two steps too small */
 
   N_VLinearSum(ONE,unew,-ONE,uu,vtemp1);
-  rlength = KINScSteplength(kin_mem, unew, vtemp1, uscale);
+  rlength = KINScSteplength(unew, vtemp1, uscale);
   if(rlength <= scsteptol)
     {
       if(!precondcurrent){
@@ -234,6 +234,31 @@ int KINSpgmr(void *kinsol_mem, int maxl, int maxlrst, int msbpre,
 }
 
 
+/*************** KINSpgmrSetGSType ************************************
+
+ This routine sets the Gram-Schmidt routine used by Spgmr. KINSpgmr
+ must have been called first.
+
+**********************************************************************/
+
+int KINSpgmrSetGSType(void *kinsol_mem, int gstype)
+{
+  KINMem kin_mem;
+  KINSpgmrMem kinspgmr_mem;
+
+  kin_mem = (KINMem)kinsol_mem;
+
+  if ((kin_mem == NULL) || (lmem == NULL)){
+     return(KIN_MEM_NULL);  
+  }
+
+  kinspgmr_mem = (KINSpgmrMem) lmem;
+  kinspgmr_mem->g_gstype = gstype;
+
+  return(0);
+}
+
+
 /* Additional readability Replacements */
 #define pretype (kinspgmr_mem->g_pretype)
 #define gstype  (kinspgmr_mem->g_gstype)
@@ -384,10 +409,7 @@ static int KINSpgmrSolve(KINMem kin_mem, N_Vector xx, N_Vector bb,
         vector J*p, where the scaling uses fscale.                        */
 
   KINSpgmrAtimes(kin_mem, xx, bb);
-  sJpnorm = N_VWL2Norm(bb,fscale);
-  N_VProd(bb, fscale, bb);
-  N_VProd(bb, fscale, bb);
-  sfdotJp = N_VDotProd(fval, bb);
+  sJpnorm = N_VWL2NormDot(bb, fscale, fval, &sfdotJp);
 
   if(kin_mem->kin_printfl>TWO)fprintf(kin_mem->kin_msgfp,
     "linear (Krylov step) residual norm %12.3g  eps %12.3g\n",*res_norm, eps);
@@ -471,24 +493,19 @@ static int KINSpgmrAtimesDQ(void *kinsol_mem, N_Vector v, N_Vector z)
 {
   real sigma, sigma_inv;
   real sutsv, sq1norm, sign, vtv;
+  real sums[3];
   KINMem   kin_mem;
   KINSpgmrMem kinspgmr_mem;
 
   kin_mem = (KINMem) kinsol_mem;
   kinspgmr_mem = (KINSpgmrMem) lmem;
 
-  /* scale the vector v ,   Du * v is put into vtemp1 */
-  N_VProd(v, uscale, vtemp1);
-  /*  scale uu and put into z used as a temporary */
-  N_VProd(uu, uscale, z);
-
-  /*  compute (Du * u ) . (Du * v)  */
-  sutsv = N_VDotProd(z, vtemp1);
-
-/* compute (Du * v ) . (Du * v ) */
-  vtv = N_VDotProd(vtemp1, vtemp1);
-
-  sq1norm = N_VL1Norm(vtemp1);
+  /*  compute (Du * u ) . (Du * v), (Du * v ) . (Du * v ) and the L1
+      norm of Du * v in one sweep */
+  N_VWDotProdL1(uu, v, uscale, sums);
+  sutsv   = sums[0];
+  vtv     = sums[1];
+  sq1norm = sums[2];
 
   sign = (sutsv >= ZERO) ? ONE : -ONE ;
  
@@ -330,6 +330,22 @@ int KINSpgmr(void *kin_mem, int maxl, int maxlrst, int msbpre,
 	      KINSpgmrPrecondSolveFn precondsolve,
 	      KINSpgmruserAtimesFn userAtimes,
               void *P_data);
+
+
+/******************************************************************
+ *                                                                *
+ * Function : KINSpgmrSetGSType                                   *
+ *----------------------------------------------------------------*
+ * KINSpgmrSetGSType selects the Gram-Schmidt routine used by     *
+ * Spgmr. It must be called after KINSpgmr, which sets the        *
+ * default MODIFIED_GS. Legal values of gstype are enumerated in  *
+ * iterativ.h.                                                    *
+ *                                                                *
+ *       KINSpgmrSetGSType returns 0 or KIN_MEM_NULL.             *
+ *                                                                *
+ ******************************************************************/
+
+int KINSpgmrSetGSType(void *kin_mem, int gstype);
 	      
 #endif
 #ifdef __cplusplus
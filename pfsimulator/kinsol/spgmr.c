@@ -156,7 +156,7 @@ int SpgmrSolve(SpgmrMem mem, void *A_data, N_Vector x, N_Vector b,
   real **Hes, *givens, *yg;
   real beta, rotation_product, r_norm, s_product, rho = 0;
   boole preOnLeft, preOnRight, scale2, scale1, converged;
-  int i, j, k, l, l_plus_1, l_max, krydim = 0, ier, ntries;
+  int i, j, l, l_plus_1, l_max, krydim = 0, ier, ntries;
 
   if (mem == NULL) return(SPGMR_MEM_NULL);
 
@@ -287,6 +287,10 @@ int SpgmrSolve(SpgmrMem mem, void *A_data, N_Vector x, N_Vector b,
 	if (ClassicalGS(V, Hes, l_plus_1, l_max, &(Hes[l_plus_1][l]),
 			vtemp, yg) != 0)
 	  return(SPGMR_GS_FAIL);
+      } else if (gstype == CLASSICAL_GS2) {
+	if (ClassicalGS2(V, Hes, l_plus_1, l_max, &(Hes[l_plus_1][l]),
+			 yg) != 0)
+	  return(SPGMR_GS_FAIL);
       } else {
 	if (ModifiedGS(V, Hes, l_plus_1, l_max, &(Hes[l_plus_1][l])) != 0) 
 	  return(SPGMR_GS_FAIL);
@@ -317,8 +321,7 @@ int SpgmrSolve(SpgmrMem mem, void *A_data, N_Vector x, N_Vector b,
       return(SPGMR_QRSOL_FAIL);
     
     /* Add correction vector V_l y to xcor. */
-    for (k = 0; k < krydim; k++)
-      N_VLinearSum(yg[k], V[k], ONE, xcor, xcor);
+    N_VMultiAxpy(krydim, yg, V, xcor);
 
     /* If converged, construct the final solution vector x and return. */
     if (converged) {
@@ -360,9 +363,7 @@ int SpgmrSolve(SpgmrMem mem, void *A_data, N_Vector x, N_Vector b,
     r_norm = ABS(r_norm);
 
     /* Multiply yg by V_(krydim+1) to get last residual vector; restart. */
-    N_VScale(yg[0], V[0], V[0]);
-    for (k = 1; k <= krydim; k++)
-      N_VLinearSum(yg[k], V[k], ONE, V[0], V[0]);
+    N_VLinearCombination(krydim+1, yg, V, V[0]);
 
   }
 
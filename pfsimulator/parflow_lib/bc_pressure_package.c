@@ -1060,16 +1060,9 @@ void  BCPressurePackageFreePublicXtra()
 
             case 4:
             {
-               int interval_number;
-
                dummy4 = (Type4 *)(public_xtra -> data[i]);
 
-                for(interval_number = 0; interval_number < interval_division; interval_number++)
-               {
-                  tfree(((dummy4 -> filenames)[interval_number]));
-                }  
-                // @RMM had to remove to not error our
-
+               /* the file names belong to the input database */
                tfree((dummy4 -> filenames));
 
                tfree(dummy4);
@@ -1079,15 +1072,9 @@ void  BCPressurePackageFreePublicXtra()
 
             case 5:
             {
-               int interval_number;
-
                dummy5 = (Type5 *)(public_xtra -> data[i]);
 
-               for(interval_number = 0; interval_number < interval_division; interval_number++)
-               {
-                  tfree(((dummy5 -> filenames)[interval_number]));
-               }
-
+               /* the file names belong to the input database */
                tfree((dummy5 -> filenames));
 
                tfree(dummy5);
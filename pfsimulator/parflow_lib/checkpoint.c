@@ -0,0 +1,288 @@
+/*BHEADER**********************************************************************
+
+  Copyright (c) 1995-2009, Lawrence Livermore National Security,
+  LLC. Produced at the Lawrence Livermore National Laboratory. Written
+  by the Parflow Team (see the CONTRIBUTORS file)
+  <parflow@lists.llnl.gov> CODE-OCEC-08-103. All rights reserved.
+
+  This file is part of Parflow. For details, see
+  http://www.llnl.gov/casc/parflow
+
+  Please read the COPYRIGHT file or Our Notice and the LICENSE file
+  for the GNU Lesser General Public License.
+
+  This program is free software; you can redistribute it and/or modify
+  it under the terms of the GNU General Public License (as published
+  by the Free Software Foundation) version 2.1 dated February 1999.
+
+  This program is distributed in the hope that it will be useful, but
+  WITHOUT ANY WARRANTY; without even the IMPLIED WARRANTY OF
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the terms
+  and conditions of the GNU General Public License for more details.
+
+  You should have received a copy of the GNU Lesser General Public
+  License along with this program; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307
+  USA
+**********************************************************************EHEADER*/
+/******************************************************************************
+ *
+ * Routines to write and read solver checkpoints.
+ *
+ * A checkpoint is a single distributed file (with the usual .dist file)
+ * holding a list of scalars and a list of vectors.  Node 0's part starts
+ * with the header
+ *
+ *    magic, version, number of processes, number of scalars,
+ *    number of vectors, scalars
+ *
+ * and every node then writes, for each vector in turn, its number of
+ * subgrids followed by each subgrid in PFB subgrid form.  The caller
+ * decides what the scalars and vectors are; the reader checks the counts
+ * and the subgrid extents, so a checkpoint can only be read back with the
+ * same process topology it was written with.
+ *
+ *****************************************************************************/
+
+#include "parflow.h"
+
+#include <string.h>
+
+#define CHECKPOINT_MAGIC   0x50464350     /* "PFCP" */
+#define CHECKPOINT_VERSION 2
+
+
+/*--------------------------------------------------------------------------
+ * WriteCheckpoint
+ *--------------------------------------------------------------------------*/
+
+void     WriteCheckpoint(
+char    *file_prefix,
+char    *file_suffix,
+double  *scalars,
+int      num_scalars,
+Vector **vectors,
+int      num_vectors)
+{
+   Grid           *grid;
+   SubgridArray   *subgrids;
+   Subgrid        *subgrid;
+
+   int             header[5];
+   int             num_subgrids;
+   int             g, n;
+
+   long            size;
+
+   char            filename[255];
+   amps_File       file;
+
+   BeginTiming(PFBTimingIndex);
+
+   if ( amps_Rank(amps_CommWorld) == 0 )
+      size = 5*(long)amps_SizeofInt + num_scalars*(long)amps_SizeofDouble;
+   else
+      size = 0;
+
+   for(n = 0; n < num_vectors; n++)
+   {
+      subgrids = GridSubgrids(VectorGrid(vectors[n]));
+
+      size += (long)amps_SizeofInt;
+      ForSubgridI(g, subgrids)
+      {
+	 subgrid = SubgridArraySubgrid(subgrids, g);
+	 size += SizeofPFBinarySubvector(VectorSubvector(vectors[n], g),
+					 subgrid);
+      }
+   }
+
+   sprintf(filename, "%s.%s.pfcp", file_prefix, file_suffix);
+
+   if ((file = amps_FFopen(amps_CommWorld, filename, "wb", size)) == NULL)
+   {
+      amps_Printf("Error: can't open checkpoint file %s\n", filename);
+      exit(1);
+   }
+
+   if ( amps_Rank(amps_CommWorld) == 0 )
+   {
+      header[0] = CHECKPOINT_MAGIC;
+      header[1] = CHECKPOINT_VERSION;
+      header[2] = amps_Size(amps_CommWorld);
+      header[3] = num_scalars;
+      header[4] = num_vectors;
+
+      amps_WriteInt(file, header, 5);
+      amps_WriteDouble(file, scalars, num_scalars);
+   }
+
+   for(n = 0; n < num_vectors; n++)
+   {
+      grid     = VectorGrid(vectors[n]);
+      subgrids = GridSubgrids(grid);
+
+      num_subgrids = GridNumSubgrids(grid);
+      amps_WriteInt(file, &num_subgrids, 1);
+
+      ForSubgridI(g, subgrids)
+      {
+	 subgrid = SubgridArraySubgrid(subgrids, g);
+	 WritePFBinary_Subvector(file, VectorSubvector(vectors[n], g),
+				 subgrid);
+      }
+   }
+
+   amps_FFclose(file);
+
+   EndTiming(PFBTimingIndex);
+}
+
+
+/*--------------------------------------------------------------------------
+ * ReadCheckpoint:
+ *   Read a checkpoint written by WriteCheckpoint with the same number of
+ *   scalars and vectors.  Ghost values of the vectors are not updated.
+ *--------------------------------------------------------------------------*/
+
+void     ReadCheckpoint(
+char    *filename,
+double  *scalars,
+int      num_scalars,
+Vector **vectors,
+int      num_vectors)
+{
+   Grid           *grid;
+   SubgridArray   *subgrids;
+   Subgrid        *subgrid;
+   Subvector      *subvector;
+
+   int             header[5];
+   int             block[9];
+   int             num_subgrids;
+   int             error;
+   int             g, n, j, k;
+
+   int             nx, ny, nz, num_values;
+   int             nx_v, ny_v;
+   double         *data;
+   double         *buffer;
+
+   amps_File       file;
+   amps_Invoice    invoice;
+
+   BeginTiming(PFBTimingIndex);
+
+   if ((file = amps_FFopen(amps_CommWorld, filename, "rb", 0)) == NULL)
+   {
+      amps_Printf("Error: can't open checkpoint file %s\n", filename);
+      exit(1);
+   }
+
+   /* Node 0 checks the header; all nodes stop together if it is bad */
+   error = 0;
+   if ( amps_Rank(amps_CommWorld) == 0 )
+   {
+      amps_ReadInt(file, header, 5);
+
+      if ( header[0] != CHECKPOINT_MAGIC || header[1] != CHECKPOINT_VERSION )
+      {
+	 amps_Printf("Error: %s is not a version %d checkpoint file\n",
+		     filename, CHECKPOINT_VERSION);
+	 error = 1;
+      }
+      else if ( header[2] != amps_Size(amps_CommWorld) )
+      {
+	 amps_Printf("Error: checkpoint %s was written by %d processes, "
+		     "restart with the same process topology\n",
+		     filename, header[2]);
+	 error = 1;
+      }
+      else if ( header[3] != num_scalars || header[4] != num_vectors )
+      {
+	 amps_Printf("Error: checkpoint %s does not match this problem\n",
+		     filename);
+	 error = 1;
+      }
+      else
+	 amps_ReadDouble(file, scalars, num_scalars);
+   }
+
+   invoice = amps_NewInvoice("%i%*d", &error, num_scalars, scalars);
+   amps_BCast(amps_CommWorld, 0, invoice);
+   amps_FreeInvoice(invoice);
+
+   if ( error )
+   {
+      amps_FFclose(file);
+      exit(1);
+   }
+
+   error = 0;
+   for(n = 0; (n < num_vectors) && !error; n++)
+   {
+      grid     = VectorGrid(vectors[n]);
+      subgrids = GridSubgrids(grid);
+
+      amps_ReadInt(file, &num_subgrids, 1);
+      if ( num_subgrids != GridNumSubgrids(grid) )
+      {
+	 error = 1;
+	 break;
+      }
+
+      ForSubgridI(g, subgrids)
+      {
+	 subgrid   = SubgridArraySubgrid(subgrids, g);
+	 subvector = VectorSubvector(vectors[n], g);
+
+	 amps_ReadInt(file, block, 9);
+	 if ( block[0] != SubgridIX(subgrid) ||
+	      block[1] != SubgridIY(subgrid) ||
+	      block[2] != SubgridIZ(subgrid) ||
+	      block[3] != SubgridNX(subgrid) ||
+	      block[4] != SubgridNY(subgrid) ||
+	      block[5] != SubgridNZ(subgrid) )
+	 {
+	    error = 1;
+	    break;
+	 }
+
+	 nx = block[3];
+	 ny = block[4];
+	 nz = block[5];
+
+	 nx_v = SubvectorNX(subvector);
+	 ny_v = SubvectorNY(subvector);
+
+	 data = SubvectorElt(subvector, block[0], block[1], block[2]);
+
+	 num_values = nx*ny*nz;
+	 buffer = talloc(double, num_values);
+	 amps_ReadDouble(file, buffer, num_values);
+
+	 for(k = 0; k < nz; k++)
+	    for(j = 0; j < ny; j++)
+	       memcpy(data + (k*ny_v + j)*nx_v, buffer + (k*ny + j)*nx,
+		      (size_t)nx*sizeof(double));
+
+	 tfree(buffer);
+      }
+   }
+
+   amps_FFclose(file);
+
+   invoice = amps_NewInvoice("%i", &error);
+   amps_AllReduce(amps_CommWorld, invoice, amps_Max);
+   amps_FreeInvoice(invoice);
+
+   if ( error )
+   {
+      if ( amps_Rank(amps_CommWorld) == 0 )
+	 amps_Printf("Error: subgrids in checkpoint %s do not match this "
+		     "problem\n", filename);
+      exit(1);
+   }
+
+   EndTiming(PFBTimingIndex);
+}
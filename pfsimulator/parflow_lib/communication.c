@@ -43,6 +43,9 @@
  *   Assumes that `comm_sub' is contained in `data_sub' (i.e. `comm_sub' is
  *   larger than `data_sub'), and that `comm_sub' and `data_sub' live on
  *   the same index space.
+ *   If `cell_stride' is 1 each variable is stored as its own plane,
+ *   otherwise the variables of a cell are stored together and
+ *   neighboring cells are `cell_stride' apart.
  *--------------------------------------------------------------------------*/
 
 int  NewCommPkgInfo(
@@ -50,6 +53,7 @@ int  NewCommPkgInfo(
    Subregion    *comm_sr,
    int           index,             
    int           num_vars,          /* number of variables in the vector */
+   int           cell_stride,       /* distance between neighboring cells */
    int          *loop_array)
 {
    int    *offset       = loop_array;
@@ -77,9 +81,9 @@ int  NewCommPkgInfo(
    sy = SubregionSY(data_sr);
    sz = SubregionSZ(data_sr);
 
-   offset[0] = (((SubregionIX(comm_sr) - ix) / sx) +
-		((SubregionIY(comm_sr) - iy) / sy) * nx + 
-		((SubregionIZ(comm_sr) - iz) / sz) * nx * ny +
+   offset[0] = ((((SubregionIX(comm_sr) - ix) / sx) +
+		 ((SubregionIY(comm_sr) - iy) / sy) * nx + 
+		 ((SubregionIZ(comm_sr) - iz) / sz) * nx * ny) * cell_stride +
 		index * num_vars * nx * ny * nz);
 
    sx = SubregionSX(comm_sr) / sx;
@@ -91,10 +95,10 @@ int  NewCommPkgInfo(
    len_array[2] = SubregionNZ(comm_sr);
    len_array[3] = num_vars;
 
-   sa[0] = (sx);
-   sa[1] = (sy)*(nx);
-   sa[2] = (sz)*(ny)*(nx);
-   sa[3] = ( 1)*(nz)*(ny)*(nx);
+   sa[0] = (sx)*(cell_stride);
+   sa[1] = (sy)*(nx)*(cell_stride);
+   sa[2] = (sz)*(ny)*(nx)*(cell_stride);
+   sa[3] = (cell_stride == 1) ? (nz)*(ny)*(nx) : 1;
 
    /* eliminate dimensions with len_array = 1 */
    dim = 4;
@@ -154,198 +158,311 @@ CommPkg         *NewCommPkg(
    int              num_vars,           /* number of variables in the vector */
    double          *data)
 {
-   CommPkg         *new_comm_pkg;
+   return NewCommPkgStrided(send_region, recv_region, data_space,
+			    num_vars, 1, data);
+}
 
-   amps_Invoice  invoice;
 
+/*--------------------------------------------------------------------------
+ * NewCommPlanProcs:
+ *   Find the distinct processes in `comm_region' and how many
+ *   subregions are communicated with each of them.  Returns the total
+ *   number of subregions.
+ *--------------------------------------------------------------------------*/
+
+static int  NewCommPlanProcs(
+   Region          *comm_region,
+   SubregionArray  *data_space,
+   int            **ranks_ptr,
+   int            **counts_ptr,
+   int             *num_procs_ptr)
+{
    SubregionArray  *comm_sra;
    Subregion       *comm_sr;
 
-   Subregion       *data_sr;
-
-   int  *loop_array;
-
-   int  *send_proc_array = NULL;
-   int  *recv_proc_array = NULL;
-
-   int   num_send_subregions;
-   int   num_recv_subregions;
+   int  *ranks  = NULL;
+   int  *counts = NULL;
 
-   int   num_send_procs;
-   int   num_recv_procs;
+   int   num_subregions;
+   int   num_procs;
 
    int   proc;
    int   i, j, p;
 
-   int   dim;
-
-   new_comm_pkg = ctalloc(CommPkg, 1);
-
-   /*------------------------------------------------------
-    * compute num send and recv subregions
-    *------------------------------------------------------*/
 
-   num_send_subregions = 0;
-   num_recv_subregions = 0;
+   num_subregions = 0;
    ForSubregionI(i, data_space)
    {
-      num_send_subregions +=
-	 SubregionArraySize(RegionSubregionArray(send_region, i));
-      num_recv_subregions +=
-	 SubregionArraySize(RegionSubregionArray(recv_region, i));
+      num_subregions +=
+	 SubregionArraySize(RegionSubregionArray(comm_region, i));
    }
 
-   /*------------------------------------------------------
-    * compute num send and recv processes and proc_array's
-    *------------------------------------------------------*/
-
-   num_send_procs = 0;
-   if(num_send_subregions)
+   num_procs = 0;
+   if(num_subregions)
    {
-      new_comm_pkg -> send_ranks = send_proc_array = 
-	 talloc(int, num_send_subregions);
-
-      for (i = 0; i < num_send_subregions; i++)
-	 send_proc_array[i] = -1;
+      ranks  = talloc(int, num_subregions);
+      counts = ctalloc(int, num_subregions);
 
-      ForSubregionArrayI(i, send_region)
+      ForSubregionArrayI(i, comm_region)
       {
-	 comm_sra = RegionSubregionArray(send_region, i);
+	 comm_sra = RegionSubregionArray(comm_region, i);
 	 ForSubregionI(j, comm_sra)
 	 {
 	    comm_sr = SubregionArraySubregion(comm_sra, j);
 	    proc = SubregionProcess(comm_sr);
 
-	    for (p = 0; p < num_send_procs; p++)
-	       if (proc == send_proc_array[p])
+	    for (p = 0; p < num_procs; p++)
+	       if (proc == ranks[p])
 		  break;
-	    if (p >= num_send_procs)
-	       send_proc_array[num_send_procs++] = proc;
+	    if (p >= num_procs)
+	       ranks[num_procs++] = proc;
+
+	    counts[p]++;
 	 }
       }
    }
 
-   num_recv_procs = 0;
-   if(num_recv_subregions)
-   {
-      new_comm_pkg -> recv_ranks = 
-	 recv_proc_array = talloc(int, num_recv_subregions);
+   *ranks_ptr     = ranks;
+   *counts_ptr    = counts;
+   *num_procs_ptr = num_procs;
 
-      for (i = 0; i < num_recv_subregions; i++)
-	 recv_proc_array[i] = -1;
+   return num_subregions;
+}
 
-      ForSubregionArrayI(i, recv_region)
+
+/*--------------------------------------------------------------------------
+ * NewCommPlanInfo:
+ *   Fill in the loop_array and dims entries for the subregions that are
+ *   communicated with each of the `num_procs' processes in `ranks'.
+ *   Returns the number of subregions set up.
+ *--------------------------------------------------------------------------*/
+
+static int  NewCommPlanInfo(
+   Region          *comm_region,
+   SubregionArray  *data_space,
+   int              num_vars,
+   int              cell_stride,
+   int              num_procs,
+   int             *ranks,
+   int             *loop_array,
+   int             *dims)
+{
+   SubregionArray  *comm_sra;
+   Subregion       *comm_sr;
+
+   Subregion       *data_sr;
+
+   int   n = 0;
+   int   i, j, p;
+
+
+   for(p = 0; p < num_procs; p++)
+   {
+      ForSubregionI(i, data_space)
       {
-	 comm_sra = RegionSubregionArray(recv_region, i);
+	 data_sr = SubregionArraySubregion(data_space, i);
+	 comm_sra = RegionSubregionArray(comm_region, i);
+
 	 ForSubregionI(j, comm_sra)
 	 {
 	    comm_sr = SubregionArraySubregion(comm_sra, j);
-	    proc = SubregionProcess(comm_sr);
 
-	    for (p = 0; p < num_recv_procs; p++)
-	       if (proc == recv_proc_array[p])
-		  break;
-	    if (p >= num_recv_procs)
-	       recv_proc_array[num_recv_procs++] = proc;
+	    if (SubregionProcess(comm_sr) == ranks[p])
+	    {
+	       dims[n] = NewCommPkgInfo(data_sr, comm_sr, i, num_vars,
+					cell_stride, loop_array + 9*n);
+	       n++;
+	    }
 	 }
       }
    }
 
-   /*------------------------------------------------------
-    * Set up CommPkg
-    *------------------------------------------------------*/
+   return n;
+}
+
+
+/*--------------------------------------------------------------------------
+ * NewCommPlan:
+ *   Data independent part of a CommPkg.  The ranks, offsets, lengths and
+ *   strides only depend on the send and recv regions and on the shape of
+ *   `data_space', so one plan can be shared by every vector with the
+ *   same layout.  Bind a plan to data with NewCommPkgFromPlan.
+ *--------------------------------------------------------------------------*/
+
+CommPlan        *NewCommPlan(
+   Region          *send_region,
+   Region          *recv_region,
+   SubregionArray  *data_space,
+   int              num_vars,           /* number of variables in the vector */
+   int              cell_stride)        /* distance between neighboring cells */
+{
+   CommPlan  *new_plan;
+
+   Subregion *data_sr;
+
+   int   num_send_subregions;
+   int   num_recv_subregions;
+
+   int   i;
+
+
+   new_plan = ctalloc(CommPlan, 1);
 
-   if(num_send_procs || num_recv_procs)
-      loop_array = (new_comm_pkg -> loop_array)
-	 = talloc(int, (num_send_subregions + num_recv_subregions) * 9);
+   num_send_subregions =
+      NewCommPlanProcs(send_region, data_space,
+		       &(new_plan -> send_ranks), &(new_plan -> send_counts),
+		       &(new_plan -> num_send_procs));
+   num_recv_subregions =
+      NewCommPlanProcs(recv_region, data_space,
+		       &(new_plan -> recv_ranks), &(new_plan -> recv_counts),
+		       &(new_plan -> num_recv_procs));
 
-   /* set up send info */
-   if(num_send_procs)
+   if(num_send_subregions + num_recv_subregions)
    {
+      new_plan -> loop_array =
+	 talloc(int, (num_send_subregions + num_recv_subregions) * 9);
+      new_plan -> dims =
+	 talloc(int, (num_send_subregions + num_recv_subregions));
+
+      NewCommPlanInfo(send_region, data_space, num_vars, cell_stride,
+		      new_plan -> num_send_procs, new_plan -> send_ranks,
+		      new_plan -> loop_array, new_plan -> dims);
+      NewCommPlanInfo(recv_region, data_space, num_vars, cell_stride,
+		      new_plan -> num_recv_procs, new_plan -> recv_ranks,
+		      new_plan -> loop_array + 9*num_send_subregions,
+		      new_plan -> dims + num_send_subregions);
+   }
 
+   /* remember what the plan was built for (see GridCommPlan) */
+   new_plan -> update_mode    = -1;
+   new_plan -> num_vars       = num_vars;
+   new_plan -> cell_stride    = cell_stride;
+   new_plan -> num_subregions = SubregionArraySize(data_space);
+   new_plan -> shape          = talloc(int, 6*SubregionArraySize(data_space));
+   ForSubregionI(i, data_space)
+   {
+      data_sr = SubregionArraySubregion(data_space, i);
+      new_plan -> shape[6*i  ] = SubregionIX(data_sr);
+      new_plan -> shape[6*i+1] = SubregionIY(data_sr);
+      new_plan -> shape[6*i+2] = SubregionIZ(data_sr);
+      new_plan -> shape[6*i+3] = SubregionNX(data_sr);
+      new_plan -> shape[6*i+4] = SubregionNY(data_sr);
+      new_plan -> shape[6*i+5] = SubregionNZ(data_sr);
+   }
 
-      new_comm_pkg -> num_send_invoices = num_send_procs;
-      (new_comm_pkg -> send_invoices) =
-	 ctalloc(amps_Invoice, num_send_procs);
+   new_plan -> ref_count = 1;
 
-      for(p = 0; p < num_send_procs; p++)
-      {
-	 num_send_subregions = 0;
-	 ForSubregionI(i, data_space)
-	 {
-	    data_sr = SubregionArraySubregion(data_space, i);
-	    comm_sra = RegionSubregionArray(send_region, i);
+   return new_plan;
+}
 
-	    ForSubregionI(j, comm_sra)
-	    {
-	       comm_sr = SubregionArraySubregion(comm_sra, j);
-
-	       if (SubregionProcess(comm_sr) == send_proc_array[p])
-	       {
-		  dim = NewCommPkgInfo(data_sr, comm_sr, i, num_vars, 
-				       loop_array);
-
-		  invoice =
-		     amps_NewInvoice("%&.&D(*)",
-				     loop_array + 1,
-				     loop_array + 5,
-				     dim,
-				     data + loop_array[0]);
-
-		  amps_AppendInvoice(&(new_comm_pkg -> send_invoices[p]),
-			 invoice);
-
-		  num_send_subregions++;
-		  loop_array += 9;
-	       }
-	    }
-	 }
-      }
 
+/*--------------------------------------------------------------------------
+ * FreeCommPlan:
+ *   Drop a reference to `plan', it is freed with the last one.
+ *--------------------------------------------------------------------------*/
+
+void FreeCommPlan(
+   CommPlan *plan)
+{
+   if(plan)
+   {
+      if(--(plan -> ref_count) > 0)
+	 return;
+
+      tfree(plan -> send_ranks);
+      tfree(plan -> send_counts);
+      tfree(plan -> recv_ranks);
+      tfree(plan -> recv_counts);
+      tfree(plan -> loop_array);
+      tfree(plan -> dims);
+      tfree(plan -> shape);
+
+      tfree(plan);
    }
+}
 
-   /* set up recv info */
-   if(num_recv_procs)
+
+/*--------------------------------------------------------------------------
+ * NewCommPlanInvoices:
+ *   One invoice per process, each the concatenation of the plan's
+ *   subregions for that process applied to `data'.
+ *--------------------------------------------------------------------------*/
+
+static amps_Invoice  *NewCommPlanInvoices(
+   int      num_procs,
+   int     *counts,
+   int     *loop_array,
+   int     *dims,
+   double  *data)
+{
+   amps_Invoice  *invoices = NULL;
+   amps_Invoice   invoice;
+
+   int   n = 0;
+   int   p, s;
+
+
+   if(num_procs)
    {
-      new_comm_pkg -> num_recv_invoices = num_recv_procs;
-      (new_comm_pkg -> recv_invoices) =
-	 ctalloc(amps_Invoice, num_recv_procs);
+      invoices = ctalloc(amps_Invoice, num_procs);
 
-      for(p = 0; p < num_recv_procs; p++)
+      for(p = 0; p < num_procs; p++)
       {
-	 num_recv_subregions = 0;
-	 ForSubregionI(i, data_space)
+	 for(s = 0; s < counts[p]; s++, n++)
 	 {
-	    data_sr = SubregionArraySubregion(data_space, i);
-	    comm_sra = RegionSubregionArray(recv_region, i);
-
-	    ForSubregionI(j, comm_sra)
-	    {
-	       comm_sr = SubregionArraySubregion(comm_sra, j);
-
-	       if (SubregionProcess(comm_sr) == recv_proc_array[p])
-	       {
-		  dim = NewCommPkgInfo(data_sr, comm_sr, i, num_vars, 
-				       loop_array);
-
-		  invoice =
-		     amps_NewInvoice("%&.&D(*)",
-				     loop_array + 1,
-				     loop_array + 5,
-				     dim,
-				     data + loop_array[0]);
-
-		  amps_AppendInvoice(&(new_comm_pkg -> recv_invoices[p]),
-				     invoice);
-
-		  num_recv_subregions++;
-		  loop_array += 9;
-	       }
-	    }
+	    invoice =
+	       amps_NewInvoice("%&.&D(*)",
+			       loop_array + 9*n + 1,
+			       loop_array + 9*n + 5,
+			       dims[n],
+			       data + loop_array[9*n]);
+
+	    amps_AppendInvoice(&(invoices[p]), invoice);
 	 }
       }
    }
 
+   return invoices;
+}
+
+
+/*--------------------------------------------------------------------------
+ * NewCommPkgFromPlan:
+ *   Bind `plan' to `data'.  The CommPkg keeps a reference to the plan,
+ *   only the invoices and amps package are per CommPkg.
+ *--------------------------------------------------------------------------*/
+
+CommPkg         *NewCommPkgFromPlan(
+   CommPlan        *plan,
+   double          *data)
+{
+   CommPkg  *new_comm_pkg;
+
+   int       num_send_subregions = 0;
+   int       p;
+
+
+   new_comm_pkg = ctalloc(CommPkg, 1);
+
+   new_comm_pkg -> plan = plan;
+   (plan -> ref_count)++;
+
+   for(p = 0; p < (plan -> num_send_procs); p++)
+      num_send_subregions += plan -> send_counts[p];
+
+   new_comm_pkg -> num_send_invoices = plan -> num_send_procs;
+   new_comm_pkg -> send_ranks        = plan -> send_ranks;
+   new_comm_pkg -> send_invoices     =
+      NewCommPlanInvoices(plan -> num_send_procs, plan -> send_counts,
+			  plan -> loop_array, plan -> dims, data);
+
+   new_comm_pkg -> num_recv_invoices = plan -> num_recv_procs;
+   new_comm_pkg -> recv_ranks        = plan -> recv_ranks;
+   new_comm_pkg -> recv_invoices     =
+      NewCommPlanInvoices(plan -> num_recv_procs, plan -> recv_counts,
+			  plan -> loop_array + 9*num_send_subregions,
+			  plan -> dims + num_send_subregions, data);
+
    new_comm_pkg -> package = amps_NewPackage(amps_CommWorld,
 					     new_comm_pkg -> num_send_invoices,
 					     new_comm_pkg -> send_ranks,
@@ -354,12 +471,124 @@ CommPkg         *NewCommPkg(
 					     new_comm_pkg -> recv_ranks,
 					     new_comm_pkg -> recv_invoices);
 
+   return new_comm_pkg;
+}
+
+
+/*--------------------------------------------------------------------------
+ * NewCommPkgStrided:
+ *   Same as NewCommPkg for data where neighboring cells are
+ *   `cell_stride' apart (see NewCommPkgInfo).
+ *--------------------------------------------------------------------------*/
+
+CommPkg         *NewCommPkgStrided(
+   Region          *send_region,
+   Region          *recv_region,
+   SubregionArray  *data_space,
+   int              num_vars,           /* number of variables in the vector */
+   int              cell_stride,        /* distance between neighboring cells */
+   double          *data)
+{
+   CommPlan  *plan;
+   CommPkg   *new_comm_pkg;
+
 
+   plan = NewCommPlan(send_region, recv_region, data_space,
+		      num_vars, cell_stride);
+   new_comm_pkg = NewCommPkgFromPlan(plan, data);
+   FreeCommPlan(plan);
 
    return new_comm_pkg;
 }
 
 
+/*--------------------------------------------------------------------------
+ * GridCommPlan:
+ *   Return the plan for communicating data laid out as `data_space'
+ *   with `update_mode' on `grid'.  Plans are built once and cached on
+ *   the grid, so all vectors with the same ghost width share them.
+ *   The returned plan is owned by the grid.
+ *--------------------------------------------------------------------------*/
+
+CommPlan        *GridCommPlan(
+   Grid            *grid,
+   int              update_mode,
+   SubregionArray  *data_space,
+   int              num_vars)
+{
+   ComputePkg *compute_pkg = GridComputePkg(grid, update_mode);
+
+   CommPlan   *plan;
+
+   Subregion  *data_sr;
+
+   int         i, match;
+
+
+   for(plan = GridCommPlans(grid); plan; plan = plan -> next)
+   {
+      if( (plan -> update_mode != update_mode) ||
+	  (plan -> num_vars != num_vars) ||
+	  (plan -> cell_stride != 1) ||
+	  (plan -> num_subregions != SubregionArraySize(data_space)) )
+	 continue;
+
+      match = TRUE;
+      ForSubregionI(i, data_space)
+      {
+	 data_sr = SubregionArraySubregion(data_space, i);
+	 if( (plan -> shape[6*i  ] != SubregionIX(data_sr)) ||
+	     (plan -> shape[6*i+1] != SubregionIY(data_sr)) ||
+	     (plan -> shape[6*i+2] != SubregionIZ(data_sr)) ||
+	     (plan -> shape[6*i+3] != SubregionNX(data_sr)) ||
+	     (plan -> shape[6*i+4] != SubregionNY(data_sr)) ||
+	     (plan -> shape[6*i+5] != SubregionNZ(data_sr)) )
+	 {
+	    match = FALSE;
+	    break;
+	 }
+      }
+
+      if(match)
+	 return plan;
+   }
+
+   plan = NewCommPlan(ComputePkgSendRegion(compute_pkg),
+		      ComputePkgRecvRegion(compute_pkg),
+		      data_space, num_vars, 1);
+   plan -> update_mode = update_mode;
+
+   plan -> next = GridCommPlans(grid);
+   GridCommPlans(grid) = plan;
+
+   return plan;
+}
+
+
+/*--------------------------------------------------------------------------
+ * FreeGridCommPlans:
+ *   Drop the grid's references to its plans, CommPkg's still using a
+ *   plan keep it alive.
+ *--------------------------------------------------------------------------*/
+
+void FreeGridCommPlans(
+   Grid *grid)
+{
+   CommPlan  *plan;
+   CommPlan  *next;
+
+
+   for(plan = GridCommPlans(grid); plan; plan = next)
+   {
+      next = plan -> next;
+      plan -> next = NULL;
+      FreeCommPlan(plan);
+   }
+
+   GridCommPlans(grid) = NULL;
+}
+
+
 /*--------------------------------------------------------------------------
  * FreeCommPkg:
  *--------------------------------------------------------------------------*/
@@ -383,10 +612,8 @@ void FreeCommPkg(
       tfree(pkg -> send_invoices);
       tfree(pkg -> recv_invoices);
 
-      tfree(pkg -> send_ranks);					     
-      tfree(pkg -> recv_ranks);					     
-      
-      tfree(pkg -> loop_array);
+      /* ranks and loop_array belong to the plan */
+      FreeCommPlan(pkg -> plan);
       
       tfree(pkg);
    }
@@ -51,6 +51,45 @@
 #define VectorUpdatePGS3     8
 #define VectorUpdatePGS4     9
 
+/* Ghost width needed by the stencil of each update mode above; a
+   vector may only be updated with modes that fit in its ghost layer */
+#define VectorUpdateGhostWidths { 1, 2, 1, 1, 3, 2, 1, 2, 3, 4 }
+
+/*--------------------------------------------------------------------------
+ * CommPlan:
+ *   Data independent description of a communication pattern: the ranks
+ *   to exchange with and the offset, length and stride factors of each
+ *   subregion relative to the start of the data array.  Shared by all
+ *   CommPkg's built from it and reference counted.
+ *--------------------------------------------------------------------------*/
+
+typedef struct _CommPlan
+{
+   int            num_send_procs;
+   int           *send_ranks;
+   int           *send_counts;   /* number of subregions per send rank */
+
+   int            num_recv_procs;
+   int           *recv_ranks;
+   int           *recv_counts;   /* number of subregions per recv rank */
+
+   int           *loop_array;    /* 9 entries per subregion, see
+				    NewCommPkgInfo; sends then recvs */
+   int           *dims;          /* invoice dimension of each subregion */
+
+   /* What the plan was built for, used to look up cached plans */
+   int            update_mode;   /* -1 if not a grid update mode */
+   int            num_vars;
+   int            cell_stride;
+   int            num_subregions;
+   int           *shape;         /* ix, iy, iz, nx, ny, nz of data space */
+
+   int            ref_count;
+
+   struct _CommPlan *next;
+
+} CommPlan;
+
 /*--------------------------------------------------------------------------
  * CommPkg:
  *   Structure containing information for communicating subregions of
@@ -69,10 +108,8 @@ typedef struct
 
    amps_Package package;
  
-   int     *loop_array; /* Contains the data-array index, offset, length,
-			 * and stride factors for setting up the invoices
-			 * in this package.
-			 * One array to save mallocing many small ones */
+   CommPlan      *plan;  /* Owns the ranks and the offset, length and
+			  * stride factors used by the invoices */
 
 } CommPkg;
 
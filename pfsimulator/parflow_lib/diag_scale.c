@@ -80,7 +80,7 @@ void     DiagScale(
 
    int             ix,   iy,   iz;
    int             nx,   ny,   nz;
-   int             nx_m, ny_m, nz_m;
+   int             nx_m, ny_m, nz_m, sx_m = 1;
    int             nx_v, ny_v, nz_v;
 
    int             s_y, s_z;
@@ -158,6 +158,7 @@ void     DiagScale(
 	    nx_m = SubmatrixNX(A_sub);
 	    ny_m = SubmatrixNY(A_sub);
 	    nz_m = SubmatrixNZ(A_sub);
+	    sx_m = SubmatrixStride(A_sub);
 
 	    nx_v = SubvectorNX(d_sub);
 	    ny_v = SubvectorNY(d_sub);
@@ -188,7 +189,7 @@ void     DiagScale(
 
 	       im = 0;
 	       BoxLoopI1(i, j, k, ix, iy, iz, nx, ny, nz,
-			 im, nx_m, ny_m, nz_m, 1, 1, 1,
+			 im, nx_m*sx_m, ny_m, nz_m, sx_m, 1, 1,
 			 {
 			    cp[im] *= dp[iv]       * dp[iv];
 			 });
@@ -205,7 +206,7 @@ void     DiagScale(
 	       im = 0;
 	       iv = 0;
 	       BoxLoopI2(i, j, k, ix, iy, iz, nx, ny, nz,
-			 im, nx_m, ny_m, nz_m, 1, 1, 1,
+			 im, nx_m*sx_m, ny_m, nz_m, sx_m, 1, 1,
 			 iv, nx_v, ny_v, nz_v, 1, 1, 1,
 			 {
 			    cp[im] *= dp[iv]       * dp[iv];
@@ -170,7 +170,7 @@ void          DiscretizePressure(
 
    int             iv, im, ival;
    int             sy_v, sz_v, sv=0;
-   int             sy_m, sz_m;
+   int             sx_m, sy_m, sz_m;
 
    int             phase, ipatch, is, i, j, k;
 
@@ -345,10 +345,11 @@ void          DiscretizePressure(
       ny_v = SubvectorNY(f_sub);
       nz_v = SubvectorNZ(f_sub);
 	 
+      sx_m = SubmatrixStride(A_sub);
       sy_v = nx_v;
-      sy_m = nx_m;
+      sy_m = nx_m * sx_m;
       sz_v = ny_v * nx_v;
-      sz_m = ny_m * nx_m;
+      sz_m = ny_m * nx_m * sx_m;
 	 
       cp    = SubmatrixStencilData(A_sub, 0);
       wp    = SubmatrixStencilData(A_sub, 1);
@@ -366,7 +367,7 @@ void          DiscretizePressure(
 
       BoxLoopI2(i, j, k, ix, iy, iz, nx, ny, nz,
 		iv, nx_v, ny_v, nz_v, 1, 1, 1,
-		im, nx_m, ny_m, nz_m, 1, 1, 1,
+		im, nx_m*sx_m, ny_m, nz_m, sx_m, 1, 1,
 	     {
 		e_temp = - ffx * Mean(ttx_p[iv], ttx_p[iv + 1]   ) / dx;
 		n_temp = - ffy * Mean(tty_p[iv], tty_p[iv + sy_v]) / dy;
@@ -377,7 +378,7 @@ void          DiscretizePressure(
 		up[im] += u_temp;
 		cp[im] -= e_temp + n_temp + u_temp;
 
-		cp[im + 1]    -= e_temp;
+		cp[im + sx_m] -= e_temp;
 		cp[im + sy_m] -= n_temp;
 		cp[im + sz_m] -= u_temp;
 
@@ -759,7 +760,7 @@ void          DiscretizePressure(
 		  d  = dy;
 		  tt_p = tty_p;
 	       }
-	       else if (fdir[2])
+	       else
 	       {
 		  ff = ffz;
 		  d  = dz;
@@ -802,7 +803,7 @@ void          DiscretizePressure(
 	       {
 		  ff = ffy;
 	       }
-	       else if (fdir[2])
+	       else
 	       {
 		  ff = ffz;
 	       }
@@ -978,7 +979,7 @@ PFModule    *DiscretizePressureInitInstanceXtra(
       stencil = NewStencil(seven_pt_shape, 7);
 
       (instance_xtra -> A) = NewMatrixType(grid, NULL, stencil, ON, stencil,
-					   matrix_cell_centered);
+					   MatrixLayoutType(GlobalsMatrixLayout));
       (instance_xtra -> f) = NewVectorType(grid, 1, 1, vector_cell_centered);
 
    }
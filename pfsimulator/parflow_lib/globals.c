@@ -79,6 +79,16 @@ void   NewGlobals(char  *run_name)
    globals_ptr -> interval_divisions = 0;
    globals_ptr -> intervals = 0;
    globals_ptr -> repeat_counts = 0;
+
+   globals_ptr -> matvec_type = MatvecFused;
+   globals_ptr -> matvec_tile_ny = 16;
+   globals_ptr -> matvec_tile_nz = 0;
+
+   globals_ptr -> matrix_layout = MatrixLayoutPlanar;
+
+   globals_ptr -> pfb_io_mode = PFBIOModeAMPS;
+
+   globals_ptr -> grgeom_span_cache = TRUE;
 }
 
 
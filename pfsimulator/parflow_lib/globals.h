@@ -85,6 +85,20 @@ typedef struct _Globals
    int      **intervals;
    int       *repeat_counts;
 
+   /* Matrix-vector product kernel selection */
+   int       matvec_type;
+   int       matvec_tile_ny;
+   int       matvec_tile_nz;
+
+   /* Storage layout of the solver matrices */
+   int       matrix_layout;
+
+   /* How PFB files are written and read */
+   int       pfb_io_mode;
+
+   /* Whether GrGeomInLoop uses the cached spans of a solid */
+   int       grgeom_span_cache;
+
    // SGS For debugging remove
    Grid     *grid3d;
    Grid     *grid2d;
@@ -142,6 +156,20 @@ amps_ThreadLocalDcl(extern IDB *, input_database);
 #define GlobalsContaminatNames    (globals -> contaminant_names)
 #define GlobalsGeometries         (globals -> geometries)
 
+#define GlobalsMatvecType         (globals -> matvec_type)
+#define GlobalsMatvecTileNY       (globals -> matvec_tile_ny)
+#define GlobalsMatvecTileNZ       (globals -> matvec_tile_nz)
+
+#define GlobalsMatrixLayout       (globals -> matrix_layout)
+
+#define GlobalsPFBIOMode          (globals -> pfb_io_mode)
+
+/* Values of GlobalsPFBIOMode */
+#define PFBIOModeAMPS  0    /* amps_FFopen and amps Read/Write */
+#define PFBIOModeMPIIO 1    /* collective MPI-IO */
+
+#define GlobalsGrGeomSpanCache    (globals -> grgeom_span_cache)
+
 #define GlobalsParflowSimulation   (globals -> parflow_simulation)
 
 #define pqr_to_process(p, q, r, P, Q, R)  ((((r)*(Q))+(q))*(P) + (p))
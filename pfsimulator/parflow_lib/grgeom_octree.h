@@ -325,6 +325,59 @@ GrGeomOctreeCellIs(octree, GrGeomOctreeCellLeaf)
 		 })\
 }
 
+/*--------------------------------------------------------------------------
+ * GrGeomOctree looping macro:
+ *   GrGeomOctreeNodeLoop with the cells of each node at the level of
+ *   interest split among the threads (see ThreadedBoxLoopI0).
+ *--------------------------------------------------------------------------*/
+
+#define ThreadedGrGeomOctreeNodeLoop(clauses, i, j, k, node, octree, level,\
+				     ix, iy, iz, nx, ny, nz, value_test,\
+				     body)\
+{\
+   int  PV_i, PV_j, PV_k, PV_l;\
+   int  PV_ixl, PV_iyl, PV_izl, PV_ixu, PV_iyu, PV_izu;\
+\
+\
+   PV_i = i;\
+   PV_j = j;\
+   PV_k = k;\
+\
+   GrGeomOctreeLoop(PV_i, PV_j, PV_k, PV_l, node, octree, level, value_test,\
+		 {\
+		    if ((PV_i >= ix) && (PV_i < (ix + nx)) &&\
+			(PV_j >= iy) && (PV_j < (iy + ny)) &&\
+			(PV_k >= iz) && (PV_k < (iz + nz)))\
+		    {\
+		       i = PV_i;\
+		       j = PV_j;\
+		       k = PV_k;\
+		 \
+		       body;\
+		    }\
+		 },\
+		 {\
+		    /* find octree and region intersection */\
+		    PV_ixl = pfmax(ix, PV_i);\
+		    PV_iyl = pfmax(iy, PV_j);\
+		    PV_izl = pfmax(iz, PV_k);\
+		    PV_ixu = pfmin((ix + nx), (PV_i + (int)PV_inc));\
+		    PV_iyu = pfmin((iy + ny), (PV_j + (int)PV_inc));\
+		    PV_izu = pfmin((iz + nz), (PV_k + (int)PV_inc));\
+		 \
+		    /* loop over indexes and execute the body */\
+		    if ((PV_ixl < PV_ixu) && (PV_iyl < PV_iyu) &&\
+			(PV_izl < PV_izu))\
+		    {\
+		       ThreadedBoxLoopI0(clauses, i, j, k,\
+					 PV_ixl, PV_iyl, PV_izl,\
+					 PV_ixu - PV_ixl, PV_iyu - PV_iyl,\
+					 PV_izu - PV_izl,\
+					 body);\
+		    }\
+		 })\
+}
+
 /*--------------------------------------------------------------------------
  * GrGeomOctree looping macro:
  *   Generic macro for looping over cell nodes with non-unitary strides.
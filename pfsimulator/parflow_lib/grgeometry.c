@@ -283,6 +283,7 @@ int            octree_iy,
 int            octree_iz)
 {
     GrGeomSolid   *new_grgeomsolid;
+    size_t         max_patch_faces;
 
 
     new_grgeomsolid = talloc(GrGeomSolid, 1);
@@ -294,6 +295,13 @@ int            octree_iz)
     (new_grgeomsolid -> octree_ix)       = octree_ix;
     (new_grgeomsolid -> octree_iy)       = octree_iy;
     (new_grgeomsolid -> octree_iz)       = octree_iz;
+    (new_grgeomsolid -> num_in_spans)    = 0;
+
+    /* face list slots of all patches, GrGeomMaxPatchFaces per patch */
+    max_patch_faces = (size_t)num_patches * GrGeomMaxPatchFaces;
+    (new_grgeomsolid -> patch_faces)     =
+       ctalloc(GrGeomFaces *, max_patch_faces);
+    (new_grgeomsolid -> num_patch_faces) = ctalloc(int, num_patches);
 
     return new_grgeomsolid;
 }
@@ -306,17 +314,328 @@ int            octree_iz)
 void          GrGeomFreeSolid(
    GrGeomSolid  *solid)
 {
-   int  i;
+   int  i, n;
 
    GrGeomFreeOctree(GrGeomSolidData(solid));
    for (i = 0; i < GrGeomSolidNumPatches(solid); i++)
       GrGeomFreeOctree(GrGeomSolidPatch(solid, i));
    tfree(GrGeomSolidPatches(solid));
 
+   for (i = 0; i < GrGeomSolidNumInSpans(solid); i++)
+      GrGeomFreeSpans(GrGeomSolidInSpans(solid, i));
+
+   for (i = 0; i < GrGeomSolidNumPatches(solid); i++)
+      for (n = 0; n < GrGeomSolidNumPatchFaces(solid, i); n++)
+	 GrGeomFreeFaces(GrGeomSolidPatchFaces(solid, i, n));
+   tfree(solid -> patch_faces);
+   tfree(solid -> num_patch_faces);
+
    tfree(solid);
 }
 
 
+/*--------------------------------------------------------------------------
+ * GrGeomNewInSpans:
+ *   Build the spans of the cells of solid inside the box ix..ix+nx-1,
+ *   iy..iy+ny-1, iz..iz+nz-1 at refinement level r.  The octree is walked
+ *   twice, once to count the spans and once to fill them in.
+ *--------------------------------------------------------------------------*/
+
+GrGeomSpans   *GrGeomNewInSpans(
+GrGeomSolid   *solid,
+int            r,
+int            ix,
+int            iy,
+int            iz,
+int            nx,
+int            ny,
+int            nz)
+{
+   GrGeomSpans   *spans;
+   GrGeomSpan    *span = NULL;
+
+   int            num_spans, num_cells;
+   int            i, j, k;
+   int            li, lj, lk;
+
+
+   /* count the spans; a cell starts a new span unless it follows
+      the previous cell along x */
+   num_spans = 0;
+   num_cells = 0;
+   li = lj = lk = 0;
+   GrGeomInOctreeLoop(i, j, k, solid, r, ix, iy, iz, nx, ny, nz,
+   {
+      if ((num_cells == 0) || (i != li + 1) || (j != lj) || (k != lk))
+	 num_spans++;
+      num_cells++;
+      li = i;
+      lj = j;
+      lk = k;
+   });
+
+   spans = talloc(GrGeomSpans, 1);
+
+   (spans -> r)         = r;
+   (spans -> ix)        = ix;
+   (spans -> iy)        = iy;
+   (spans -> iz)        = iz;
+   (spans -> nx)        = nx;
+   (spans -> ny)        = ny;
+   (spans -> nz)        = nz;
+   (spans -> data)      = talloc(GrGeomSpan, num_spans);
+   (spans -> num_spans) = num_spans;
+   (spans -> num_cells) = num_cells;
+
+   num_spans = 0;
+   GrGeomInOctreeLoop(i, j, k, solid, r, ix, iy, iz, nx, ny, nz,
+   {
+      if ((num_spans > 0) &&
+	  (i == (span -> ix) + (span -> nx)) &&
+	  (j == (span -> iy)) && (k == (span -> iz)))
+      {
+	 (span -> nx)++;
+      }
+      else
+      {
+	 span = GrGeomSpansSpan(spans, num_spans);
+	 (span -> ix) = i;
+	 (span -> iy) = j;
+	 (span -> iz) = k;
+	 (span -> nx) = 1;
+	 num_spans++;
+      }
+   });
+
+   return spans;
+}
+
+
+/*--------------------------------------------------------------------------
+ * GrGeomFreeSpans
+ *--------------------------------------------------------------------------*/
+
+void           GrGeomFreeSpans(
+GrGeomSpans   *spans)
+{
+   tfree(spans -> data);
+   tfree(spans);
+}
+
+
+/*--------------------------------------------------------------------------
+ * GrGeomGetInSpans:
+ *   Return the spans of the inside of solid for the given box, building
+ *   them the first time the box is asked for.  The cached boxes are kept
+ *   most recently used first; once GrGeomMaxInSpans boxes are held the
+ *   least recently used one is dropped to make room.  NULL is returned
+ *   when the span cache is turned off (Solver.GrGeom.SpanCache) and
+ *   GrGeomInLoop then walks the octree instead.
+ *--------------------------------------------------------------------------*/
+
+GrGeomSpans   *GrGeomGetInSpans(
+GrGeomSolid   *solid,
+int            r,
+int            ix,
+int            iy,
+int            iz,
+int            nx,
+int            ny,
+int            nz)
+{
+   GrGeomSpans   *spans = NULL;
+   int            n;
+
+
+   if (!GlobalsGrGeomSpanCache)
+      return NULL;
+
+   for (n = 0; n < GrGeomSolidNumInSpans(solid); n++)
+   {
+      spans = GrGeomSolidInSpans(solid, n);
+      if ((GrGeomSpansR(spans)  == r)  &&
+	  (GrGeomSpansIX(spans) == ix) &&
+	  (GrGeomSpansIY(spans) == iy) &&
+	  (GrGeomSpansIZ(spans) == iz) &&
+	  (GrGeomSpansNX(spans) == nx) &&
+	  (GrGeomSpansNY(spans) == ny) &&
+	  (GrGeomSpansNZ(spans) == nz))
+      {
+	 break;
+      }
+   }
+
+   if (n == GrGeomSolidNumInSpans(solid))
+   {
+      spans = GrGeomNewInSpans(solid, r, ix, iy, iz, nx, ny, nz);
+
+      if (n == GrGeomMaxInSpans)
+	 GrGeomFreeSpans(GrGeomSolidInSpans(solid, --n));
+      else
+	 GrGeomSolidNumInSpans(solid)++;
+   }
+
+   /* move the box to the front */
+   for (; n > 0; n--)
+      GrGeomSolidInSpans(solid, n) = GrGeomSolidInSpans(solid, n - 1);
+   GrGeomSolidInSpans(solid, 0) = spans;
+
+   return spans;
+}
+
+
+/*--------------------------------------------------------------------------
+ * GrGeomNewPatchFaces:
+ *   List the faces of patch patch_num of solid inside the box
+ *   ix..ix+nx-1, iy..iy+ny-1, iz..iz+nz-1 at refinement level r.  The
+ *   patch octree is walked twice, once to count the faces and once to
+ *   fill in the list.
+ *--------------------------------------------------------------------------*/
+
+GrGeomFaces   *GrGeomNewPatchFaces(
+GrGeomSolid   *solid,
+int            patch_num,
+int            r,
+int            ix,
+int            iy,
+int            iz,
+int            nx,
+int            ny,
+int            nz)
+{
+   GrGeomFaces   *faces;
+
+   int            num_faces;
+   int            i, j, k;
+   int           *fdir;
+
+
+   num_faces = 0;
+   GrGeomPatchOctreeLoop(i, j, k, fdir, solid, patch_num,
+			 r, ix, iy, iz, nx, ny, nz,
+   {
+      num_faces++;
+   });
+
+   faces = talloc(GrGeomFaces, 1);
+
+   (faces -> r)         = r;
+   (faces -> ix)        = ix;
+   (faces -> iy)        = iy;
+   (faces -> iz)        = iz;
+   (faces -> nx)        = nx;
+   (faces -> ny)        = ny;
+   (faces -> nz)        = nz;
+   (faces -> i)         = talloc(int, num_faces);
+   (faces -> j)         = talloc(int, num_faces);
+   (faces -> k)         = talloc(int, num_faces);
+   (faces -> face)      = talloc(int, num_faces);
+   (faces -> num_faces) = num_faces;
+
+   num_faces = 0;
+   GrGeomPatchOctreeLoop(i, j, k, fdir, solid, patch_num,
+			 r, ix, iy, iz, nx, ny, nz,
+   {
+      GrGeomFacesI(faces)[num_faces] = i;
+      GrGeomFacesJ(faces)[num_faces] = j;
+      GrGeomFacesK(faces)[num_faces] = k;
+
+      if (fdir[0])
+	 GrGeomFacesFace(faces)[num_faces] =
+	    (fdir[0] < 0) ? GrGeomOctreeFaceL : GrGeomOctreeFaceR;
+      else if (fdir[1])
+	 GrGeomFacesFace(faces)[num_faces] =
+	    (fdir[1] < 0) ? GrGeomOctreeFaceD : GrGeomOctreeFaceU;
+      else
+	 GrGeomFacesFace(faces)[num_faces] =
+	    (fdir[2] < 0) ? GrGeomOctreeFaceB : GrGeomOctreeFaceF;
+
+      num_faces++;
+   });
+
+   return faces;
+}
+
+
+/*--------------------------------------------------------------------------
+ * GrGeomFreeFaces
+ *--------------------------------------------------------------------------*/
+
+void           GrGeomFreeFaces(
+GrGeomFaces   *faces)
+{
+   tfree(faces -> i);
+   tfree(faces -> j);
+   tfree(faces -> k);
+   tfree(faces -> face);
+   tfree(faces);
+}
+
+
+/*--------------------------------------------------------------------------
+ * GrGeomGetPatchFaces:
+ *   Return the face list of patch patch_num of solid for the given box,
+ *   building it the first time the box is asked for.  The cached boxes
+ *   of each patch are kept most recently used first; once
+ *   GrGeomMaxPatchFaces boxes are held the least recently used one is
+ *   dropped to make room.  NULL is returned when the cache is turned off
+ *   (Solver.GrGeom.SpanCache) and GrGeomPatchLoop then lists the faces
+ *   for the one loop only.
+ *--------------------------------------------------------------------------*/
+
+GrGeomFaces   *GrGeomGetPatchFaces(
+GrGeomSolid   *solid,
+int            patch_num,
+int            r,
+int            ix,
+int            iy,
+int            iz,
+int            nx,
+int            ny,
+int            nz)
+{
+   GrGeomFaces   *faces = NULL;
+   int            n;
+
+
+   if (!GlobalsGrGeomSpanCache)
+      return NULL;
+
+   for (n = 0; n < GrGeomSolidNumPatchFaces(solid, patch_num); n++)
+   {
+      faces = GrGeomSolidPatchFaces(solid, patch_num, n);
+      if ((GrGeomFacesR(faces)  == r)  &&
+	  (GrGeomFacesIX(faces) == ix) &&
+	  (GrGeomFacesIY(faces) == iy) &&
+	  (GrGeomFacesIZ(faces) == iz) &&
+	  (GrGeomFacesNX(faces) == nx) &&
+	  (GrGeomFacesNY(faces) == ny) &&
+	  (GrGeomFacesNZ(faces) == nz))
+      {
+	 break;
+      }
+   }
+
+   if (n == GrGeomSolidNumPatchFaces(solid, patch_num))
+   {
+      faces = GrGeomNewPatchFaces(solid, patch_num, r, ix, iy, iz, nx, ny, nz);
+
+      if (n == GrGeomMaxPatchFaces)
+	 GrGeomFreeFaces(GrGeomSolidPatchFaces(solid, patch_num, --n));
+      else
+	 GrGeomSolidNumPatchFaces(solid, patch_num)++;
+   }
+
+   /* move the box to the front */
+   for (; n > 0; n--)
+      GrGeomSolidPatchFaces(solid, patch_num, n) =
+	 GrGeomSolidPatchFaces(solid, patch_num, n - 1);
+   GrGeomSolidPatchFaces(solid, patch_num, 0) = faces;
+
+   return faces;
+}
+
+
 /*--------------------------------------------------------------------------
  * GrGeomSolidFromInd
  *--------------------------------------------------------------------------*/
@@ -406,4 +725,3 @@ void                GrGeomSolidFromGeom(
    *solid_ptr = solid;
 }
 
-
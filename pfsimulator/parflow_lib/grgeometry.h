@@ -52,6 +52,64 @@ typedef struct
 } GrGeomExtentArray;
 
 
+/*--------------------------------------------------------------------------
+ * Span structures:
+ *   The cells of a solid inside a box stored as runs of cells along x.
+ *   The spans are kept in the order GrGeomOctreeNodeLoop visits the
+ *   cells, so looping over them gives the same results as walking the
+ *   octree.
+ *--------------------------------------------------------------------------*/
+
+typedef struct
+{
+   int   ix, iy, iz;
+   int   nx;
+
+} GrGeomSpan;
+
+typedef struct
+{
+   /* the refinement level and box the spans were built for */
+   int          r;
+   int          ix, iy, iz;
+   int          nx, ny, nz;
+
+   GrGeomSpan  *data;
+   int          num_spans;
+   int          num_cells;
+
+} GrGeomSpans;
+
+/* number of boxes a solid keeps spans for, see GrGeomGetInSpans */
+#define GrGeomMaxInSpans 16
+
+/*--------------------------------------------------------------------------
+ * Face list structures:
+ *   The faces of a solid patch inside a box, one entry per cell face in
+ *   the order GrGeomOctreeFaceLoop visits them.  The cell indexes and
+ *   face (a GrGeomOctreeFace value) of the entries are kept in separate
+ *   arrays.
+ *--------------------------------------------------------------------------*/
+
+typedef struct
+{
+   /* the refinement level and box the faces were listed for */
+   int          r;
+   int          ix, iy, iz;
+   int          nx, ny, nz;
+
+   int         *i;
+   int         *j;
+   int         *k;
+   int         *face;
+   int          num_faces;
+
+} GrGeomFaces;
+
+/* number of boxes a solid keeps face lists for, per patch */
+#define GrGeomMaxPatchFaces 8
+
+
 /*--------------------------------------------------------------------------
  * Solid structures:
  *--------------------------------------------------------------------------*/
@@ -67,6 +125,14 @@ typedef struct
    int            octree_bg_level;
    int            octree_ix, octree_iy, octree_iz;
 
+   /* spans of the inside of the solid, see GrGeomGetInSpans */
+   GrGeomSpans   *in_spans[GrGeomMaxInSpans];
+   int            num_in_spans;
+
+   /* face lists of the patches, see GrGeomGetPatchFaces */
+   GrGeomFaces  **patch_faces;      /* num_patches x GrGeomMaxPatchFaces */
+   int           *num_patch_faces;  /* num_patches */
+
 } GrGeomSolid;
 
 
@@ -92,18 +158,99 @@ typedef struct
 #define GrGeomSolidOctreeIY(solid)      ((solid) -> octree_iy)
 #define GrGeomSolidOctreeIZ(solid)      ((solid) -> octree_iz)
 #define GrGeomSolidPatch(solid, i)      ((solid) -> patches[i])
+#define GrGeomSolidInSpans(solid, i)    ((solid) -> in_spans[i])
+#define GrGeomSolidNumInSpans(solid)    ((solid) -> num_in_spans)
+
+#define GrGeomSolidPatchFaces(solid, p, n) \
+((solid) -> patch_faces[(p)*GrGeomMaxPatchFaces + (n)])
+#define GrGeomSolidNumPatchFaces(solid, p) ((solid) -> num_patch_faces[p])
+
+#define GrGeomSpansR(spans)             ((spans) -> r)
+#define GrGeomSpansIX(spans)            ((spans) -> ix)
+#define GrGeomSpansIY(spans)            ((spans) -> iy)
+#define GrGeomSpansIZ(spans)            ((spans) -> iz)
+#define GrGeomSpansNX(spans)            ((spans) -> nx)
+#define GrGeomSpansNY(spans)            ((spans) -> ny)
+#define GrGeomSpansNZ(spans)            ((spans) -> nz)
+#define GrGeomSpansSpan(spans, s)       (&((spans) -> data[s]))
+#define GrGeomSpansNumSpans(spans)      ((spans) -> num_spans)
+#define GrGeomSpansNumCells(spans)      ((spans) -> num_cells)
+
+#define GrGeomFacesR(faces)             ((faces) -> r)
+#define GrGeomFacesIX(faces)            ((faces) -> ix)
+#define GrGeomFacesIY(faces)            ((faces) -> iy)
+#define GrGeomFacesIZ(faces)            ((faces) -> iz)
+#define GrGeomFacesNX(faces)            ((faces) -> nx)
+#define GrGeomFacesNY(faces)            ((faces) -> ny)
+#define GrGeomFacesNZ(faces)            ((faces) -> nz)
+#define GrGeomFacesI(faces)             ((faces) -> i)
+#define GrGeomFacesJ(faces)             ((faces) -> j)
+#define GrGeomFacesK(faces)             ((faces) -> k)
+#define GrGeomFacesFace(faces)          ((faces) -> face)
+#define GrGeomFacesNumFaces(faces)      ((faces) -> num_faces)
 
 
 /*==========================================================================
  *==========================================================================*/
 
+/*--------------------------------------------------------------------------
+ * GrGeomSpans looping macro:
+ *   Macro for looping over the cells of a set of spans.
+ *--------------------------------------------------------------------------*/
+
+#define GrGeomSpansLoop(i, j, k, spans, body)\
+{\
+   GrGeomSpan  *PV_span;\
+   int          PV_s, PV_iu;\
+\
+\
+   for (PV_s = 0; PV_s < GrGeomSpansNumSpans(spans); PV_s++)\
+   {\
+      PV_span = GrGeomSpansSpan(spans, PV_s);\
+      j = PV_span -> iy;\
+      k = PV_span -> iz;\
+      PV_iu = PV_span -> ix + PV_span -> nx;\
+      for (i = PV_span -> ix; i < PV_iu; i++)\
+      {\
+	 body;\
+      }\
+   }\
+}
+
+/*--------------------------------------------------------------------------
+ * GrGeomSpans looping macro:
+ *   GrGeomSpansLoop with the spans split among the threads.  clauses are
+ *   as for ThreadedBoxLoopI0.
+ *--------------------------------------------------------------------------*/
+
+#define ThreadedGrGeomSpansLoop(clauses, i, j, k, spans, body)\
+{\
+   int          PV_s;\
+\
+\
+   ThreadPragma(omp parallel for private(i, j, k) clauses\
+		if (GrGeomSpansNumCells(spans) >= THREADED_LOOP_MIN_CELLS))\
+   for (PV_s = 0; PV_s < GrGeomSpansNumSpans(spans); PV_s++)\
+   {\
+      GrGeomSpan  *PV_span = GrGeomSpansSpan(spans, PV_s);\
+      int          PV_iu   = PV_span -> ix + PV_span -> nx;\
+\
+      j = PV_span -> iy;\
+      k = PV_span -> iz;\
+      for (i = PV_span -> ix; i < PV_iu; i++)\
+      {\
+	 body;\
+      }\
+   }\
+}
+
 /*--------------------------------------------------------------------------
  * GrGeomSolid looping macro:
- *   Macro for looping over the inside of a solid.
+ *   Macro for looping over the inside of a solid by walking its octree.
  *--------------------------------------------------------------------------*/
 
-#define GrGeomInLoop(i, j, k, grgeom,\
-		     r, ix, iy, iz, nx, ny, nz, body)\
+#define GrGeomInOctreeLoop(i, j, k, grgeom,\
+			   r, ix, iy, iz, nx, ny, nz, body)\
 {\
    GrGeomOctree  *PV_node;\
    double         PV_ref = pow(2.0, r);\
@@ -121,6 +268,66 @@ typedef struct
 			body);\
 }
 
+/*--------------------------------------------------------------------------
+ * GrGeomSolid looping macro:
+ *   Macro for looping over the inside of a solid.  The cached spans of
+ *   the solid are used when there are any (see GrGeomSolidInSpans),
+ *   otherwise the octree is walked.
+ *--------------------------------------------------------------------------*/
+
+#define GrGeomInLoop(i, j, k, grgeom,\
+		     r, ix, iy, iz, nx, ny, nz, body)\
+{\
+   GrGeomSpans   *PV_spans;\
+\
+\
+   PV_spans = GrGeomGetInSpans(grgeom, r, ix, iy, iz, nx, ny, nz);\
+   if (PV_spans)\
+   {\
+      GrGeomSpansLoop(i, j, k, PV_spans, body);\
+   }\
+   else\
+   {\
+      GrGeomInOctreeLoop(i, j, k, grgeom, r, ix, iy, iz, nx, ny, nz, body);\
+   }\
+}
+
+/*--------------------------------------------------------------------------
+ * GrGeomSolid looping macro:
+ *   GrGeomInLoop with the cells split among the threads.  clauses are as
+ *   for ThreadedBoxLoopI0; the body may only write to cell (i, j, k).
+ *--------------------------------------------------------------------------*/
+
+#define ThreadedGrGeomInLoop(clauses, i, j, k, grgeom,\
+			     r, ix, iy, iz, nx, ny, nz, body)\
+{\
+   GrGeomSpans   *PV_spans;\
+\
+\
+   PV_spans = GrGeomGetInSpans(grgeom, r, ix, iy, iz, nx, ny, nz);\
+   if (PV_spans)\
+   {\
+      ThreadedGrGeomSpansLoop(clauses, i, j, k, PV_spans, body);\
+   }\
+   else\
+   {\
+      GrGeomOctree  *PV_node;\
+      double         PV_ref = pow(2.0, r);\
+\
+\
+      i = GrGeomSolidOctreeIX(grgeom)*(int)PV_ref;\
+      j = GrGeomSolidOctreeIY(grgeom)*(int)PV_ref;\
+      k = GrGeomSolidOctreeIZ(grgeom)*(int)PV_ref;\
+      ThreadedGrGeomOctreeNodeLoop(clauses, i, j, k, PV_node,\
+				   GrGeomSolidData(grgeom),\
+				   GrGeomSolidOctreeBGLevel(grgeom) + r,\
+				   ix, iy, iz, nx, ny, nz,\
+				   (GrGeomOctreeCellIsInside(PV_node) ||\
+				    GrGeomOctreeCellIsFull(PV_node)),\
+				   body);\
+   }\
+}
+
 /*--------------------------------------------------------------------------
  * GrGeomSolid looping macro:
  *   Macro for looping over the inside of a solid with non-unitary strides.
@@ -214,13 +421,38 @@ typedef struct
 			ix, iy, iz, nx, ny, nz, body);\
 }
 
+/*--------------------------------------------------------------------------
+ * GrGeomFaces looping macro:
+ *   Macro for looping over the entries of a face list.  fdir points to
+ *   the outward normal of the current face.
+ *--------------------------------------------------------------------------*/
+
+#define GrGeomFacesLoop(i, j, k, fdir, faces, body)\
+{\
+   int  PV_fdirs[GrGeomOctreeNumFaces][3] =\
+      {{-1, 0, 0}, {1, 0, 0}, {0, -1, 0}, {0, 1, 0}, {0, 0, -1}, {0, 0, 1}};\
+   int  PV_n;\
+\
+\
+   for (PV_n = 0; PV_n < GrGeomFacesNumFaces(faces); PV_n++)\
+   {\
+      i = GrGeomFacesI(faces)[PV_n];\
+      j = GrGeomFacesJ(faces)[PV_n];\
+      k = GrGeomFacesK(faces)[PV_n];\
+      fdir = PV_fdirs[GrGeomFacesFace(faces)[PV_n]];\
+\
+      body;\
+   }\
+}
+
 /*--------------------------------------------------------------------------
  * GrGeomSolid looping macro:
- *   Macro for looping over the faces of a solid patch.
+ *   Macro for looping over the faces of a solid patch by walking the
+ *   patch octree.
  *--------------------------------------------------------------------------*/
 
-#define GrGeomPatchLoop(i, j, k, fdir, grgeom, patch_num,\
-			r, ix, iy, iz, nx, ny, nz, body)\
+#define GrGeomPatchOctreeLoop(i, j, k, fdir, grgeom, patch_num,\
+			      r, ix, iy, iz, nx, ny, nz, body)\
 {\
    GrGeomOctree  *PV_node;\
    double         PV_ref = pow(2.0, r);\
@@ -235,6 +467,34 @@ typedef struct
 			ix, iy, iz, nx, ny, nz, body);\
 }
 
+/*--------------------------------------------------------------------------
+ * GrGeomSolid looping macro:
+ *   Macro for looping over the faces of a solid patch.  The cached face
+ *   list of the patch is used when there is one (see
+ *   GrGeomGetPatchFaces), otherwise a face list is built from the patch
+ *   octree for this loop only.
+ *--------------------------------------------------------------------------*/
+
+#define GrGeomPatchLoop(i, j, k, fdir, grgeom, patch_num,\
+			r, ix, iy, iz, nx, ny, nz, body)\
+{\
+   GrGeomFaces   *PV_faces;\
+   GrGeomFaces   *PV_tmp_faces = NULL;\
+\
+\
+   PV_faces = GrGeomGetPatchFaces(grgeom, patch_num,\
+				  r, ix, iy, iz, nx, ny, nz);\
+   if (!PV_faces)\
+   {\
+      PV_tmp_faces = GrGeomNewPatchFaces(grgeom, patch_num,\
+					 r, ix, iy, iz, nx, ny, nz);\
+      PV_faces = PV_tmp_faces;\
+   }\
+   GrGeomFacesLoop(i, j, k, fdir, PV_faces, body);\
+   if (PV_tmp_faces)\
+      GrGeomFreeFaces(PV_tmp_faces);\
+}
+
 
 /*--------------------------------------------------------------------------
  * GrGeomSolid looping macro:
@@ -99,6 +99,10 @@ Grid  *NewGrid(
 
    new_grid -> compute_pkgs = NULL;
 
+   new_grid -> vector_pool = NULL;
+
+   new_grid -> comm_plans = NULL;
+
    return new_grid;
 }
 
@@ -112,6 +116,11 @@ void  FreeGrid(
 {
    if(grid)  {
 
+      /* pooled vectors reference the subgrids so free them first */
+      FreeGridVectorPool(grid);
+
+      FreeGridCommPlans(grid);
+
       if (grid -> background) {
 	 FreeSubgrid(grid -> background);
       }
@@ -590,6 +599,73 @@ SubgridArray  *SubtractSubgrids(
 }
 
 
+/*--------------------------------------------------------------------------
+ * SubtractBox:
+ *   Compute B_1 - B_2 for boxes given as {ix, iy, iz, nx, ny, nz} in the
+ *   same index space.  The result is put in at most 6 disjoint boxes and
+ *   their number is returned.  Unlike SubtractSubgrids nothing is
+ *   allocated, so this may be used on every call of a compute routine.
+ *--------------------------------------------------------------------------*/
+
+int            SubtractBox(
+   int            box1[6],
+   int            box2[6],
+   int            boxes[6][6])
+{
+   int            lo[3], hi[3], cut_lo[3], cut_hi[3];
+   int            d, e, n;
+
+
+   for (d = 0; d < 3; d++)
+   {
+      lo[d] = box1[d];
+      hi[d] = box1[d] + box1[d+3];
+
+      cut_lo[d] = pfmax(box2[d], lo[d]);
+      cut_hi[d] = pfmin(box2[d] + box2[d+3], hi[d]);
+
+      if (cut_lo[d] >= cut_hi[d])
+      {
+	 for (e = 0; e < 6; e++)
+	    boxes[0][e] = box1[e];
+	 return 1;
+      }
+   }
+
+   /* cut off the slabs below and above B_2 in z, then in y, then in x */
+   n = 0;
+   for (d = 2; d >= 0; d--)
+   {
+      if (cut_lo[d] > lo[d])
+      {
+	 for (e = 0; e < 3; e++)
+	 {
+	    boxes[n][e]   = lo[e];
+	    boxes[n][e+3] = hi[e] - lo[e];
+	 }
+	 boxes[n][d+3] = cut_lo[d] - lo[d];
+	 n++;
+      }
+      if (cut_hi[d] < hi[d])
+      {
+	 for (e = 0; e < 3; e++)
+	 {
+	    boxes[n][e]   = lo[e];
+	    boxes[n][e+3] = hi[e] - lo[e];
+	 }
+	 boxes[n][d]   = cut_hi[d];
+	 boxes[n][d+3] = hi[d] - cut_hi[d];
+	 n++;
+      }
+
+      lo[d] = cut_lo[d];
+      hi[d] = cut_hi[d];
+   }
+
+   return n;
+}
+
+
 /*--------------------------------------------------------------------------
  * UnionSubgridArray: RDF todo
  *   Compute the union of all S_i.
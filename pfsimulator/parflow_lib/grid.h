@@ -71,6 +71,12 @@ typedef struct
 
    ComputePkg   **compute_pkgs;
 
+   CommPlan      *comm_plans;  /* Shared communication plans for
+				  vectors on this grid (see GridCommPlan) */
+
+   struct _VectorPoolEntry *vector_pool; /* Work vectors on this grid
+					    (see CheckoutVector) */
+
    Subgrid        *background;   /* The background reference grid for 
 				    this grid.   Includes the entire 
 				    space of points that all subgrids
@@ -122,6 +128,10 @@ typedef struct
 #define GridComputePkgs(grid)   ((grid) -> compute_pkgs)
 #define GridComputePkg(grid, i) ((grid) -> compute_pkgs[(i)])
 
+#define GridVectorPool(grid)    ((grid) -> vector_pool)
+
+#define GridCommPlans(grid)     ((grid) -> comm_plans)
+
 #define GridSubgrid(grid, i)  (SubgridArraySubgrid(GridSubgrids(grid), i))
 #define GridNumSubgrids(grid) (SubgridArraySize(GridSubgrids(grid)))
 
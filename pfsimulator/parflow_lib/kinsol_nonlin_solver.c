@@ -38,6 +38,7 @@ typedef struct
    int       max_iter;
    int       krylov_dimension;
    int       max_restarts;
+   int       gs_type;
    int       print_flag;
    int       eta_choice;
    int       globalization;
@@ -50,6 +51,10 @@ typedef struct
    double    eta_alpha;
    double    eta_gamma;
    double    derivative_epsilon;
+
+   int       pc_reuse_newton_iter;
+   int       pc_reuse_time_steps;
+   double    pc_reuse_lin_iter_ratio;
    
    PFModule *precond;
    PFModule *nl_function_eval;
@@ -80,6 +85,10 @@ typedef struct
 
    State    *current_state;
 
+   /* preconditioner reuse across time steps */
+   int       pc_time_steps;      /* time steps the last setup was used for */
+   double    pc_lin_iter_base;   /* linear its. per Newton it. after it */
+
    KINMem    kin_mem;
    FILE     *kinsol_file;
    SysFn     feval;
@@ -234,6 +243,8 @@ int KinsolNonlinSolver (Vector *pressure , Vector *density , Vector *old_density
 
    int           ret              = 0;
 
+   double        lin_iter;
+
    StateFunc(current_state)          = nl_function_eval;
    StateProblemData(current_state)   = problem_data;
    StateTime(current_state)          = t;
@@ -256,6 +267,12 @@ int KinsolNonlinSolver (Vector *pressure , Vector *density , Vector *old_density
    if (!amps_Rank(amps_CommWorld))
       fprintf(kinsol_file,"\nKINSOL starting step for time %f\n",t);
 
+   /* Keep the preconditioner of the last time step unless it has been
+      used for the allowed number of time steps.  KINSol still sets it up
+      again if the linear solve or the line search fails with it. */
+   iopt[PRECOND_NO_INIT] =
+      ((instance_xtra -> pc_time_steps) < (public_xtra -> pc_reuse_time_steps));
+
    BeginTiming(public_xtra -> time_index);
 
    ret = KINSol( (void*)kin_mem,        /* Memory allocated above */
@@ -288,6 +305,35 @@ int KinsolNonlinSolver (Vector *pressure , Vector *density , Vector *old_density
    if (!amps_Rank(amps_CommWorld))
       PrintFinalStats(kinsol_file, iopt, integer_outputs);
 
+   /* Update the age of the preconditioner.  A step that set it up gives
+      the linear iterations per Newton iteration to expect from it; it is
+      set up again at the next step if a step using it needed more than
+      pc_reuse_lin_iter_ratio times as many, or if the step failed.  If it
+      was set up in a step without Newton iterations, the next step with
+      iterations gives the base instead. */
+   lin_iter = (iopt[NNI] > 0) ?
+      ((double) iopt[SPGMR_NLI])/((double) iopt[NNI]) : 0.0;
+
+   if ( iopt[SPGMR_NPE] > 0 )
+   {
+      (instance_xtra -> pc_time_steps)    = 1;
+      (instance_xtra -> pc_lin_iter_base) = lin_iter;
+   }
+   else
+   {
+      (instance_xtra -> pc_time_steps)++;
+
+      if ( (instance_xtra -> pc_lin_iter_base) == 0.0 )
+	 (instance_xtra -> pc_lin_iter_base) = lin_iter;
+   }
+
+   if ( ( ret != KINSOL_SUCCESS && ret != KINSOL_INITIAL_GUESS_OK ) ||
+	lin_iter > (public_xtra -> pc_reuse_lin_iter_ratio)
+	           *(instance_xtra -> pc_lin_iter_base) )
+   {
+      (instance_xtra -> pc_time_steps) = (public_xtra -> pc_reuse_time_steps);
+   }
+
    if ( ret == KINSOL_SUCCESS || ret == KINSOL_INITIAL_GUESS_OK ) 
    {
       ret = 0;
@@ -297,6 +343,25 @@ int KinsolNonlinSolver (Vector *pressure , Vector *density , Vector *old_density
 
 }
 
+/*--------------------------------------------------------------------------
+ * KinsolNonlinSolverStepStats:
+ *   Return the number of nonlinear and linear iterations taken by the
+ *   last call of the solver instance this_module.
+ *--------------------------------------------------------------------------*/
+
+void  KinsolNonlinSolverStepStats(
+PFModule  *this_module,
+int       *num_nonlin_iter,
+int       *num_lin_iter)
+{
+   InstanceXtra  *instance_xtra = (InstanceXtra *)PFModuleInstanceXtra(this_module);
+   long int      *iopt          = (instance_xtra -> int_optional_input);
+
+   *num_nonlin_iter = (int) iopt[NNI];
+   *num_lin_iter    = (int) iopt[SPGMR_NLI];
+}
+
+
 /*--------------------------------------------------------------------------
  * KinsolNonlinSolverInitInstanceXtra
  *--------------------------------------------------------------------------*/
@@ -314,7 +379,9 @@ double      *temp_data)
    int           neq                 = public_xtra -> neq;
    int           max_restarts        = public_xtra -> max_restarts;
    int           krylov_dimension    = public_xtra -> krylov_dimension;
+   int           gs_type             = public_xtra -> gs_type;
    int           max_iter            = public_xtra -> max_iter;
+   int           pc_reuse_newton_iter = public_xtra -> pc_reuse_newton_iter;
    int           print_flag          = public_xtra -> print_flag;
    int           eta_choice          = public_xtra -> eta_choice;
 
@@ -414,12 +481,13 @@ double      *temp_data)
       KINSpgmr( (void*)kin_mem,        /* Memory allocated above */
 		krylov_dimension,      /* Max. Krylov dimension */
 		max_restarts,          /* Max. no. of restarts - 0 is none */
-		1,                     /* Max. calls to PC Solve w/o PC Set */
+		pc_reuse_newton_iter,  /* Max. Newton its. w/o PC Set */
 		pcinit,                /* PC Set function */
 		pcsolve,               /* PC Solve function */
 		matvec,                /* ATimes routine */
 		current_state          /* User data for PC stuff */
 		);
+      KINSpgmrSetGSType( (void*)kin_mem, gs_type );
 
       /* Initialize optional arguments for KINSol */
       iopt = instance_xtra -> int_optional_input;
@@ -462,6 +530,9 @@ double      *temp_data)
       instance_xtra -> feval = KINSolFunctionEval;
       instance_xtra -> kin_mem = kin_mem;
       instance_xtra -> current_state = current_state;
+
+      /* The first step sets up the preconditioner */
+      instance_xtra -> pc_time_steps = public_xtra -> pc_reuse_time_steps;
    }
 
 
@@ -524,6 +595,7 @@ PFModule  *KinsolNonlinSolverNewPublicXtra()
    NameArray      eta_switch_na;
    NameArray      globalization_switch_na;
    NameArray      precond_switch_na;
+   NameArray      gs_switch_na;
 
    public_xtra = ctalloc(PublicXtra, 1);
 
@@ -539,6 +611,35 @@ PFModule  *KinsolNonlinSolverNewPublicXtra()
    sprintf(key, "Solver.Linear.MaxRestarts");
    (public_xtra -> max_restarts) = GetIntDefault(key, 0);
 
+   gs_switch_na = NA_NewNameArray("ModifiedGS ClassicalGS ClassicalGS2");
+   sprintf(key, "Solver.Linear.Orthogonalization");
+   switch_name = GetStringDefault(key, "ModifiedGS");
+   switch_value = NA_NameToIndex(gs_switch_na, switch_name);
+   switch (switch_value)
+   {
+      case 0:
+      {
+	 (public_xtra -> gs_type) = MODIFIED_GS;
+	 break;
+      }
+      case 1:
+      {
+	 (public_xtra -> gs_type) = CLASSICAL_GS;
+	 break;
+      }
+      case 2:
+      {
+	 (public_xtra -> gs_type) = CLASSICAL_GS2;
+	 break;
+      }
+      default:
+      {
+	 InputError("Error: Invalid value <%s> for key <%s>\n", switch_name,
+		     key);
+      }
+   }
+   NA_FreeNameArray(gs_switch_na);
+
    verbosity_switch_na = NA_NewNameArray("NoVerbosity LowVerbosity "
 	                                 "NormalVerbosity HighVerbosity");
    sprintf(key, "Solver.Nonlinear.PrintFlag");
@@ -664,6 +765,23 @@ PFModule  *KinsolNonlinSolverNewPublicXtra()
    }
    NA_FreeNameArray(precond_switch_na);
 
+   sprintf(key, "Solver.Linear.Preconditioner.ReuseNewtonIter");
+   (public_xtra -> pc_reuse_newton_iter) = GetIntDefault(key, 1);
+   if ( (public_xtra -> pc_reuse_newton_iter) < 1 )
+   {
+      InputError("Error: value for key <%s> must be at least 1%s\n", key, "");
+   }
+
+   sprintf(key, "Solver.Linear.Preconditioner.ReuseTimeSteps");
+   (public_xtra -> pc_reuse_time_steps) = GetIntDefault(key, 1);
+   if ( (public_xtra -> pc_reuse_time_steps) < 1 )
+   {
+      InputError("Error: value for key <%s> must be at least 1%s\n", key, "");
+   }
+
+   sprintf(key, "Solver.Linear.Preconditioner.ReuseLinIterRatio");
+   (public_xtra -> pc_reuse_lin_iter_ratio) = GetDoubleDefault(key, 2.0);
+
    public_xtra -> nl_function_eval = PFModuleNewModule(NlFunctionEval, ());
    public_xtra -> neq = ((public_xtra -> max_restarts)+1)
                            *(public_xtra -> krylov_dimension);
@@ -133,6 +133,218 @@ int  kinc = (sz)*(nxd)*(nyd) - (ny)*(sy)*(nxd)
    }\
 }
 
+/*--------------------------------------------------------------------------
+ * TiledBoxLoopI2:
+ *   Same iteration space as BoxLoopI2 but the j and k directions are
+ *   blocked into tiles of size tj x tk so that neighboring rows and
+ *   planes touched by a stencil stay in cache.  The indices are
+ *   recomputed at the start of every row so i1 and i2 are relative to
+ *   (ix, iy, iz) and are set (not incremented) by the macro.
+ *   Tile sizes <= 0 mean no blocking in that direction.
+ *--------------------------------------------------------------------------*/
+
+#define TiledBoxLoopI2(i, j, k,\
+		       ix, iy, iz, nx, ny, nz,\
+		       tj, tk,\
+		       i1, nx1, ny1, nz1, sx1, sy1, sz1,\
+		       i2, nx2, ny2, nz2, sx2, sy2, sz2,\
+		       body)\
+{\
+   int PV_tj = ((tj) > 0) ? (tj) : (ny);\
+   int PV_tk = ((tk) > 0) ? (tk) : (nz);\
+   int PV_jj, PV_kk, PV_jend, PV_kend;\
+   for (PV_kk = iz; PV_kk < iz + nz; PV_kk += PV_tk)\
+   {\
+      PV_kend = pfmin(PV_kk + PV_tk, iz + nz);\
+      for (PV_jj = iy; PV_jj < iy + ny; PV_jj += PV_tj)\
+      {\
+	 PV_jend = pfmin(PV_jj + PV_tj, iy + ny);\
+	 for (k = PV_kk; k < PV_kend; k++)\
+	 {\
+	    for (j = PV_jj; j < PV_jend; j++)\
+	    {\
+	       i1 = ((k - iz)*(sz1)*(ny1) + (j - iy)*(sy1))*(nx1);\
+	       i2 = ((k - iz)*(sz2)*(ny2) + (j - iy)*(sy2))*(nx2);\
+	       for (i = ix; i < ix + nx; i++)\
+	       {\
+		  body;\
+		  i1 += sx1;\
+		  i2 += sx2;\
+	       }\
+	    }\
+	 }\
+      }\
+   }\
+}
+
+/*--------------------------------------------------------------------------
+ * Threaded loops:
+ *   With OpenMP (configure --enable-openmp) the Threaded* macros split
+ *   the k and j loops of a box among the threads of the process.  The
+ *   indices are computed at the start of every row rather than carried
+ *   from the previous one, so any thread can do any row.
+ *
+ *   The first argument holds extra OpenMP clauses for the loop:
+ *   ThreadPrivate(...) for scalars assigned in the body,
+ *   ThreadReduction(op, ...) for values accumulated in the body, or
+ *   NoThreadClauses.  The loop and index variables are private already.
+ *   The body may only write to the current point and to private or
+ *   reduction variables.
+ *
+ *   Boxes with fewer than THREADED_LOOP_MIN_CELLS cells run on a single
+ *   thread.  Without OpenMP the macros are the serial loops.
+ *--------------------------------------------------------------------------*/
+
+#define THREADED_LOOP_MIN_CELLS 4096
+
+#ifdef PARFLOW_HAVE_OMP
+#define ThreadPragma(x)           PV_ThreadPragma(x)
+#define PV_ThreadPragma(x)        _Pragma(#x)
+#else
+#define ThreadPragma(x)
+#endif
+
+#define ThreadPrivate(...)        private(__VA_ARGS__)
+#define ThreadReduction(op, ...)  reduction(op:__VA_ARGS__)
+#define NoThreadClauses
+
+#define ThreadedLoopPragma(clauses, nx, ny, nz, ...)\
+   ThreadPragma(omp parallel for collapse(2) private(__VA_ARGS__) clauses\
+		if ((nx)*(ny)*(nz) >= THREADED_LOOP_MIN_CELLS))
+
+#define ThreadedBoxLoopI0(clauses, i, j, k,\
+			  ix, iy, iz, nx, ny, nz,\
+			  body)\
+{\
+   ThreadedLoopPragma(clauses, nx, ny, nz, i)\
+   for (k = iz; k < iz + nz; k++)\
+   {\
+      for (j = iy; j < iy + ny; j++)\
+      {\
+	 for (i = ix; i < ix + nx; i++)\
+	 {\
+	    body;\
+	 }\
+      }\
+   }\
+}
+
+#define ThreadedBoxLoopI1(clauses, i, j, k,\
+			  ix, iy, iz, nx, ny, nz,\
+			  i1, nx1, ny1, nz1, sx1, sy1, sz1,\
+			  body)\
+{\
+   int PV_i1 = i1;\
+   ThreadedLoopPragma(clauses, nx, ny, nz, i, i1)\
+   for (k = iz; k < iz + nz; k++)\
+   {\
+      for (j = iy; j < iy + ny; j++)\
+      {\
+	 i1 = PV_i1 + ((k - iz)*(sz1)*(ny1) + (j - iy)*(sy1))*(nx1);\
+	 for (i = ix; i < ix + nx; i++)\
+	 {\
+	    body;\
+	    i1 += sx1;\
+	 }\
+      }\
+   }\
+}
+
+#define ThreadedBoxLoopI2(clauses, i, j, k,\
+			  ix, iy, iz, nx, ny, nz,\
+			  i1, nx1, ny1, nz1, sx1, sy1, sz1,\
+			  i2, nx2, ny2, nz2, sx2, sy2, sz2,\
+			  body)\
+{\
+   int PV_i1 = i1;\
+   int PV_i2 = i2;\
+   ThreadedLoopPragma(clauses, nx, ny, nz, i, i1, i2)\
+   for (k = iz; k < iz + nz; k++)\
+   {\
+      for (j = iy; j < iy + ny; j++)\
+      {\
+	 i1 = PV_i1 + ((k - iz)*(sz1)*(ny1) + (j - iy)*(sy1))*(nx1);\
+	 i2 = PV_i2 + ((k - iz)*(sz2)*(ny2) + (j - iy)*(sy2))*(nx2);\
+	 for (i = ix; i < ix + nx; i++)\
+	 {\
+	    body;\
+	    i1 += sx1;\
+	    i2 += sx2;\
+	 }\
+      }\
+   }\
+}
+
+#define ThreadedBoxLoopI3(clauses, i, j, k,\
+			  ix, iy, iz, nx, ny, nz,\
+			  i1, nx1, ny1, nz1, sx1, sy1, sz1,\
+			  i2, nx2, ny2, nz2, sx2, sy2, sz2,\
+			  i3, nx3, ny3, nz3, sx3, sy3, sz3,\
+			  body)\
+{\
+   int PV_i1 = i1;\
+   int PV_i2 = i2;\
+   int PV_i3 = i3;\
+   ThreadedLoopPragma(clauses, nx, ny, nz, i, i1, i2, i3)\
+   for (k = iz; k < iz + nz; k++)\
+   {\
+      for (j = iy; j < iy + ny; j++)\
+      {\
+	 i1 = PV_i1 + ((k - iz)*(sz1)*(ny1) + (j - iy)*(sy1))*(nx1);\
+	 i2 = PV_i2 + ((k - iz)*(sz2)*(ny2) + (j - iy)*(sy2))*(nx2);\
+	 i3 = PV_i3 + ((k - iz)*(sz3)*(ny3) + (j - iy)*(sy3))*(nx3);\
+	 for (i = ix; i < ix + nx; i++)\
+	 {\
+	    body;\
+	    i1 += sx1;\
+	    i2 += sx2;\
+	    i3 += sx3;\
+	 }\
+      }\
+   }\
+}
+
+/*--------------------------------------------------------------------------
+ * ThreadedTiledBoxLoopI2:
+ *   TiledBoxLoopI2 with the tiles split among the threads.
+ *--------------------------------------------------------------------------*/
+
+#define ThreadedTiledBoxLoopI2(clauses, i, j, k,\
+			       ix, iy, iz, nx, ny, nz,\
+			       tj, tk,\
+			       i1, nx1, ny1, nz1, sx1, sy1, sz1,\
+			       i2, nx2, ny2, nz2, sx2, sy2, sz2,\
+			       body)\
+{\
+   int PV_tj = ((tj) > 0) ? (tj) : (ny);\
+   int PV_tk = ((tk) > 0) ? (tk) : (nz);\
+   int PV_jj, PV_kk, PV_jend, PV_kend;\
+   ThreadedLoopPragma(clauses, nx, ny, nz,\
+		      i, j, k, i1, i2, PV_jend, PV_kend)\
+   for (PV_kk = iz; PV_kk < iz + nz; PV_kk += PV_tk)\
+   {\
+      for (PV_jj = iy; PV_jj < iy + ny; PV_jj += PV_tj)\
+      {\
+	 PV_kend = pfmin(PV_kk + PV_tk, iz + nz);\
+	 PV_jend = pfmin(PV_jj + PV_tj, iy + ny);\
+	 for (k = PV_kk; k < PV_kend; k++)\
+	 {\
+	    for (j = PV_jj; j < PV_jend; j++)\
+	    {\
+	       i1 = ((k - iz)*(sz1)*(ny1) + (j - iy)*(sy1))*(nx1);\
+	       i2 = ((k - iz)*(sz2)*(ny2) + (j - iy)*(sy2))*(nx2);\
+	       for (i = ix; i < ix + nx; i++)\
+	       {\
+		  body;\
+		  i1 += sx1;\
+		  i2 += sx2;\
+	       }\
+	    }\
+	 }\
+      }\
+   }\
+}
+
 /*******************************************************************************
  *     SPECIAL NOTE! SPECIAL NOTE! SPECIAL NOTE! SPECIAL NOTE! SPECIAL NOTE!   *
  *                                                                             *
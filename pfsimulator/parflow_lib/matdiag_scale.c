@@ -96,7 +96,7 @@ void MatDiagScale (Vector *x , Matrix *A , Vector *b , int flag )
    int             ix,   iy,   iz;
    int             nx,   ny,   nz;
    int             nx_v, ny_v, nz_v;
-   int             nx_m, ny_m, nz_m;
+   int             nx_m, ny_m, nz_m, sx_m;
 
    int             iv, im;
    int             i, j, k;
@@ -130,6 +130,7 @@ void MatDiagScale (Vector *x , Matrix *A , Vector *b , int flag )
 	 nx_m = SubmatrixNX(A_sub);
 	 ny_m = SubmatrixNY(A_sub);
 	 nz_m = SubmatrixNZ(A_sub);
+	 sx_m = SubmatrixStride(A_sub);
 
 	 dp = SubvectorElt(d_sub, ix, iy, iz);
 	 cp = SubmatrixElt(A_sub, 0, ix, iy, iz);
@@ -138,7 +139,7 @@ void MatDiagScale (Vector *x , Matrix *A , Vector *b , int flag )
 	 im = 0;
 	 BoxLoopI2(i, j, k, ix, iy, iz, nx, ny, nz,
 		   iv, nx_v, ny_v, nz_v, 1, 1, 1,
-		   im, nx_m, ny_m, nz_m, 1, 1, 1,
+		   im, nx_m*sx_m, ny_m, nz_m, sx_m, 1, 1,
 		   {
 		      dp[iv] = 1.0/sqrt(cp[im]);
 		   });
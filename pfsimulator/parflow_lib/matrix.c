@@ -111,8 +111,10 @@ CommPkg   *NewMatrixUpdatePkg(
       ProjectRegion(recv_reg, sx, sy, sz, ix, iy, iz);
       
       
-      new_commpkg = NewCommPkg(send_reg, recv_reg,
-			       MatrixDataSpace(matrix), n, SubmatrixData(submatrix));
+      new_commpkg = NewCommPkgStrided(send_reg, recv_reg,
+				      MatrixDataSpace(matrix), n,
+				      SubmatrixStride(submatrix),
+				      SubmatrixData(submatrix));
 
       FreeRegion(send_reg);
       FreeRegion(recv_reg);
@@ -144,6 +146,7 @@ CommHandle  *InitMatrixUpdate(
 	 break;
       }
       case matrix_non_samrai : 
+      case matrix_interleaved : 
       {
 	 grid_type = invalid_grid_type;
 	 break;
@@ -242,6 +245,7 @@ enum matrix_type     type)
 
    int             i, j, k, n;
    int             nx, ny, nz;
+   int             stride;
 
    int            *symmetric_coeff;
 
@@ -361,6 +365,7 @@ enum matrix_type     type)
 	  break;
        }
        case matrix_non_samrai :
+       case matrix_interleaved :
        {
 	  grid_type = invalid_grid_type;
 	  break;
@@ -390,7 +395,8 @@ enum matrix_type     type)
 
 #else 
 
-    type = matrix_non_samrai;
+    if (type != matrix_interleaved)
+       type = matrix_non_samrai;
 
 #endif
 
@@ -415,6 +421,7 @@ enum matrix_type     type)
 	 break;
       }
       case matrix_non_samrai :
+      case matrix_interleaved :
       {
 	 break;
       }
@@ -470,12 +477,18 @@ enum matrix_type     type)
       nz = SubmatrixNZ(new_sub);
       n  = nx * ny * nz; 
 
+      /* interleaved data stores the coefficients of a cell together,
+	 so each coefficient is offset within the cell and consecutive
+	 cells are data_stencil_size apart */
+      stride = (type == matrix_interleaved) ? data_stencil_size : 1;
+
       data_size = 0;
+      j = 0;
       /* set pointers for upper triangle coefficients */
       for (k = 0; k < StencilSize(stencil); k++)
 	 if (!symmetric_coeff[k])
 	 {
-	    data_index[k] = data_size;
+	    data_index[k] = (type == matrix_interleaved) ? j++ : data_size;
 
 	    data_size += n;
 	 }
@@ -486,11 +499,12 @@ enum matrix_type     type)
 	 {
 	    data_index[k] =
 	       data_index[symmetric_coeff[k]] +
-	       (shape[k][2]*ny + shape[k][1])*nx + shape[k][0];
+	       ((shape[k][2]*ny + shape[k][1])*nx + shape[k][0]) * stride;
 	 }
 
       (new_sub -> data_index) = data_index;
       (new_sub -> data_size) = data_size;
+      (new_sub -> data_stride) = stride;
 
       MatrixSubmatrix(new_matrix, i) = new_sub;
 
@@ -504,6 +518,7 @@ enum matrix_type     type)
 	 }
 #endif
 	 case matrix_non_samrai :
+	 case matrix_interleaved :
 	 {
 	    Submatrix *submatrix = MatrixSubmatrix(new_matrix, i);
 	    data = amps_CTAlloc(double, submatrix -> data_size);
@@ -547,6 +562,7 @@ enum matrix_type     type)
       }
 #endif
       case matrix_non_samrai :
+      case matrix_interleaved :
       {
 	 // Allocated previously
 	 break;
@@ -604,6 +620,7 @@ enum matrix_type     type)
        }
 #endif
        case matrix_non_samrai :
+       case matrix_interleaved :
 	  if (ghost)
 	     MatrixCommPkg(new_matrix) = NewMatrixUpdatePkg(new_matrix, ghost);
    
@@ -671,6 +688,7 @@ void FreeMatrix(
       }
 #endif
       case matrix_non_samrai :
+      case matrix_interleaved :
       {
 	 break;
       }
@@ -729,6 +747,7 @@ void    InitMatrix(
    int         ix,   iy,   iz;
    int         nx,   ny,   nz;
    int         nx_m, ny_m, nz_m;
+   int         sx_m;
 
    int         i, j, k;
 
@@ -751,6 +770,7 @@ void    InitMatrix(
       nx_m = SubmatrixNX(A_sub);
       ny_m = SubmatrixNY(A_sub);
       nz_m = SubmatrixNZ(A_sub);
+      sx_m = SubmatrixStride(A_sub);
 
       stencil = MatrixStencil(A);
       for (s = 0; s < StencilSize(stencil); s++)
@@ -759,7 +779,7 @@ void    InitMatrix(
 	       
 	 im  = 0;
 	 BoxLoopI1(i, j, k, ix, iy, iz, nx, ny, nz,
-		   im, nx_m, ny_m, nz_m, 1, 1, 1,
+		   im, nx_m*sx_m, ny_m, nz_m, sx_m, 1, 1,
 		   {
 		      Ap[im]  = value;
 		   });
@@ -41,9 +41,16 @@
 #include "SAMRAI/xfer/RefineSchedule.h"
 #endif
 
+/*--------------------------------------------------------------------------
+ * matrix_interleaved stores the coefficients of a cell contiguously
+ * (array-of-stencils) instead of one plane per stencil coefficient, so
+ * a matrix row is read from a single cache line.
+ *--------------------------------------------------------------------------*/
+
 enum matrix_type { 
    matrix_cell_centered,
-   matrix_non_samrai
+   matrix_non_samrai,
+   matrix_interleaved
 };
 
 
@@ -75,6 +82,10 @@ typedef struct
 
    int        data_size;       /* Size of data */
 
+   int        data_stride;     /* distance between the coefficients of
+				  neighboring cells; 1 for planar storage,
+				  the data stencil size for interleaved */
+
    Subregion* data_space;
 
 } Submatrix;
@@ -146,12 +157,14 @@ typedef struct
 #define SubmatrixSY(submatrix)   (SubregionSY(SubmatrixDataSpace(submatrix)))
 #define SubmatrixSZ(submatrix)   (SubregionSZ(SubmatrixDataSpace(submatrix)))
 
+#define SubmatrixStride(submatrix) ((submatrix) -> data_stride)
+
 #define SubmatrixEltIndex(submatrix, x, y, z) \
-(((x) - SubmatrixIX(submatrix))/SubmatrixSX(submatrix) + \
- (((y) - SubmatrixIY(submatrix))/SubmatrixSY(submatrix) + \
-  (((z) - SubmatrixIZ(submatrix))/SubmatrixSZ(submatrix)) * \
-  SubmatrixNY(submatrix)) * \
- SubmatrixNX(submatrix))
+((((x) - SubmatrixIX(submatrix))/SubmatrixSX(submatrix) + \
+  (((y) - SubmatrixIY(submatrix))/SubmatrixSY(submatrix) + \
+   (((z) - SubmatrixIZ(submatrix))/SubmatrixSZ(submatrix)) * \
+   SubmatrixNY(submatrix)) * \
+  SubmatrixNX(submatrix)) * SubmatrixStride(submatrix))
 
 #define SubmatrixElt(submatrix, s, x, y, z) \
 (SubmatrixStencilData(submatrix, s) + SubmatrixEltIndex(submatrix, x, y, z))
@@ -182,5 +195,23 @@ typedef struct
 
 #define MatrixCommPkg(matrix)     ((matrix) -> comm_pkg)
 
+/*--------------------------------------------------------------------------
+ * Matvec kernel types (see Solver.Matvec.Type)
+ *--------------------------------------------------------------------------*/
+
+#define MatvecStandard 0
+#define MatvecFused    1
+
+/*--------------------------------------------------------------------------
+ * Matrix storage layouts (see Solver.Matrix.Layout)
+ *--------------------------------------------------------------------------*/
+
+#define MatrixLayoutPlanar      0
+#define MatrixLayoutInterleaved 1
+
+#define MatrixLayoutType(layout) \
+(((layout) == MatrixLayoutInterleaved) ? matrix_interleaved : \
+ matrix_cell_centered)
+
 
 #endif
@@ -34,6 +34,114 @@
 #include "parflow.h"
 
 
+/*--------------------------------------------------------------------------
+ * Fused kernels:
+ *   y = alpha*(temp*y + A*x) computed in a single sweep over a subregion.
+ *   Every stencil coefficient is applied while y[vi] is held in a
+ *   register, so y is read and written once instead of once per stencil
+ *   entry plus the scaling passes.  The operations are done in the same
+ *   order as the standard path so results are identical.
+ *--------------------------------------------------------------------------*/
+
+#define MatvecFusedMaxStencilSize 27
+
+#define MatvecFusedLoop(clauses, body_stencil)\
+{\
+   ThreadedTiledBoxLoopI2(clauses, i, j, k,\
+			  ix, iy, iz, nx, ny, nz,\
+			  GlobalsMatvecTileNY, GlobalsMatvecTileNZ,\
+			  vi, nx_v, ny_v, nz_v, sx, sy, sz,\
+			  mi, nx_m*sx_m, ny_m, nz_m, sx_m,  1,  1,\
+			  {\
+			     double acc = (temp == 0.0) ? 0.0 : ((temp == 1.0) ? yp[vi] : yp[vi] * temp);\
+			     body_stencil;\
+			     yp[vi] = (alpha == 1.0) ? acc : acc * alpha;\
+			  });\
+}
+
+static void     MatvecFusedBox(
+double          alpha,
+double          temp,
+Submatrix      *A_sub,
+Subvector      *x_sub,
+Subvector      *y_sub,
+Stencil        *stencil,
+int             ix,
+int             iy,
+int             iz,
+int             nx,
+int             ny,
+int             nz,
+int             sx,
+int             sy,
+int             sz)
+{
+   StencilElt     *s = StencilShape(stencil);
+   int             stencil_size = StencilSize(stencil);
+
+   double         *ap[MatvecFusedMaxStencilSize];
+   int             xo[MatvecFusedMaxStencilSize];
+
+   double         *xp, *yp;
+
+   int             nx_v = SubvectorNX(y_sub);
+   int             ny_v = SubvectorNY(y_sub);
+
+   int             nx_m = SubmatrixNX(A_sub);
+   int             ny_m = SubmatrixNY(A_sub);
+   int             sx_m = SubmatrixStride(A_sub);
+
+   int             i, j, k, si, vi, mi;
+
+
+   yp = SubvectorElt(y_sub, ix, iy, iz);
+   xp = SubvectorElt(x_sub, ix, iy, iz);
+
+   for (si = 0; si < stencil_size; si++)
+   {
+      ap[si] = SubmatrixElt(A_sub, si, ix, iy, iz);
+      xo[si] = SubvectorEltIndex(x_sub, ix + s[si][0], iy + s[si][1], iz + s[si][2])
+	 - SubvectorEltIndex(x_sub, ix, iy, iz);
+   }
+
+   vi = 0; mi = 0;
+   if (stencil_size == 7)
+   {
+      double *a0 = ap[0], *a1 = ap[1], *a2 = ap[2], *a3 = ap[3];
+      double *a4 = ap[4], *a5 = ap[5], *a6 = ap[6];
+      int     o0 = xo[0], o1 = xo[1], o2 = xo[2], o3 = xo[3];
+      int     o4 = xo[4], o5 = xo[5], o6 = xo[6];
+
+      MatvecFusedLoop(NoThreadClauses,
+		      {
+			 acc += a0[mi] * xp[vi + o0];
+			 acc += a1[mi] * xp[vi + o1];
+			 acc += a2[mi] * xp[vi + o2];
+			 acc += a3[mi] * xp[vi + o3];
+			 acc += a4[mi] * xp[vi + o4];
+			 acc += a5[mi] * xp[vi + o5];
+			 acc += a6[mi] * xp[vi + o6];
+		      });
+   }
+   else if (stencil_size == 19)
+   {
+      MatvecFusedLoop(ThreadPrivate(si),
+		      {
+			 for (si = 0; si < 19; si++)
+			    acc += ap[si][mi] * xp[vi + xo[si]];
+		      });
+   }
+   else
+   {
+      MatvecFusedLoop(ThreadPrivate(si),
+		      {
+			 for (si = 0; si < stencil_size; si++)
+			    acc += ap[si][mi] * xp[vi + xo[si]];
+		      });
+   }
+}
+
+
 /*--------------------------------------------------------------------------
  * Matvec
  *--------------------------------------------------------------------------*/
@@ -81,6 +189,9 @@ Vector         *y)
 
    int             nx_v = 0, ny_v = 0, nz_v = 0;
    int             nx_m = 0, ny_m = 0, nz_m = 0;
+   int             sx_m = 1;
+
+   int             fused;
 
    /*-----------------------------------------------------------------------
     * Begin timing
@@ -143,6 +254,14 @@ Vector         *y)
 
    compute_pkg = GridComputePkg(grid, VectorUpdateAll);
 
+   /* The fused kernel does the (beta/alpha) scaling of y in the same
+      sweep since the independent and dependent regions partition the
+      subgrids */
+   fused = (GlobalsMatvecType == MatvecFused) &&
+      (StencilSize(MatrixStencil(A)) <= MatvecFusedMaxStencilSize);
+
+   temp = beta / alpha;
+
    for (compute_i = 0; compute_i < 2; compute_i++)
    {
       switch(compute_i)
@@ -169,50 +288,51 @@ Vector         *y)
 	  * initialize y= (beta/alpha)*y
 	  *-----------------------------------------------------------------*/
 
-	 ForSubgridI(sg, GridSubgrids(grid))
+	 if (!fused)
 	 {
-	    subgrid = SubgridArraySubgrid(GridSubgrids(grid), sg);
-
-	    nx = SubgridNX(subgrid);
-	    ny = SubgridNY(subgrid);
-	    nz = SubgridNZ(subgrid);
-
-	    if (nx && ny && nz)
+	    ForSubgridI(sg, GridSubgrids(grid))
 	    {
-	       ix = SubgridIX(subgrid);
-	       iy = SubgridIY(subgrid);
-	       iz = SubgridIZ(subgrid);
+	       subgrid = SubgridArraySubgrid(GridSubgrids(grid), sg);
 
-	       y_sub = VectorSubvector(y, sg);
+	       nx = SubgridNX(subgrid);
+	       ny = SubgridNY(subgrid);
+	       nz = SubgridNZ(subgrid);
 
-	       nx_v = SubvectorNX(y_sub);
-	       ny_v = SubvectorNY(y_sub);
-	       nz_v = SubvectorNZ(y_sub);
+	       if (nx && ny && nz)
+	       {
+		  ix = SubgridIX(subgrid);
+		  iy = SubgridIY(subgrid);
+		  iz = SubgridIZ(subgrid);
 
-	       temp = beta / alpha;
+		  y_sub = VectorSubvector(y, sg);
 
-	       if (temp != 1.0)
-	       {
-		  yp = SubvectorElt(y_sub, ix, iy, iz);
+		  nx_v = SubvectorNX(y_sub);
+		  ny_v = SubvectorNY(y_sub);
+		  nz_v = SubvectorNZ(y_sub);
 
-		  vi = 0;
-		  if (temp == 0.0)
+		  if (temp != 1.0)
 		  {
-		     BoxLoopI1(i, j, k,
-			       ix, iy, iz, nx, ny, nz,
-			       vi, nx_v, ny_v, nz_v, 1, 1, 1,
-			       {
-				  yp[vi] = 0.0;
-			       });
-		  }
-		  else
-		  {
-		     BoxLoopI1(i, j, k,
-			       ix, iy, iz, nx, ny, nz,
-			       vi, nx_v, ny_v, nz_v, 1, 1, 1,
-			       {
-				  yp[vi] *= temp;
-			       });
+		     yp = SubvectorElt(y_sub, ix, iy, iz);
+
+		     vi = 0;
+		     if (temp == 0.0)
+		     {
+			BoxLoopI1(i, j, k,
+				  ix, iy, iz, nx, ny, nz,
+				  vi, nx_v, ny_v, nz_v, 1, 1, 1,
+				  {
+				     yp[vi] = 0.0;
+				  });
+		     }
+		     else
+		     {
+			BoxLoopI1(i, j, k,
+				  ix, iy, iz, nx, ny, nz,
+				  vi, nx_v, ny_v, nz_v, 1, 1, 1,
+				  {
+				     yp[vi] *= temp;
+				  });
+		     }
 		  }
 	       }
 	    }
@@ -257,6 +377,7 @@ Vector         *y)
             nx_m = SubmatrixNX(A_sub);
             ny_m = SubmatrixNY(A_sub);
             nz_m = SubmatrixNZ(A_sub);
+            sx_m = SubmatrixStride(A_sub);
          }
 
 	 /*-----------------------------------------------------------------
@@ -283,6 +404,13 @@ Vector         *y)
 	    stencil_size = StencilSize(stencil);
 	    s = StencilShape(stencil);
 
+	    if (fused)
+	    {
+	       MatvecFusedBox(alpha, temp, A_sub, x_sub, y_sub, stencil,
+			      ix, iy, iz, nx, ny, nz, sx, sy, sz);
+	       continue;
+	    }
+
 	    yp = SubvectorElt(y_sub, ix, iy, iz);
 
 	    for (si = 0; si < stencil_size; si++)
@@ -297,7 +425,7 @@ Vector         *y)
 	       BoxLoopI2(i, j, k,
 			 ix, iy, iz, nx, ny, nz,
 			 vi, nx_v, ny_v, nz_v, sx, sy, sz,
-			 mi, nx_m, ny_m, nz_m,  1,  1,  1,
+			 mi, nx_m*sx_m, ny_m, nz_m, sx_m,  1,  1,
 			 {
 			    yp[vi] += ap[mi] * xp[vi];
 			 });
@@ -395,6 +523,7 @@ Vector         *y
    int             nx_v = 0, ny_v = 0, nz_v = 0;
    int             nx_m = 0, ny_m = 0, nz_m = 0;
    int             nx_mc = 0, ny_mc = 0, nz_mc = 0;
+   int             sx_m = 1, sx_mc = 1;
 
    int          r;
 
@@ -579,10 +708,12 @@ Vector         *y
             nx_m = SubmatrixNX(JB_sub);
             ny_m = SubmatrixNY(JB_sub);
             nz_m = SubmatrixNZ(JB_sub);
+            sx_m = SubmatrixStride(JB_sub);
 
             nx_mc = SubmatrixNX(JC_sub);
             ny_mc = SubmatrixNY(JC_sub);
             nz_mc = SubmatrixNZ(JC_sub);
+            sx_mc = SubmatrixStride(JC_sub);
 
          }
 
@@ -624,7 +755,7 @@ Vector         *y
 	       BoxLoopI2(i, j, k,
 			 ix, iy, iz, nx, ny, nz,
 			 vi, nx_v, ny_v, nz_v, sx, sy, sz,
-			 mi, nx_m, ny_m, nz_m,  1,  1,  1,
+			 mi, nx_m*sx_m, ny_m, nz_m, sx_m,  1,  1,
 			 {
 			    yp[vi] += bp[mi] * xp[vi];
 			 });
@@ -643,7 +774,7 @@ Vector         *y
 	       BoxLoopI2(i, j, k,
 			 ix, iy, iz, nx, ny, 1,
 			 vi, nx_v, ny_v, nz_v, sx, sy, sz,
-			 mi, nx_mc, ny_mc, nz_mc,  1,  1,  1,
+			 mi, nx_mc*sx_mc, ny_mc, nz_mc, sx_mc,  1,  1,
 	       {
 		  itop   = SubvectorEltIndex(top_sub, i, j, 0);    
 		  k1 = (int)top_dat[itop]; 
@@ -750,6 +881,7 @@ Vector         *y
 
    int             nx_v = 0, ny_v = 0, nz_v = 0;
    int             nx_mf = 0, ny_mf = 0, nz_mf = 0;
+   int             sx_mf = 1;
 
    int             r;
 
@@ -934,6 +1066,7 @@ Vector         *y
             nx_mf = SubmatrixNX(JF_sub);
             ny_mf = SubmatrixNY(JF_sub);
             nz_mf = SubmatrixNZ(JF_sub);
+            sx_mf = SubmatrixStride(JF_sub);
          }
 
          ForSubregionI(sr, subregion_array)
@@ -975,7 +1108,7 @@ Vector         *y
 	       BoxLoopI2(i, j, k,
 			 ix, iy, iz, nx, ny, 1,
 			 vi, nx_v, ny_v, nz_v, sx, sy, sz,
-			 mi, nx_mf, ny_mf, nz_mf,  1,  1,  1,
+			 mi, nx_mf*sx_mf, ny_mf, nz_mf, sx_mf,  1,  1,
 			 {
                             itop   = SubvectorEltIndex(top_sub, (i+s[si][0]), (j+s[si][1]), 0);    
 			    k1 = (int)top_dat[itop];  
@@ -999,7 +1132,7 @@ Vector         *y
 	    BoxLoopI2(i, j, k,
 		 ix, iy, iz, nx, ny, 1,
 		 vi, nx_v, ny_v, nz_v, sx, sy, sz,
-		 mi, nx_mf, ny_mf, nz_mf,  1,  1,  1,
+		 mi, nx_mf*sx_mf, ny_mf, nz_mf, sx_mf,  1,  1,
 		 {
                     itop   = SubvectorEltIndex(top_sub, i, j, 0);    
 		    k1 = (int)top_dat[itop]; 
@@ -1095,6 +1228,7 @@ Vector         *y
 
    int             nx_v = 0, ny_v = 0, nz_v = 0;
    int             nx_me = 0, ny_me = 0, nz_me = 0;
+   int             sx_me = 1;
 
    int             r;
 
@@ -1279,6 +1413,7 @@ Vector         *y
             nx_me = SubmatrixNX(JE_sub);
             ny_me = SubmatrixNY(JE_sub);
             nz_me = SubmatrixNZ(JE_sub);
+            sx_me = SubmatrixStride(JE_sub);
          }
 
          ForSubregionI(sr, subregion_array)
@@ -1317,7 +1452,7 @@ Vector         *y
 	       BoxLoopI2(i, j, k,
 			 ix, iy, iz, nx, ny, 1,
 			 vi, nx_v, ny_v, nz_v, sx, sy, sz,
-			 mi, nx_me, ny_me, nz_me,  1,  1,  1,
+			 mi, nx_me*sx_me, ny_me, nz_me, sx_me,  1,  1,
 			 {
                             itop   = SubvectorEltIndex(top_sub, i, j, 0);    
 			    k1 = (int)top_dat[itop];  
@@ -1336,7 +1471,7 @@ Vector         *y
 	    BoxLoopI2(i, j, k,
 		 ix, iy, iz, nx, ny, 1,
 		 vi, nx_v, ny_v, nz_v, sx, sy, sz,
-		 mi, nx_me, ny_me, nz_me,  1,  1,  1,
+		 mi, nx_me*sx_me, ny_me, nz_me, sx_me,  1,  1,
 		 {
                     itop   = SubvectorEltIndex(top_sub, i, j, 0);    
 		    k1 = (int)top_dat[itop]; 
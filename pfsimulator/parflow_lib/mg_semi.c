@@ -459,9 +459,9 @@ SubregionArray  **c_sra_l)
    int             s_num[7];
 
    int             nx,    ny,    nz;
-   int             nx_A,  ny_A,  nz_A;
-   int             nx_Ac, ny_Ac, nz_Ac;
-   int             nx_P,  ny_P,  nz_P;
+   int             nx_A,  ny_A,  nz_A,  sx_A;
+   int             nx_Ac, ny_Ac, nz_Ac, sx_Ac;
+   int             nx_P,  ny_P,  nz_P,  sx_P;
 
    int             ii, jj, kk;
    int             ix, iy, iz;
@@ -537,10 +537,12 @@ SubregionArray  **c_sra_l)
 	    nx_P = SubmatrixNX(P_sub);
 	    ny_P = SubmatrixNY(P_sub);
 	    nz_P = SubmatrixNZ(P_sub);
+	    sx_P = SubmatrixStride(P_sub);
 
 	    nx_A = SubmatrixNX(A_sub);
 	    ny_A = SubmatrixNY(A_sub);
 	    nz_A = SubmatrixNZ(A_sub);
+	    sx_A = SubmatrixStride(A_sub);
 
 	    p1 = SubmatrixStencilData(P_sub, 0);
 	    p2 = SubmatrixStencilData(P_sub, 1);
@@ -557,8 +559,8 @@ SubregionArray  **c_sra_l)
 	    iA = SubmatrixEltIndex(A_sub, ix, iy, iz);
 
 	    BoxLoopI2(ii, jj, kk, ix, iy, iz, nx, ny, nz,
-		      iP, nx_P, ny_P, nz_P, 1,  1,  1,
-		      iA, nx_A, ny_A, nz_A, sx, sy, sz,
+		      iP, nx_P*sx_P, ny_P, nz_P, sx_P, 1, 1,
+		      iA, nx_A*sx_A, ny_A, nz_A, sx*sx_A, sy, sz,
 		      {
 			 ap0 = a0[iA] + a3[iA] + a4[iA] + a5[iA] + a6[iA];
 
@@ -613,14 +615,17 @@ SubregionArray  **c_sra_l)
 	    nx_P = SubmatrixNX(P_sub);
 	    ny_P = SubmatrixNY(P_sub);
 	    nz_P = SubmatrixNZ(P_sub);
+	    sx_P = SubmatrixStride(P_sub);
 
 	    nx_A = SubmatrixNX(A_sub);
 	    ny_A = SubmatrixNY(A_sub);
 	    nz_A = SubmatrixNZ(A_sub);
+	    sx_A = SubmatrixStride(A_sub);
 
 	    nx_Ac = SubmatrixNX(Ac_sub);
 	    ny_Ac = SubmatrixNY(Ac_sub);
 	    nz_Ac = SubmatrixNZ(Ac_sub);
+	    sx_Ac = SubmatrixStride(Ac_sub);
 
 	    p1 = SubmatrixStencilData(P_sub, 0);
 	    p2 = SubmatrixStencilData(P_sub, 1);
@@ -651,24 +656,24 @@ SubregionArray  **c_sra_l)
 
 	    if (s_num[2] == 2)
 	    {
-	       dP12 = 1;
-	       dA12 = 1;
+	       dP12 = sx_P;
+	       dA12 = sx_A;
 	    }
 	    else if (s_num[2] == 4)
 	    {
-	       dP12 = SubmatrixNX(P_sub);
-	       dA12 = SubmatrixNX(A_sub);
+	       dP12 = SubmatrixNX(P_sub) * sx_P;
+	       dA12 = SubmatrixNX(A_sub) * sx_A;
 	    }
 	    else if (s_num[2] == 6)
 	    {
-	       dP12 = SubmatrixNX(P_sub) * SubmatrixNY(P_sub);
-	       dA12 = SubmatrixNX(A_sub) * SubmatrixNY(A_sub);
+	       dP12 = SubmatrixNX(P_sub) * SubmatrixNY(P_sub) * sx_P;
+	       dA12 = SubmatrixNX(A_sub) * SubmatrixNY(A_sub) * sx_A;
 	    }
 
 	    BoxLoopI3(ii, jj, kk, ix, iy, iz, nx, ny, nz,
-		      iP1, nx_P,  ny_P,  nz_P,  1,  1,  1,
-		      iA,  nx_A,  ny_A,  nz_A,  sx, sy, sz,
-		      iAc, nx_Ac, ny_Ac, nz_Ac, 1,  1,  1,
+		      iP1, nx_P*sx_P,  ny_P,  nz_P,  sx_P, 1, 1,
+		      iA,  nx_A*sx_A,  ny_A,  nz_A,  sx*sx_A, sy, sz,
+		      iAc, nx_Ac*sx_Ac, ny_Ac, nz_Ac, sx_Ac, 1, 1,
 		      {
 			 iP2 = iP1 + dP12;
 			 iA1 = iA  - dA12;
@@ -722,6 +727,7 @@ SubregionArray  **c_sra_l)
 	    nx_Ac = SubmatrixNX(Ac_sub);
 	    ny_Ac = SubmatrixNY(Ac_sub);
 	    nz_Ac = SubmatrixNZ(Ac_sub);
+	    sx_Ac = SubmatrixStride(Ac_sub);
 
 	    ac0 = SubmatrixStencilData(Ac_sub, s_num[0]);
 	    ac3 = SubmatrixStencilData(Ac_sub, s_num[3]);
@@ -732,7 +738,7 @@ SubregionArray  **c_sra_l)
 	    iAc = SubmatrixEltIndex(Ac_sub, ix/sx, iy/sy, iz/sz);
 
 	    BoxLoopI1(ii, jj, kk, ix, iy, iz, nx, ny, nz,
-		      iAc, nx_Ac, ny_Ac, nz_Ac, 1,  1,  1,
+		      iAc, nx_Ac*sx_Ac, ny_Ac, nz_Ac, sx_Ac, 1, 1,
 		      {
 			 ac0[iAc] -= (ac3[iAc] + ac4[iAc] +
 				      ac5[iAc] + ac6[iAc]);
@@ -66,7 +66,7 @@ void   		 MGSemiProlong(
    int             ix, iy, iz;
    int             nx, ny, nz;
    int             nx_f, ny_f, nz_f;
-   int             nx_c, ny_c, nz_c;
+   int             nx_c, ny_c, nz_c, sx_c = 1;
 
    int             i_f, i_c;
 
@@ -163,6 +163,7 @@ void   		 MGSemiProlong(
 	    nx_c = SubmatrixNX(P_sub);
 	    ny_c = SubmatrixNY(P_sub);
 	    nz_c = SubmatrixNZ(P_sub);
+	    sx_c = SubmatrixStride(P_sub);
 	 }
  
 	 ForSubregionI(j, subregion_array)
@@ -191,7 +192,7 @@ void   		 MGSemiProlong(
 	    i_c = 0;
 	    i_f = 0;
 	    BoxLoopI2(ii, jj, kk, ix, iy, iz, nx, ny, nz,
-		      i_c, nx_c, ny_c, nz_c, 1,  1,  1,
+		      i_c, nx_c*sx_c, ny_c, nz_c, sx_c, 1,  1,
 		      i_f, nx_f, ny_f, nz_f, sx, sy, sz,
 		      {
 			 e_fp[i_f] = (p1[i_c]*e_fp[i_f - stride] +
@@ -67,7 +67,7 @@ CommPkg         *r_f_comm_pkg)
 
    int             ix, iy, iz;
    int             nx, ny, nz;
-   int             nx_p, ny_p, nz_p;
+   int             nx_p, ny_p, nz_p, sx_p = 1;
    int             nx_f, ny_f, nz_f;
    int             nx_c, ny_c, nz_c;
 
@@ -117,6 +117,7 @@ CommPkg         *r_f_comm_pkg)
             nx_p = SubmatrixNX(P_sub);
             ny_p = SubmatrixNY(P_sub);
             nz_p = SubmatrixNZ(P_sub);
+            sx_p = SubmatrixStride(P_sub);
 
             nx_c = SubvectorNX(r_c_sub);
             ny_c = SubvectorNY(r_c_sub);
@@ -160,7 +161,7 @@ CommPkg         *r_f_comm_pkg)
 	    i_c = 0;
 	    i_f = 0;
 	    BoxLoopI3(ii, jj, kk, ix, iy, iz, nx, ny, nz,
-		      i_p, nx_p, ny_p, nz_p, 1,  1,  1,
+		      i_p, nx_p*sx_p, ny_p, nz_p, sx_p, 1,  1,
 		      i_c, nx_c, ny_c, nz_c, 1,  1,  1,
 		      i_f, nx_f, ny_f, nz_f, sx, sy, sz,
 		      {
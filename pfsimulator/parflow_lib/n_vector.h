@@ -45,6 +45,7 @@
 #define N_VAddConst(x, b, z)          PFVAddConst(x, b, z)
  
 #define N_VDotProd(x, y)              PFVDotProd(x, y)
+#define N_VDotProdMulti(n, x, y, r)   PFVDotProdMulti(n, x, y, r)
 #define N_VMaxNorm(x)                 PFVMaxNorm(x)
 #define N_VWrmsNorm(x, w)             PFVWrmsNorm(x, w)
 #define N_VWL2Norm(x, w)              PFVWL2Norm(x, w)
@@ -55,5 +56,14 @@
 #define N_VCompare(c, x, z)           PFVCompare(c, x, z)
 #define N_VInvTest(x, z)              PFVInvTest(x, z)
 
+/* Fused operations */
+#define N_VLinearCombination(n, c, x, z)  PFVLinearCombination(n, c, x, z)
+#define N_VMultiAxpy(n, c, x, y)          PFVMultiAxpy(n, c, x, y)
+#define N_VMultiAxpyDot(n, c, x, y)       PFVMultiAxpyDot(n, c, x, y, TRUE)
+#define N_VWMaxNorm(x, w)                 PFVWMaxNorm(x, w)
+#define N_VStepMaxNorm(u, p, w)           PFVStepMaxNorm(u, p, w)
+#define N_VWL2NormDot(x, w, y, d)         PFVWL2NormDot(x, w, y, d)
+#define N_VWDotProdL1(u, v, w, r)         PFVWDotProdL1(u, v, w, r)
+
 #endif
 
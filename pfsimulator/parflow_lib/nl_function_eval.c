@@ -39,6 +39,7 @@
 typedef struct
 {
    int       time_index;
+   int       overlap_exchange;
     double    SpinupDampP1; // NBE
     double    SpinupDampP2; // NBE
 } PublicXtra;
@@ -56,6 +57,9 @@ typedef struct
    PFModule	*overlandflow_module; //DOK
    PFModule	*overlandflow_module_diff; //@RMM
 
+   PhaseProperties *phase_properties;
+   int              phase_properties_tried;   /* NewPhaseProperties was called */
+
 } InstanceXtra;
 
 /*---------------------------------------------------------------------
@@ -68,6 +72,360 @@ typedef struct
 #define Mean(a,b)            ArithmeticMean(a, b)
 
 
+/*--------------------------------------------------------------------------
+ * InsertDirichletValues:
+ *   Temporarily insert boundary pressure values for Dirichlet boundaries
+ *   into the cells next to them that are in the given cell selection.
+ *--------------------------------------------------------------------------*/
+
+static void  InsertDirichletValues(
+BCStruct    *bc_struct,
+Vector      *pressure,
+int          cells)
+{
+   Grid        *grid = VectorGrid(pressure);
+   Subgrid     *subgrid;
+   Subvector   *p_sub;
+
+   double      *pp;
+   double      *bc_patch_values;
+   double       value;
+
+   int         *fdir;
+   int          i, j, k, is, ip, ipatch, ival;
+   int          sy_p, sz_p;
+
+   ForSubgridI(is, GridSubgrids(grid))
+   {
+      subgrid = GridSubgrid(grid, is);
+	 
+      p_sub   = VectorSubvector(pressure, is);
+
+      sy_p = SubvectorNX(p_sub);
+      sz_p = SubvectorNY(p_sub) * SubvectorNX(p_sub);
+
+      pp = SubvectorData(p_sub);
+
+      for (ipatch = 0; ipatch < BCStructNumPatches(bc_struct); ipatch++)
+      {
+	 bc_patch_values = BCStructPatchValues(bc_struct, ipatch, is);
+
+	 switch(BCStructBCType(bc_struct, ipatch))
+	 {
+
+	    case DirichletBC:
+	    {
+	       BCStructPatchLoop(i, j, k, fdir, ival, bc_struct, ipatch, is,
+	       {
+		  if (InPhaseCells(cells, subgrid, 
+				   i + fdir[0], j + fdir[1], k + fdir[2]))
+		  {
+		     ip   = SubvectorEltIndex(p_sub, i, j, k);
+		     value =  bc_patch_values[ival];
+		     pp[ip + fdir[0]*1 + fdir[1]*sy_p + fdir[2]*sz_p] = value;
+		  }
+	       });
+	       break;
+	    }
+
+	 }     /* End switch BCtype */
+      }        /* End ipatch loop */
+   }           /* End subgrid loop */
+}
+
+
+/*--------------------------------------------------------------------------
+ * AddFluxTerms:
+ *   Add the contributions from second order derivatives and gravity of
+ *   the faces between the cells of a subgrid and their upper neighbors.
+ *   PhaseCellsCore selects the faces that only use values in the subgrid
+ *   core, PhaseCellsNotCore the others and PhaseCellsAll all of them.  The two calls together add the
+ *   same terms, in the same order, whether or not the pressure exchange
+ *   completed in between.
+ *--------------------------------------------------------------------------*/
+
+static void  AddFluxTerms(
+ProblemData *problem_data,
+Vector      *pressure,
+Vector      *density,
+Vector      *rel_perm,
+Vector      *fval,
+Vector      *x_velocity,
+Vector      *y_velocity,
+Vector      *z_velocity,
+double       gravity,
+double       viscosity,
+double       dt,
+int          cells)
+{
+   Vector      *permeability_x    = ProblemDataPermeabilityX(problem_data);
+   Vector      *permeability_y    = ProblemDataPermeabilityY(problem_data);
+   Vector      *permeability_z    = ProblemDataPermeabilityZ(problem_data);
+   Vector      *x_sl              = ProblemDataTSlopeX(problem_data);  //sk
+   Vector      *x_ssl             = ProblemDataSSlopeX(problem_data);  //@RMM
+   Vector      *y_ssl             = ProblemDataSSlopeY(problem_data);  //@RMM
+   Vector      *z_mult            = ProblemDataZmult(problem_data);  //@RMM
+   GrGeomSolid *gr_domain         = ProblemDataGrDomain(problem_data);
+
+   Grid        *grid              = VectorGrid(pressure);
+   Grid        *grid2d            = VectorGrid(x_sl);
+
+   Subgrid     *subgrid;
+
+   Subvector   *p_sub, *d_sub, *f_sub, *rp_sub;
+   Subvector   *permx_sub, *permy_sub, *permz_sub;
+   Subvector   *x_ssl_sub, *y_ssl_sub, *z_mult_sub;
+   Subvector   *vx_sub, *vy_sub, *vz_sub; //jjb
+
+   double      *pp, *dp, *rpp, *fp;
+   double      *permxp, *permyp, *permzp;
+   double      *x_ssl_dat, *y_ssl_dat, *z_mult_dat;
+   double      *vx, *vy, *vz; //jjb
+
+   int          i, j, k, r, is;
+   int          ix, iy, iz;
+   int          nx, ny, nz;
+   int          sy_p, sz_p;
+   int          ip, io;
+   int          vxi, vyi, vzi; //jjb
+   int          flux_box[6], ind_box[6], boxes[6][6], num_boxes, b;
+
+   double       dx, dy, dz, ffx, ffy, ffz;
+   double       u_right, u_front, u_upper;
+   double       diff, updir, sep;
+   double       lower_cond, upper_cond;
+   double       x_dir_g, y_dir_g, z_dir_g, del_x_slope, del_y_slope;
+   double       x_dir_g_c, y_dir_g_c;
+
+   ForSubgridI(is, GridSubgrids(grid))
+   {
+      subgrid = GridSubgrid(grid, is);
+      
+       /* velocity vectors jjb */
+      vx_sub    = VectorSubvector(x_velocity, is);
+      vy_sub    = VectorSubvector(y_velocity, is);
+      vz_sub    = VectorSubvector(z_velocity, is);
+      
+      Subgrid       *grid2d_subgrid          = GridSubgrid(grid2d, is);
+      int grid2d_iz = SubgridIZ(grid2d_subgrid);
+	
+      p_sub     = VectorSubvector(pressure, is);
+      d_sub     = VectorSubvector(density, is);
+      rp_sub    = VectorSubvector(rel_perm, is);
+      f_sub     = VectorSubvector(fval, is);
+      permx_sub = VectorSubvector(permeability_x, is);
+      permy_sub = VectorSubvector(permeability_y, is);
+      permz_sub = VectorSubvector(permeability_z, is);
+       /* @RMM added to provide access to x/y slopes */ 
+       x_ssl_sub = VectorSubvector(x_ssl, is);
+       y_ssl_sub = VectorSubvector(y_ssl, is);
+       
+       /* @RMM added to provide access to zmult */
+       z_mult_sub = VectorSubvector(z_mult, is);
+
+      /* RDF: assumes resolutions are the same in all 3 directions */
+      r = SubgridRX(subgrid);
+
+      /* The flux terms are computed for the faces between the cells in
+	 flux_box and their upper neighbors.  Those in ind_box only use
+	 values in the subgrid core. */
+      flux_box[0] = SubgridIX(subgrid) - 1;
+      flux_box[1] = SubgridIY(subgrid) - 1;
+      flux_box[2] = SubgridIZ(subgrid) - 1;
+      flux_box[3] = SubgridNX(subgrid) + 1;
+      flux_box[4] = SubgridNY(subgrid) + 1;
+      flux_box[5] = SubgridNZ(subgrid) + 1;
+
+      ind_box[0] = SubgridIX(subgrid) + 1;
+      ind_box[1] = SubgridIY(subgrid) + 1;
+      ind_box[2] = SubgridIZ(subgrid) + 1;
+      ind_box[3] = SubgridNX(subgrid) - 3;
+      ind_box[4] = SubgridNY(subgrid) - 3;
+      ind_box[5] = SubgridNZ(subgrid) - 3;
+
+      switch(cells)
+      {
+	 case PhaseCellsCore:
+	    num_boxes = 0;
+	    if (ind_box[3] > 0 && ind_box[4] > 0 && ind_box[5] > 0)
+	    {
+	       for (b = 0; b < 6; b++)
+		  boxes[0][b] = ind_box[b];
+	       num_boxes = 1;
+	    }
+	    break;
+	 case PhaseCellsNotCore:
+	    num_boxes = SubtractBox(flux_box, ind_box, boxes);
+	    break;
+	 default:
+	    for (b = 0; b < 6; b++)
+	       boxes[0][b] = flux_box[b];
+	    num_boxes = 1;
+	    break;
+      }
+	 
+      dx = SubgridDX(subgrid);
+      dy = SubgridDY(subgrid);
+      dz = SubgridDZ(subgrid);
+	 
+      ffx = dy * dz;
+      ffy = dx * dz;
+      ffz = dx * dy;
+
+      sy_p = SubvectorNX(p_sub);
+      sz_p = SubvectorNY(p_sub) * SubvectorNX(p_sub);
+      
+      /* velocity accessors jjb */
+      vx    = SubvectorData(vx_sub);
+      vy    = SubvectorData(vy_sub);
+      vz    = SubvectorData(vz_sub);
+
+      pp    = SubvectorData(p_sub);
+      dp    = SubvectorData(d_sub);
+      rpp   = SubvectorData(rp_sub);
+      fp    = SubvectorData(f_sub);
+      permxp = SubvectorData(permx_sub);
+      permyp = SubvectorData(permy_sub);
+      permzp = SubvectorData(permz_sub);
+       
+      /* @RMM  added to provide slopes to terrain fns */
+      x_ssl_dat = SubvectorData(x_ssl_sub);
+      y_ssl_dat = SubvectorData(y_ssl_sub);
+      
+      /* @RMM added to provide variable dz */
+      z_mult_dat = SubvectorData(z_mult_sub);
+
+      for (b = 0; b < num_boxes; b++)
+      {
+	 ix = boxes[b][0];
+	 iy = boxes[b][1];
+	 iz = boxes[b][2];
+
+	 nx = boxes[b][3];
+	 ny = boxes[b][4];
+	 nz = boxes[b][5];
+
+	 GrGeomInLoop(i, j, k, gr_domain, r, ix, iy, iz, nx, ny, nz,
+	 {
+	    ip = SubvectorEltIndex(p_sub, i, j, k);
+	    io = SubvectorEltIndex(x_ssl_sub, i, j, grid2d_iz);
+
+	     /* @RMM: modified the terrain-following transform
+	      to be swtichable in the UZ
+	      terms:
+	      1. x dir terrain tendency:  gravity*sin(atan(x_ssl_dat[io]))
+	      2. y dir terrain tendency:  gravity*sin(atan(y_ssl_dat[io]))
+	      3. change in delta-x due to slope: (1.0/cos(atan(x_ssl_dat[io])))
+	      4. change in delta-y due to slope: (1.0/cos(atan(y_ssl_dat[io]))) */
+	  
+	     /* velocity subvector indices jjb */
+	     vxi = SubvectorEltIndex(vx_sub, i+1, j, k);
+	     vyi = SubvectorEltIndex(vy_sub, i, j+1, k);
+	     vzi = SubvectorEltIndex(vz_sub, i, j, k+1);
+	  
+	  
+	     x_dir_g = Mean(gravity*sin(atan(x_ssl_dat[io])),gravity*sin(atan(x_ssl_dat[io+1])));
+	     x_dir_g_c = Mean(gravity*cos(atan(x_ssl_dat[io])),gravity*cos(atan(x_ssl_dat[io+1])));
+	     y_dir_g = Mean(gravity*sin(atan(y_ssl_dat[io])),gravity*sin(atan(y_ssl_dat[io+sy_p])));
+		 y_dir_g_c = Mean(gravity*cos(atan(y_ssl_dat[io])),gravity*cos(atan(y_ssl_dat[io+sy_p])));
+
+	     z_dir_g = 1.0;
+
+	     del_x_slope = 1.0;
+	     del_y_slope = 1.0;
+          
+	    /* Calculate right face velocity.
+	 diff >= 0 implies flow goes left to right */
+	
+	     diff    = pp[ip] - pp[ip+1];
+	     updir= (diff/dx)*x_dir_g_c - x_dir_g;
+          
+	     u_right = z_mult_dat[ip]*ffx*del_y_slope * PMean(pp[ip], pp[ip+1],
+		       permxp[ip], permxp[ip+1])
+			   * (diff / (dx *del_x_slope) )*x_dir_g_c
+		       * RPMean(updir,0.0,
+		       rpp[ip]*dp[ip],
+			   rpp[ip+1]*dp[ip+1])
+			   / viscosity;
+
+	     /* Calculate right face velocity gravity terms
+	      @RMM added sin* g term to test terrain-following grid
+	       upwind on pressure is currently implemented
+	      Sx < 0 implies flow goes left to right */
+          
+	     u_right += z_mult_dat[ip]*ffx *del_y_slope* PMean(pp[ip], pp[ip+1], 
+			permxp[ip], permxp[ip+1])
+			* (-x_dir_g )
+			* RPMean(updir, 0.0, rpp[ip]*dp[ip],
+			rpp[ip+1]*dp[ip+1])
+			/ viscosity;
+ 
+          
+	    /* Calculate front face velocity.
+	       diff >= 0 implies flow goes back to front */
+		diff    = pp[ip] - pp[ip+sy_p];
+	    updir= (diff/dy)*y_dir_g_c - y_dir_g;
+	 
+	    u_front = z_mult_dat[ip]*ffy*del_x_slope
+		     * PMean(pp[ip], pp[ip+sy_p], permyp[ip], permyp[ip+sy_p])
+			 * (diff / (dy*del_y_slope) )*y_dir_g_c
+		     * RPMean(updir, 0.0,
+		       rpp[ip]*dp[ip],
+			   rpp[ip+sy_p]*dp[ip+sy_p])
+			   / viscosity;
+
+	     /* Calculate front face velocity gravity terms
+	      @RMM added sin* g term to test terrain-following grid
+	      note upwinding on gravity terms not pressure 
+	      Sy < 0 implies flow goes from left to right
+	      */
+	
+	     u_front += z_mult_dat[ip]*ffy*del_x_slope
+			* PMean(pp[ip], pp[ip+sy_p], permyp[ip], permyp[ip+sy_p])
+			* (-y_dir_g)
+			* RPMean(updir, 0.0, rpp[ip]*dp[ip],
+			  rpp[ip+sy_p]*dp[ip+sy_p])
+			  / viscosity;
+
+	    /* Calculate upper face velocity.
+	       diff >= 0 implies flow goes lower to upper 
+	 */
+	     sep = dz*(Mean(z_mult_dat[ip],z_mult_dat[ip+sz_p]));
+          
+         
+	     lower_cond = pp[ip]/ sep
+			  - (z_mult_dat[ip]/(z_mult_dat[ip]+z_mult_dat[ip+sz_p]))
+			  * dp[ip] * gravity * z_dir_g;
+
+	     upper_cond = pp[ip+sz_p] / sep
+			  + (z_mult_dat[ip+sz_p]/(z_mult_dat[ip]+z_mult_dat[ip+sz_p]))
+			  * dp[ip+sz_p] * gravity *z_dir_g;
+
+ 
+	     diff = (lower_cond - upper_cond);
+          
+	     u_upper = ffz*del_x_slope*del_y_slope
+		       * PMeanDZ(permzp[ip], permzp[ip+sz_p], z_mult_dat[ip],z_mult_dat[ip+sz_p])
+			   * diff
+			   * RPMean(lower_cond, upper_cond, rpp[ip]*dp[ip],
+			 rpp[ip+sz_p]*dp[ip+sz_p])
+			   / viscosity;
+			
+	    /* velocity data jjb */ 
+	    vx[vxi]      = u_right/ffx;
+	    vy[vyi]      = u_front/ffy;
+	    vz[vzi]      = u_upper/ffz;            
+
+	    fp[ip]      += dt * ( u_right + u_front + u_upper );
+	    fp[ip+1]    -= dt * u_right;
+	    fp[ip+sy_p] -= dt * u_front;
+	    fp[ip+sz_p] -= dt * u_upper;
+	 });
+      }
+   }
+}
+
+
 /*  This routine provides the interface between KINSOL and ParFlow
     for function evaluations.  */
 
@@ -184,10 +542,6 @@ void NlFunctionEval (Vector *pressure,  /* Current pressure values */
 
    Subvector   *p_sub, *d_sub, *od_sub, *s_sub, *os_sub, *po_sub, *op_sub, *ss_sub, *et_sub;
    Subvector   *f_sub, *rp_sub, *permx_sub, *permy_sub, *permz_sub;
-   
-   Subvector   *vx_sub, *vy_sub, *vz_sub; //jjb
-   double      *vx, *vy, *vz; //jjb
-   int          vxi,vyi,vzi; //jjb
 
    Grid        *grid              = VectorGrid(pressure);
    Grid        *grid2d            = VectorGrid(x_sl);
@@ -204,14 +558,13 @@ void NlFunctionEval (Vector *pressure,  /* Current pressure values */
    int          sy_p, sz_p;
    int          ip, ipo,io;
     int         diffusive;   //@RMM
+   int          overlap;
 
    double       dtmp, dx, dy, dz, vol, ffx, ffy, ffz;
-   double       u_right, u_front, u_upper;
    double       diff = 0.0e0; 
-    double       updir = 0.0e0;
    double       lower_cond, upper_cond;
     //@RMM : terms for gravity/terrain
-    double   x_dir_g, y_dir_g, z_dir_g, del_x_slope, del_y_slope, x_dir_g_c, y_dir_g_c;
+    double   x_dir_g, y_dir_g, z_dir_g, del_x_slope, del_y_slope;
     
    BCStruct    *bc_struct;
    GrGeomSolid *gr_domain         = ProblemDataGrDomain(problem_data);
@@ -238,25 +591,70 @@ void NlFunctionEval (Vector *pressure,  /* Current pressure values */
     int          overlandspinup;   //@RMM
     overlandspinup = GetIntDefault("OverlandFlowSpinUp",0);
     
-   /* Pass pressure values to neighbors.  */
+   /* Pass pressure values to neighbors.  With the overlap (the
+      Solver.Nonlinear.OverlapExchange key) the work that neither needs
+      the ghost layer values nor writes the boundary layer of the
+      subgrid being sent is done while the exchange is in progress: the
+      density, saturation, accumulation, storage and source terms on the
+      subgrid, and the relative permeability and flux terms on its core.
+      The rest is done once the exchange is complete.  This needs the
+      fused phase property routines; the modules evaluate whole vectors,
+      so with them the exchange is completed right away. */
    handle = InitVectorUpdate(pressure, VectorUpdateAll);
-   FinalizeVectorUpdate(handle);
  
-   KW = NewVectorType( grid2d, 1, 1, vector_cell_centered_2D);
-   KE = NewVectorType( grid2d, 1, 1, vector_cell_centered_2D);
-   KN = NewVectorType( grid2d, 1, 1, vector_cell_centered_2D);
-   KS = NewVectorType( grid2d, 1, 1, vector_cell_centered_2D);
-   qx = NewVectorType( grid2d, 1, 1, vector_cell_centered_2D);
-   qy = NewVectorType( grid2d, 1, 1, vector_cell_centered_2D);
+   KW = CheckoutVector( grid2d, 1, 1, vector_cell_centered_2D);
+   KE = CheckoutVector( grid2d, 1, 1, vector_cell_centered_2D);
+   KN = CheckoutVector( grid2d, 1, 1, vector_cell_centered_2D);
+   KS = CheckoutVector( grid2d, 1, 1, vector_cell_centered_2D);
+   qx = CheckoutVector( grid2d, 1, 1, vector_cell_centered_2D);
+   qy = CheckoutVector( grid2d, 1, 1, vector_cell_centered_2D);
 
 
    /* Calculate pressure dependent properties: density and saturation */
 
-   PFModuleInvokeType(PhaseDensityInvoke, density_module, (0, pressure, density, &dtmp, &dtmp, 
+   /* NULL if the modules are not supported, then they are used */
+   if ( !(instance_xtra -> phase_properties_tried) )
+   {
+      (instance_xtra -> phase_properties) = 
+	 NewPhaseProperties(density_module, saturation_module, 
+			    rel_perm_module, problem_data, grid);
+      (instance_xtra -> phase_properties_tried) = 1;
+
+      if ( (public_xtra -> overlap_exchange) &&
+	   !(instance_xtra -> phase_properties) &&
+	   !amps_Rank(amps_CommWorld) )
+	 amps_Printf("Warning: the pressure exchange is not overlapped with "
+		     "the function evaluation, it needs Van Genuchten "
+		     "saturation and relative permeability\n");
+   }
+
+   overlap = (public_xtra -> overlap_exchange) && 
+      ( (instance_xtra -> phase_properties) != NULL );
+
+   if (overlap)
+   {
+      PhaseStorageProperties((instance_xtra -> phase_properties), pressure, 
+			     density, NULL, saturation, NULL, gravity,
+			     PhaseCellsSubgrid);
+   }
+   else if ( (instance_xtra -> phase_properties) )
+   {
+      FinalizeVectorUpdate(handle);
+
+      PhaseStorageProperties((instance_xtra -> phase_properties), pressure, 
+			     density, NULL, saturation, NULL, gravity,
+			     PhaseCellsAll);
+   }
+   else
+   {
+      FinalizeVectorUpdate(handle);
+
+      PFModuleInvokeType(PhaseDensityInvoke, density_module, (0, pressure, density, &dtmp, &dtmp, 
 					 CALCFCN));
 
-   PFModuleInvokeType(SaturationInvoke, saturation_module, (saturation, pressure, density, 
-   gravity, problem_data, CALCFCN));
+      PFModuleInvokeType(SaturationInvoke, saturation_module, (saturation, pressure, density, 
+      gravity, problem_data, CALCFCN));
+   }
 
  
    /* Calculate accumulation terms for the function values */
@@ -321,7 +719,8 @@ void NlFunctionEval (Vector *pressure,  /* Current pressure values */
       pop = SubvectorData(po_sub);
       fp  = SubvectorData(f_sub);
 
-      GrGeomInLoop(i, j, k, gr_domain, r, ix, iy, iz, nx, ny, nz,
+      ThreadedGrGeomInLoop(ThreadPrivate(ip, ipo, io, del_x_slope, del_y_slope),
+			   i, j, k, gr_domain, r, ix, iy, iz, nx, ny, nz,
       {
 	 ip  = SubvectorEltIndex(f_sub,   i, j, k);
 	 ipo = SubvectorEltIndex(po_sub,  i, j, k);
@@ -397,7 +796,8 @@ void NlFunctionEval (Vector *pressure,  /* Current pressure values */
       fp  = SubvectorData(f_sub);
 
 
-      GrGeomInLoop(i, j, k, gr_domain, r, ix, iy, iz, nx, ny, nz,
+      ThreadedGrGeomInLoop(ThreadPrivate(ip, io, del_x_slope, del_y_slope),
+			   i, j, k, gr_domain, r, ix, iy, iz, nx, ny, nz,
       {
 	 ip = SubvectorEltIndex(f_sub, i, j, k);
 	 io = SubvectorEltIndex(x_ssl_sub, i, j, grid2d_iz);
@@ -463,7 +863,8 @@ void NlFunctionEval (Vector *pressure,  /* Current pressure values */
        /* @RMM added to provide variable dz */
        z_mult_dat = SubvectorData(z_mult_sub);
 
-      GrGeomInLoop(i, j, k, gr_domain, r, ix, iy, iz, nx, ny, nz,
+      ThreadedGrGeomInLoop(ThreadPrivate(ip, io, del_x_slope, del_y_slope),
+			   i, j, k, gr_domain, r, ix, iy, iz, nx, ny, nz,
       {
 
 	 ip = SubvectorEltIndex(f_sub, i, j, k);
@@ -508,248 +909,63 @@ void NlFunctionEval (Vector *pressure,  /* Current pressure values */
       BCStructPatchValues as was done here.  In other words use
       bc_patch_values[ival] in rel_perm_module code and remove this
       loop.
+
+      The relative permeability values overwrite the current phase
+      source values.  With the overlap the flux terms of the subgrid
+      core are added while the pressure exchange is in progress.
    */
 
-   ForSubgridI(is, GridSubgrids(grid))
+   if (overlap)
    {
-      subgrid = GridSubgrid(grid, is);
-	 
-      p_sub   = VectorSubvector(pressure, is);
-
-      nx_p = SubvectorNX(p_sub);
-      ny_p = SubvectorNY(p_sub);
-      nz_p = SubvectorNZ(p_sub);
-	 
-      sy_p = nx_p;
-      sz_p = ny_p * nx_p;
-
-      pp = SubvectorData(p_sub);
-
-      for (ipatch = 0; ipatch < BCStructNumPatches(bc_struct); ipatch++)
-      {
-	 bc_patch_values = BCStructPatchValues(bc_struct, ipatch, is);
+      InsertDirichletValues(bc_struct, pressure, PhaseCellsCore);
 
-	 switch(BCStructBCType(bc_struct, ipatch))
-	 {
+      PhaseRelPermProperties((instance_xtra -> phase_properties), pressure, 
+			     density, rel_perm, NULL, gravity, problem_data,
+			     PhaseCellsCore);
 
-	    case DirichletBC:
-	    {
-	       BCStructPatchLoop(i, j, k, fdir, ival, bc_struct, ipatch, is,
-	       {
-		  ip   = SubvectorEltIndex(p_sub, i, j, k);
-		  value =  bc_patch_values[ival];
-		  pp[ip + fdir[0]*1 + fdir[1]*sy_p + fdir[2]*sz_p] = value;
-	       
-	       });
-	       break;
-	    }
+      AddFluxTerms(problem_data, pressure, density, rel_perm, fval, 
+		   x_velocity, y_velocity, z_velocity, gravity, viscosity, 
+		   dt, PhaseCellsCore);
 
-	 }     /* End switch BCtype */
-      }        /* End ipatch loop */
-   }           /* End subgrid loop */
+      FinalizeVectorUpdate(handle);
 
-   /* Calculate relative permeability values overwriting current 
-      phase source values */
+      /* The flux terms need the density in the ghost layer */
+      PhaseStorageProperties((instance_xtra -> phase_properties), pressure, 
+			     density, NULL, saturation, NULL, gravity,
+			     PhaseCellsGhost);
 
-   PFModuleInvokeType(PhaseRelPermInvoke, rel_perm_module, 
-		  (rel_perm, pressure, density, gravity, problem_data, 
-		   CALCFCN));
+      InsertDirichletValues(bc_struct, pressure, PhaseCellsNotCore);
 
-   
-   /* Calculate contributions from second order derivatives and gravity */
-   ForSubgridI(is, GridSubgrids(grid))
+      PhaseRelPermProperties((instance_xtra -> phase_properties), pressure, 
+			     density, rel_perm, NULL, gravity, problem_data,
+			     PhaseCellsNotCore);
+   }
+   else
    {
-      subgrid = GridSubgrid(grid, is);
-      
-       /* velocity vectors jjb */
-      vx_sub    = VectorSubvector(x_velocity, is);
-      vy_sub    = VectorSubvector(y_velocity, is);
-      vz_sub    = VectorSubvector(z_velocity, is);
-      
-      Subgrid       *grid2d_subgrid          = GridSubgrid(grid2d, is);
-      int grid2d_iz = SubgridIZ(grid2d_subgrid);
-	
-      p_sub     = VectorSubvector(pressure, is);
-      d_sub     = VectorSubvector(density, is);
-      rp_sub    = VectorSubvector(rel_perm, is);
-      f_sub     = VectorSubvector(fval, is);
-      permx_sub = VectorSubvector(permeability_x, is);
-      permy_sub = VectorSubvector(permeability_y, is);
-      permz_sub = VectorSubvector(permeability_z, is);
-       /* @RMM added to provide access to x/y slopes */ 
-       x_ssl_sub = VectorSubvector(x_ssl, is);
-       y_ssl_sub = VectorSubvector(y_ssl, is);
-       
-       /* @RMM added to provide access to zmult */
-       z_mult_sub = VectorSubvector(z_mult, is);
-
-      /* RDF: assumes resolutions are the same in all 3 directions */
-      r = SubgridRX(subgrid);
-	 
-      ix = SubgridIX(subgrid) - 1;
-      iy = SubgridIY(subgrid) - 1;
-      iz = SubgridIZ(subgrid) - 1;
-	 
-      nx = SubgridNX(subgrid) + 1;
-      ny = SubgridNY(subgrid) + 1;
-      nz = SubgridNZ(subgrid) + 1;
-	 
-      dx = SubgridDX(subgrid);
-      dy = SubgridDY(subgrid);
-      dz = SubgridDZ(subgrid);
-	 
-      ffx = dy * dz;
-      ffy = dx * dz;
-      ffz = dx * dy;
-
-      nx_p = SubvectorNX(p_sub);
-      ny_p = SubvectorNY(p_sub);
-      nz_p = SubvectorNZ(p_sub);
-	 
-      sy_p = nx_p;
-      sz_p = ny_p * nx_p;
-      
-      /* velocity accessors jjb */
-      vx    = SubvectorData(vx_sub);
-      vy    = SubvectorData(vy_sub);
-      vz    = SubvectorData(vz_sub);
-
-      pp    = SubvectorData(p_sub);
-      dp    = SubvectorData(d_sub);
-      rpp   = SubvectorData(rp_sub);
-      fp    = SubvectorData(f_sub);
-      permxp = SubvectorData(permx_sub);
-      permyp = SubvectorData(permy_sub);
-      permzp = SubvectorData(permz_sub);
-       
-      /* @RMM  added to provide slopes to terrain fns */
-      x_ssl_dat = SubvectorData(x_ssl_sub);
-      y_ssl_dat = SubvectorData(y_ssl_sub);
-      
-      /* @RMM added to provide variable dz */
-      z_mult_dat = SubvectorData(z_mult_sub);
-      
-      qx_sub = VectorSubvector(qx, is);
+      InsertDirichletValues(bc_struct, pressure, PhaseCellsAll);
 
-
-      GrGeomInLoop(i, j, k, gr_domain, r, ix, iy, iz, nx, ny, nz,
+      if ( (instance_xtra -> phase_properties) )
       {
-	 ip = SubvectorEltIndex(p_sub, i, j, k);
-	 io = SubvectorEltIndex(x_ssl_sub, i, j, grid2d_iz);
-
-          /* @RMM: modified the terrain-following transform
-           to be swtichable in the UZ
-           terms:
-           1. x dir terrain tendency:  gravity*sin(atan(x_ssl_dat[io]))
-           2. y dir terrain tendency:  gravity*sin(atan(y_ssl_dat[io]))
-           3. change in delta-x due to slope: (1.0/cos(atan(x_ssl_dat[io])))
-           4. change in delta-y due to slope: (1.0/cos(atan(y_ssl_dat[io]))) */
-	  
-	  /* velocity subvector indices jjb */
-          vxi = SubvectorEltIndex(vx_sub, i+1, j, k);
-	  vyi = SubvectorEltIndex(vy_sub, i, j+1, k);
-	  vzi = SubvectorEltIndex(vz_sub, i, j, k+1);
-	  
-	  
-          x_dir_g = Mean(gravity*sin(atan(x_ssl_dat[io])),gravity*sin(atan(x_ssl_dat[io+1])));
-          x_dir_g_c = Mean(gravity*cos(atan(x_ssl_dat[io])),gravity*cos(atan(x_ssl_dat[io+1])));
-          y_dir_g = Mean(gravity*sin(atan(y_ssl_dat[io])),gravity*sin(atan(y_ssl_dat[io+sy_p])));
-	      y_dir_g_c = Mean(gravity*cos(atan(y_ssl_dat[io])),gravity*cos(atan(y_ssl_dat[io+sy_p])));
-
-          z_dir_g = 1.0;
-
-          del_x_slope = 1.0;
-          del_y_slope = 1.0;
-          
-	 /* Calculate right face velocity.
-      diff >= 0 implies flow goes left to right */
-	
-          diff    = pp[ip] - pp[ip+1];
-          updir= (diff/dx)*x_dir_g_c - x_dir_g;
-          
-          u_right = z_mult_dat[ip]*ffx*del_y_slope * PMean(pp[ip], pp[ip+1],
-                    permxp[ip], permxp[ip+1])
-	                * (diff / (dx *del_x_slope) )*x_dir_g_c
-                    * RPMean(updir,0.0,
-                    rpp[ip]*dp[ip],
-	                rpp[ip+1]*dp[ip+1])
-	                / viscosity;
-
-          /* Calculate right face velocity gravity terms
-           @RMM added sin* g term to test terrain-following grid
-            upwind on pressure is currently implemented
-           Sx < 0 implies flow goes left to right */
-          
-          u_right += z_mult_dat[ip]*ffx *del_y_slope* PMean(pp[ip], pp[ip+1], 
-                     permxp[ip], permxp[ip+1])
-                     * (-x_dir_g )
-                     * RPMean(updir, 0.0, rpp[ip]*dp[ip],
-                     rpp[ip+1]*dp[ip+1])
-                     / viscosity;
- 
-          
-	 /* Calculate front face velocity.
-	    diff >= 0 implies flow goes back to front */
-	     diff    = pp[ip] - pp[ip+sy_p];
-         updir= (diff/dy)*y_dir_g_c - y_dir_g;
-	 
-         u_front = z_mult_dat[ip]*ffy*del_x_slope
-                  * PMean(pp[ip], pp[ip+sy_p], permyp[ip], permyp[ip+sy_p])
-	              * (diff / (dy*del_y_slope) )*y_dir_g_c
-                  * RPMean(updir, 0.0,
-                    rpp[ip]*dp[ip],
-	                rpp[ip+sy_p]*dp[ip+sy_p])
-	                / viscosity;
-
-          /* Calculate front face velocity gravity terms
-           @RMM added sin* g term to test terrain-following grid
-           note upwinding on gravity terms not pressure 
-           Sy < 0 implies flow goes from left to right
-           */
-	
-          u_front += z_mult_dat[ip]*ffy*del_x_slope
-                     * PMean(pp[ip], pp[ip+sy_p], permyp[ip], permyp[ip+sy_p])
-                     * (-y_dir_g)
-                     * RPMean(updir, 0.0, rpp[ip]*dp[ip],
-                       rpp[ip+sy_p]*dp[ip+sy_p])
-                       / viscosity;
-
-	 /* Calculate upper face velocity.
-	    diff >= 0 implies flow goes lower to upper 
-      */
-          sep = dz*(Mean(z_mult_dat[ip],z_mult_dat[ip+sz_p]));
-          
-         
-          lower_cond = pp[ip]/ sep
-                       - (z_mult_dat[ip]/(z_mult_dat[ip]+z_mult_dat[ip+sz_p]))
-                       * dp[ip] * gravity * z_dir_g;
-
-          upper_cond = pp[ip+sz_p] / sep
-                       + (z_mult_dat[ip+sz_p]/(z_mult_dat[ip]+z_mult_dat[ip+sz_p]))
-                       * dp[ip+sz_p] * gravity *z_dir_g;
-
- 
-          diff = (lower_cond - upper_cond);
-          
-          u_upper = ffz*del_x_slope*del_y_slope
-                    * PMeanDZ(permzp[ip], permzp[ip+sz_p], z_mult_dat[ip],z_mult_dat[ip+sz_p])
-	                * diff
-	                * RPMean(lower_cond, upper_cond, rpp[ip]*dp[ip],
-                      rpp[ip+sz_p]*dp[ip+sz_p])
-	                / viscosity;
-			
-	 /* velocity data jjb */ 
-         vx[vxi]      = u_right/ffx;
-         vy[vyi]      = u_front/ffy;
-         vz[vzi]      = u_upper/ffz;		
-
-	 fp[ip]      += dt * ( u_right + u_front + u_upper );
-	 fp[ip+1]    -= dt * u_right;
-	 fp[ip+sy_p] -= dt * u_front;
-	 fp[ip+sz_p] -= dt * u_upper;
-      });
+	 PhaseRelPermProperties((instance_xtra -> phase_properties), pressure, 
+				density, rel_perm, NULL, gravity, problem_data,
+				PhaseCellsAll);
+      }
+      else
+      {
+	 PFModuleInvokeType(PhaseRelPermInvoke, rel_perm_module, 
+			    (rel_perm, pressure, density, gravity, 
+			     problem_data, CALCFCN));
+      }
+
+      AddFluxTerms(problem_data, pressure, density, rel_perm, fval, 
+		   x_velocity, y_velocity, z_velocity, gravity, viscosity, 
+		   dt, PhaseCellsCore);
    }
 
+   AddFluxTerms(problem_data, pressure, density, rel_perm, fval, 
+		x_velocity, y_velocity, z_velocity, gravity, viscosity, 
+		dt, PhaseCellsNotCore);
+
    /*  Calculate correction for boundary conditions */
 
    ForSubgridI(is, GridSubgrids(grid))
@@ -1420,7 +1636,7 @@ void NlFunctionEval (Vector *pressure,  /* Current pressure values */
             } else {
             /*  @RMM this is modified to be kinematic wave routing, with a new module for diffusive wave
              routing added */
-                double *dummy1, *dummy2, *dummy3, *dummy4; 
+                double *dummy1 = NULL, *dummy2 = NULL, *dummy3 = NULL, *dummy4 = NULL; 
             PFModuleInvokeType(OverlandFlowEvalDiffInvoke, overlandflow_module_diff, (grid, is, bc_struct, ipatch, problem_data, pressure,
                                                                              ke_, kw_, kn_, ks_, 
                                         dummy1, dummy2, dummy3, dummy4,
@@ -1580,12 +1796,12 @@ void NlFunctionEval (Vector *pressure,  /* Current pressure values */
 
    EndTiming(public_xtra -> time_index);
 
-   FreeVector(KW);
-   FreeVector(KE);
-   FreeVector(KN);
-   FreeVector(KS);
-   FreeVector(qx);
-   FreeVector(qy); 
+   ReturnVector(KW);
+   ReturnVector(KE);
+   ReturnVector(KN);
+   ReturnVector(KS);
+   ReturnVector(qx);
+   ReturnVector(qy); 
 
    return;
 }
@@ -1681,6 +1897,8 @@ void  NlFunctionEvalFreeInstanceXtra()
       PFModuleFreeInstance(instance_xtra -> bc_internal);
       PFModuleFreeInstance(instance_xtra -> overlandflow_module); //DOK
        PFModuleFreeInstance(instance_xtra -> overlandflow_module_diff); //@RMM
+
+      FreePhaseProperties(instance_xtra -> phase_properties);
       
       tfree(instance_xtra);
    }
@@ -1696,9 +1914,22 @@ PFModule   *NlFunctionEvalNewPublicXtra()
    PFModule      *this_module   = ThisPFModule;
    PublicXtra    *public_xtra;
    char           key[IDB_MAX_KEY_LEN];
+   NameArray      switch_na;
+   char          *switch_name;
 
 
    public_xtra = ctalloc(PublicXtra, 1);
+
+   switch_na = NA_NewNameArray("False True");
+   sprintf(key, "Solver.Nonlinear.OverlapExchange");
+   switch_name = GetStringDefault(key, "True");
+   (public_xtra -> overlap_exchange) = NA_NameToIndex(switch_na, switch_name);
+   if ( (public_xtra -> overlap_exchange) < 0 )
+   {
+      InputError("Error: Invalid value <%s> for key <%s>\n", switch_name,
+		 key);
+   }
+   NA_FreeNameArray(switch_na);
     
 /* These parameters dampen the transition/switching into overland flow to speedup
    the spinup process. */
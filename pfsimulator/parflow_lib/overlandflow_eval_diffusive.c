@@ -308,10 +308,10 @@ void    OverlandFlowEvalDiff(
                                    * RPowerR(pfmax(Pmean,0.0),(5.0/3.0));
 	   
          
-			   }
-					                 	                       
 	                   /* compute kn - NOTE: io is for current cell */
 			   kn_v[io] = q_v[3]; 
+			   }
+					                 	                       
 			     
 
 	     });
@@ -70,6 +70,9 @@
 #include "problem.h"
 #include "solver.h"
 #include "nl_function_eval.h"
+#include "pfb_prefetch.h"
+#include "vang_table.h"
+#include "phase_properties.h"
 #include "parflow_proto.h"
 #include "parflow_proto_f.h"
 
@@ -80,6 +80,10 @@ PFModule *ChebyshevNewPublicXtra (char *name );
 void ChebyshevFreePublicXtra (void );
 int ChebyshevSizeOfTempData (void );
 
+/* checkpoint.c */
+void WriteCheckpoint (char *file_prefix , char *file_suffix , double *scalars , int num_scalars , Vector **vectors , int num_vectors );
+void ReadCheckpoint (char *filename , double *scalars , int num_scalars , Vector **vectors , int num_vectors );
+
 /* comm_pkg.c */
 void ProjectRegion (Region *region , int sx , int sy , int sz , int ix , int iy , int iz );
 Region *ProjectRBPoint (Region *region , int rb [4 ][3 ]);
@@ -87,8 +91,14 @@ void CreateComputePkgs (Grid *grid );
 void FreeComputePkgs (Grid *grid );
 
 /* communication.c */
-int NewCommPkgInfo (Subregion *data_sr , Subregion *comm_sr , int index , int num_vars , int *loop_array );
+int NewCommPkgInfo (Subregion *data_sr , Subregion *comm_sr , int index , int num_vars , int cell_stride , int *loop_array );
 CommPkg *NewCommPkg (Region *send_region , Region *recv_region , SubregionArray *data_space , int num_vars , double *data );
+CommPlan *NewCommPlan (Region *send_region , Region *recv_region , SubregionArray *data_space , int num_vars , int cell_stride );
+void FreeCommPlan (CommPlan *plan );
+CommPkg *NewCommPkgFromPlan (CommPlan *plan , double *data );
+CommPkg *NewCommPkgStrided (Region *send_region , Region *recv_region , SubregionArray *data_space , int num_vars , int cell_stride , double *data );
+CommPlan *GridCommPlan (Grid *grid , int update_mode , SubregionArray *data_space , int num_vars );
+void FreeGridCommPlans (Grid *grid );
 void FreeCommPkg (CommPkg *pkg );
 // SGS what's up with this?
 CommHandle *InitCommunication (CommPkg *comm_pkg );
@@ -238,6 +248,12 @@ void GrGeomFreeExtentArray (GrGeomExtentArray *extent_array );
 GrGeomExtentArray *GrGeomCreateExtentArray (SubgridArray *subgrids , int xl_ghost , int xu_ghost , int yl_ghost , int yu_ghost , int zl_ghost , int zu_ghost );
 GrGeomSolid *GrGeomNewSolid (GrGeomOctree *data , GrGeomOctree **patches , int num_patches , int octree_bg_level , int octree_ix , int octree_iy , int octree_iz );
 void GrGeomFreeSolid (GrGeomSolid *solid );
+GrGeomSpans *GrGeomNewInSpans (GrGeomSolid *solid , int r , int ix , int iy , int iz , int nx , int ny , int nz );
+void GrGeomFreeSpans (GrGeomSpans *spans );
+GrGeomSpans *GrGeomGetInSpans (GrGeomSolid *solid , int r , int ix , int iy , int iz , int nx , int ny , int nz );
+GrGeomFaces *GrGeomNewPatchFaces (GrGeomSolid *solid , int patch_num , int r , int ix , int iy , int iz , int nx , int ny , int nz );
+void GrGeomFreeFaces (GrGeomFaces *faces );
+GrGeomFaces *GrGeomGetPatchFaces (GrGeomSolid *solid , int patch_num , int r , int ix , int iy , int iz , int nx , int ny , int nz );
 void GrGeomSolidFromInd (GrGeomSolid **solid_ptr , Vector *indicator_field , int indicator );
 void GrGeomSolidFromGeom (GrGeomSolid **solid_ptr , GeomSolid *geom_solid , GrGeomExtentArray *extent_array );
 
@@ -249,6 +265,7 @@ Subgrid *ConvertToSubgrid (Subregion *subregion );
 Subgrid *ExtractSubgrid (int rx , int ry , int rz , Subgrid *subgrid );
 Subgrid *IntersectSubgrids (Subgrid *subgrid1 , Subgrid *subgrid2 );
 SubgridArray *SubtractSubgrids (Subgrid *subgrid1 , Subgrid *subgrid2 );
+int SubtractBox (int box1 [6 ], int box2 [6 ], int boxes [6 ][6 ]);
 SubgridArray *UnionSubgridArray (SubgridArray *subgrids );
 
 /* hbt.c */
@@ -324,6 +341,7 @@ int KINSolInitPC (int neq , N_Vector pressure , N_Vector uscale , N_Vector fval
 int KINSolCallPC (int neq , N_Vector pressure , N_Vector uscale , N_Vector fval , N_Vector fscale , N_Vector vtem , N_Vector ftem , void *nl_function , double uround , long int *nfePtr , void *current_state );
 void PrintFinalStats (FILE *out_file , long int *integer_outputs_now , long int *integer_outputs_total );
 int KinsolNonlinSolver (Vector *pressure , Vector *density , Vector *old_density , Vector *saturation , Vector *old_saturation , double t , double dt , ProblemData *problem_data, Vector *old_pressure, Vector *evap_trans, Vector *ovrl_bc_flx, Vector *x_velocity, Vector *y_velocity, Vector *z_velocity );
+void KinsolNonlinSolverStepStats (PFModule *this_module , int *num_nonlin_iter , int *num_lin_iter );
 PFModule *KinsolNonlinSolverInitInstanceXtra (Problem *problem , Grid *grid , ProblemData *problem_data , double *temp_data );
 void KinsolNonlinSolverFreeInstanceXtra (void );
 PFModule *KinsolNonlinSolverNewPublicXtra (void );
@@ -533,6 +551,26 @@ PFModule *SMGNewPublicXtra (char *name );
 void SMGFreePublicXtra (void );
 int SMGSizeOfTempData (void );
 
+/* pfb_mpiio.c */
+char *PFBPackInts (char *pos , int *ptr , int len );
+char *PFBPackDoubles (char *pos , double *ptr , int len );
+char *PFBUnpackInts (char *pos , int *ptr , int len );
+char *PFBUnpackDoubles (char *pos , double *ptr , int len );
+char *PFBPackSubvector (char *pos , Subvector *subvector , Subgrid *subgrid );
+char *PFBUnpackSubvector (char *pos , Subvector *subvector , int *header );
+#ifdef AMPS_HAVE_MPI_IO
+void PFBMPIIOCheck (int error , char *what , char *filename );
+void PFBMPIIOReadAtAll (MPI_File fh , char *filename , long start , char *buffer , long size );
+void PFBMPIIOWriteAtAll (MPI_File fh , char *filename , long start , char *buffer , long size );
+#endif
+
+/* pfb_prefetch.c */
+PFBPrefetch *NewPFBPrefetch (int num_slots );
+void FreePFBPrefetch (PFBPrefetch *prefetch );
+void PFBPrefetchStart (PFBPrefetch *prefetch , int key , char **filenames , int num_files );
+void PFBPrefetchWait (PFBPrefetch *prefetch , int key );
+void PFBPrefetchReadPFBinary (PFBPrefetch *prefetch , char *filename , Vector *v );
+
 /* pfield.c */
 void PField (Grid *grid , GeomSolid *geounit , GrGeomSolid *gr_geounit , Vector *field , RFCondData *cdata , Statistics *stats );
 
@@ -547,6 +585,14 @@ int PGSRFSizeOfTempData (void );
 typedef void (*PhaseVelocityFaceInvoke) (Vector *xvel , Vector *yvel , Vector *zvel , ProblemData *problem_data , Vector *pressure , Vector **saturations , int phase );
 typedef PFModule *(*PhaseVelocityFaceInitInstanceXtraInvoke) (Problem *problem , Grid *grid , Grid *x_grid , Grid *y_grid , Grid *z_grid , double *temp_data );
 
+/* phase_properties.c */
+PhaseProperties *NewPhaseProperties (PFModule *density_module , PFModule *saturation_module , PFModule *rel_perm_module , ProblemData *problem_data , Grid *grid );
+void FreePhaseProperties (PhaseProperties *phase_properties );
+int PhaseCellsBoxes (int cells , Subgrid *subgrid , int boxes [6 ][6 ]);
+int InPhaseCells (int cells , Subgrid *subgrid , int i , int j , int k );
+void PhaseStorageProperties (PhaseProperties *phase_properties , Vector *pressure , Vector *density , Vector *density_der , Vector *saturation , Vector *saturation_der , double gravity , int cells );
+void PhaseRelPermProperties (PhaseProperties *phase_properties , Vector *pressure , Vector *density , Vector *rel_perm , Vector *rel_perm_der , double gravity , ProblemData *problem_data , int cells );
+
 /* phase_velocity_face.c */
 void PhaseVelocityFace (Vector *xvel , Vector *yvel , Vector *zvel , ProblemData *problem_data , Vector *pressure , Vector **saturations , int phase );
 PFModule *PhaseVelocityFaceInitInstanceXtra (Problem *problem , Grid *grid , Grid *x_grid , Grid *y_grid , Grid *z_grid , double *temp_data );
@@ -821,6 +867,7 @@ typedef void (*PhaseDensityInvoke) (int phase , Vector *phase_pressure , Vector
 typedef PFModule *(*PhaseDensityNewPublicXtraInvoke) (int num_phases );
 
 void PhaseDensity (int phase , Vector *phase_pressure , Vector *density_v , double *pressure_d , double *density_d , int fcn );
+void PhaseDensityConstants (PFModule *density_module , int phase , double *reference_density , double *compressibility_constant );
 PFModule *PhaseDensityInitInstanceXtra (void );
 void PhaseDensityFreeInstanceXtra (void );
 PFModule *PhaseDensityNewPublicXtra (int num_phases );
@@ -843,6 +890,7 @@ typedef PFModule *(*PhaseRelPermInitInstanceXtraInvoke) (Grid *grid , double *te
 
 /* problem_phase_rel_perm.c */
 void PhaseRelPerm (Vector *phase_rel_perm , Vector *phase_pressure , Vector *phase_density , double gravity , ProblemData *problem_data , int fcn );
+int PhaseRelPermVanGParameters (PFModule *rel_perm_module , int *num_regions , int **region_indices , double **alphas , double **ns , VanGTable ***lookup_tables );
 PFModule *PhaseRelPermInitInstanceXtra (Grid *grid , double *temp_data );
 void PhaseRelPermFreeInstanceXtra (void );
 PFModule *PhaseRelPermNewPublicXtra (void );
@@ -900,6 +948,7 @@ typedef PFModule *(*SaturationInitInstanceXtraInvoke) (Grid *grid , double *temp
 
 /* problem_saturation.c */
 void Saturation (Vector *phase_saturation , Vector *phase_pressure , Vector *phase_density , double gravity , ProblemData *problem_data , int fcn );
+int SaturationVanGParameters (PFModule *saturation_module , int *num_regions , int **region_indices , double **alphas , double **ns , double **s_ress , double **s_difs , VanGTable ***lookup_tables );
 PFModule *SaturationInitInstanceXtra (Grid *grid , double *temp_data );
 void SaturationFreeInstanceXtra (void );
 PFModule *SaturationNewPublicXtra (void );
@@ -955,6 +1004,8 @@ int RedBlackGSPointSizeOfTempData (void );
 /* read_parflow_binary.c */
 void ReadPFBinary_Subvector (amps_File file , Subvector *subvector , Subgrid *subgrid );
 void ReadPFBinary (char *filename , Vector *v );
+void ReadPFBinaryStaged (char *filename , Vector *v , char *buffer , long start , long size );
+void ReadPFBinarySubset (char *filename , Vector *v );
 
 /* reg_from_stenc.c */
 void ComputeRegFromStencil (Region **dep_reg_ptr , Region **ind_reg_ptr , SubregionArray *cr_array , Region *send_reg , Region *recv_reg , Stencil *stencil );
@@ -1006,6 +1057,10 @@ typedef void (*SelectTimeStepInvoke) (double *dt , char *dt_info , double time ,
 
 /* select_time_step.c */
 void SelectTimeStep (double *dt , char *dt_info , double time , Problem *problem , ProblemData *problem_data );
+void SelectTimeStepReportStep (PFModule *this_module , int num_nonlin_iter , int num_lin_iter , Vector *pressure , Vector *old_pressure , Vector *saturation , Vector *old_saturation , GrGeomSolid *gr_domain );
+double SelectTimeStepFailedStep (PFModule *this_module , double dt );
+void SelectTimeStepGetState (PFModule *this_module , double *state );
+void SelectTimeStepSetState (PFModule *this_module , double *state );
 PFModule *SelectTimeStepInitInstanceXtra (void );
 void SelectTimeStepFreeInstanceXtra (void );
 PFModule *SelectTimeStepNewPublicXtra (void );
@@ -1151,8 +1206,16 @@ Subgrid *ReadUserSubgrid (void );
 Grid *ReadUserGrid (void );
 void FreeUserGrid (Grid *user_grid );
 
+/* vang_table.c */
+VanGTable *NewVanGTable (int interpolation_method , int num_sample_points , double min_pressure_head , double alpha , double n , VanGFunction function );
+void FreeVanGTable (VanGTable *table );
+void LogVanGTable (char *name , VanGTable *table );
+VanGClasses *NewVanGClasses (char *name , Vector *alpha_values , Vector *n_values , int max_classes , double max_n_error , int interpolation_method , int num_sample_points , double min_pressure_head , VanGFunction function );
+void FreeVanGClasses (VanGClasses *classes );
+
 /* vector.c */
 CommPkg *NewVectorCommPkg (Vector *vector , ComputePkg *compute_pkg );
+CommPkg *GetVectorCommPkg (Vector *vector , int update_mode );
 VectorUpdateCommHandle  *InitVectorUpdate(
    Vector      *vector,
    int          update_mode);
@@ -1168,6 +1231,9 @@ Vector  *NewVectorType(
    int      num_ghost,
    enum vector_type type);
 void FreeVector (Vector *vector );
+Vector *CheckoutVector (Grid *grid , int nc , int num_ghost , enum vector_type type );
+void ReturnVector (Vector *vector );
+void FreeGridVectorPool (Grid *grid );
 void InitVector (Vector *v , double value );
 void InitVectorAll (Vector *v , double value );
 void InitVectorInc (Vector *v , double value , double inc );
@@ -1183,7 +1249,9 @@ void PFVAbs (Vector *x , Vector *z );
 void PFVInv (Vector *x , Vector *z );
 void PFVAddConst (Vector *x , double b , Vector *z );
 double PFVDotProd (Vector *x , Vector *y );
+void PFVDotProdMulti (int nvec , Vector **x , Vector *y , double *result );
 double PFVMaxNorm (Vector *x );
+double PFVMaxRelChange (Vector *x , Vector *y , double scale , GrGeomSolid *gr_domain );
 double PFVWrmsNorm (Vector *x , Vector *w );
 double PFVWL2Norm (Vector *x , Vector *w );
 double PFVL1Norm (Vector *x );
@@ -1203,6 +1271,13 @@ void PFVLin2 (double a , Vector *x , Vector *y , Vector *z );
 void PFVAxpy (double a , Vector *x , Vector *y );
 void PFVScaleBy (double a , Vector *x );
 void PFVLayerCopy (int  a, int  b, Vector *x, Vector *y);
+void PFVLinearCombination (int nvec , double *c , Vector **x , Vector *z );
+void PFVMultiAxpy (int nvec , double *c , Vector **x , Vector *y );
+double PFVMultiAxpyDot (int nvec , double *c , Vector **x , Vector *y , int dot );
+double PFVWMaxNorm (Vector *x , Vector *w );
+double PFVStepMaxNorm (Vector *u , Vector *p , Vector *w );
+double PFVWL2NormDot (Vector *x , Vector *w , Vector *y , double *dot );
+void PFVWDotProdL1 (Vector *u , Vector *v , Vector *w , double *result );
 
 /* w_jacobi.c */
 void WJacobi (Vector *x , Vector *b , double tol , int zero );
@@ -263,7 +263,7 @@ double       *temp_data)
    int                 i, j, k, itop, k1, ktop;
    int                 ix, iy, iz;
    int                 nx, ny, nz;
-   int                 nx_m, ny_m, nz_m, sy_m, sy_v;
+   int                 nx_m, ny_m, nz_m, sx_m, sy_m, sy_v;
    int                 im,io;
    int                 stencil_size;
    int                 symmetric;
@@ -420,13 +420,14 @@ double       *temp_data)
 	 nx_m  = SubmatrixNX(pfB_sub);
 	 ny_m  = SubmatrixNY(pfB_sub);
 	 nz_m  = SubmatrixNZ(pfB_sub);
+	 sx_m  = SubmatrixStride(pfB_sub);
 
 	 im  = SubmatrixEltIndex(pfB_sub,  ix, iy, iz);
 
 	 if (symmetric)
 	 {
             BoxLoopI1(i, j, k, ix, iy, iz, nx, ny, nz,
-		      im,  nx_m,  ny_m,  nz_m,  1, 1, 1,
+		      im, nx_m*sx_m,  ny_m,  nz_m,  sx_m, 1, 1,
 		      {
 		         coeffs_symm[0] = cp[im];
 			 coeffs_symm[1] = ep[im];
@@ -445,7 +446,7 @@ double       *temp_data)
 	 else 
 	 {
             BoxLoopI1(i, j, k, ix, iy, iz, nx, ny, nz,
-		      im,  nx_m,  ny_m,  nz_m,  1, 1, 1,
+		      im, nx_m*sx_m,  ny_m,  nz_m,  sx_m, 1, 1,
 		      {
 		         coeffs[0] = cp[im];
 			 coeffs[1] = wp[im];
@@ -523,6 +524,7 @@ double       *temp_data)
 	 nx_m  = SubmatrixNX(pfB_sub);
 	 ny_m  = SubmatrixNY(pfB_sub);
 	 nz_m  = SubmatrixNZ(pfB_sub);
+	 sx_m  = SubmatrixStride(pfB_sub);
 	 
 	 sy_v = SubvectorNX(top_sub);
 	 
@@ -533,7 +535,7 @@ double       *temp_data)
 	 if (symmetric)
 	 {
             BoxLoopI1(i, j, k, ix, iy, iz, nx, ny, nz,
-		      im,  nx_m,  ny_m,  nz_m,  1, 1, 1,
+		      im, nx_m*sx_m,  ny_m,  nz_m,  sx_m, 1, 1,
 		      {
                          itop   = SubvectorEltIndex(top_sub, i, j, 0);    
                 	 ktop = (int)top_dat[itop]; 
@@ -572,7 +574,7 @@ double       *temp_data)
 	 else
 	 {
             BoxLoopI1(i, j, k, ix, iy, iz, nx, ny, nz,
-		      im,  nx_m,  ny_m,  nz_m,  1, 1, 1,
+		      im, nx_m*sx_m,  ny_m,  nz_m,  sx_m, 1, 1,
 		      {
                          itop   = SubvectorEltIndex(top_sub, i, j, 0);    
                 	 ktop = (int)top_dat[itop]; 
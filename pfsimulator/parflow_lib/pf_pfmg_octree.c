@@ -345,7 +345,7 @@ double       *temp_data)
    int                 num_i, num_j, num_k;
    int                 ix, iy, iz;
    int                 nx, ny, nz;
-   int                 nx_m, ny_m, nz_m, sy_m, sy_v;
+   int                 nx_m, ny_m, nz_m, sx_m, sy_m, sy_v;
    int                 im, io, itop, ktop, k1;
    int                 stencil_size;
    int                 symmetric;
@@ -537,6 +537,7 @@ double       *temp_data)
 	 	nx_m  = SubmatrixNX(pfB_sub);
 	 	ny_m  = SubmatrixNY(pfB_sub);
 	 	nz_m  = SubmatrixNZ(pfB_sub);
+	 	sx_m  = SubmatrixStride(pfB_sub);
 
 	 	im  = SubmatrixEltIndex(pfB_sub,  ix, iy, iz);
 
@@ -621,12 +622,12 @@ double       *temp_data)
 	    		hypre_Box          *set_box;
 	    		hypre_Box          *value_box;
 
-	    		ilo[0] = ix;
-	    		ilo[1] = iy;
-	    		ilo[2] = iz;
-	    		ihi[0] = ilo[0] + nx - 1;
-	    		ihi[1] = ilo[1] + ny - 1;
-	    		ihi[2] = ilo[2] + nz - 1;
+	    		ilo[0] = SubmatrixIX(pfB_sub);
+	    		ilo[1] = SubmatrixIY(pfB_sub);
+	    		ilo[2] = SubmatrixIZ(pfB_sub);
+	    		ihi[0] = ilo[0] + nx_m - 1;
+			ihi[1] = ilo[1] + ny_m - 1;
+	    		ihi[2] = ilo[2] + nz_m - 1;
 
 	    		value_box = hypre_BoxCreate(PARFLOW_HYPRE_DIM);
 	    		hypre_BoxSetExtents(value_box, ilo, ihi); 
@@ -735,6 +736,7 @@ double       *temp_data)
 	 	nx_m  = SubmatrixNX(pfB_sub);
 	 	ny_m  = SubmatrixNY(pfB_sub);
 	 	nz_m  = SubmatrixNZ(pfB_sub);
+	 	sx_m  = SubmatrixStride(pfB_sub);
 
 		sy_v = SubvectorNX(top_sub);
 	 
@@ -816,7 +818,7 @@ double       *temp_data)
 			     * diagonal, east, and north terms - DOK
 			    */
 			    BoxLoopI1(i, j, k, ix, iy, 0, nx, ny, 1,
-		      		im,  nx_m,  ny_m,  nz_m,  1, 1, 1,
+		      		im, nx_m*sx_m,  ny_m,  nz_m,  sx_m, 1, 1,
 		      		{
                          		itop   = SubvectorEltIndex(top_sub, i, j, 0);    
                 	 		ktop = (int)top_dat[itop]; 
@@ -834,6 +836,8 @@ double       *temp_data)
 		            		   //k1 = (int)top_dat[itop+sy_v];
 		            		   //if(k1 == ktop)
 					   coeffs_symm[2] = 0.0; //np_c[io];// + sop_c[io+sy_v]; // symmetrize - np[im] is zero
+					   /* top coeff */
+					   coeffs_symm[3] = 0.0;
 		            
 					   index[0] = i;
 					   index[1] = j;
@@ -859,12 +863,12 @@ double       *temp_data)
 	    		hypre_Box          *set_box;
 	    		hypre_Box          *value_box;
 
-	    		ilo[0] = ix;
-	    		ilo[1] = iy;
-	    		ilo[2] = iz;
-	    		ihi[0] = ilo[0] + nx - 1;
-	    		ihi[1] = ilo[1] + ny - 1;
-	    		ihi[2] = ilo[2] + nz - 1;
+	    		ilo[0] = SubmatrixIX(pfB_sub);
+	    		ilo[1] = SubmatrixIY(pfB_sub);
+	    		ilo[2] = SubmatrixIZ(pfB_sub);
+	    		ihi[0] = ilo[0] + nx_m - 1;
+			ihi[1] = ilo[1] + ny_m - 1;
+	    		ihi[2] = ilo[2] + nz_m - 1;
 
 	    		value_box = hypre_BoxCreate(PARFLOW_HYPRE_DIM);
 	    		hypre_BoxSetExtents(value_box, ilo, ihi); 
@@ -914,7 +918,7 @@ double       *temp_data)
 			     * diagonal, east, west, north, and south terms - DOK
 			    */
 			    BoxLoopI1(i, j, k, ix, iy, 0, nx, ny, 1,
-		      		im,  nx_m,  ny_m,  nz_m,  1, 1, 1,
+		      		im, nx_m*sx_m,  ny_m,  nz_m,  sx_m, 1, 1,
 		      		{
                          		itop   = SubvectorEltIndex(top_sub, i, j, 0);    
                 	 		ktop = (int)top_dat[itop]; 
@@ -940,6 +944,9 @@ double       *temp_data)
 				            //k1 = (int)top_dat[itop+sy_v];
 				            //if(k1 == ktop)
 				                coeffs[4] = 0.0;//np_c[io] ; //np[im] is zero  
+				         /* lower and upper coeffs */
+				                coeffs[5] = 0.0;
+				                coeffs[6] = 0.0;
 					   
 					   index[0] = i;
 					   index[1] = j;
@@ -254,7 +254,7 @@ double       *temp_data)
    int                 i, j, k;
    int                 ix, iy, iz;
    int                 nx, ny, nz;
-   int                 nx_m, ny_m, nz_m;
+   int                 nx_m, ny_m, nz_m, sx_m;
    int                 im;
    int                 stencil_size;
    int                 symmetric;
@@ -406,13 +406,14 @@ double       *temp_data)
 	 nx_m  = SubmatrixNX(pf_sub);
 	 ny_m  = SubmatrixNY(pf_sub);
 	 nz_m  = SubmatrixNZ(pf_sub);
+	 sx_m  = SubmatrixStride(pf_sub);
 
 	 im  = SubmatrixEltIndex(pf_sub,  ix, iy, iz);
 
 	 if (symmetric)
 	 {
             BoxLoopI1(i, j, k, ix, iy, iz, nx, ny, nz,
-		      im,  nx_m,  ny_m,  nz_m,  1, 1, 1,
+		      im, nx_m*sx_m,  ny_m,  nz_m,  sx_m, 1, 1,
 		      {
 		         coeffs_symm[0] = cp[im];
 			 coeffs_symm[1] = ep[im];
@@ -431,7 +432,7 @@ double       *temp_data)
 	 else
 	 {
             BoxLoopI1(i, j, k, ix, iy, iz, nx, ny, nz,
-		      im,  nx_m,  ny_m,  nz_m,  1, 1, 1,
+		      im, nx_m*sx_m,  ny_m,  nz_m,  sx_m, 1, 1,
 		      {
 		         coeffs[0] = cp[im];
 			 coeffs[1] = wp[im];
@@ -0,0 +1,271 @@
+/*BHEADER**********************************************************************
+
+  Copyright (c) 1995-2009, Lawrence Livermore National Security,
+  LLC. Produced at the Lawrence Livermore National Laboratory. Written
+  by the Parflow Team (see the CONTRIBUTORS file)
+  <parflow@lists.llnl.gov> CODE-OCEC-08-103. All rights reserved.
+
+  This file is part of Parflow. For details, see
+  http://www.llnl.gov/casc/parflow
+
+  Please read the COPYRIGHT file or Our Notice and the LICENSE file
+  for the GNU Lesser General Public License.
+
+  This program is free software; you can redistribute it and/or modify
+  it under the terms of the GNU General Public License (as published
+  by the Free Software Foundation) version 2.1 dated February 1999.
+
+  This program is distributed in the hope that it will be useful, but
+  WITHOUT ANY WARRANTY; without even the IMPLIED WARRANTY OF
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the terms
+  and conditions of the GNU General Public License for more details.
+
+  You should have received a copy of the GNU Lesser General Public
+  License along with this program; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307
+  USA
+**********************************************************************EHEADER*/
+/******************************************************************************
+ *
+ * Packing of PFB blocks to and from memory (big endian, the layout of the
+ * amps writer) and the collective MPI-IO transfers of whole parts of a
+ * PFB file.  Shared by the PFB readers and writers and the read-ahead of
+ * pfb_prefetch.c.
+ *
+ *****************************************************************************/
+
+#include "parflow.h"
+
+#include <string.h>
+
+
+/*--------------------------------------------------------------------------
+ * PFBCopyBigEndian:
+ *   Copy len items of size bytes from from to to, reversing the bytes of
+ *   each item on little endian machines.  Packing and unpacking are the
+ *   same operation.
+ *--------------------------------------------------------------------------*/
+
+static void  PFBCopyBigEndian(
+char  *to,
+char  *from,
+int    size,
+int    len)
+{
+#ifdef CASC_HAVE_BIGENDIAN
+   memcpy(to, from, (size_t)size * (size_t)len);
+#else
+   int   i, b;
+
+   for(i = 0; i < len; i++, to += size, from += size)
+      for(b = 0; b < size; b++)
+	 to[b] = from[size - 1 - b];
+#endif
+}
+
+
+char  *PFBPackInts(
+char  *pos,
+int   *ptr,
+int    len)
+{
+   PFBCopyBigEndian(pos, (char *)ptr, 4, len);
+   return pos + 4*len;
+}
+
+char  *PFBPackDoubles(
+char    *pos,
+double  *ptr,
+int      len)
+{
+   PFBCopyBigEndian(pos, (char *)ptr, 8, len);
+   return pos + 8*len;
+}
+
+char  *PFBUnpackInts(
+char  *pos,
+int   *ptr,
+int    len)
+{
+   PFBCopyBigEndian((char *)ptr, pos, 4, len);
+   return pos + 4*len;
+}
+
+char  *PFBUnpackDoubles(
+char    *pos,
+double  *ptr,
+int      len)
+{
+   PFBCopyBigEndian((char *)ptr, pos, 8, len);
+   return pos + 8*len;
+}
+
+
+/*--------------------------------------------------------------------------
+ * PFBPackSubvector:
+ *   Pack the block of subvector on subgrid, header and data, at pos.
+ *--------------------------------------------------------------------------*/
+
+char  *PFBPackSubvector(
+char      *pos,
+Subvector *subvector,
+Subgrid   *subgrid)
+{
+   int             header[9];
+
+   int             nx_v = SubvectorNX(subvector);
+   int             ny_v = SubvectorNY(subvector);
+
+   int             j, k;
+   double         *data;
+
+   header[0] = SubgridIX(subgrid);
+   header[1] = SubgridIY(subgrid);
+   header[2] = SubgridIZ(subgrid);
+   header[3] = SubgridNX(subgrid);
+   header[4] = SubgridNY(subgrid);
+   header[5] = SubgridNZ(subgrid);
+   header[6] = SubgridRX(subgrid);
+   header[7] = SubgridRY(subgrid);
+   header[8] = SubgridRZ(subgrid);
+
+   pos = PFBPackInts(pos, header, 9);
+
+   data = SubvectorElt(subvector, header[0], header[1], header[2]);
+
+   for(k = 0; k < header[5]; k++)
+      for(j = 0; j < header[4]; j++)
+	 pos = PFBPackDoubles(pos, data + (k*ny_v + j)*nx_v, header[3]);
+
+   return pos;
+}
+
+
+/*--------------------------------------------------------------------------
+ * PFBUnpackSubvector:
+ *   Unpack the data of a block into subvector.  The block header has
+ *   already been unpacked into header and checked against the subgrid by
+ *   the caller; pos points just past it.
+ *--------------------------------------------------------------------------*/
+
+char  *PFBUnpackSubvector(
+char      *pos,
+Subvector *subvector,
+int       *header)
+{
+   int             nx_v = SubvectorNX(subvector);
+   int             ny_v = SubvectorNY(subvector);
+
+   int             j, k;
+   double         *data;
+
+   data = SubvectorElt(subvector, header[0], header[1], header[2]);
+
+   for(k = 0; k < header[5]; k++)
+      for(j = 0; j < header[4]; j++)
+	 pos = PFBUnpackDoubles(pos, data + (k*ny_v + j)*nx_v, header[3]);
+
+   return pos;
+}
+
+
+#ifdef AMPS_HAVE_MPI_IO
+
+/*--------------------------------------------------------------------------
+ * PFBMPIIOCheck:
+ *   Abort the run if the MPI-IO call what on filename did not succeed.
+ *   The calls are collective, so a rank that fails can not simply exit.
+ *--------------------------------------------------------------------------*/
+
+void  PFBMPIIOCheck(
+int    error,
+char  *what,
+char  *filename)
+{
+   char   error_string[MPI_MAX_ERROR_STRING];
+   char   message[MPI_MAX_ERROR_STRING + 2048];
+   int    len;
+
+   if (error == MPI_SUCCESS)
+      return;
+
+   MPI_Error_string(error, error_string, &len);
+   snprintf(message, sizeof(message), "Error: MPI-IO %s of %s failed: %s",
+	    what, filename, error_string);
+   PARFLOW_ERROR(message);
+}
+
+
+/*--------------------------------------------------------------------------
+ * PFBMPIIOTransferAtAll:
+ *   Read (write == 0) or write size bytes of buffer at offset start of
+ *   fh.  Collective.
+ *--------------------------------------------------------------------------*/
+
+/* MPI counts are ints, so a rank's part of the file is transferred in
+   pieces of at most PFBMPIIOPieceSize bytes.  The transfers are
+   collective, so every rank makes as many calls as the rank with the
+   most pieces, with empty pieces once its part is done. */
+#define PFBMPIIOPieceSize  (1L << 30)
+
+static void  PFBMPIIOTransferAtAll(
+MPI_File  fh,
+char     *filename,
+long      start,
+char     *buffer,
+long      size,
+int       write)
+{
+   long         num_pieces, max_pieces, piece, n;
+   int          count;
+   MPI_Status   status;
+
+   num_pieces = (size + PFBMPIIOPieceSize - 1) / PFBMPIIOPieceSize;
+   MPI_Allreduce(&num_pieces, &max_pieces, 1, MPI_LONG, MPI_MAX,
+		 amps_CommWorld);
+
+   for(piece = 0; piece < max_pieces; piece++)
+   {
+      n = pfmin(size, PFBMPIIOPieceSize);
+
+      if (write)
+	 PFBMPIIOCheck(MPI_File_write_at_all(fh, (MPI_Offset)start, buffer,
+					     (int)n, MPI_BYTE, &status),
+		       "write", filename);
+      else
+	 PFBMPIIOCheck(MPI_File_read_at_all(fh, (MPI_Offset)start, buffer,
+					    (int)n, MPI_BYTE, &status),
+		       "read", filename);
+
+      /* A read past the end of a truncated file succeeds short */
+      MPI_Get_count(&status, MPI_BYTE, &count);
+      if (count != n)
+	 PFBMPIIOCheck(MPI_ERR_TRUNCATE, write ? "write" : "read", filename);
+
+      start  += n;
+      buffer += n;
+      size   -= n;
+   }
+}
+
+void  PFBMPIIOReadAtAll(
+MPI_File  fh,
+char     *filename,
+long      start,
+char     *buffer,
+long      size)
+{
+   PFBMPIIOTransferAtAll(fh, filename, start, buffer, size, 0);
+}
+
+void  PFBMPIIOWriteAtAll(
+MPI_File  fh,
+char     *filename,
+long      start,
+char     *buffer,
+long      size)
+{
+   PFBMPIIOTransferAtAll(fh, filename, start, buffer, size, 1);
+}
+
+#endif
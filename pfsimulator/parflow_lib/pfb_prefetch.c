@@ -0,0 +1,416 @@
+/*BHEADER**********************************************************************
+
+  Copyright (c) 1995-2009, Lawrence Livermore National Security,
+  LLC. Produced at the Lawrence Livermore National Laboratory. Written
+  by the Parflow Team (see the CONTRIBUTORS file)
+  <parflow@lists.llnl.gov> CODE-OCEC-08-103. All rights reserved.
+
+  This file is part of Parflow. For details, see
+  http://www.llnl.gov/casc/parflow
+
+  Please read the COPYRIGHT file or Our Notice and the LICENSE file
+  for the GNU Lesser General Public License.
+
+  This program is free software; you can redistribute it and/or modify
+  it under the terms of the GNU General Public License (as published
+  by the Free Software Foundation) version 2.1 dated February 1999.
+
+  This program is distributed in the hope that it will be useful, but
+  WITHOUT ANY WARRANTY; without even the IMPLIED WARRANTY OF
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the terms
+  and conditions of the GNU General Public License for more details.
+
+  You should have received a copy of the GNU Lesser General Public
+  License along with this program; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307
+  USA
+**********************************************************************EHEADER*/
+/******************************************************************************
+ *
+ * Read-ahead of PFB files.
+ *
+ * Input that is read every few time steps (e.g. the CLM forcing files)
+ * can be requested ahead of time.  A background thread reads this
+ * process's part of each file into a staging buffer, which
+ * PFBPrefetchReadPFBinary unpacks into the vector on the main thread
+ * when the file is needed.  Only plain file reads are done in the
+ * background, the checks whether the staged data can be used are
+ * collective and done on the main thread by ReadPFBinaryStaged.
+ *
+ * The part of a file staged is the process's byte range given by the
+ * .dist file for a single file, or the process's part file for split
+ * files (the same order ReadPFBinary looks for them in).  Nothing is
+ * staged for a single file without a .dist file or with a .dist file
+ * written by a different number of processes, such files are read by
+ * ReadPFBinary as usual.  Missing files are skipped, it is up to
+ * ReadPFBinary to complain about them.
+ *
+ * Without threads the reads are handed to the operating system as
+ * advice, which starts the reads asynchronously where it is supported.
+ *
+ *****************************************************************************/
+
+#include "parflow.h"
+
+#include <string.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/stat.h>
+
+
+/*--------------------------------------------------------------------------
+ * PFBPrefetchOpen:
+ *   Open the file holding the part of filename written by rank and find
+ *   the byte range [start, end) of the part.  Returns -1 if there is no
+ *   such part.
+ *--------------------------------------------------------------------------*/
+
+static int  PFBPrefetchOpen(
+char           *filename,
+int             rank,
+int             num_procs,
+long           *start,
+long           *end)
+{
+   char            part_filename[255];
+   char            dist_filename[255];
+   FILE           *dfile;
+   struct stat     st;
+
+   long            offset;
+   int             fd, p;
+
+   if ((fd = open(filename, O_RDONLY)) >= 0)
+   {
+      if (fstat(fd, &st) != 0)
+      {
+	 close(fd);
+	 return -1;
+      }
+
+      *start = -1;
+      *end   = (long)st.st_size;
+
+      /* the .dist file must have one offset per process of this run */
+      sprintf(dist_filename, "%s.dist", filename);
+      if ((dfile = fopen(dist_filename, "r")) != NULL)
+      {
+	 for(p = 0; fscanf(dfile, "%ld", &offset) == 1; p++)
+	 {
+	    if (p == rank)
+	       *start = offset;
+	    else if (p == rank + 1)
+	       *end = offset;
+	 }
+	 fclose(dfile);
+
+	 if (p != num_procs)
+	    *start = -1;
+      }
+
+      if ( (*start < 0) || (*end < *start) )
+      {
+	 close(fd);
+	 return -1;
+      }
+
+      return fd;
+   }
+
+   sprintf(part_filename, "%s.%05d", filename, rank);
+   if ((fd = open(part_filename, O_RDONLY)) >= 0)
+   {
+      if (fstat(fd, &st) != 0)
+      {
+	 close(fd);
+	 return -1;
+      }
+
+      *start = 0;
+      *end   = (long)st.st_size;
+   }
+
+   return fd;
+}
+
+
+/*--------------------------------------------------------------------------
+ * PFBPrefetchFile:
+ *   Read the part of file f of slot for its rank into a staging buffer,
+ *   or if stage is 0 only advise that it will be needed.
+ *--------------------------------------------------------------------------*/
+
+static void  PFBPrefetchFile(
+PFBPrefetchSlot *slot,
+int              f,
+int              stage)
+{
+   char           *buffer;
+   long            start, end;
+   long            n, size;
+   int             fd;
+
+   (slot -> buffers)[f] = NULL;
+
+   if ((fd = PFBPrefetchOpen((slot -> filenames)[f], (slot -> rank),
+			     (slot -> num_procs), &start, &end)) < 0)
+      return;
+
+   if (!stage)
+   {
+#ifdef POSIX_FADV_WILLNEED
+      posix_fadvise(fd, start, end - start, POSIX_FADV_WILLNEED);
+#endif
+      close(fd);
+      return;
+   }
+
+   if ((buffer = talloc(char, end - start)) == NULL)
+   {
+      close(fd);
+      return;
+   }
+
+   lseek(fd, start, SEEK_SET);
+   for(size = 0; size < end - start; size += n)
+   {
+      if ((n = read(fd, buffer + size, (size_t)(end - start - size))) <= 0)
+	 break;
+   }
+   close(fd);
+
+   if (size < end - start)
+   {
+      tfree(buffer);
+      return;
+   }
+
+   (slot -> buffers)[f] = buffer;
+   (slot -> starts)[f]  = start;
+   (slot -> sizes)[f]   = size;
+}
+
+
+/*--------------------------------------------------------------------------
+ * PFBPrefetchRelease:
+ *   Wait for the reads of slot and free its staging buffers.
+ *--------------------------------------------------------------------------*/
+
+static void  PFBPrefetchRelease(
+PFBPrefetchSlot *slot)
+{
+   int             f;
+
+   if (slot -> running)
+   {
+#ifdef HAVE_PTHREAD
+      pthread_join((slot -> thread), NULL);
+#endif
+      (slot -> running) = 0;
+   }
+
+   for(f = 0; f < (slot -> num_files); f++)
+   {
+      tfree((slot -> buffers)[f]);
+      (slot -> buffers)[f] = NULL;
+   }
+}
+
+
+#ifdef HAVE_PTHREAD
+
+/*--------------------------------------------------------------------------
+ * PFBPrefetchRead:
+ *   Thread body, stages the files of one slot.  Only the slot is
+ *   touched here.
+ *--------------------------------------------------------------------------*/
+
+static void  *PFBPrefetchRead(
+void           *arg)
+{
+   PFBPrefetchSlot *slot = (PFBPrefetchSlot *)arg;
+   int              f;
+
+   for(f = 0; f < (slot -> num_files); f++)
+      PFBPrefetchFile(slot, f, 1);
+
+   return NULL;
+}
+
+#endif
+
+
+/*--------------------------------------------------------------------------
+ * NewPFBPrefetch
+ *--------------------------------------------------------------------------*/
+
+PFBPrefetch  *NewPFBPrefetch(
+int             num_slots)
+{
+   PFBPrefetch    *prefetch;
+
+   prefetch = ctalloc(PFBPrefetch, 1);
+
+   (prefetch -> num_slots) = num_slots;
+   (prefetch -> slots)     = ctalloc(PFBPrefetchSlot, num_slots);
+
+   return prefetch;
+}
+
+
+/*--------------------------------------------------------------------------
+ * FreePFBPrefetch:
+ *   Waits for any reads still running and drops the staged data.
+ *--------------------------------------------------------------------------*/
+
+void  FreePFBPrefetch(
+PFBPrefetch    *prefetch)
+{
+   int             s;
+
+   if (prefetch)
+   {
+      for(s = 0; s < (prefetch -> num_slots); s++)
+	 PFBPrefetchRelease(&(prefetch -> slots)[s]);
+
+      tfree(prefetch -> slots);
+      tfree(prefetch);
+   }
+}
+
+
+/*--------------------------------------------------------------------------
+ * PFBPrefetchStart:
+ *   Start reading the files for key unless that has already been done.
+ *   The slot with the oldest (smallest) key is reused.
+ *--------------------------------------------------------------------------*/
+
+void  PFBPrefetchStart(
+PFBPrefetch    *prefetch,
+int             key,
+char          **filenames,
+int             num_files)
+{
+   PFBPrefetchSlot *slot = NULL;
+   int              s, f;
+
+   for(s = 0; s < (prefetch -> num_slots); s++)
+      if ((prefetch -> slots)[s].used && (prefetch -> slots)[s].key == key)
+	 return;
+
+   /* an unused slot if there is one, else the one with the oldest key */
+   for(s = 0; s < (prefetch -> num_slots); s++)
+   {
+      if ( (slot == NULL) || !((prefetch -> slots)[s].used) ||
+	   ((prefetch -> slots)[s].key < (slot -> key)) )
+	 slot = &(prefetch -> slots)[s];
+
+      if (!(slot -> used))
+	 break;
+   }
+
+   if (slot == NULL)
+      return;
+
+   PFBPrefetchRelease(slot);
+
+   (slot -> key)       = key;
+   (slot -> used)      = 1;
+   (slot -> rank)      = amps_Rank(amps_CommWorld);
+   (slot -> num_procs) = amps_Size(amps_CommWorld);
+   (slot -> num_files) = pfmin(num_files, PFBPrefetchMaxFiles);
+
+   for(f = 0; f < (slot -> num_files); f++)
+   {
+      strncpy((slot -> filenames)[f], filenames[f], 254);
+      (slot -> filenames)[f][254] = '\0';
+      (slot -> buffers)[f] = NULL;
+   }
+
+#ifdef HAVE_PTHREAD
+   (slot -> running) =
+      (pthread_create(&(slot -> thread), NULL, PFBPrefetchRead, slot) == 0);
+#else
+   for(f = 0; f < (slot -> num_files); f++)
+      PFBPrefetchFile(slot, f, 0);
+#endif
+}
+
+
+/*--------------------------------------------------------------------------
+ * PFBPrefetchWait:
+ *   Wait for the read of the files for key to finish, if it was started.
+ *--------------------------------------------------------------------------*/
+
+void  PFBPrefetchWait(
+PFBPrefetch    *prefetch,
+int             key)
+{
+   PFBPrefetchSlot *slot;
+   int              s;
+
+   for(s = 0; s < (prefetch -> num_slots); s++)
+   {
+      slot = &(prefetch -> slots)[s];
+
+      if ((slot -> used) && (slot -> key) == key && (slot -> running))
+      {
+#ifdef HAVE_PTHREAD
+	 pthread_join((slot -> thread), NULL);
+#endif
+	 (slot -> running) = 0;
+      }
+   }
+}
+
+
+/*--------------------------------------------------------------------------
+ * PFBPrefetchReadPFBinary:
+ *   Read filename into v, from its staged part if it was read ahead.
+ *   The staged data is dropped once used.  Collective, like ReadPFBinary,
+ *   and prefetch may be NULL.
+ *--------------------------------------------------------------------------*/
+
+void  PFBPrefetchReadPFBinary(
+PFBPrefetch    *prefetch,
+char           *filename,
+Vector         *v)
+{
+   PFBPrefetchSlot *slot;
+   char            *buffer = NULL;
+   long             start  = 0;
+   long             size   = 0;
+   int              s, f;
+
+   if (prefetch == NULL)
+   {
+      ReadPFBinary(filename, v);
+      return;
+   }
+
+   for(s = 0; (s < (prefetch -> num_slots)) && (buffer == NULL); s++)
+   {
+      slot = &(prefetch -> slots)[s];
+
+      if (!(slot -> used))
+	 continue;
+
+      for(f = 0; f < (slot -> num_files); f++)
+      {
+	 if (strcmp((slot -> filenames)[f], filename) == 0)
+	 {
+	    PFBPrefetchWait(prefetch, (slot -> key));
+
+	    buffer = (slot -> buffers)[f];
+	    start  = (slot -> starts)[f];
+	    size   = (slot -> sizes)[f];
+	    (slot -> buffers)[f] = NULL;
+	    break;
+	 }
+      }
+   }
+
+   ReadPFBinaryStaged(filename, v, buffer, start, size);
+
+   tfree(buffer);
+}
@@ -0,0 +1,84 @@
+/*BHEADER**********************************************************************
+
+  Copyright (c) 1995-2009, Lawrence Livermore National Security,
+  LLC. Produced at the Lawrence Livermore National Laboratory. Written
+  by the Parflow Team (see the CONTRIBUTORS file)
+  <parflow@lists.llnl.gov> CODE-OCEC-08-103. All rights reserved.
+
+  This file is part of Parflow. For details, see
+  http://www.llnl.gov/casc/parflow
+
+  Please read the COPYRIGHT file or Our Notice and the LICENSE file
+  for the GNU Lesser General Public License.
+
+  This program is free software; you can redistribute it and/or modify
+  it under the terms of the GNU General Public License (as published
+  by the Free Software Foundation) version 2.1 dated February 1999.
+
+  This program is distributed in the hope that it will be useful, but
+  WITHOUT ANY WARRANTY; without even the IMPLIED WARRANTY OF
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the terms
+  and conditions of the GNU General Public License for more details.
+
+  You should have received a copy of the GNU Lesser General Public
+  License along with this program; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307
+  USA
+**********************************************************************EHEADER*/
+
+/******************************************************************************
+ *
+ * Header info for the PFB read-ahead structure
+ *
+ *****************************************************************************/
+
+#ifndef _PFB_PREFETCH_HEADER
+#define _PFB_PREFETCH_HEADER
+
+#ifdef HAVE_PTHREAD
+#include <pthread.h>
+#endif
+
+#define PFBPrefetchMaxFiles 16
+
+/*--------------------------------------------------------------------------
+ * PFBPrefetchSlot:
+ *   One set of files being read ahead.  The key is chosen by the caller
+ *   (e.g. the time step the files belong to).
+ *--------------------------------------------------------------------------*/
+
+typedef struct
+{
+   int        key;
+   int        used;	/* files for key have been (or are being) read */
+   int        running;	/* the read thread has not been joined yet */
+
+   int        rank;
+   int        num_procs;
+   int        num_files;
+   char       filenames[PFBPrefetchMaxFiles][255];
+
+   /* the part of each file staged for this rank, NULL if none */
+   char      *buffers[PFBPrefetchMaxFiles];
+   long       starts[PFBPrefetchMaxFiles];	/* offset in the file */
+   long       sizes[PFBPrefetchMaxFiles];
+
+#ifdef HAVE_PTHREAD
+   pthread_t  thread;
+#endif
+
+} PFBPrefetchSlot;
+
+/*--------------------------------------------------------------------------
+ * PFBPrefetch:
+ *   A fixed number of slots, reused oldest key first.
+ *--------------------------------------------------------------------------*/
+
+typedef struct
+{
+   int               num_slots;
+   PFBPrefetchSlot  *slots;
+
+} PFBPrefetch;
+
+#endif
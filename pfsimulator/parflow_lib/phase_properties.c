@@ -0,0 +1,670 @@
+/*BHEADER**********************************************************************
+
+  Copyright (c) 1995-2009, Lawrence Livermore National Security,
+  LLC. Produced at the Lawrence Livermore National Laboratory. Written
+  by the Parflow Team (see the CONTRIBUTORS file)
+  <parflow@lists.llnl.gov> CODE-OCEC-08-103. All rights reserved.
+
+  This file is part of Parflow. For details, see
+  http://www.llnl.gov/casc/parflow
+
+  Please read the COPYRIGHT file or Our Notice and the LICENSE file
+  for the GNU Lesser General Public License.
+
+  This program is free software; you can redistribute it and/or modify
+  it under the terms of the GNU General Public License (as published
+  by the Free Software Foundation) version 2.1 dated February 1999.
+
+  This program is distributed in the hope that it will be useful, but
+  WITHOUT ANY WARRANTY; without even the IMPLIED WARRANTY OF
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the terms
+  and conditions of the GNU General Public License for more details.
+
+  You should have received a copy of the GNU Lesser General Public
+  License along with this program; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307
+  USA
+**********************************************************************EHEADER*/
+/******************************************************************************
+ *
+ * Fused evaluation of the pressure dependent phase properties.
+ *
+ * The nonlinear function and the Jacobian need the density, saturation
+ * and relative permeability (and their derivatives) of every cell.  Done
+ * by the PhaseDensity, Saturation and PhaseRelPerm modules each property
+ * and each derivative is a separate sweep over the grid, one region at a
+ * time.  When the standard models are selected (constant density or the
+ * density equation of state, Van Genuchten saturation and relative
+ * permeability with parameters given by region) the routines here
+ * compute them together:
+ *
+ *    PhaseStorageProperties   density, saturation and their derivatives
+ *    PhaseRelPermProperties   relative permeability and its derivative
+ *
+ * each in a single sweep, looking up the region of a cell in a region
+ * vector built once.  The relative permeability can not be part of the
+ * first sweep since it is evaluated on the pressure with the Dirichlet
+ * boundary values inserted.  The results are the same as the modules'.
+ *
+ * All the vectors passed must be on the same grid with a ghost layer of
+ * width 1.  The cells evaluated can be restricted (see the PhaseCells
+ * selections in phase_properties.h) so that the cells not depending on
+ * the ghost layer can be done while it is being exchanged.
+ *
+ *****************************************************************************/
+
+#include "parflow.h"
+
+#include <float.h>
+
+
+/*--------------------------------------------------------------------------
+ * NewPhaseProperties:
+ *   Returns NULL if the modules are not the standard models, the caller
+ *   then invokes the modules.
+ *--------------------------------------------------------------------------*/
+
+PhaseProperties  *NewPhaseProperties(
+PFModule         *density_module,
+PFModule         *saturation_module,
+PFModule         *rel_perm_module,
+ProblemData      *problem_data,
+Grid             *grid)
+{
+   PhaseProperties  *phase_properties;
+
+   GrGeomSolid      *gr_solid;
+
+   SubgridArray     *subgrids = GridSubgrids(grid);
+   Subgrid          *subgrid;
+   Subvector        *r_sub;
+
+   double           *rdat;
+
+   int               sat_num_regions, rel_perm_num_regions;
+   int              *sat_region_indices, *rel_perm_region_indices;
+   double           *sat_alphas, *sat_ns, *sat_s_ress, *sat_s_difs;
+   double           *rel_perm_alphas, *rel_perm_ns;
+   VanGTable       **sat_lookup_tables, **rel_perm_lookup_tables;
+
+   int               sg, ir, i, j, k, ir_index, r;
+   int               ix, iy, iz;
+   int               nx, ny, nz;
+
+   if ( !SaturationVanGParameters(saturation_module, 
+				  &sat_num_regions, &sat_region_indices,
+				  &sat_alphas, &sat_ns, 
+				  &sat_s_ress, &sat_s_difs,
+				  &sat_lookup_tables) )
+      return NULL;
+
+   if ( !PhaseRelPermVanGParameters(rel_perm_module, 
+				    &rel_perm_num_regions, 
+				    &rel_perm_region_indices,
+				    &rel_perm_alphas, &rel_perm_ns,
+				    &rel_perm_lookup_tables) )
+      return NULL;
+
+   phase_properties = ctalloc(PhaseProperties, 1);
+
+   PhaseDensityConstants(density_module, 0, 
+			 &(phase_properties -> reference_density),
+			 &(phase_properties -> compressibility_constant));
+
+   (phase_properties -> sat_num_regions)   = sat_num_regions;
+   (phase_properties -> sat_alphas)        = sat_alphas;
+   (phase_properties -> sat_ns)            = sat_ns;
+   (phase_properties -> sat_s_ress)        = sat_s_ress;
+   (phase_properties -> sat_s_difs)        = sat_s_difs;
+   (phase_properties -> sat_lookup_tables) = sat_lookup_tables;
+
+   (phase_properties -> rel_perm_num_regions)    = rel_perm_num_regions;
+   (phase_properties -> rel_perm_region_indices) = rel_perm_region_indices;
+   (phase_properties -> rel_perm_alphas)         = rel_perm_alphas;
+   (phase_properties -> rel_perm_ns)             = rel_perm_ns;
+   (phase_properties -> rel_perm_lookup_tables)  = rel_perm_lookup_tables;
+
+   /* The saturation is evaluated on the subgrids */
+   (phase_properties -> sat_regions) = 
+      NewVectorType(grid, 1, 1, vector_cell_centered);
+   InitVectorAll(phase_properties -> sat_regions, -1.0);
+
+   for (ir = 0; ir < sat_num_regions; ir++)
+   {
+      gr_solid = ProblemDataGrSolid(problem_data, sat_region_indices[ir]);
+
+      ForSubgridI(sg, subgrids)
+      {
+	 subgrid = SubgridArraySubgrid(subgrids, sg);
+	 r_sub   = VectorSubvector(phase_properties -> sat_regions, sg);
+
+	 ix = SubgridIX(subgrid);
+	 iy = SubgridIY(subgrid);
+	 iz = SubgridIZ(subgrid);
+
+	 nx = SubgridNX(subgrid);
+	 ny = SubgridNY(subgrid);
+	 nz = SubgridNZ(subgrid);
+
+	 r  = SubgridRX(subgrid);
+
+	 rdat = SubvectorData(r_sub);
+
+	 GrGeomInLoop(i, j, k, gr_solid, r, ix, iy, iz, nx, ny, nz,
+	 {
+	    ir_index = SubvectorEltIndex(r_sub, i, j, k);
+	    rdat[ir_index] = ir;
+	 });
+      }
+   }
+
+   /* The relative permeability is evaluated on the subgrids and the ghost
+      layer */
+   (phase_properties -> rel_perm_regions) = 
+      NewVectorType(grid, 1, 1, vector_cell_centered);
+   InitVectorAll(phase_properties -> rel_perm_regions, -1.0);
+
+   for (ir = 0; ir < rel_perm_num_regions; ir++)
+   {
+      gr_solid = ProblemDataGrSolid(problem_data, rel_perm_region_indices[ir]);
+
+      ForSubgridI(sg, subgrids)
+      {
+	 subgrid = SubgridArraySubgrid(subgrids, sg);
+	 r_sub   = VectorSubvector(phase_properties -> rel_perm_regions, sg);
+
+	 ix = SubgridIX(subgrid) - 1;
+	 iy = SubgridIY(subgrid) - 1;
+	 iz = SubgridIZ(subgrid) - 1;
+
+	 nx = SubgridNX(subgrid) + 2;
+	 ny = SubgridNY(subgrid) + 2;
+	 nz = SubgridNZ(subgrid) + 2;
+
+	 r  = SubgridRX(subgrid);
+
+	 rdat = SubvectorData(r_sub);
+
+	 GrGeomInLoop(i, j, k, gr_solid, r, ix, iy, iz, nx, ny, nz,
+	 {
+	    ir_index = SubvectorEltIndex(r_sub, i, j, k);
+	    rdat[ir_index] = ir;
+	 });
+      }
+   }
+
+   return phase_properties;
+}
+
+
+/*--------------------------------------------------------------------------
+ * FreePhaseProperties
+ *--------------------------------------------------------------------------*/
+
+void  FreePhaseProperties(
+PhaseProperties  *phase_properties)
+{
+   if (phase_properties)
+   {
+      FreeVector(phase_properties -> sat_regions);
+      FreeVector(phase_properties -> rel_perm_regions);
+
+      tfree(phase_properties);
+   }
+}
+
+
+/*--------------------------------------------------------------------------
+ * RelPermCell:
+ *   Van Genuchten relative permeability, and its derivative if rel_perm_der
+ *   is not NULL, of a cell in region ir.
+ *--------------------------------------------------------------------------*/
+
+static void RelPermCell(
+PhaseProperties  *phase_properties,
+int               ir,
+double            pressure,
+double            density,
+double            gravity,
+double           *rel_perm,
+double           *rel_perm_der)
+{
+   VanGTable  *lookup_table = (phase_properties -> rel_perm_lookup_tables[ir]);
+   double      alpha, n, m, head, opahn, ahnm1, coeff;
+
+   if (pressure >= 0.0)
+   {
+      (*rel_perm) = 1.0;
+      if (rel_perm_der)
+	 (*rel_perm_der) = 0.0;
+      return;
+   }
+
+   head = fabs(pressure)/(density*gravity);
+
+   if (lookup_table)
+   {
+      (*rel_perm) = VanGLookup(head, lookup_table, CALCFCN);
+      if (rel_perm_der)
+	 (*rel_perm_der) = VanGLookup(head, lookup_table, CALCDER);
+      return;
+   }
+
+   alpha = (phase_properties -> rel_perm_alphas[ir]);
+   n     = (phase_properties -> rel_perm_ns[ir]);
+   m     = 1.0e0 - (1.0e0/n);
+
+   opahn = 1.0 + pow(alpha*head,n);
+   ahnm1 = pow(alpha*head,n-1);
+
+   (*rel_perm) = pow(1.0 - ahnm1/(pow(opahn,m)),2)
+                 /pow(opahn,(m/2));
+
+   if (rel_perm_der)
+   {
+      coeff = 1.0 - ahnm1*pow(opahn,-m);
+
+      (*rel_perm_der) = 2.0*(coeff/(pow(opahn,(m/2))))
+	                *((n-1)*pow(alpha*head,n-2)*alpha
+			*pow(opahn,-m)
+			- ahnm1*m*pow(opahn,-(m+1))*n*alpha*ahnm1)
+                        + pow(coeff,2)*(m/2)*pow(opahn,(-(m+2)/2))
+                        *n*alpha*ahnm1;
+   }
+}
+
+
+/*--------------------------------------------------------------------------
+ * PhaseCellsWidths:
+ *   The number of layers the subgrid is grown by to get the box of the
+ *   cells selected and, if a hole is cut out of this box (the return
+ *   value is then 1), to get the hole.  Negative numbers shrink.
+ *--------------------------------------------------------------------------*/
+
+static int  PhaseCellsWidths(
+int         cells,
+int        *outer,
+int        *inner)
+{
+   switch(cells)
+   {
+      case PhaseCellsSubgrid:
+	 (*outer) = 0;
+	 return 0;
+      case PhaseCellsGhost:
+	 (*outer) = 1;
+	 (*inner) = 0;
+	 return 1;
+      case PhaseCellsCore:
+	 (*outer) = -1;
+	 return 0;
+      case PhaseCellsNotCore:
+	 (*outer) = 1;
+	 (*inner) = -1;
+	 return 1;
+      default:
+	 (*outer) = 1;
+	 return 0;
+   }
+}
+
+
+/*--------------------------------------------------------------------------
+ * PhaseCellsBoxes:
+ *   The (at most 6) boxes, as {ix, iy, iz, nx, ny, nz}, covering the
+ *   cells of the subgrid given by the cell selection.  Returns their
+ *   number.
+ *--------------------------------------------------------------------------*/
+
+int         PhaseCellsBoxes(
+int         cells,
+Subgrid    *subgrid,
+int         boxes[6][6])
+{
+   int      box[6], hole[6];
+   int      outer, inner, d;
+
+   box[0] = SubgridIX(subgrid);
+   box[1] = SubgridIY(subgrid);
+   box[2] = SubgridIZ(subgrid);
+   box[3] = SubgridNX(subgrid);
+   box[4] = SubgridNY(subgrid);
+   box[5] = SubgridNZ(subgrid);
+
+   if (PhaseCellsWidths(cells, &outer, &inner))
+   {
+      for (d = 0; d < 3; d++)
+      {
+	 hole[d]   = box[d] - inner;
+	 hole[d+3] = box[d+3] + 2*inner;
+      }
+   }
+   else
+   {
+      hole[3] = 0;
+   }
+
+   for (d = 0; d < 3; d++)
+   {
+      box[d]   -= outer;
+      box[d+3] += 2*outer;
+      if (box[d+3] <= 0)
+	 return 0;
+   }
+
+   if (hole[3] <= 0 || hole[4] <= 0 || hole[5] <= 0)
+   {
+      for (d = 0; d < 6; d++)
+	 boxes[0][d] = box[d];
+      return 1;
+   }
+
+   return SubtractBox(box, hole, boxes);
+}
+
+
+/*--------------------------------------------------------------------------
+ * InPhaseCells:
+ *   Whether cell (i, j, k) is in the cells of the subgrid given by the
+ *   cell selection.
+ *--------------------------------------------------------------------------*/
+
+int         InPhaseCells(
+int         cells,
+Subgrid    *subgrid,
+int         i,
+int         j,
+int         k)
+{
+   int      outer, inner, in_hole;
+
+   in_hole = PhaseCellsWidths(cells, &outer, &inner);
+
+#define InGrownSubgrid(w) \
+   ( i >= SubgridIX(subgrid) - (w) && i < SubgridIX(subgrid) + SubgridNX(subgrid) + (w) && \
+     j >= SubgridIY(subgrid) - (w) && j < SubgridIY(subgrid) + SubgridNY(subgrid) + (w) && \
+     k >= SubgridIZ(subgrid) - (w) && k < SubgridIZ(subgrid) + SubgridNZ(subgrid) + (w) )
+
+   if (in_hole)
+      in_hole = InGrownSubgrid(inner);
+
+   return (InGrownSubgrid(outer) && !in_hole);
+
+#undef InGrownSubgrid
+}
+
+
+/*--------------------------------------------------------------------------
+ * PhaseStorageProperties:
+ *   Density, saturation and, if density_der and saturation_der are not
+ *   NULL, their derivatives with respect to pressure in the cells
+ *   selected.  This gives what the PhaseDensity and Saturation modules
+ *   give.
+ *--------------------------------------------------------------------------*/
+
+void     PhaseStorageProperties(
+PhaseProperties  *phase_properties,
+Vector           *pressure,
+Vector           *density,
+Vector           *density_der,
+Vector           *saturation,
+Vector           *saturation_der,
+double            gravity,
+int               cells)
+{
+   Grid          *grid = VectorGrid(pressure);
+
+   Subgrid       *subgrid;
+   Subvector     *p_sub;
+
+   double        *pp, *dp, *ddp, *sp, *sdp, *rp;
+
+   double         ref  = (phase_properties -> reference_density);
+   double         comp = (phase_properties -> compressibility_constant);
+
+   double        *alphas        = (phase_properties -> sat_alphas);
+   double        *ns            = (phase_properties -> sat_ns);
+   double        *s_ress        = (phase_properties -> sat_s_ress);
+   double        *s_difs        = (phase_properties -> sat_s_difs);
+   VanGTable    **lookup_tables = (phase_properties -> sat_lookup_tables);
+
+   double         rho, drho, e, head, alpha, n, m, s_dif, ahn;
+
+   int            sg, ir;
+   int            boxes[6][6], num_boxes, b;
+   int            ix, iy, iz;
+   int            nx, ny, nz;
+   int            nx_p, ny_p;
+   int            i, j, k, ip;
+
+   ForSubgridI(sg, GridSubgrids(grid))
+   {
+      subgrid = GridSubgrid(grid, sg);
+
+      p_sub = VectorSubvector(pressure, sg);
+
+      nx_p = SubvectorNX(p_sub);
+      ny_p = SubvectorNY(p_sub);
+
+      num_boxes = PhaseCellsBoxes(cells, subgrid, boxes);
+
+      for (b = 0; b < num_boxes; b++)
+      {
+	 ix = boxes[b][0];
+	 iy = boxes[b][1];
+	 iz = boxes[b][2];
+
+	 nx = boxes[b][3];
+	 ny = boxes[b][4];
+	 nz = boxes[b][5];
+
+	 pp  = SubvectorElt(p_sub, ix, iy, iz);
+	 dp  = SubvectorElt(VectorSubvector(density, sg), ix, iy, iz);
+	 sp  = SubvectorElt(VectorSubvector(saturation, sg), ix, iy, iz);
+	 rp  = SubvectorElt(VectorSubvector(phase_properties -> sat_regions, sg),
+			    ix, iy, iz);
+	 ddp = (density_der) ? 
+	    SubvectorElt(VectorSubvector(density_der, sg), ix, iy, iz) : NULL;
+	 sdp = (saturation_der) ? 
+	    SubvectorElt(VectorSubvector(saturation_der, sg), ix, iy, iz) : NULL;
+
+	 ip = 0;
+	 BoxLoopI1(i, j, k, ix, iy, iz, nx, ny, nz,
+		   ip, nx_p, ny_p, SubvectorNZ(p_sub), 1, 1, 1,
+	 {
+	    if (comp == 0.0)
+	    {
+	       rho  = ref;
+	       drho = 0.0;
+	    }
+	    else
+	    {
+	       e    = exp(pp[ip] * comp);
+	       rho  = ref * e;
+	       drho = comp * ref * e;
+	    }
+
+	    dp[ip] = rho;
+	    if (ddp)
+	       ddp[ip] = drho;
+
+	    ir = (int) rp[ip];
+
+	    if (ir < 0)
+	    {
+	       sp[ip] = -FLT_MAX;
+	       if (sdp)
+		  sdp[ip] = -FLT_MAX;
+	    }
+	    else if (pp[ip] >= 0.0)
+	    {
+	       sp[ip] = s_difs[ir] + s_ress[ir];
+	       if (sdp)
+		  sdp[ip] = 0.0;
+	    }
+	    else
+	    {
+	       head  = fabs(pp[ip])/(rho*gravity);
+	       s_dif = s_difs[ir];
+
+	       if (lookup_tables[ir])
+	       {
+		  sp[ip] = s_dif * VanGLookup(head, lookup_tables[ir], CALCFCN)
+			   + s_ress[ir];
+		  if (sdp)
+		     sdp[ip] = s_dif * VanGLookup(head, lookup_tables[ir], CALCDER);
+	       }
+	       else
+	       {
+		  alpha = alphas[ir];
+		  n     = ns[ir];
+		  m     = 1.0e0 - (1.0e0/n);
+
+		  ahn    = pow(alpha*head,n);
+		  sp[ip] = s_dif / pow(1.0 + ahn,m) + s_ress[ir];
+		  if (sdp)
+		     sdp[ip] = (m*n*alpha*pow(alpha*head,(n-1)))*s_dif
+			       /(pow(1.0 + ahn,m+1));
+	       }
+	    }
+	 });
+      }
+   }
+}
+
+
+/*--------------------------------------------------------------------------
+ * PhaseRelPermProperties:
+ *   Relative permeability and, if rel_perm_der is not NULL, its derivative
+ *   with respect to pressure.  This gives what the PhaseRelPerm module
+ *   gives: cells in a region (including the ghost layer) are evaluated in
+ *   the region and the cells across the region boundaries that are in no
+ *   region in the boundary region.
+ *   Only the cells selected are set.
+ *--------------------------------------------------------------------------*/
+
+void     PhaseRelPermProperties(
+PhaseProperties  *phase_properties,
+Vector           *pressure,
+Vector           *density,
+Vector           *rel_perm,
+Vector           *rel_perm_der,
+double            gravity,
+ProblemData      *problem_data,
+int               cells)
+{
+   Grid          *grid = VectorGrid(pressure);
+
+   GrGeomSolid   *gr_solid;
+
+   Subgrid       *subgrid;
+   Subvector     *p_sub;
+
+   double        *pp, *dp, *krp, *dkrp, *rp;
+
+   int           *region_indices = (phase_properties -> rel_perm_region_indices);
+
+   int            sg, ir, r;
+   int            boxes[6][6], num_boxes, b;
+   int            ix, iy, iz;
+   int            nx, ny, nz;
+   int            nx_p, ny_p;
+   int            i, j, k, ip;
+   int           *fdir;
+
+   /* Cells in a region */
+   ForSubgridI(sg, GridSubgrids(grid))
+   {
+      subgrid = GridSubgrid(grid, sg);
+
+      p_sub = VectorSubvector(pressure, sg);
+
+      nx_p = SubvectorNX(p_sub);
+      ny_p = SubvectorNY(p_sub);
+
+      num_boxes = PhaseCellsBoxes(cells, subgrid, boxes);
+
+      for (b = 0; b < num_boxes; b++)
+      {
+	 ix = boxes[b][0];
+	 iy = boxes[b][1];
+	 iz = boxes[b][2];
+
+	 nx = boxes[b][3];
+	 ny = boxes[b][4];
+	 nz = boxes[b][5];
+
+	 pp   = SubvectorElt(p_sub, ix, iy, iz);
+	 dp   = SubvectorElt(VectorSubvector(density, sg), ix, iy, iz);
+	 krp  = SubvectorElt(VectorSubvector(rel_perm, sg), ix, iy, iz);
+	 rp   = SubvectorElt(VectorSubvector(phase_properties -> rel_perm_regions,
+					     sg), ix, iy, iz);
+	 dkrp = (rel_perm_der) ? 
+	    SubvectorElt(VectorSubvector(rel_perm_der, sg), ix, iy, iz) : NULL;
+
+	 ip = 0;
+	 BoxLoopI1(i, j, k, ix, iy, iz, nx, ny, nz,
+		   ip, nx_p, ny_p, SubvectorNZ(p_sub), 1, 1, 1,
+	 {
+	    ir = (int) rp[ip];
+
+	    if (ir < 0)
+	    {
+	       krp[ip] = 0.0;
+	       if (dkrp)
+		  dkrp[ip] = 0.0;
+	    }
+	    else
+	    {
+	       RelPermCell(phase_properties, ir, pp[ip], dp[ip], gravity,
+			   &krp[ip], (dkrp) ? &dkrp[ip] : NULL);
+	    }
+	 });
+      }
+   }
+
+   /* Cells across the region boundaries, for Dirichlet boundary 
+      conditions */
+   for (ir = 0; ir < (phase_properties -> rel_perm_num_regions); ir++)
+   {
+      gr_solid = ProblemDataGrSolid(problem_data, region_indices[ir]);
+
+      ForSubgridI(sg, GridSubgrids(grid))
+      {
+	 subgrid = GridSubgrid(grid, sg);
+
+	 p_sub = VectorSubvector(pressure, sg);
+
+	 ix = SubgridIX(subgrid);
+	 iy = SubgridIY(subgrid);
+	 iz = SubgridIZ(subgrid);
+
+	 nx = SubgridNX(subgrid);
+	 ny = SubgridNY(subgrid);
+	 nz = SubgridNZ(subgrid);
+
+	 r  = SubgridRX(subgrid);
+
+	 pp   = SubvectorData(p_sub);
+	 dp   = SubvectorData(VectorSubvector(density, sg));
+	 krp  = SubvectorData(VectorSubvector(rel_perm, sg));
+	 rp   = SubvectorData(VectorSubvector(phase_properties -> 
+					      rel_perm_regions, sg));
+	 dkrp = (rel_perm_der) ? 
+	    SubvectorData(VectorSubvector(rel_perm_der, sg)) : NULL;
+
+	 GrGeomSurfLoop(i, j, k, fdir, gr_solid, r, ix, iy, iz, 
+			nx, ny, nz,
+	 {
+	    ip = SubvectorEltIndex(p_sub, i+fdir[0], j+fdir[1], k+fdir[2]);
+
+	    if (rp[ip] < 0.0 && 
+		InPhaseCells(cells, subgrid, i+fdir[0], j+fdir[1], k+fdir[2]))
+	    {
+	       RelPermCell(phase_properties, ir, pp[ip], dp[ip], gravity,
+			   &krp[ip], (dkrp) ? &dkrp[ip] : NULL);
+	    }
+	 });
+      }
+   }
+}
@@ -0,0 +1,86 @@
+/*BHEADER**********************************************************************
+
+  Copyright (c) 1995-2009, Lawrence Livermore National Security,
+  LLC. Produced at the Lawrence Livermore National Laboratory. Written
+  by the Parflow Team (see the CONTRIBUTORS file)
+  <parflow@lists.llnl.gov> CODE-OCEC-08-103. All rights reserved.
+
+  This file is part of Parflow. For details, see
+  http://www.llnl.gov/casc/parflow
+
+  Please read the COPYRIGHT file or Our Notice and the LICENSE file
+  for the GNU Lesser General Public License.
+
+  This program is free software; you can redistribute it and/or modify
+  it under the terms of the GNU General Public License (as published
+  by the Free Software Foundation) version 2.1 dated February 1999.
+
+  This program is distributed in the hope that it will be useful, but
+  WITHOUT ANY WARRANTY; without even the IMPLIED WARRANTY OF
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the terms
+  and conditions of the GNU General Public License for more details.
+
+  You should have received a copy of the GNU Lesser General Public
+  License along with this program; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307
+  USA
+**********************************************************************EHEADER*/
+/******************************************************************************
+ *
+ * Header info for the fused phase property evaluation
+ *
+ *****************************************************************************/
+
+#ifndef _PHASE_PROPERTIES_HEADER
+#define _PHASE_PROPERTIES_HEADER
+
+/*--------------------------------------------------------------------------
+ * PhaseProperties:
+ *   The parameters of the density, saturation and relative permeability
+ *   modules when these are the standard models (constant density or the
+ *   density equation of state, Van Genuchten saturation and relative
+ *   permeability given by region), so the properties of a cell can be
+ *   evaluated together instead of by separate module sweeps.
+ *
+ *   The region vectors hold the index (into the region arrays) of the
+ *   region each cell is evaluated in by the modules, or -1.  When regions
+ *   overlap this is the last one, as in the modules.
+ *--------------------------------------------------------------------------*/
+
+typedef struct
+{
+   double      reference_density;
+   double      compressibility_constant;
+
+   int         sat_num_regions;
+   double     *sat_alphas;
+   double     *sat_ns;
+   double     *sat_s_ress;
+   double     *sat_s_difs;
+   VanGTable **sat_lookup_tables;
+   Vector     *sat_regions;
+
+   int         rel_perm_num_regions;
+   int        *rel_perm_region_indices;
+   double     *rel_perm_alphas;
+   double     *rel_perm_ns;
+   VanGTable **rel_perm_lookup_tables;
+   Vector     *rel_perm_regions;
+
+} PhaseProperties;
+
+/*--------------------------------------------------------------------------
+ * Cell selections for PhaseStorageProperties and PhaseRelPermProperties.
+ *
+ *   The core of a subgrid is the subgrid less its boundary layer.  These
+ *   cells are not sent to the neighbors by a VectorUpdateAll update, so
+ *   they may be written while the update is in progress.
+ *--------------------------------------------------------------------------*/
+
+#define PhaseCellsAll      0   /* subgrid and ghost layer */
+#define PhaseCellsSubgrid  1   /* subgrid */
+#define PhaseCellsGhost    2   /* ghost layer */
+#define PhaseCellsCore     3   /* subgrid core */
+#define PhaseCellsNotCore  4   /* subgrid and ghost layer less the core */
+
+#endif
@@ -31,6 +31,7 @@
 
 #include "parflow.h"
 
+#include <string.h>
 
 /*--------------------------------------------------------------------------
  * Structures
@@ -50,8 +51,145 @@ typedef struct
    double     ***elevations;
    ProblemData  *problem_data;
    Grid         *grid;
+
+   /* Patch values read from file (types 4, 5 and 8) and the file each
+      patch's values were read from */
+   double     ***file_values;
+   char        **file_names;
+   int           file_num_patches;
+   int           file_num_subgrids;
 } InstanceXtra;
 
+/*--------------------------------------------------------------------------
+ * BCPressureFileValues:
+ *   Values of the cells of patch ipatch read from a PFB file, in the
+ *   order of BCStructPatchLoop on each subgrid.  The values are kept
+ *   until the patch's file name changes, i.e. the file is read once per
+ *   time cycle interval rather than on every call.  Only the bounding
+ *   box of the patch cells on each subgrid is read from the file.
+ *--------------------------------------------------------------------------*/
+
+static double  **BCPressureFileValues(
+   InstanceXtra *instance_xtra,
+   BCStruct     *bc_struct,
+   Grid         *grid,
+   int           num_patches,
+   int           ipatch,
+   char         *filename)
+{
+   SubgridArray   *subgrids = GridSubgrids(grid);
+   SubgridArray   *all_slabs;
+   SubgridArray   *slabs;
+   Subgrid        *subgrid;
+   Subgrid        *slab;
+
+   Grid           *slab_grid;
+   Vector         *slab_vector;
+   Subvector      *subvector;
+   double         *data;
+
+   double        **patch_values;
+   int             patch_values_size;
+
+   int            *fdir;
+   int             lo[3], hi[3];
+   int             i, j, k, ival, is;
+
+   if (instance_xtra -> file_values == NULL)
+   {
+      instance_xtra -> file_values       = ctalloc(double **, num_patches);
+      instance_xtra -> file_names        = ctalloc(char *, num_patches);
+      instance_xtra -> file_num_patches  = num_patches;
+      instance_xtra -> file_num_subgrids = SubgridArraySize(subgrids);
+   }
+
+   if ( (instance_xtra -> file_names[ipatch]) &&
+	(strcmp(instance_xtra -> file_names[ipatch], filename) == 0) )
+   {
+      return instance_xtra -> file_values[ipatch];
+   }
+
+   if (instance_xtra -> file_values[ipatch])
+   {
+      ForSubgridI(is, subgrids)
+      {
+	 tfree(instance_xtra -> file_values[ipatch][is]);
+      }
+      tfree(instance_xtra -> file_values[ipatch]);
+      tfree(instance_xtra -> file_names[ipatch]);
+   }
+
+   /* Bounding box of the patch cells on each subgrid.  A subgrid
+      without cells of the patch gets a single cell box. */
+   all_slabs = NewSubgridArray();
+   ForSubgridI(is, subgrids)
+   {
+      subgrid = SubgridArraySubgrid(subgrids, is);
+
+      lo[0] = lo[1] = lo[2] = INT_MAX;
+      hi[0] = hi[1] = hi[2] = INT_MIN;
+      BCStructPatchLoop(i, j, k, fdir, ival, bc_struct, ipatch, is,
+      {
+	 lo[0] = pfmin(lo[0], i);
+	 lo[1] = pfmin(lo[1], j);
+	 lo[2] = pfmin(lo[2], k);
+	 hi[0] = pfmax(hi[0], i);
+	 hi[1] = pfmax(hi[1], j);
+	 hi[2] = pfmax(hi[2], k);
+      });
+
+      if (lo[0] > hi[0])
+      {
+	 lo[0] = hi[0] = SubgridIX(subgrid);
+	 lo[1] = hi[1] = SubgridIY(subgrid);
+	 lo[2] = hi[2] = SubgridIZ(subgrid);
+      }
+
+      slab = DuplicateSubgrid(subgrid);
+      SubgridIX(slab) = lo[0];
+      SubgridIY(slab) = lo[1];
+      SubgridIZ(slab) = lo[2];
+      SubgridNX(slab) = hi[0] - lo[0] + 1;
+      SubgridNY(slab) = hi[1] - lo[1] + 1;
+      SubgridNZ(slab) = hi[2] - lo[2] + 1;
+      AppendSubgrid(slab, all_slabs);
+   }
+   slabs = GetGridSubgrids(all_slabs);
+
+   slab_grid   = NewGrid(slabs, all_slabs);
+   slab_vector = NewVector(slab_grid, 1, 0);
+
+   ReadPFBinarySubset(filename, slab_vector);
+
+   patch_values = ctalloc(double *, SubgridArraySize(subgrids));
+   ForSubgridI(is, subgrids)
+   {
+      patch_values_size = 0;
+      BCStructPatchLoop(i, j, k, fdir, ival, bc_struct, ipatch, is,
+      {
+	 patch_values_size++;
+      });
+
+      patch_values[is] = ctalloc(double, patch_values_size);
+
+      subvector = VectorSubvector(slab_vector, is);
+      data      = SubvectorData(subvector);
+      BCStructPatchLoop(i, j, k, fdir, ival, bc_struct, ipatch, is,
+      {
+	 patch_values[is][ival] = data[SubvectorEltIndex(subvector, i, j, k)];
+      });
+   }
+
+   FreeVector(slab_vector);
+   FreeGrid(slab_grid);
+
+   instance_xtra -> file_values[ipatch] = patch_values;
+   instance_xtra -> file_names[ipatch]  = ctalloc(char, strlen(filename) + 1);
+   strcpy(instance_xtra -> file_names[ipatch], filename);
+
+   return patch_values;
+}
+
 /*--------------------------------------------------------------------------
  * BCPressure:
  *   This routine returns a BCStruct structure which describes where
@@ -676,38 +814,21 @@ BCStruct    *BCPressure(
          {
 	    /* Read input pressures from file (temporary).
 	       This case assumes hydraulic head input conditions and 
-	       a constant density.  */
+	       a constant density.  The density*gravity*z term was taken
+	       out, the file values are used as is. */
 
 	    BCPressureType4 *bc_pressure_type4;
-	    Vector          *tmp_vector;
-	    Subvector       *subvector;
-	    char            *filename;
-	    double          *tmpp;
-	    int              itmp;
-	    double           z, dz2;
-	    double           density, dtmp;
-	    
-	    double           gravity = ProblemGravity(problem);
-
-	    /* Calculate density using dtmp as dummy argument. */
-	    dtmp = 0.0;
-	    PFModuleInvokeType(PhaseDensityInvoke, phase_density,
-			   (0, NULL, NULL, &dtmp, &density, CALCFCN));
+	    double         **file_values;
 
 	    bc_pressure_type4 = (BCPressureType4*)BCPressureDataIntervalValue(
                                    bc_pressure_data,ipatch,interval_number);
 
+	    file_values = BCPressureFileValues(instance_xtra, bc_struct, grid,
+				 num_patches, ipatch,
+				 BCPressureType4FileName(bc_pressure_type4));
+
 	    ForSubgridI(is, subgrids)
 	    {
-	       subgrid = SubgridArraySubgrid(subgrids, is);
-
-               z_mult_sub = VectorSubvector(z_mult, is);
-               rsz_sub = VectorSubvector(rsz, is);
-               z_mult_dat = SubvectorData(z_mult_sub);
-               rsz_dat = SubvectorData(rsz_sub);
-
-	       dz2  = SubgridDZ(subgrid) / 2.0;
-
 	       /* compute patch_values_size (this isn't really needed yet) */
 	       patch_values_size = 0;
 	       BCStructPatchLoop(i, j, k, fdir, ival, bc_struct, ipatch, is,
@@ -718,27 +839,8 @@ BCStruct    *BCPressure(
 	       patch_values = ctalloc(double, patch_values_size);
 	       values[ipatch][is] = patch_values;
 
-               tmp_vector = NewVectorType(grid, 1, 0, vector_cell_centered);
-
-               filename = BCPressureType4FileName(bc_pressure_type4);
-               ReadPFBinary(filename, tmp_vector);
-
-               subvector = VectorSubvector(tmp_vector, is);
-
-               tmpp = SubvectorData(subvector);
-               BCStructPatchLoop(i, j, k, fdir, ival, bc_struct, ipatch, is,
-               {
-                  ips = SubvectorEltIndex(z_mult_sub, i,j,k);
-                  z = rsz_dat[ips] + fdir[2]*dz2*z_mult_dat[ips];
-                  itmp = SubvectorEltIndex(subvector, i, j, k);
-
-                  patch_values[ival] = tmpp[itmp]; /*- density*gravity*z;*/
-                  /*last part taken out, very likely to be a bug)*/
-
-               });
-
-               FreeVector(tmp_vector);
-
+	       memcpy(patch_values, file_values[is], 
+		      (size_t)patch_values_size*sizeof(double));
 	    }           /* End subgrid loop */
 	    break;
 	 }
@@ -747,15 +849,15 @@ BCStruct    *BCPressure(
 	 {
 	    /* Read input fluxes from file (temporary) */
 	    BCPressureType5 *bc_pressure_type5;
-	    Vector          *tmp_vector;
-	    Subvector       *subvector;
-	    char            *filename;
-	    double          *tmpp;
-	    int              itmp;
+	    double         **file_values;
 	    
 	    bc_pressure_type5 = (BCPressureType5*)BCPressureDataIntervalValue(
                                    bc_pressure_data,ipatch,interval_number);
 
+	    file_values = BCPressureFileValues(instance_xtra, bc_struct, grid,
+				 num_patches, ipatch,
+				 BCPressureType5FileName(bc_pressure_type5));
+
 	    ForSubgridI(is, subgrids)
 	    {
 	       /* compute patch_values_size (this isn't really needed yet) */
@@ -768,22 +870,8 @@ BCStruct    *BCPressure(
 	       patch_values = ctalloc(double, patch_values_size);
 	       values[ipatch][is] = patch_values;
 
-               tmp_vector = NewVectorType(grid, 1, 0, vector_cell_centered);
-
-               filename = BCPressureType5FileName(bc_pressure_type5);
-               ReadPFBinary(filename, tmp_vector);
-
-               subvector = VectorSubvector(tmp_vector, is);
-
-               tmpp = SubvectorData(subvector);
-               BCStructPatchLoop(i, j, k, fdir, ival, bc_struct, ipatch, is,
-               {
-                  itmp = SubvectorEltIndex(subvector, i, j, k);
-
-                  patch_values[ival] = tmpp[itmp];
-               });
-
-               FreeVector(tmp_vector);
+	       memcpy(patch_values, file_values[is], 
+		      (size_t)patch_values_size*sizeof(double));
 	    }       /* End subgrid loop */
 	    break;
 	 }
@@ -953,16 +1041,14 @@ BCStruct    *BCPressure(
              {
                  /* Read input fluxes from file (overland) */
                  BCPressureType8 *bc_pressure_type8;
-                 Vector          *tmp_vector;
-                 Subvector       *subvector;
-                 //double          *data;
-                 char            *filename;
-                 double          *tmpp;
-                 int              itmp;
-                 double           dtmp;
+                 double         **file_values;
                  
                  bc_pressure_type8 = (BCPressureType8*)BCPressureDataIntervalValue(bc_pressure_data,ipatch,interval_number);
                  
+                 file_values = BCPressureFileValues(instance_xtra, bc_struct, grid,
+                                      num_patches, ipatch,
+                                      BCPressureType8FileName(bc_pressure_type8));
+                 
                  ForSubgridI(is, subgrids)
                  {
                      /* compute patch_values_size (this isn't really needed yet) */
@@ -975,26 +1061,8 @@ BCStruct    *BCPressure(
                      patch_values = ctalloc(double, patch_values_size);
                      values[ipatch][is] = patch_values;
                      
-                     tmp_vector = NewVectorType(grid, 1, 0, vector_cell_centered);
-                     //data = ctalloc(double, SizeOfVector(tmp_vector));
-                     //SetTempVectorData(tmp_vector, data);
-                     
-                     printf("reading overland file \n");
-                     filename = BCPressureType8FileName(bc_pressure_type8);
-                     ReadPFBinary(filename, tmp_vector);
-                     
-                     subvector = VectorSubvector(tmp_vector, is);
-                     
-                     tmpp = SubvectorData(subvector);
-                     BCStructPatchLoop(i, j, k, fdir, ival, bc_struct, ipatch, is,
-                                       {
-                                           itmp = SubvectorEltIndex(subvector, i, j, k);
-                                           
-                                           patch_values[ival] = tmpp[itmp];
-                                       });
-                     
-                     //tfree(VectorData(tmp_vector));
-                     FreeVector(tmp_vector);
+                     memcpy(patch_values, file_values[is], 
+                            (size_t)patch_values_size*sizeof(double));
                  }       /* End subgrid loop */
                  break;
              }
@@ -1082,6 +1150,24 @@ void BCPressureFreeInstanceXtra()
 
 	 tfree(instance_xtra -> elevations);
       }
+
+      if(instance_xtra -> file_values) {
+	 int ipatch;
+	 int is;
+
+	 for (ipatch = 0; ipatch < instance_xtra -> file_num_patches; ipatch++) {
+	    if(instance_xtra -> file_values[ipatch]) {
+	       for (is = 0; is < instance_xtra -> file_num_subgrids; is++) {
+		  tfree(instance_xtra -> file_values[ipatch][is]);
+	       }
+	       tfree(instance_xtra -> file_values[ipatch]);
+	       tfree(instance_xtra -> file_names[ipatch]);
+	    }
+	 }
+
+	 tfree(instance_xtra -> file_values);
+	 tfree(instance_xtra -> file_names);
+      }
       PFModuleFreeInstance(instance_xtra -> phase_density);
       tfree(instance_xtra);
    }
@@ -270,6 +270,44 @@ void    PhaseDensity(
    }         /* End switch */
 }
 
+/*--------------------------------------------------------------------------
+ * PhaseDensityConstants:
+ *   Get the reference density and compressibility constant of a phase so
+ *   the density can be evaluated outside the module.  A constant density
+ *   has compressibility constant 0.
+ *--------------------------------------------------------------------------*/
+
+void    PhaseDensityConstants(
+   PFModule *density_module,           /* A PhaseDensity module */
+   int       phase,                    /* Phase */
+   double   *reference_density,        /* Return reference density */
+   double   *compressibility_constant) /* Return compressibility constant */
+{
+   PublicXtra    *public_xtra = (PublicXtra *)PFModulePublicXtra(density_module);
+
+   Type0         *dummy0;
+   Type1         *dummy1;
+
+   switch((public_xtra -> type[phase]))
+   {
+   case 0:
+   {
+      dummy0 = (Type0 *)(public_xtra -> data[phase]);
+      (*reference_density)        = (dummy0 -> constant);
+      (*compressibility_constant) = 0.0;
+      break;
+   }
+
+   case 1:
+   {
+      dummy1 = (Type1 *)(public_xtra -> data[phase]);
+      (*reference_density)        = (dummy1 -> reference_density);
+      (*compressibility_constant) = (dummy1 -> compressibility_constant);
+      break;
+   }
+   }
+}
+
 /*--------------------------------------------------------------------------
  * PhaseDensityInitInstanceXtra
  *--------------------------------------------------------------------------*/
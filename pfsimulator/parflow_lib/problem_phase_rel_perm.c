@@ -61,26 +61,6 @@ typedef struct
 } Type0;
 
 
-typedef struct {
-   double min_pressure_head;
-   int    num_sample_points;
-
-   double *x;
-   double *a;
-   double *d;
-   double *a_der;
-   double *d_der;
-
-   /* used by linear interpolation method */
-   double *slope;
-   double *slope_der;
-
-   int interpolation_method;
-
-   double interval;
-  
-} VanGTable;
-
 typedef struct
 {
    int     num_regions;
@@ -95,6 +75,14 @@ typedef struct
 
    VanGTable **lookup_tables;
 
+   /* lookup tables for parameters from files */
+   int          num_sample_points;
+   double       min_pressure_head;
+   int          interpolation_method;
+   int          num_classes;
+   double       max_n_error;
+   VanGClasses *classes;
+
 #ifdef PF_PRINT_VG_TABLE
    int     *print_table;
 #endif
@@ -124,266 +112,39 @@ typedef struct
 } Type4;                      /* Polynomial Function for Rel. Perm. */
 
 
-VanGTable *VanGComputeTable(
-   int interpolation_method,
-   int num_sample_points,
-   double min_pressure_head,
+/*--------------------------------------------------------------------------
+ * VanGRelPerm:
+ *    Van Genuchten relative permeability and its derivative with respect
+ *    to the pressure head magnitude, used to fill the lookup tables.
+ *--------------------------------------------------------------------------*/
+
+static double VanGRelPerm(
+   double head,
    double alpha,
-   double n)
+   double n,
+   int    fcn)
 {
-   double *x,*a,*d,*a_der,*d_der;
-   
-   VanGTable *new_table = ctalloc(VanGTable, 1);
-
-   new_table -> interpolation_method = interpolation_method;
-
-   new_table -> num_sample_points = num_sample_points;
-   new_table -> min_pressure_head = min_pressure_head;
-
-   new_table -> x = ctalloc(double, num_sample_points+1);// interpolation points
-   new_table -> a = ctalloc(double, num_sample_points+1);// function value at interpolation point
-   new_table -> d = ctalloc(double, num_sample_points+1);// derivative used in monotonic spline
-   new_table -> a_der = ctalloc(double, num_sample_points+1);// function derivative value
-   new_table -> d_der = ctalloc(double, num_sample_points+1);// derivative of function derivative
+   double m, opahn, ahnm1, coeff;
 
-   /* Fill in slope for linear interpolation */
-   if(interpolation_method == 1) {
-      new_table -> slope     = ctalloc(double, num_sample_points+1);// slope for linear interpolation
-      new_table -> slope_der = ctalloc(double, num_sample_points+1);// slope for linear interpolation
-   }
- 
-   x = new_table -> x;
-   a = new_table -> a;
-   d = new_table -> d;
-   a_der = new_table -> a_der;
-   d_der = new_table -> d_der;
-
-   double h[num_sample_points+1];
-   double f[num_sample_points+1],del[num_sample_points+1],f_der[num_sample_points+1];
-   double del_der[num_sample_points+1];
-   double alph, beta, magn;
-   int index;
-   double interval,m,opahn,ahnm1,coeff;
-   
-   // Loop over sample min_pressure_head to 0.0, min_pressure_head/num_sample_points step
-   interval = min_pressure_head/(double)(num_sample_points - 1);
-   new_table -> interval = fabs(interval);
    m        = 1.0e0 - (1.0e0/n);
+   opahn    = 1.0 + pow(alpha*head,n);
+   ahnm1    = pow(alpha*head,n-1);
 
-   // evenly spaced interpolation points (future: variably spaced points)
-   for(index = 0; index <= num_sample_points; index++)
-   {
-      x[index]   = fabs(index*interval); 
-      opahn      = 1.0 + pow(alpha*x[index],n);
-      ahnm1      = pow(alpha*x[index],n-1);
-      // calculating function at interpolation points
-      a[index]   = pow(1.0 - ahnm1/(pow(opahn,m)),2)
-			   /pow(opahn,(m/2));
-
-      coeff    = 1.0 - ahnm1*pow(opahn,-m);
-      // calculating derivative at interpolation points
-      a_der[index] = 2.0*(coeff/(pow(opahn,(m/2))))
-		         *((n-1)*pow(alpha*x[index],n-2)*alpha
-		         *pow(opahn,-m)
-		         - ahnm1*m*pow(opahn,-(m+1))*n*alpha*ahnm1)
-			 + pow(coeff,2)*(m/2)*pow(opahn,(-(m+2)/2))
-	                 *n*alpha*ahnm1;
-    //CPS fix of 1<n<2, K is infinite at pressure head = 0
-   if ((n < 2) && (index == 0)) {
-     a_der[index] = 0;
-   }
-
-   }
-
-   /* Fill in slope for linear interpolation */
-   if(interpolation_method == 1) {
-      for(index = 0; index < num_sample_points; index++) 
-      {
-	 new_table -> slope[index]     = (a[index+1] - a[index]) / 
-	    new_table -> interval;
-	 new_table -> slope_der[index] = (a_der[index+1] - a_der[index]) / 
-	    new_table -> interval;
-      }
-   }
+   if ( fcn == CALCFCN )
+      return pow(1.0 - ahnm1/(pow(opahn,m)),2)
+	 /pow(opahn,(m/2));
 
-   // begin monotonic spline (see Fritsch and Carlson, SIAM J. Num. Anal., 17 (2), 1980)
-   for(index = 0; index < num_sample_points; index++)
-   {
-      h[index] = x[index + 1] - x[index];
-      f[index] = a[index + 1] - a[index];
-      del[index] = f[index]/h[index]; 
-      f_der[index] = a_der[index + 1] - a_der[index];
-      del_der[index] = f_der[index]/h[index];
-   }
-   d[0] = del[0];
-   d[num_sample_points] = del[num_sample_points - 1];
-   d_der[0] = del_der[0];
-   d_der[num_sample_points] = del_der[num_sample_points - 1];
-
-   for(index = 1; index < num_sample_points; index++)
-   {
-      d[index] = (del[index - 1] + del[index])/2;
-      d_der[index] = (del_der[index - 1] + del_der[index])/2;
-   }
-
-
-   for(index = 0; index < num_sample_points; index++)
-   {
-      if(del[index] == 0.0)   
-      {
-         d[index] = 0;
-         d[index+1] = 0;
-      }
-      else
-      {
-         alph = d[index]/del[index];
-         beta = d[index+1]/del[index];
-         magn = pow(alph,2) + pow(beta,2);
-         if(magn > 9.0)
-         {
-            d[index] = 3*alph*del[index]/magn;
-            d[index+1] = 3*beta*del[index]/magn;
-         }
-      }
-
-      if(del_der[index] == 0.0)   
-      {
-         d_der[index] = 0;
-         d_der[index+1] = 0;
-      }
-      else
-      {
-	 // to ensure monotonicity
-         alph = d_der[index]/del_der[index];
-         beta = d_der[index+1]/del_der[index];
-         magn = pow(alph,2) + pow(beta,2);
-         if(magn > 9.0)
-         {
-            d_der[index] = 3*alph*del_der[index]/magn;
-            d_der[index+1] = 3*beta*del_der[index]/magn;
-         }
-      }
-   }
-   return new_table;
-}
-		      
-
-static inline double VanGLookupSpline(
-   double pressure_head,
-   VanGTable *lookup_table,
-   int fcn)
-{
-   double rel_perm, t;
-   int pt = 0;
-   int num_sample_points = lookup_table -> num_sample_points;
-   double min_pressure_head = lookup_table -> min_pressure_head;
-   int max = num_sample_points +1;
-
-   // This table goes from 0 to fabs(min_pressure_head)
-   assert(pressure_head >= 0);
-
-   // SGS TODO add warning in output?
-   // Make sure values are in the table range, if lower then set to the 0.0 which is limit of VG curve
-   if(pressure_head >= fabs(min_pressure_head)){
+   //CPS fix of 1<n<2, K is infinite at pressure head = 0
+   if ((n < 2) && (head == 0.0))
       return 0.0;
-   } else {
-
-      // Use direct table lookup to avoid using this binary search since
-      // we have uniformly spaced points.
-      double interval = lookup_table -> interval;
-      pt = (int)floor(pressure_head / interval);
-      if(pt > max) {
-	 pt = max-1;
-      }
-
-#if 0
-      // When using variably spaced interpolation points, use binary
-      // search to find the interval
-      {
-	 int min = 0;
-	 int mid;
-	 
-	 while(max != min+1){
-	    mid = min + floor((max - min)/2);
-	    if(pressure_head == lookup_table -> x[mid]){
-	       min = mid;
-	       max = min+1;
-	    }
-	    if(pressure_head < lookup_table -> x[mid]){
-	       max = mid;
-	    } else {
-	       min = mid;
-	    }
-	 }
-	 pt = min;
-      }
-#endif 
-   }
-
-   double x = lookup_table -> x[pt];
-   double a = lookup_table -> a[pt];
-   double d = lookup_table -> d[pt];
-   double a_der = lookup_table -> a_der[pt];
-   double d_der = lookup_table -> d_der[pt];
-
-   // using cubic Hermite interpolation
-   if(fcn == CALCFCN){
-      t = (pressure_head - x)/(lookup_table -> x[pt+1] - x);
-      rel_perm = (2.0*pow(t,3) - 3.0*pow(t,2) + 1.0)*a 
-	 + (pow(t,3) - 2.0*pow(t,2) + t)
-	 *(lookup_table -> x[pt+1] - x)*d + (-2.0*pow(t,3)
-					     + 3.0*pow(t,2))*(lookup_table -> a[pt+1])
-	 +(pow(t,3) - pow(t,2))*(lookup_table -> x[pt+1] - x)
-	 *(lookup_table -> d[pt+1]);
-   } else {
-      t = (pressure_head - x)/(lookup_table -> x[pt+1] - x);
-      rel_perm = (2.0*pow(t,3) - 3.0*pow(t,2) + 1.0)*a_der 
-	 + (pow(t,3) - 2.0*pow(t,2) + t)
-	 *(lookup_table -> x[pt+1] - x)*d_der + (-2.0*pow(t,3)
-						 + 3.0*pow(t,2))*(lookup_table -> a_der[pt+1])
-	 +(pow(t,3) - pow(t,2))*(lookup_table -> x[pt+1] - x)
-	 *(lookup_table -> d_der[pt+1]);
-   }
-
-   return rel_perm;
-}
-
-static inline double VanGLookupLinear(
-   double pressure_head,
-   VanGTable *lookup_table,
-   int fcn)
-{
-   double rel_perm = 0.0;
-   int pt = 0;
-   int num_sample_points = lookup_table -> num_sample_points;
-   double min_pressure_head = lookup_table -> min_pressure_head;
-   int max = num_sample_points +1;
-
-   // This table goes from 0 to fabs(min_pressure_head)
-   assert(pressure_head >= 0);
-
-   // SGS TODO add warning in output?
-   // Make sure values are in the table range, if lower then set to the 0.0 which is limit of VG curve
-   if(pressure_head < fabs(min_pressure_head)){
-      double interval = lookup_table -> interval;
-
-      // Use direct table lookup to avoid using this binary search since
-      // we have uniformly spaced points.
-
-      pt = (int)floor(pressure_head / interval);
-      assert(pt < max);
-
-      // using cubic Hermite interpolation
-
 
-      if(fcn == CALCFCN) {
-	 rel_perm = lookup_table -> a[pt] + lookup_table -> slope[pt] * (pressure_head - lookup_table -> x[pt]);
-      } else {
-	 rel_perm = lookup_table -> a_der[pt] + lookup_table -> slope_der[pt] * (pressure_head - lookup_table -> x[pt]);
-      }
-   }
-
-   return rel_perm;
+   coeff    = 1.0 - ahnm1*pow(opahn,-m);
+   return 2.0*(coeff/(pow(opahn,(m/2))))
+      *((n-1)*pow(alpha*head,n-2)*alpha
+	*pow(opahn,-m)
+	- ahnm1*m*pow(opahn,-(m+1))*n*alpha*ahnm1)
+      + pow(coeff,2)*(m/2)*pow(opahn,(-(m+2)/2))
+      *n*alpha*ahnm1;
 }
 		     
 
@@ -427,6 +188,7 @@ int          fcn)            /* Flag determining what to calculate
 
    double        *prdat, *ppdat, *pddat;
    double        *n_values_dat, *alpha_values_dat;
+   double        *class_dat;
 
    SubgridArray  *subgrids = GridSubgrids(grid);
 
@@ -564,6 +326,8 @@ int          fcn)            /* Flag determining what to calculate
 
       Vector  *n_values, *alpha_values;
 
+      VanGTable  **class_tables;
+
       dummy1 = (Type1 *)(public_xtra -> data);
 
       num_regions    = (dummy1 -> num_regions);
@@ -907,6 +671,7 @@ int          fcn)            /* Flag determining what to calculate
 	 gr_solid = ProblemDataGrDomain(problem_data);
 	 n_values = dummy1->n_values;
 	 alpha_values = dummy1->alpha_values;
+	 class_tables = (dummy1->classes) ? dummy1->classes->tables : NULL;
 
 	 ForSubgridI(sg, subgrids)
 	 {
@@ -936,6 +701,11 @@ int          fcn)            /* Flag determining what to calculate
 	    n_values_dat = SubvectorData(n_values_sub);
 	    alpha_values_dat = SubvectorData(alpha_values_sub);
 
+	    /* the class vector has the layout of n_values */
+	    class_dat = (dummy1->classes) ? 
+	       SubvectorData(VectorSubvector(dummy1->classes->class_values, sg))
+	       : NULL;
+
 	    if ( fcn == CALCFCN )
 	    {
 	       GrGeomSurfLoop(i, j, k, fdir, gr_solid, r, ix, iy, iz, 
@@ -953,6 +723,14 @@ int          fcn)            /* Flag determining what to calculate
 
 		  if (ppdat[ipp] >= 0.0)
 		     prdat[ipr] = 1.0;
+		  else if (class_dat && class_dat[n_index] >= 0.0)
+		  {
+		     alpha      = alpha_values_dat[alpha_index];
+		     head       = fabs(ppdat[ipp])/(pddat[ipd]*gravity);
+		     prdat[ipr] = VanGLookup(alpha*head, 
+					     class_tables[(int)class_dat[n_index]],
+					     CALCFCN);
+		  }
 		  else
 		  {
 		     alpha      = alpha_values_dat[alpha_index];
@@ -984,6 +762,14 @@ int          fcn)            /* Flag determining what to calculate
 
 		  if (ppdat[ipp] >= 0.0)
 		     prdat[ipr] = 0.0;
+		  else if (class_dat && class_dat[n_index] >= 0.0)
+		  {
+		     alpha      = alpha_values_dat[alpha_index];
+		     head       = fabs(ppdat[ipp])/(pddat[ipd]*gravity);
+		     prdat[ipr] = alpha*VanGLookup(alpha*head, 
+					     class_tables[(int)class_dat[n_index]],
+					     CALCDER);
+		  }
 		  else
 		  {
 		     alpha    = alpha_values_dat[alpha_index];
@@ -1238,6 +1024,7 @@ int          fcn)            /* Flag determining what to calculate
          gr_solid = ProblemDataGrDomain(problem_data);
 	 n_values = dummy1->n_values;
 	 alpha_values = dummy1->alpha_values;
+	 class_tables = (dummy1->classes) ? dummy1->classes->tables : NULL;
 
 	 ForSubgridI(sg, subgrids)
 	 {
@@ -1267,6 +1054,11 @@ int          fcn)            /* Flag determining what to calculate
 	    n_values_dat = SubvectorData(n_values_sub);
 	    alpha_values_dat = SubvectorData(alpha_values_sub);
 
+	    /* the class vector has the layout of n_values */
+	    class_dat = (dummy1->classes) ? 
+	       SubvectorData(VectorSubvector(dummy1->classes->class_values, sg))
+	       : NULL;
+
 	    if ( fcn == CALCFCN )
 	    {
 	       GrGeomInLoop(i, j, k, gr_solid, r, ix, iy, iz, nx, ny, nz,
@@ -1280,6 +1072,14 @@ int          fcn)            /* Flag determining what to calculate
 
 		  if (ppdat[ipp] >= 0.0)
 		     prdat[ipr] = 1.0;
+		  else if (class_dat && class_dat[n_index] >= 0.0)
+		  {
+		     alpha      = alpha_values_dat[alpha_index];
+		     head       = fabs(ppdat[ipp])/(pddat[ipd]*gravity);
+		     prdat[ipr] = VanGLookup(alpha*head, 
+					     class_tables[(int)class_dat[n_index]],
+					     CALCFCN);
+		  }
 		  else
 		  {
 		     alpha      = alpha_values_dat[alpha_index];
@@ -1307,6 +1107,14 @@ int          fcn)            /* Flag determining what to calculate
 
 		  if (ppdat[ipp] >= 0.0)
 		     prdat[ipr] = 0.0;
+		  else if (class_dat && class_dat[n_index] >= 0.0)
+		  {
+		     alpha      = alpha_values_dat[alpha_index];
+		     head       = fabs(ppdat[ipp])/(pddat[ipd]*gravity);
+		     prdat[ipr] = alpha*VanGLookup(alpha*head, 
+					     class_tables[(int)class_dat[n_index]],
+					     CALCDER);
+		  }
 		  else
 		  {
 		     alpha    = alpha_values_dat[alpha_index];
@@ -1664,6 +1472,42 @@ int          fcn)            /* Flag determining what to calculate
 
 
 
+/*--------------------------------------------------------------------------
+ * PhaseRelPermVanGParameters:
+ *   Get the Van Genuchten parameters of a PhaseRelPerm module so the
+ *   relative permeability can be evaluated outside the module.  Returns 0
+ *   if the module is not Van Genuchten with parameters given by region.
+ *--------------------------------------------------------------------------*/
+
+int          PhaseRelPermVanGParameters(
+PFModule    *rel_perm_module, /* A PhaseRelPerm module */
+int         *num_regions,
+int        **region_indices,
+double     **alphas,
+double     **ns,
+VanGTable ***lookup_tables)   /* NULL entries for regions without one */
+{
+   PublicXtra    *public_xtra = (PublicXtra *)PFModulePublicXtra(rel_perm_module);
+
+   Type1         *dummy1;
+
+   if ( (public_xtra -> type) != 1 )
+      return 0;
+
+   dummy1 = (Type1 *)(public_xtra -> data);
+
+   if ( (dummy1 -> data_from_file) != 0 )
+      return 0;
+
+   (*num_regions)    = (dummy1 -> num_regions);
+   (*region_indices) = (dummy1 -> region_indices);
+   (*alphas)         = (dummy1 -> alphas);
+   (*ns)             = (dummy1 -> ns);
+   (*lookup_tables)  = (dummy1 -> lookup_tables);
+
+   return 1;
+}
+
 /*--------------------------------------------------------------------------
  * PhaseRelPermInitInstanceXtra
  *--------------------------------------------------------------------------*/
@@ -1695,6 +1539,13 @@ PFModule  *PhaseRelPermInitInstanceXtra(
 	 dummy1 = (Type1 *)(public_xtra -> data);
          if ((dummy1->data_from_file) == 1)
 	 {
+	    /* free old data */
+	    if (dummy1 -> n_values)
+	    {
+	       FreeVector(dummy1 -> alpha_values);
+	       FreeVector(dummy1 -> n_values);
+	    }
+
 	    (dummy1 -> n_values) = NewVectorType(grid, 1, 1, vector_cell_centered);
 	    (dummy1 -> alpha_values) = NewVectorType(grid, 1, 1, vector_cell_centered);
 
@@ -1707,6 +1558,21 @@ PFModule  *PhaseRelPermInitInstanceXtra(
 			 (dummy1 ->n_values));
             handle = InitVectorUpdate(dummy1 ->n_values, VectorUpdateAll);
             FinalizeVectorUpdate(handle);
+
+	    if (dummy1 -> num_sample_points)
+	    {
+	       FreeVanGClasses(dummy1 -> classes);
+	       dummy1 -> classes = NewVanGClasses(
+		  "Geom.domain.RelPerm",
+		  dummy1 -> alpha_values,
+		  dummy1 -> n_values,
+		  dummy1 -> num_classes,
+		  dummy1 -> max_n_error,
+		  dummy1 -> interpolation_method,
+		  dummy1 -> num_sample_points,
+		  dummy1 -> min_pressure_head,
+		  VanGRelPerm);
+	    }
 	 }
       }
 
@@ -1729,11 +1595,30 @@ PFModule  *PhaseRelPermInitInstanceXtra(
 void  PhaseRelPermFreeInstanceXtra()
 {
    PFModule      *this_module   = ThisPFModule;
+   PublicXtra    *public_xtra   = (PublicXtra *)PFModulePublicXtra(this_module);
    InstanceXtra  *instance_xtra = (InstanceXtra *)PFModuleInstanceXtra(this_module);
 
+   Type1         *dummy1;
 
    if (instance_xtra)
    {
+      /* the parameter fields are on this instance's grid, which may be
+	 freed before the public data */
+      if ( (instance_xtra -> grid) != NULL && (public_xtra -> type) == 1 )
+      {
+	 dummy1 = (Type1 *)(public_xtra -> data);
+	 if ( (dummy1 -> data_from_file) == 1 && (dummy1 -> n_values) )
+	 {
+	    FreeVector(dummy1 -> alpha_values);
+	    FreeVector(dummy1 -> n_values);
+	    FreeVanGClasses(dummy1 -> classes);
+
+	    dummy1 -> alpha_values = NULL;
+	    dummy1 -> n_values     = NULL;
+	    dummy1 -> classes      = NULL;
+	 }
+      }
+
       tfree(instance_xtra);
    }
 }
@@ -1865,12 +1750,16 @@ PFModule   *PhaseRelPermNewPublicXtra()
 
 		  NA_FreeNameArray(type_na);
 
-		  dummy1 -> lookup_tables[ir] = VanGComputeTable(
+		  dummy1 -> lookup_tables[ir] = NewVanGTable(
 		     interpolation_method,
 		     num_sample_points,
 		     min_pressure_head,
 		     dummy1 -> alphas[ir],
-		     dummy1 -> ns[ir]);
+		     dummy1 -> ns[ir],
+		     VanGRelPerm);
+
+		  sprintf(key, "Geom.%s.RelPerm", region);
+		  LogVanGTable(key, dummy1 -> lookup_tables[ir]);
 				     
 	       } else {
 		  dummy1 -> lookup_tables[ir] = NULL;
@@ -1890,6 +1779,48 @@ PFModule   *PhaseRelPermNewPublicXtra()
 	    dummy1->alpha_file = GetString(key);
 	    sprintf(key, "Geom.%s.RelPerm.N.Filename", "domain");
 	    dummy1->n_file = GetString(key);
+
+	    /* the tables are built by class of n once the files are read */
+	    sprintf(key, "Geom.%s.RelPerm.NumSamplePoints", "domain");
+	    dummy1->num_sample_points = GetIntDefault(key, 0);
+
+	    if (dummy1->num_sample_points)
+	    {
+	       sprintf(key, "Geom.%s.RelPerm.MinPressureHead", "domain");
+	       dummy1->min_pressure_head = GetDouble(key);
+
+	       type_na = NA_NewNameArray("Spline Linear");
+
+	       sprintf(key, "Geom.%s.RelPerm.InterpolationMethod", "domain");
+	       switch_name = GetStringDefault(key, "Spline");
+	       dummy1->interpolation_method = NA_NameToIndex(type_na, switch_name);
+
+	       if (dummy1->interpolation_method < 0)
+	       {
+		  InputError("Error: invalid type <%s> for key <%s>\n",
+			     switch_name, key);
+	       }
+
+	       NA_FreeNameArray(type_na);
+
+	       sprintf(key, "Geom.%s.RelPerm.NumClasses", "domain");
+	       dummy1->num_classes = GetIntDefault(key, 32);
+
+	       if (dummy1->num_classes < 1)
+	       {
+		  InputError("Error: the key <%s> must be at least 1%s\n",
+			     key, "");
+	       }
+
+	       sprintf(key, "Geom.%s.RelPerm.MaxNError", "domain");
+	       dummy1->max_n_error = GetDoubleDefault(key, 0.001);
+
+	       if (dummy1->max_n_error < 0.0)
+	       {
+		  InputError("Error: the key <%s> must not be negative%s\n",
+			     key, "");
+	       }
+	    }
 	      
 	    dummy1->num_regions = 0;
 	    dummy1->region_indices = NULL;
@@ -2041,10 +1972,11 @@ void  PhaseRelPermFreePublicXtra()
      {
         dummy1 = (Type1 *)(public_xtra -> data);
 
-	if (dummy1->data_from_file == 1)
+	if (dummy1->data_from_file == 1 && dummy1->n_values)
 	{
 	   FreeVector(dummy1->alpha_values);
 	   FreeVector(dummy1->n_values);
+	   FreeVanGClasses(dummy1->classes);
 	}
 
 	tfree(dummy1 -> region_indices);
@@ -2054,18 +1986,7 @@ void  PhaseRelPermFreePublicXtra()
 	num_regions = (dummy1 -> num_regions);
 	for (ir = 0; ir < num_regions; ir++)
 	{
-	   if(dummy1 -> lookup_tables[ir]) {
-	      tfree(dummy1 -> lookup_tables[ir] -> x);
-	      tfree(dummy1 -> lookup_tables[ir] -> a);
-	      tfree(dummy1 -> lookup_tables[ir] -> d);
-	      tfree(dummy1 -> lookup_tables[ir] -> a_der);
-	      tfree(dummy1 -> lookup_tables[ir] -> d_der);
-
-	      tfree(dummy1 -> lookup_tables[ir] -> slope);
-	      tfree(dummy1 -> lookup_tables[ir] -> slope_der);
-
-	      tfree(dummy1 -> lookup_tables[ir]);
-	   }
+	   FreeVanGTable(dummy1 -> lookup_tables[ir]);
 	}
 
 	tfree(dummy1 -> lookup_tables);
@@ -75,6 +75,16 @@ typedef struct
    Vector *n_values;
    Vector *s_res_values;
    Vector *s_sat_values;
+
+   VanGTable **lookup_tables;
+
+   /* lookup tables for parameters from files */
+   int          num_sample_points;
+   double       min_pressure_head;
+   int          interpolation_method;
+   int          num_classes;
+   double       max_n_error;
+   VanGClasses *classes;
 } Type1;                      /* Van Genuchten Saturation Curve */
 
 typedef struct
@@ -109,6 +119,27 @@ typedef struct
 } Type5;                      /* Spatially varying field over entire domain
                                  read from a file */
 
+/*--------------------------------------------------------------------------
+ * VanGSaturation:
+ *    Van Genuchten effective saturation and its derivative with respect
+ *    to the pressure head magnitude, used to fill the lookup tables.
+ *--------------------------------------------------------------------------*/
+
+static double VanGSaturation(
+   double head,
+   double alpha,
+   double n,
+   int    fcn)
+{
+   double m = 1.0e0 - (1.0e0/n);
+
+   if ( fcn == CALCFCN )
+      return 1.0 / pow(1.0 + pow((alpha*head),n),m);
+   else
+      return (m*n*alpha*pow(alpha*head,(n-1)))
+	 /(pow(1.0 + pow(alpha*head,n),m+1));
+}
+
 /*--------------------------------------------------------------------------
  * Saturation:
  *    This routine returns a Vector of saturations based on pressures.
@@ -152,6 +183,7 @@ int          fcn)               /* Flag determining what to calculate
    double        *psdat, *ppdat, *pddat, *satRFdat;
    double        *n_values_dat, *alpha_values_dat;
    double        *s_res_values_dat, *s_sat_values_dat;
+   double        *class_dat;
 
    SubgridArray  *subgrids = GridSubgrids(grid);
 
@@ -236,6 +268,9 @@ int          fcn)               /* Flag determining what to calculate
       double *alphas, *ns, *s_ress, *s_difs;
       double  head, alpha, n, s_res, s_dif, s_sat, m;
 
+      VanGTable **lookup_tables, *lookup_table;
+      VanGTable **class_tables;
+
       Vector *n_values, *alpha_values, *s_res_values, *s_sat_values;
 
       dummy1 = (Type1 *)(public_xtra -> data);
@@ -246,6 +281,7 @@ int          fcn)               /* Flag determining what to calculate
       ns             = (dummy1 -> ns);
       s_ress         = (dummy1 -> s_ress);
       s_difs         = (dummy1 -> s_difs);
+      lookup_tables  = (dummy1 -> lookup_tables);
       data_from_file = (dummy1 -> data_from_file);
 
       if (data_from_file == 0) /* Soil parameters given by region */
@@ -254,6 +290,8 @@ int          fcn)               /* Flag determining what to calculate
       {
 	 gr_solid = ProblemDataGrSolid(problem_data, region_indices[ir]);
 
+	 lookup_table = lookup_tables[ir];
+
 	 ForSubgridI(sg, subgrids)
 	 {
 	    subgrid = SubgridArraySubgrid(subgrids,     sg);
@@ -294,8 +332,12 @@ int          fcn)               /* Flag determining what to calculate
 		  else
 		  {
 		     head     = fabs(ppdat[ipp])/(pddat[ipd]*gravity);
-		     psdat[ips] = s_dif / pow(1.0 + pow((alpha*head),n),m)
-		                  + s_res;
+		     if (lookup_table)
+			psdat[ips] = s_dif * VanGLookup(head, lookup_table,
+							CALCFCN) + s_res;
+		     else
+			psdat[ips] = s_dif / pow(1.0 + pow((alpha*head),n),m)
+			             + s_res;
 		  }
 	       });
 	    }    /* End if clause */
@@ -318,8 +360,12 @@ int          fcn)               /* Flag determining what to calculate
 		  else
 		  {
 		     head     = fabs(ppdat[ipp])/(pddat[ipd]*gravity);
-		     psdat[ips] = (m*n*alpha*pow(alpha*head,(n-1)))*s_dif
-				        /(pow(1.0 + pow(alpha*head,n),m+1));
+		     if (lookup_table)
+			psdat[ips] = s_dif * VanGLookup(head, lookup_table,
+							CALCDER);
+		     else
+			psdat[ips] = (m*n*alpha*pow(alpha*head,(n-1)))*s_dif
+			             /(pow(1.0 + pow(alpha*head,n),m+1));
 		  }
 	       });
 	    }   /* End else clause */
@@ -333,6 +379,7 @@ int          fcn)               /* Flag determining what to calculate
 	 alpha_values = dummy1->alpha_values;
 	 s_res_values = dummy1->s_res_values;
 	 s_sat_values = dummy1->s_sat_values;
+	 class_tables = (dummy1->classes) ? dummy1->classes->tables : NULL;
 
 	 ForSubgridI(sg, subgrids)
 	 {
@@ -365,6 +412,11 @@ int          fcn)               /* Flag determining what to calculate
 	    s_res_values_dat = SubvectorData(s_res_values_sub);
 	    s_sat_values_dat = SubvectorData(s_sat_values_sub);
 
+	    /* the class vector has the layout of n_values */
+	    class_dat = (dummy1->classes) ? 
+	       SubvectorData(VectorSubvector(dummy1->classes->class_values, sg))
+	       : NULL;
+
 	    if ( fcn == CALCFCN )
 	    {
 	       GrGeomInLoop(i, j, k, gr_solid, r, ix, iy, iz, nx, ny, nz,
@@ -389,9 +441,15 @@ int          fcn)               /* Flag determining what to calculate
 		  else
 		  {
 		     head     = fabs(ppdat[ipp])/(pddat[ipd]*gravity);
-		     psdat[ips] = (s_sat - s_res) / 
-		                  pow(1.0 + pow((alpha*head),n),m)
-		                  + s_res;
+		     if (class_dat && class_dat[n_index] >= 0.0)
+			psdat[ips] = (s_sat - s_res) *
+			             VanGLookup(alpha*head, 
+					  class_tables[(int)class_dat[n_index]],
+					  CALCFCN) + s_res;
+		     else
+			psdat[ips] = (s_sat - s_res) / 
+			             pow(1.0 + pow((alpha*head),n),m)
+			             + s_res;
 		  }
 	       });
 	    }    /* End if clause */
@@ -420,8 +478,14 @@ int          fcn)               /* Flag determining what to calculate
 		  else
 		  {
 		     head     = fabs(ppdat[ipp])/(pddat[ipd]*gravity);
-		     psdat[ips] = (m*n*alpha*pow(alpha*head,(n-1)))*s_dif
-				        /(pow(1.0 + pow(alpha*head,n),m+1));
+		     if (class_dat && class_dat[n_index] >= 0.0)
+			psdat[ips] = s_dif * alpha *
+			             VanGLookup(alpha*head, 
+					  class_tables[(int)class_dat[n_index]],
+					  CALCDER);
+		     else
+			psdat[ips] = (m*n*alpha*pow(alpha*head,(n-1)))*s_dif
+			             /(pow(1.0 + pow(alpha*head,n),m+1));
 		  }
 	       });
 	    }   /* End else clause */
@@ -674,6 +738,46 @@ int          fcn)               /* Flag determining what to calculate
 
 }
 
+/*--------------------------------------------------------------------------
+ * SaturationVanGParameters:
+ *   Get the Van Genuchten parameters of a Saturation module so the
+ *   saturation can be evaluated outside the module.  Returns 0 if the
+ *   module is not the Van Genuchten curve with parameters given by region.
+ *--------------------------------------------------------------------------*/
+
+int          SaturationVanGParameters(
+PFModule    *saturation_module, /* A Saturation module */
+int         *num_regions,
+int        **region_indices,
+double     **alphas,
+double     **ns,
+double     **s_ress,
+double     **s_difs,
+VanGTable ***lookup_tables)     /* NULL entries for regions without one */
+{
+   PublicXtra    *public_xtra = (PublicXtra *)PFModulePublicXtra(saturation_module);
+
+   Type1         *dummy1;
+
+   if ( (public_xtra -> type) != 1 )
+      return 0;
+
+   dummy1 = (Type1 *)(public_xtra -> data);
+
+   if ( (dummy1 -> data_from_file) != 0 )
+      return 0;
+
+   (*num_regions)    = (dummy1 -> num_regions);
+   (*region_indices) = (dummy1 -> region_indices);
+   (*alphas)         = (dummy1 -> alphas);
+   (*ns)             = (dummy1 -> ns);
+   (*s_ress)         = (dummy1 -> s_ress);
+   (*s_difs)         = (dummy1 -> s_difs);
+   (*lookup_tables)  = (dummy1 -> lookup_tables);
+
+   return 1;
+}
+
 /*--------------------------------------------------------------------------
  * SaturationInitInstanceXtra
  *--------------------------------------------------------------------------*/
@@ -712,6 +816,9 @@ PFModule  *SaturationInitInstanceXtra(
 	       FreeVector(dummy1 -> alpha_values);
 	       FreeVector(dummy1 -> s_res_values);
 	       FreeVector(dummy1 -> s_sat_values);
+
+	       FreeVanGClasses(dummy1 -> classes);
+	       dummy1 -> classes = NULL;
 	    }
 	 }
 	 if (public_xtra -> type == 5)
@@ -766,6 +873,21 @@ PFModule  *SaturationInitInstanceXtra(
 			 (dummy1 ->s_res_values));
 	    ReadPFBinary((dummy1 ->s_sat_file), 
 			 (dummy1 ->s_sat_values));
+
+	    if (dummy1 -> num_sample_points)
+	    {
+	       FreeVanGClasses(dummy1 -> classes);
+	       dummy1 -> classes = NewVanGClasses(
+		  "Geom.domain.Saturation",
+		  dummy1 -> alpha_values,
+		  dummy1 -> n_values,
+		  dummy1 -> num_classes,
+		  dummy1 -> max_n_error,
+		  dummy1 -> interpolation_method,
+		  dummy1 -> num_sample_points,
+		  dummy1 -> min_pressure_head,
+		  VanGSaturation);
+	    }
 	 }
 	 
       }
@@ -790,11 +912,34 @@ PFModule  *SaturationInitInstanceXtra(
 void  SaturationFreeInstanceXtra()
 {
    PFModule      *this_module   = ThisPFModule;
+   PublicXtra    *public_xtra   = (PublicXtra *)PFModulePublicXtra(this_module);
    InstanceXtra  *instance_xtra = (InstanceXtra *)PFModuleInstanceXtra(this_module);
 
+   Type1         *dummy1;
 
    if (instance_xtra)
    {
+      /* the parameter fields are on this instance's grid, which may be
+	 freed before the public data */
+      if ( (instance_xtra -> grid) != NULL && (public_xtra -> type) == 1 )
+      {
+	 dummy1 = (Type1 *)(public_xtra -> data);
+	 if ( (dummy1 -> data_from_file) == 1 && (dummy1 -> n_values) )
+	 {
+	    FreeVector(dummy1 -> n_values);
+	    FreeVector(dummy1 -> alpha_values);
+	    FreeVector(dummy1 -> s_res_values);
+	    FreeVector(dummy1 -> s_sat_values);
+	    FreeVanGClasses(dummy1 -> classes);
+
+	    dummy1 -> n_values     = NULL;
+	    dummy1 -> alpha_values = NULL;
+	    dummy1 -> s_res_values = NULL;
+	    dummy1 -> s_sat_values = NULL;
+	    dummy1 -> classes      = NULL;
+	 }
+      }
+
       tfree(instance_xtra);
    }
 }
@@ -822,7 +967,10 @@ PFModule   *SaturationNewPublicXtra()
    
    char key[IDB_MAX_KEY_LEN];
 
-   NameArray type_na;
+   NameArray type_na, interp_na;
+
+   int    num_sample_points, interpolation_method;
+   double min_pressure_head;
 
    type_na = NA_NewNameArray("Constant VanGenuchten Haverkamp Data Polynomial PFBFile"); 
 
@@ -888,6 +1036,7 @@ PFModule   *SaturationNewPublicXtra()
 	    (dummy1 -> ns            ) = ctalloc(double, num_regions);
 	    (dummy1 -> s_ress        ) = ctalloc(double, num_regions);
 	    (dummy1 -> s_difs        ) = ctalloc(double, num_regions);
+	    (dummy1 -> lookup_tables ) = ctalloc(VanGTable *, num_regions);
 	 
 	    for (ir = 0; ir < num_regions; ir++)
 	    {
@@ -916,6 +1065,40 @@ PFModule   *SaturationNewPublicXtra()
 	       s_sat = GetDouble(key);
 	    
 	       (dummy1 -> s_difs[ir]) = s_sat - (dummy1 -> s_ress[ir]);
+
+	       sprintf(key, "Geom.%s.Saturation.NumSamplePoints", region);
+	       num_sample_points = GetIntDefault(key, 0);
+
+	       if (num_sample_points)
+	       {
+		  sprintf(key, "Geom.%s.Saturation.MinPressureHead", region);
+		  min_pressure_head = GetDouble(key);
+
+		  interp_na = NA_NewNameArray("Spline Linear");
+
+		  sprintf(key, "Geom.%s.Saturation.InterpolationMethod", region);
+		  switch_name = GetStringDefault(key, "Spline");
+		  interpolation_method = NA_NameToIndex(interp_na, switch_name);
+
+		  if (interpolation_method < 0)
+		  {
+		     InputError("Error: invalid type <%s> for key <%s>\n",
+				switch_name, key);
+		  }
+
+		  NA_FreeNameArray(interp_na);
+
+		  dummy1 -> lookup_tables[ir] = NewVanGTable(
+		     interpolation_method,
+		     num_sample_points,
+		     min_pressure_head,
+		     dummy1 -> alphas[ir],
+		     dummy1 -> ns[ir],
+		     VanGSaturation);
+
+		  sprintf(key, "Geom.%s.Saturation", region);
+		  LogVanGTable(key, dummy1 -> lookup_tables[ir]);
+	       }
 	    }
 
 	    dummy1->alpha_file = NULL;
@@ -937,6 +1120,49 @@ PFModule   *SaturationNewPublicXtra()
 	    dummy1->s_res_file = GetString(key);
 	    sprintf(key, "Geom.%s.Saturation.SSat.Filename", "domain");
 	    dummy1->s_sat_file = GetString(key);
+
+	    /* the tables are built by class of n once the files are read */
+	    sprintf(key, "Geom.%s.Saturation.NumSamplePoints", "domain");
+	    dummy1->num_sample_points = GetIntDefault(key, 0);
+
+	    if (dummy1->num_sample_points)
+	    {
+	       sprintf(key, "Geom.%s.Saturation.MinPressureHead", "domain");
+	       dummy1->min_pressure_head = GetDouble(key);
+
+	       interp_na = NA_NewNameArray("Spline Linear");
+
+	       sprintf(key, "Geom.%s.Saturation.InterpolationMethod", "domain");
+	       switch_name = GetStringDefault(key, "Spline");
+	       dummy1->interpolation_method = NA_NameToIndex(interp_na, 
+							     switch_name);
+
+	       if (dummy1->interpolation_method < 0)
+	       {
+		  InputError("Error: invalid type <%s> for key <%s>\n",
+			     switch_name, key);
+	       }
+
+	       NA_FreeNameArray(interp_na);
+
+	       sprintf(key, "Geom.%s.Saturation.NumClasses", "domain");
+	       dummy1->num_classes = GetIntDefault(key, 32);
+
+	       if (dummy1->num_classes < 1)
+	       {
+		  InputError("Error: the key <%s> must be at least 1%s\n",
+			     key, "");
+	       }
+
+	       sprintf(key, "Geom.%s.Saturation.MaxNError", "domain");
+	       dummy1->max_n_error = GetDoubleDefault(key, 0.001);
+
+	       if (dummy1->max_n_error < 0.0)
+	       {
+		  InputError("Error: the key <%s> must not be negative%s\n",
+			     key, "");
+	       }
+	    }
 	      
 	    dummy1->num_regions = 0;
 	    dummy1->region_indices = NULL;
@@ -944,6 +1170,7 @@ PFModule   *SaturationNewPublicXtra()
 	    dummy1->ns = NULL;
 	    dummy1->s_ress = NULL;
 	    dummy1->s_difs = NULL;
+	    dummy1->lookup_tables = NULL;
 	 }
 
 	 (public_xtra -> data) = (void *) dummy1;
@@ -1114,12 +1341,13 @@ void  SaturationFreePublicXtra()
      {
         dummy1 = (Type1 *)(public_xtra -> data);
 
-	if (dummy1->data_from_file == 1)
+	if (dummy1->data_from_file == 1 && dummy1->n_values)
 	{
 	   FreeVector(dummy1->alpha_values);
 	   FreeVector(dummy1->n_values);
 	   FreeVector(dummy1->s_res_values);
 	   FreeVector(dummy1->s_sat_values);
+	   FreeVanGClasses(dummy1->classes);
 	}
 
 	tfree(dummy1 -> region_indices);
@@ -1127,6 +1355,13 @@ void  SaturationFreePublicXtra()
 	tfree(dummy1 -> ns);
 	tfree(dummy1 -> s_ress);
 	tfree(dummy1 -> s_difs);
+
+	num_regions = (dummy1 -> num_regions);
+	for (ir = 0; ir < num_regions; ir++)
+	   FreeVanGTable(dummy1 -> lookup_tables[ir]);
+
+	tfree(dummy1 -> lookup_tables);
+
 	tfree(dummy1);
 
 	break;
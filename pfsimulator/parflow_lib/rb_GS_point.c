@@ -92,7 +92,7 @@ int    	 zero)
    int             ix, iy, iz;
    int             nx, ny, nz;
 
-   int             nx_m = 0, ny_m = 0, nz_m = 0;
+   int             nx_m = 0, ny_m = 0, nz_m = 0, sx_m = 1;
    int             nx_v = 0, ny_v = 0, nz_v = 0;
 
    int             sx, sy, sz;
@@ -182,6 +182,7 @@ int    	 zero)
 	       nx_m = SubmatrixNX(A_sub);
 	       ny_m = SubmatrixNY(A_sub);
 	       nz_m = SubmatrixNZ(A_sub);
+	       sx_m = SubmatrixStride(A_sub);
 
 	       nx_v = SubvectorNX(x_sub);
 	       ny_v = SubvectorNY(x_sub);
@@ -211,7 +212,7 @@ int    	 zero)
 	       iv = im = 0;
 	       BoxLoopI2(i, j, k, ix, iy, iz, nx, ny, nz,
 			 iv, nx_v, ny_v, nz_v, sx, sy, sz,
-			 im, nx_m, ny_m, nz_m, sx, sy, sz,
+			 im, nx_m*sx_m, ny_m, nz_m, sx*sx_m, sy, sz,
 			 {
 			    x0[iv] = bp[iv] / a0[im];
 			 });
@@ -276,6 +277,7 @@ int    	 zero)
 	       nx_m = SubmatrixNX(A_sub);
 	       ny_m = SubmatrixNY(A_sub);
 	       nz_m = SubmatrixNZ(A_sub);
+	       sx_m = SubmatrixStride(A_sub);
 
 	       nx_v = SubvectorNX(x_sub);
 	       ny_v = SubvectorNY(x_sub);
@@ -339,7 +341,7 @@ int    	 zero)
 	       iv = im = 0;
 	       BoxLoopI2(i, j, k, ix, iy, iz, nx, ny, nz,
 			 iv, nx_v, ny_v, nz_v, sx, sy, sz,
-			 im, nx_m, ny_m, nz_m, sx, sy, sz,
+			 im, nx_m*sx_m, ny_m, nz_m, sx*sx_m, sy, sz,
 			 {
 			    x0[iv] = (bp[iv] - (a1[im] * x1[iv] +
 						a2[im] * x2[iv] +
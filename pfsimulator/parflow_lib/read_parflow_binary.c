@@ -47,8 +47,9 @@ Subgrid        *subgrid)
    int             nx_v = SubvectorNX(subvector);
    int             ny_v = SubvectorNY(subvector);
 
-   int             i, j, k, ai;
+   int             j, k, ai, bi, n;
    double         *data;
+   double         *buffer;
 
    (void)subgrid;
 
@@ -66,15 +67,549 @@ Subgrid        *subgrid)
 
    data = SubvectorElt(subvector, ix, iy, iz);
 
-   ai = 0;
-   BoxLoopI1(i, j, k,
-	     ix, iy, iz, nx, ny, nz,
-	     ai, nx_v, ny_v, nz_v, 1, 1, 1,
-	     {
-		amps_ReadDouble(file, &data[ai], 1);
-	     });
+   /* Read the whole subgrid block with one call and scatter it into the
+      subvector one x-pencil at a time */
+   n = nx*ny*nz;
+   buffer = talloc(double, n);
+
+   amps_ReadDouble(file, buffer, n);
+
+   bi = 0;
+   for(k = 0; k < nz; k++)
+   {
+      for(j = 0; j < ny; j++)
+      {
+	 ai = (k*ny_v + j)*nx_v;
+	 memcpy(data + ai, buffer + bi, (size_t)nx*sizeof(double));
+	 bi += nx;
+      }
+   }
+
+   tfree(buffer);
+}
+
+
+/*--------------------------------------------------------------------------
+ * PFB subgrid index.
+ *
+ *   Rank 0 walks the subgrid headers in the file, seeking over the data,
+ *   and broadcasts the header ints and data offset of every block.  A
+ *   file is either a single PFB file (with or without a .dist file) or,
+ *   with AMPS_SPLIT_FILE, one part file per writing process named
+ *   <filename>.<part> with the PFB header at the start of part 0.
+ *--------------------------------------------------------------------------*/
+
+#define PFBLayoutSingle  0	/* one file, no .dist file */
+#define PFBLayoutDist    1	/* one file with a .dist file */
+#define PFBLayoutSplit   2	/* one part file per writing process */
+
+#define PFBHeaderSize    (6*amps_SizeofDouble + 4*amps_SizeofInt)
+
+typedef struct
+{
+   int      layout;
+   int      num_blocks;
+   int     *blocks;	/* ix, iy, iz, nx, ny, nz, rx, ry, rz, part */
+   long    *offsets;	/* offset of the data of each block in its part */
+
+} PFBIndex;
+
+#define PFBIndexBlock(index, b) ((index) -> blocks + 10*(b))
+
+/* file offset of cell (i, j, k) of a block whose data starts at offset */
+#define PFBBlockOffset(offset, block, i, j, k) \
+   ((offset) + (long)amps_SizeofDouble * \
+    ( ((long)((k) - (block)[2])*(block)[4] + ((j) - (block)[1]))*(block)[3] \
+      + ((i) - (block)[0]) ))
+
+static amps_File  PFBOpenPart(
+char           *filename,
+int             part)
+{
+   char            part_filename[255];
+
+   if (part < 0)
+      return fopen(filename, "rb");
+
+   sprintf(part_filename, "%s.%05d", filename, part);
+   return fopen(part_filename, "rb");
+}
+
+/* layout of the file on disk, -1 if there is none; only called on rank 0 */
+static int  PFBFileLayout(
+char           *filename)
+{
+   amps_File       file;
+   FILE           *dfile;
+
+   char            dist_filename[255];
+
+   /* a single file is used if there is one, this is what pfdist and
+      the AMPS writers leave behind in either I/O mode */
+   if ((file = PFBOpenPart(filename, -1)) != NULL)
+   {
+      fclose(file);
+
+      sprintf(dist_filename, "%s.dist", filename);
+      if ((dfile = fopen(dist_filename, "r")) != NULL)
+      {
+	 fclose(dfile);
+	 return PFBLayoutDist;
+      }
+      return PFBLayoutSingle;
+   }
+   else if ((file = PFBOpenPart(filename, 0)) != NULL)
+   {
+      fclose(file);
+      return PFBLayoutSplit;
+   }
+
+   return -1;
+}
+
+static PFBIndex  *ReadPFBinaryIndex(
+char           *filename)
+{
+   PFBIndex       *index;
+
+   amps_Invoice    invoice;
+   amps_File       file = NULL;
+
+   int            *block;
+   int             part = -1, b, c, num_ints;
+   long            size;
+
+   index = ctalloc(PFBIndex, 1);
+
+   if ( amps_Rank(amps_CommWorld) == 0 )
+   {
+      (index -> layout) = PFBFileLayout(filename);
+      part = ((index -> layout) == PFBLayoutSplit) ? 0 : -1;
+
+      if ( ((index -> layout) < 0) ||
+	   ((file = PFBOpenPart(filename, part)) == NULL) )
+      {
+	 amps_Printf("Error: can't open input file %s\n", filename);
+	 exit(1);
+      }
+
+      fseek(file, PFBHeaderSize - amps_SizeofInt, SEEK_SET);
+      amps_ReadInt(file, &(index -> num_blocks), 1);
+   }
+
+   invoice = amps_NewInvoice("%i%i", &(index -> layout),
+			     &(index -> num_blocks));
+   amps_BCast(amps_CommWorld, 0, invoice);
+   amps_FreeInvoice(invoice);
+
+   num_ints = 10*(index -> num_blocks);
+   (index -> blocks)  = talloc(int, num_ints);
+   (index -> offsets) = talloc(long, (index -> num_blocks));
+
+   if ( amps_Rank(amps_CommWorld) == 0 )
+   {
+      for(b = 0; b < (index -> num_blocks); b++)
+      {
+	 /* move on to the next part once this one is used up */
+	 while ( (part >= 0) && ((c = getc(file)) == EOF) )
+	 {
+	    fclose(file);
+	    if ((file = PFBOpenPart(filename, ++part)) == NULL)
+	    {
+	       amps_Printf("Error: %s ends after %d of its %d subgrids\n",
+			   filename, b, (index -> num_blocks));
+	       exit(1);
+	    }
+	 }
+	 if (part >= 0)
+	    ungetc(c, file);
+
+	 block = PFBIndexBlock(index, b);
+
+	 amps_ReadInt(file, block, 9);
+	 block[9] = part;
+
+	 (index -> offsets)[b] = ftell(file);
+
+	 size = (long)block[3]*block[4]*block[5];
+	 fseek(file, size*(long)amps_SizeofDouble, SEEK_CUR);
+      }
+
+      fclose(file);
+   }
+
+   invoice = amps_NewInvoice("%*i%*l",
+			     num_ints, (index -> blocks),
+			     (index -> num_blocks), (index -> offsets));
+   amps_BCast(amps_CommWorld, 0, invoice);
+   amps_FreeInvoice(invoice);
+
+   return index;
+}
+
+static void  FreePFBIndex(
+PFBIndex       *index)
+{
+   tfree(index -> offsets);
+   tfree(index -> blocks);
+   tfree(index);
+}
+
+/* open the part of the file written by this rank, positioned at its
+   first block; a .dist file is read on rank 0 and its offsets are sent
+   to the other ranks, NULL if it does not have one per rank */
+
+static amps_File  PFBOpenLocal(
+char           *filename,
+int             layout)
+{
+   amps_Invoice    invoice;
+   amps_File       file;
+   FILE           *dfile;
+
+   char            dist_filename[255];
+   long           *starts;
+   int             p, num_starts;
+
+   if (layout == PFBLayoutSplit)
+      return PFBOpenPart(filename, amps_Rank(amps_CommWorld));
+
+   starts     = talloc(long, amps_Size(amps_CommWorld));
+   num_starts = 0;
+
+   if ( amps_Rank(amps_CommWorld) == 0 )
+   {
+      sprintf(dist_filename, "%s.dist", filename);
+      if ((dfile = fopen(dist_filename, "r")) != NULL)
+      {
+	 for(p = 0; p < amps_Size(amps_CommWorld); p++)
+	    if (fscanf(dfile, "%ld", &starts[p]) != 1)
+	       break;
+	 num_starts = p;
+
+	 /* written by more processes than this run has */
+	 if (fscanf(dfile, "%ld", &starts[0]) == 1)
+	    num_starts = 0;
+
+	 fclose(dfile);
+      }
+   }
+
+   invoice = amps_NewInvoice("%i%*l", &num_starts,
+			     amps_Size(amps_CommWorld), starts);
+   amps_BCast(amps_CommWorld, 0, invoice);
+   amps_FreeInvoice(invoice);
+
+   file = NULL;
+   if ( (num_starts == amps_Size(amps_CommWorld)) &&
+	((file = PFBOpenPart(filename, -1)) != NULL) )
+      fseek(file, starts[amps_Rank(amps_CommWorld)], SEEK_SET);
+
+   tfree(starts);
+
+   return file;
+}
+
+/*--------------------------------------------------------------------------
+ * PFBOpenMatching:
+ *   Open the part of the file of this rank if it was written with
+ *   the layout this run reads and the decomposition of grid, so it can
+ *   be read without building the index.  Rank 0 checks the layout and
+ *   the number of subgrids, then every rank checks the headers of its
+ *   own blocks.  Returns the file positioned at the first block of the
+ *   rank, or NULL on all ranks if any of the checks fails.
+ *--------------------------------------------------------------------------*/
+
+static amps_File  PFBOpenMatching(
+char           *filename,
+Grid           *grid,
+int             layout)
+{
+   SubgridArray   *subgrids = GridSubgrids(grid);
+   Subgrid        *subgrid;
+
+   amps_Invoice    invoice;
+   amps_File       file = NULL;
+
+   int             header[9];
+   int             matches, num_blocks, g;
+   long            start;
+
+   if ( amps_Rank(amps_CommWorld) == 0 )
+   {
+      matches = (PFBFileLayout(filename) == layout);
+
+      if (matches)
+      {
+	 file = PFBOpenPart(filename, (layout == PFBLayoutSplit) ? 0 : -1);
+
+	 fseek(file, PFBHeaderSize - amps_SizeofInt, SEEK_SET);
+	 amps_ReadInt(file, &num_blocks, 1);
+	 fclose(file);
+
+	 matches = (num_blocks == SubgridArraySize(GridAllSubgrids(grid)));
+      }
+   }
+
+   invoice = amps_NewInvoice("%i", &matches);
+   amps_BCast(amps_CommWorld, 0, invoice);
+   amps_FreeInvoice(invoice);
+
+   if (!matches)
+      return NULL;
+
+   file    = PFBOpenLocal(filename, layout);
+   matches = (file != NULL);
+
+   if (file)
+   {
+      if ( amps_Rank(amps_CommWorld) == 0 )
+	 fseek(file, PFBHeaderSize, SEEK_SET);
+      start = ftell(file);
+
+      ForSubgridI(g, subgrids)
+      {
+	 subgrid = SubgridArraySubgrid(subgrids, g);
+
+	 amps_ReadInt(file, header, 9);
+
+	 if ( (header[0] != SubgridIX(subgrid)) ||
+	      (header[1] != SubgridIY(subgrid)) ||
+	      (header[2] != SubgridIZ(subgrid)) ||
+	      (header[3] != SubgridNX(subgrid)) ||
+	      (header[4] != SubgridNY(subgrid)) ||
+	      (header[5] != SubgridNZ(subgrid)) )
+	 {
+	    matches = 0;
+	    break;
+	 }
+
+	 fseek(file, (long)header[3]*header[4]*header[5]*(long)amps_SizeofDouble,
+	       SEEK_CUR);
+      }
+
+      fseek(file, start, SEEK_SET);
+   }
+
+   invoice = amps_NewInvoice("%i", &matches);
+   amps_AllReduce(amps_CommWorld, invoice, amps_Min);
+   amps_FreeInvoice(invoice);
+
+   if (!matches)
+   {
+      if (file)
+	 amps_FFclose(file);
+      return NULL;
+   }
+
+   return file;
+}
+
+/*--------------------------------------------------------------------------
+ * ReadPFBinaryRedistribute:
+ *   Read a PFB file written with a different decomposition.  Every rank
+ *   opens the file itself and, for each local subgrid, reads only the
+ *   parts of the file blocks that overlap it.  Overlaps spanning the
+ *   full x (and y) extent of a block are contiguous in the file and are
+ *   read with one call per plane (or one call for the whole overlap).
+ *--------------------------------------------------------------------------*/
+
+static void  ReadPFBinaryRedistribute(
+char           *filename,
+Vector         *v,
+PFBIndex       *index)
+{
+   Grid           *grid     = VectorGrid(v);
+   SubgridArray   *subgrids = GridSubgrids(grid);
+   Subgrid        *subgrid;
+   Subvector      *subvector;
+
+   amps_File       file = NULL;
+   int             part = -2;
+
+   int             g, b, j, k, n;
+   int            *block;
+   long            offset;
+
+   int             ix, iy, iz;
+   int             nx, ny, nz;
+   int             nx_v, ny_v;
+
+   double         *buffer;
+   double         *bp;
+   double         *data;
+
+   ForSubgridI(g, subgrids)
+   {
+      subgrid   = SubgridArraySubgrid(subgrids, g);
+      subvector = VectorSubvector(v, g);
+
+      nx_v = SubvectorNX(subvector);
+      ny_v = SubvectorNY(subvector);
+
+      for(b = 0; b < (index -> num_blocks); b++)
+      {
+	 block  = PFBIndexBlock(index, b);
+	 offset = (index -> offsets)[b];
+
+	 ix = pfmax(SubgridIX(subgrid), block[0]);
+	 iy = pfmax(SubgridIY(subgrid), block[1]);
+	 iz = pfmax(SubgridIZ(subgrid), block[2]);
+	 nx = pfmin(SubgridIX(subgrid) + SubgridNX(subgrid),
+		    block[0] + block[3]) - ix;
+	 ny = pfmin(SubgridIY(subgrid) + SubgridNY(subgrid),
+		    block[1] + block[4]) - iy;
+	 nz = pfmin(SubgridIZ(subgrid) + SubgridNZ(subgrid),
+		    block[2] + block[5]) - iz;
+
+	 if ( (nx <= 0) || (ny <= 0) || (nz <= 0) )
+	    continue;
+
+	 if (block[9] != part)
+	 {
+	    if (file)
+	       fclose(file);
+
+	    part = block[9];
+	    if ((file = PFBOpenPart(filename, part)) == NULL)
+	    {
+	       amps_Printf("Error: can't open input file %s\n", filename);
+	       exit(1);
+	    }
+	 }
+
+	 n = nx*ny*nz;
+	 buffer = talloc(double, n);
+
+	 /* fill buffer in (k, j) pencil order using the largest
+	    contiguous reads the overlap allows */
+	 if ( (nx == block[3]) && (ny == block[4]) )
+	 {
+	    fseek(file, PFBBlockOffset(offset, block, ix, iy, iz), SEEK_SET);
+	    amps_ReadDouble(file, buffer, n);
+	 }
+	 else if (nx == block[3])
+	 {
+	    bp = buffer;
+	    for(k = iz; k < iz + nz; k++)
+	    {
+	       fseek(file, PFBBlockOffset(offset, block, ix, iy, k), SEEK_SET);
+	       amps_ReadDouble(file, bp, nx*ny);
+	       bp += nx*ny;
+	    }
+	 }
+	 else
+	 {
+	    bp = buffer;
+	    for(k = iz; k < iz + nz; k++)
+	    {
+	       for(j = iy; j < iy + ny; j++)
+	       {
+		  fseek(file, PFBBlockOffset(offset, block, ix, j, k), SEEK_SET);
+		  amps_ReadDouble(file, bp, nx);
+		  bp += nx;
+	       }
+	    }
+	 }
+
+	 data = SubvectorElt(subvector, ix, iy, iz);
+
+	 bp = buffer;
+	 for(k = 0; k < nz; k++)
+	 {
+	    for(j = 0; j < ny; j++)
+	    {
+	       memcpy(data + (k*ny_v + j)*nx_v, bp, (size_t)nx*sizeof(double));
+	       bp += nx;
+	    }
+	 }
+
+	 tfree(buffer);
+      }
+   }
+
+   if (file)
+      fclose(file);
+}
+
+
+#ifdef AMPS_HAVE_MPI_IO
+
+/*--------------------------------------------------------------------------
+ * MPI-IO PFB reader.
+ *
+ *   Every rank reads its blocks, starting at offset start, with one
+ *   collective read and unpacks them from memory.
+ *--------------------------------------------------------------------------*/
+
+static void  ReadPFBinaryMPIIO(
+char           *filename,
+Vector         *v,
+long            start)
+{
+   Grid           *grid     = VectorGrid(v);
+   SubgridArray   *subgrids = GridSubgrids(grid);
+   Subgrid        *subgrid;
+   Subvector      *subvector;
+
+   int             g;
+
+   int             header[9];
+
+   char           *buffer;
+   char           *pos;
+
+   long            size;
+
+   MPI_File        fh;
+
+   size = 0;
+   ForSubgridI(g, subgrids)
+   {
+      size += SizeofPFBinarySubvector(VectorSubvector(v, g),
+				      SubgridArraySubgrid(subgrids, g));
+   }
+
+   buffer = talloc(char, size);
+
+   PFBMPIIOCheck(MPI_File_open(amps_CommWorld, filename, MPI_MODE_RDONLY,
+			       MPI_INFO_NULL, &fh),
+		 "open", filename);
+
+   PFBMPIIOReadAtAll(fh, filename, start, buffer, size);
+
+   PFBMPIIOCheck(MPI_File_close(&fh), "close", filename);
+
+   pos = buffer;
+   ForSubgridI(g, subgrids)
+   {
+      subgrid   = SubgridArraySubgrid(subgrids, g);
+      subvector = VectorSubvector(v, g);
+
+      pos = PFBUnpackInts(pos, header, 9);
+
+      /* the buffer is sized from the subgrids, a block of another size
+	 would be unpacked past its end */
+      if ( (header[0] != SubgridIX(subgrid)) ||
+	   (header[1] != SubgridIY(subgrid)) ||
+	   (header[2] != SubgridIZ(subgrid)) ||
+	   (header[3] != SubgridNX(subgrid)) ||
+	   (header[4] != SubgridNY(subgrid)) ||
+	   (header[5] != SubgridNZ(subgrid)) )
+      {
+	 amps_Printf("Error: subgrid %d of %s does not match the process "
+		     "subgrid\n", g, filename);
+	 exit(1);
+      }
+
+      pos = PFBUnpackSubvector(pos, subvector, header);
+   }
+
+   tfree(buffer);
 }
 
+#endif
+
 
 void ReadPFBinary(
 char           *filename,
@@ -86,48 +621,58 @@ Vector         *v)
    Subvector      *subvector;
 
    int             num_chars, g;
-   int             p, P;
 
    amps_File       file;
 
-   double          X, Y, Z;
-   int             NX, NY, NZ;
-   double          DX, DY, DZ;
+   PFBIndex       *index;
+   int             layout;
 
    BeginTiming(PFBTimingIndex);
 
-   p = amps_Rank(amps_CommWorld);
-   P = amps_Size(amps_CommWorld);
-
-   if ( ((num_chars = strlen(filename)) < 4) ||
+   if ( ((num_chars = (int)strlen(filename)) < 4) ||
 	(strcmp(".pfb", &filename[num_chars - 4])) )
    {
       amps_Printf("Error: %s is not in pfb format\n", filename);
       exit(1);
    }
 
-   if ((file = amps_FFopen(amps_CommWorld, filename, "rb", 0)) == NULL) 
+#ifdef AMPS_SPLIT_FILE
+   layout = PFBLayoutSplit;
+#else
+   layout = PFBLayoutDist;
+#endif
+#ifdef AMPS_HAVE_MPI_IO
+   if ( GlobalsPFBIOMode == PFBIOModeMPIIO )
+      layout = PFBLayoutDist;
+#endif
+
+   /* Files written on another process topology, or not laid out the
+      way this run would read them, are redistributed on the fly with
+      each rank reading the overlapping parts of the file blocks.  The
+      index of the file blocks this needs is only built then. */
+   if ((file = PFBOpenMatching(filename, grid, layout)) == NULL)
    {
-      amps_Printf("Error: can't open input file %s\n", filename);
-      exit(1);
+      index = ReadPFBinaryIndex(filename);
+      ReadPFBinaryRedistribute(filename, v, index);
+      FreePFBIndex(index);
+
+      EndTiming(PFBTimingIndex);
+      return;
    }
 
-   if (p == 0) 
+#ifdef AMPS_HAVE_MPI_IO
+   if ( GlobalsPFBIOMode == PFBIOModeMPIIO )
    {
-      amps_ReadDouble(file, &X, 1);
-      amps_ReadDouble(file, &Y, 1);
-      amps_ReadDouble(file, &Z, 1);
+      long start = ftell(file);
 
-      amps_ReadInt(file, &NX, 1);
-      amps_ReadInt(file, &NY, 1);
-      amps_ReadInt(file, &NZ, 1);
+      amps_FFclose(file);
 
-      amps_ReadDouble(file, &DX, 1);
-      amps_ReadDouble(file, &DY, 1);
-      amps_ReadDouble(file, &DZ, 1);
+      ReadPFBinaryMPIIO(filename, v, start);
 
-      amps_ReadInt(file, &P, 1);
+      EndTiming(PFBTimingIndex);
+      return;
    }
+#endif
 
    ForSubgridI(g, subgrids)
    {
@@ -140,3 +685,134 @@ Vector         *v)
 
    EndTiming(PFBTimingIndex);
 }
+
+
+/*--------------------------------------------------------------------------
+ * ReadPFBinaryStaged:
+ *   Read a PFB file whose part for this rank was already read into
+ *   memory (by the read-ahead of pfb_prefetch.c).  buffer holds size
+ *   bytes of the file (or part file) starting at offset start, it may
+ *   be NULL if nothing was staged.  The staged data is only used if on
+ *   every rank it holds exactly the blocks of the rank's subgrids, else
+ *   the file is read with ReadPFBinary, which redistributes files
+ *   written on another process topology.  Collective.
+ *--------------------------------------------------------------------------*/
+
+void ReadPFBinaryStaged(
+char           *filename,
+Vector         *v,
+char           *buffer,
+long            start,
+long            size)
+{
+   Grid           *grid     = VectorGrid(v);
+   SubgridArray   *subgrids = GridSubgrids(grid);
+   Subgrid        *subgrid;
+
+   amps_Invoice    invoice;
+
+   int             g;
+   int             header[9];
+   int             matches;
+
+   char           *pos;
+   long            expected;
+
+   /* the part of rank 0 starts with the file header */
+   expected = 0;
+   if ( amps_Rank(amps_CommWorld) == 0 )
+      expected = PFBHeaderSize;
+   ForSubgridI(g, subgrids)
+   {
+      expected += SizeofPFBinarySubvector(VectorSubvector(v, g),
+					  SubgridArraySubgrid(subgrids, g));
+   }
+
+   matches = (buffer != NULL) && (size == expected) &&
+      ( (amps_Rank(amps_CommWorld) != 0) || (start == 0) );
+
+   if (matches)
+   {
+      pos = buffer;
+      if ( amps_Rank(amps_CommWorld) == 0 )
+	 pos += PFBHeaderSize;
+
+      ForSubgridI(g, subgrids)
+      {
+	 subgrid = SubgridArraySubgrid(subgrids, g);
+
+	 pos = PFBUnpackInts(pos, header, 9);
+
+	 if ( (header[0] != SubgridIX(subgrid)) ||
+	      (header[1] != SubgridIY(subgrid)) ||
+	      (header[2] != SubgridIZ(subgrid)) ||
+	      (header[3] != SubgridNX(subgrid)) ||
+	      (header[4] != SubgridNY(subgrid)) ||
+	      (header[5] != SubgridNZ(subgrid)) )
+	 {
+	    matches = 0;
+	    break;
+	 }
+
+	 pos += (long)header[3]*header[4]*header[5]*(long)amps_SizeofDouble;
+      }
+   }
+
+   invoice = amps_NewInvoice("%i", &matches);
+   amps_AllReduce(amps_CommWorld, invoice, amps_Min);
+   amps_FreeInvoice(invoice);
+
+   if (!matches)
+   {
+      ReadPFBinary(filename, v);
+      return;
+   }
+
+   BeginTiming(PFBTimingIndex);
+
+   pos = buffer;
+   if ( amps_Rank(amps_CommWorld) == 0 )
+      pos += PFBHeaderSize;
+
+   ForSubgridI(g, subgrids)
+   {
+      pos = PFBUnpackInts(pos, header, 9);
+      pos = PFBUnpackSubvector(pos, VectorSubvector(v, g), header);
+   }
+
+   EndTiming(PFBTimingIndex);
+}
+
+
+/*--------------------------------------------------------------------------
+ * ReadPFBinarySubset:
+ *   Read the cells of the subgrids of v from a PFB file written with any
+ *   decomposition.  The grid of v may cover only part of the file's
+ *   domain (e.g. the boundary cells of a patch), only the parts of the
+ *   file overlapping its subgrids are read.
+ *--------------------------------------------------------------------------*/
+
+void ReadPFBinarySubset(
+char           *filename,
+Vector         *v)
+{
+   PFBIndex       *index;
+   int             num_chars;
+
+   BeginTiming(PFBTimingIndex);
+
+   if ( ((num_chars = (int)strlen(filename)) < 4) ||
+	(strcmp(".pfb", &filename[num_chars - 4])) )
+   {
+      amps_Printf("Error: %s is not in pfb format\n", filename);
+      exit(1);
+   }
+
+   index = ReadPFBinaryIndex(filename);
+
+   ReadPFBinaryRedistribute(filename, v, index);
+
+   FreePFBIndex(index);
+
+   EndTiming(PFBTimingIndex);
+}
@@ -101,6 +101,9 @@ typedef struct
    Grid         *grid;
    double       *temp_data;
 
+   PhaseProperties *phase_properties;
+   int              phase_properties_tried;   /* NewPhaseProperties was called */
+
 } InstanceXtra;
 
 /*--------------------------------------------------------------------------
@@ -242,7 +245,7 @@ int           symm_part)      /* Specifies whether to compute just the
    Vector      *x_ssl             = ProblemDataSSlopeX(problem_data);  //@RMM
    Vector      *y_ssl             = ProblemDataSSlopeY(problem_data);  //@RMM
    Subvector   *x_ssl_sub, *y_ssl_sub;   //@RMM
-   double      *x_ssl_dat, *y_ssl_dat;    //@RMM
+   double      *x_ssl_dat = NULL, *y_ssl_dat = NULL;    //@RMM
     
    /* @RMM variable dz multiplier */
    Vector      *z_mult            = ProblemDataZmult(problem_data);  //@RMM
@@ -272,7 +275,7 @@ int           symm_part)      /* Specifies whether to compute just the
    int          nx_m, ny_m, nz_m;
    int          nx_po, ny_po, nz_po;
    int          sy_v, sz_v;
-   int          sy_m, sz_m;
+   int          sx_m, sy_m, sz_m;
    int          ip, ipo, im, iv;
    
    
@@ -339,8 +342,8 @@ int           symm_part)      /* Specifies whether to compute just the
    /*-----------------------------------------------------------------------
     * Allocate temp vectors
     *-----------------------------------------------------------------------*/
-   density_der     = NewVectorType(grid, 1, 1, vector_cell_centered);
-   saturation_der  = NewVectorType(grid, 1, 1, vector_cell_centered);
+   density_der     = CheckoutVector(grid, 1, 1, vector_cell_centered);
+   saturation_der  = CheckoutVector(grid, 1, 1, vector_cell_centered);
 
    /*-----------------------------------------------------------------------
     * reuse the temp vectors for both saturation and rel_perm calculations.
@@ -353,14 +356,14 @@ int           symm_part)      /* Specifies whether to compute just the
    FinalizeVectorUpdate(vector_update_handle);
 
 /* Define grid for surface contribution */ 
-   KW = NewVectorType( grid2d, 1, 1, vector_cell_centered);
-   KE = NewVectorType( grid2d, 1, 1, vector_cell_centered);
-   KN = NewVectorType( grid2d, 1, 1, vector_cell_centered);
-   KS = NewVectorType( grid2d, 1, 1, vector_cell_centered);
-   KWns = NewVectorType( grid2d, 1, 1, vector_cell_centered);
-   KEns = NewVectorType( grid2d, 1, 1, vector_cell_centered);
-   KNns = NewVectorType( grid2d, 1, 1, vector_cell_centered);
-   KSns = NewVectorType( grid2d, 1, 1, vector_cell_centered);
+   KW = CheckoutVector( grid2d, 1, 1, vector_cell_centered);
+   KE = CheckoutVector( grid2d, 1, 1, vector_cell_centered);
+   KN = CheckoutVector( grid2d, 1, 1, vector_cell_centered);
+   KS = CheckoutVector( grid2d, 1, 1, vector_cell_centered);
+   KWns = CheckoutVector( grid2d, 1, 1, vector_cell_centered);
+   KEns = CheckoutVector( grid2d, 1, 1, vector_cell_centered);
+   KNns = CheckoutVector( grid2d, 1, 1, vector_cell_centered);
+   KSns = CheckoutVector( grid2d, 1, 1, vector_cell_centered);
 
    InitVector(KW, 0.0);
    InitVector(KE, 0.0);
@@ -382,16 +385,34 @@ int           symm_part)      /* Specifies whether to compute just the
 
    /* Calculate time term contributions. */
 
-   PFModuleInvokeType(PhaseDensityInvoke, density_module, (0, pressure, density, &dtmp, &dtmp, 
+   /* NULL if the modules are not supported, then they are used */
+   if ( !(instance_xtra -> phase_properties_tried) )
+   {
+      (instance_xtra -> phase_properties) = 
+	 NewPhaseProperties(density_module, saturation_module, 
+			    rel_perm_module, problem_data, grid);
+      (instance_xtra -> phase_properties_tried) = 1;
+   }
+
+   if ( (instance_xtra -> phase_properties) )
+   {
+      PhaseStorageProperties((instance_xtra -> phase_properties), pressure, 
+			     density, density_der, saturation, saturation_der,
+			     gravity, PhaseCellsAll);
+   }
+   else
+   {
+      PFModuleInvokeType(PhaseDensityInvoke, density_module, (0, pressure, density, &dtmp, &dtmp, 
 					 CALCFCN));
-   PFModuleInvokeType(PhaseDensityInvoke, density_module, (0, pressure, density_der, &dtmp, 
+      PFModuleInvokeType(PhaseDensityInvoke, density_module, (0, pressure, density_der, &dtmp, 
 					 &dtmp, CALCDER));
-   PFModuleInvokeType(SaturationInvoke, saturation_module, (saturation, pressure, 
+      PFModuleInvokeType(SaturationInvoke, saturation_module, (saturation, pressure, 
 					    density, gravity, problem_data, 
 					    CALCFCN));
-   PFModuleInvokeType(SaturationInvoke, saturation_module, (saturation_der, pressure, 
+      PFModuleInvokeType(SaturationInvoke, saturation_module, (saturation_der, pressure, 
 					    density, gravity, problem_data,
 					    CALCDER));
+   }
 
    ForSubgridI(is, GridSubgrids(grid))
    {
@@ -456,7 +477,8 @@ int           symm_part)      /* Specifies whether to compute just the
       pop = SubvectorData(po_sub);   // porosity
       ss  = SubvectorData(ss_sub);  // sepcific storage
 
-      GrGeomInLoop(i, j, k, gr_domain, r, ix, iy, iz, nx, ny, nz,
+      ThreadedGrGeomInLoop(ThreadPrivate(im, ipo, iv, vol2),
+			   i, j, k, gr_domain, r, ix, iy, iz, nx, ny, nz,
       {
 
 	 im  = SubmatrixEltIndex(J_sub, i, j, k);
@@ -519,13 +541,22 @@ int           symm_part)      /* Specifies whether to compute just the
 
    /* Calculate rel_perm and rel_perm_der */
 
-   PFModuleInvokeType(PhaseRelPermInvoke, rel_perm_module, 
+   if ( (instance_xtra -> phase_properties) )
+   {
+      PhaseRelPermProperties((instance_xtra -> phase_properties), pressure, 
+			     density, rel_perm, rel_perm_der, gravity, 
+			     problem_data, PhaseCellsAll);
+   }
+   else
+   {
+      PFModuleInvokeType(PhaseRelPermInvoke, rel_perm_module, 
 		      (rel_perm, pressure, density, gravity, problem_data, 
 		       CALCFCN));
 
-   PFModuleInvokeType(PhaseRelPermInvoke, rel_perm_module, 
+      PFModuleInvokeType(PhaseRelPermInvoke, rel_perm_module, 
 		  (rel_perm_der, pressure, density, gravity, problem_data, 
 		   CALCDER));
+   }
 
    /* Calculate contributions from second order derivatives and gravity */
    ForSubgridI(is, GridSubgrids(grid))
@@ -581,8 +612,9 @@ int           symm_part)      /* Specifies whether to compute just the
 
       sy_v = nx_v;
       sz_v = ny_v * nx_v;
-      sy_m = nx_m;
-      sz_m = ny_m * nx_m;
+      sx_m = SubmatrixStride(J_sub);
+      sy_m = nx_m * sx_m;
+      sz_m = ny_m * nx_m * sx_m;
 
       cp    = SubmatrixStencilData(J_sub, 0);
       wp    = SubmatrixStencilData(J_sub, 1);
@@ -724,7 +756,7 @@ int           symm_part)      /* Specifies whether to compute just the
           
 
 	 cp[im]      -= west_temp + south_temp + lower_temp;
-	 cp[im+1]    -= east_temp;
+	 cp[im+sx_m] -= east_temp;
 	 cp[im+sy_m] -= north_temp;
 	 cp[im+sz_m] -= upper_temp;
 
@@ -734,7 +766,7 @@ int           symm_part)      /* Specifies whether to compute just the
 	    np[im] += north_temp;
 	    up[im] += upper_temp;
 
-	    wp[im+1] += west_temp;
+	    wp[im+sx_m] += west_temp;
 	    sop[im+sy_m] += south_temp;
 	    lp[im+sz_m] += lower_temp;
 	 }
@@ -1382,8 +1414,9 @@ int           symm_part)      /* Specifies whether to compute just the
 	 sy_v = SubvectorNX(sx_sub);
 	 nx_m = SubmatrixNX(J_sub);
 	 ny_m = SubmatrixNY(J_sub);
-	 sy_m = nx_m;
-	 sz_m = nx_m*ny_m;           
+	 sx_m = SubmatrixStride(J_sub);
+	 sy_m = nx_m*sx_m;
+	 sz_m = nx_m*ny_m*sx_m;
 
 	 ix = SubgridIX(subgrid);
 	 iy = SubgridIY(subgrid);
@@ -1643,16 +1676,16 @@ int           symm_part)      /* Specifies whether to compute just the
 
     FreeBCStruct(bc_struct);
 
-   FreeVector(density_der);
-   FreeVector(saturation_der);
-   FreeVector(KW);
-   FreeVector(KE);
-   FreeVector(KN);
-   FreeVector(KS);
-   FreeVector(KWns);
-   FreeVector(KEns);
-   FreeVector(KNns);
-   FreeVector(KSns);
+   ReturnVector(density_der);
+   ReturnVector(saturation_der);
+   ReturnVector(KW);
+   ReturnVector(KE);
+   ReturnVector(KN);
+   ReturnVector(KS);
+   ReturnVector(KWns);
+   ReturnVector(KEns);
+   ReturnVector(KNns);
+   ReturnVector(KSns);
 
    return;
 }
@@ -1699,15 +1732,15 @@ PFModule    *RichardsJacobianEvalInitInstanceXtra(
 
       if (symmetric_jac){
 	 (instance_xtra -> J)  =  NewMatrixType(grid, NULL, stencil, ON, stencil, 
-						matrix_cell_centered);
+						MatrixLayoutType(GlobalsMatrixLayout));
 	 (instance_xtra -> JC) = NewMatrixType(grid, NULL, stencil_C, ON, stencil_C,
-					       matrix_cell_centered);
+					       MatrixLayoutType(GlobalsMatrixLayout));
       }
       else{
 	 (instance_xtra -> J)  = NewMatrixType(grid, NULL, stencil, OFF, stencil,
-					       matrix_cell_centered);
+					       MatrixLayoutType(GlobalsMatrixLayout));
 	 (instance_xtra -> JC) = NewMatrixType(grid, NULL, stencil_C, OFF, stencil_C,
-					       matrix_cell_centered);
+					       MatrixLayoutType(GlobalsMatrixLayout));
       }
 
    }
@@ -1781,6 +1814,8 @@ void  RichardsJacobianEvalFreeInstanceXtra()
 
       FreeMatrix(instance_xtra -> JC); /* DOK */
 
+      FreePhaseProperties(instance_xtra -> phase_properties);
+
       tfree(instance_xtra);
    }
 }
@@ -40,7 +40,21 @@ typedef struct
 
 } PublicXtra;
 
-typedef void InstanceXtra;
+typedef struct
+{
+   /* Adaptive (type 2) controller state; NULL for the other types */
+
+   double   proposed_step;     /* step chosen before it was cut to a well,
+				  BC, dump or stop time */
+   int      have_stats;        /* TRUE if the last step was reported */
+   int      after_failure;     /* TRUE if the last step was a retry */
+
+   int      num_nonlin_iter;   /* statistics of the last step */
+   int      num_lin_iter;
+   double   pressure_change;
+   double   saturation_change;
+
+} InstanceXtra;
 
 typedef struct
 {
@@ -57,6 +71,25 @@ typedef struct
                                
 } Type1;                       /* step increases to a max value */
 
+typedef struct
+{
+   double   initial_step;
+   double   min_step;
+   double   max_step;
+
+   double   min_factor;        /* bounds on the change of dt per step */
+   double   max_factor;
+   double   safety;            /* applied to the solution change factors */
+   double   failure_factor;    /* dt is cut by this after a failed step */
+
+   int      target_nonlin_iter;       /* 0 to ignore */
+   int      target_lin_iter;          /* 0 to ignore */
+   double   target_pressure_change;   /* 0 to ignore */
+   double   target_saturation_change; /* 0 to ignore */
+   double   pressure_scale;
+
+} Type2;                       /* step adapted to the solver and solution */
+
 /*--------------------------------------------------------------------------
  * SelectTimeStep:
  *    This routine returns a time step size.
@@ -73,9 +106,11 @@ ProblemData *problem_data)
 {
    PFModule      *this_module   = ThisPFModule;
    PublicXtra    *public_xtra   = (PublicXtra *)PFModulePublicXtra(this_module);
+   InstanceXtra  *instance_xtra = (InstanceXtra *)PFModuleInstanceXtra(this_module);
 
    Type0         *dummy0;
    Type1         *dummy1;
+   Type2         *dummy2;
 
    double         well_dt, bc_dt;
 
@@ -123,6 +158,90 @@ ProblemData *problem_data)
       break;
    }     /* End case 1 */
 
+   case 2:
+   {
+      double factor, f;
+      double base_step;
+
+      dummy2 = (Type2 *)(public_xtra -> data);
+
+      if ((*dt) == 0.0)
+      {
+	 (*dt) = (dummy2 -> initial_step);
+      }
+      else if (instance_xtra -> have_stats)
+      {
+	 /*----------------------------------------------------------
+	  * Each target gives the factor that would have brought the
+	  * last step onto it; the smallest factor is used.  The
+	  * solution change factors assume the change is linear in dt
+	  * and are scaled by the safety factor.
+	  *----------------------------------------------------------*/
+
+	 factor = (dummy2 -> max_factor);
+
+	 if ((dummy2 -> target_nonlin_iter) > 0)
+	 {
+	    f = (double)(dummy2 -> target_nonlin_iter) /
+	       (double)pfmax(instance_xtra -> num_nonlin_iter, 1);
+	    factor = pfmin(factor, f);
+	 }
+
+	 if ((dummy2 -> target_lin_iter) > 0)
+	 {
+	    f = (double)(dummy2 -> target_lin_iter) /
+	       (double)pfmax(instance_xtra -> num_lin_iter, 1);
+	    factor = pfmin(factor, f);
+	 }
+
+	 if (((dummy2 -> target_pressure_change) > 0.0) &&
+	     ((instance_xtra -> pressure_change) > 0.0))
+	 {
+	    f = (dummy2 -> safety) * (dummy2 -> target_pressure_change) /
+	       (instance_xtra -> pressure_change);
+	    factor = pfmin(factor, f);
+	 }
+
+	 if (((dummy2 -> target_saturation_change) > 0.0) &&
+	     ((instance_xtra -> saturation_change) > 0.0))
+	 {
+	    f = (dummy2 -> safety) * (dummy2 -> target_saturation_change) /
+	       (instance_xtra -> saturation_change);
+	    factor = pfmin(factor, f);
+	 }
+
+	 /* do not grow right after a failed step */
+	 if (instance_xtra -> after_failure)
+	    factor = pfmin(factor, 1.0);
+
+	 factor = pfmax(factor, (dummy2 -> min_factor));
+
+	 /*----------------------------------------------------------
+	  * If the last step was cut short to land on a well, BC, dump
+	  * or stop time, carry on from the step proposed before the
+	  * cut; it may only shrink.
+	  *----------------------------------------------------------*/
+
+	 base_step = (*dt);
+	 if ((*dt) < (instance_xtra -> proposed_step)*(1.0 - 1.0e-8))
+	 {
+	    base_step = (instance_xtra -> proposed_step);
+	    factor    = pfmin(factor, 1.0);
+	 }
+
+	 (*dt) = base_step*factor;
+      }
+
+      if ((*dt) < (dummy2 -> min_step)) (*dt) = (dummy2 -> min_step);
+      if ((*dt) > (dummy2 -> max_step)) (*dt) = (dummy2 -> max_step);
+
+      (instance_xtra -> proposed_step) = (*dt);
+      (instance_xtra -> have_stats)    = FALSE;
+      (instance_xtra -> after_failure) = FALSE;
+
+      break;
+   }     /* End case 2 */
+
    }     /* End switch */
 
    /*-----------------------------------------------------------------
@@ -162,6 +281,146 @@ ProblemData *problem_data)
 
 }
 
+/*--------------------------------------------------------------------------
+ * SelectTimeStepReportStep:
+ *   Tell the time step selector this_module how the last time step went.
+ *   Only the Adaptive type uses this; the solution changes are computed
+ *   only for the targets it has, over the cells inside gr_domain.
+ *--------------------------------------------------------------------------*/
+
+void     SelectTimeStepReportStep(
+PFModule    *this_module,
+int          num_nonlin_iter,
+int          num_lin_iter,
+Vector      *pressure,
+Vector      *old_pressure,
+Vector      *saturation,
+Vector      *old_saturation,
+GrGeomSolid *gr_domain)
+{
+   PublicXtra    *public_xtra   = (PublicXtra *)PFModulePublicXtra(this_module);
+   InstanceXtra  *instance_xtra = (InstanceXtra *)PFModuleInstanceXtra(this_module);
+
+   Type2         *dummy2;
+
+
+   if ((public_xtra -> type) != 2 || instance_xtra == NULL)
+      return;
+
+   dummy2 = (Type2 *)(public_xtra -> data);
+
+   (instance_xtra -> num_nonlin_iter) = num_nonlin_iter;
+   (instance_xtra -> num_lin_iter)    = num_lin_iter;
+
+   (instance_xtra -> pressure_change) = 0.0;
+   if ((dummy2 -> target_pressure_change) > 0.0)
+   {
+      (instance_xtra -> pressure_change) =
+	 PFVMaxRelChange(pressure, old_pressure, (dummy2 -> pressure_scale),
+			 gr_domain);
+   }
+
+   /* saturations are at most 1, so this is the absolute change */
+   (instance_xtra -> saturation_change) = 0.0;
+   if ((dummy2 -> target_saturation_change) > 0.0)
+   {
+      (instance_xtra -> saturation_change) =
+	 PFVMaxRelChange(saturation, old_saturation, 1.0, gr_domain);
+   }
+
+   (instance_xtra -> have_stats) = TRUE;
+}
+
+
+/*--------------------------------------------------------------------------
+ * SelectTimeStepFailedStep:
+ *   Return the step to retry with after the nonlinear solver failed to
+ *   converge with step dt.
+ *--------------------------------------------------------------------------*/
+
+double   SelectTimeStepFailedStep(
+PFModule    *this_module,
+double       dt)
+{
+   PublicXtra    *public_xtra   = (PublicXtra *)PFModulePublicXtra(this_module);
+   InstanceXtra  *instance_xtra = (InstanceXtra *)PFModuleInstanceXtra(this_module);
+
+   Type2         *dummy2;
+
+
+   if ((public_xtra -> type) != 2 || instance_xtra == NULL)
+      return 0.5*dt;
+
+   dummy2 = (Type2 *)(public_xtra -> data);
+
+   dt = dt*(dummy2 -> failure_factor);
+
+   (instance_xtra -> proposed_step) = dt;
+   (instance_xtra -> have_stats)    = FALSE;
+   (instance_xtra -> after_failure) = TRUE;
+
+   return dt;
+}
+
+
+/*--------------------------------------------------------------------------
+ * SelectTimeStepGetState:
+ *   Copy the Adaptive controller state of this_module into the
+ *   SelectTimeStepStateSize doubles of state so it can be checkpointed.
+ *   The other types have no state and store zeros.
+ *--------------------------------------------------------------------------*/
+
+void     SelectTimeStepGetState(
+PFModule    *this_module,
+double      *state)
+{
+   InstanceXtra  *instance_xtra = (InstanceXtra *)PFModuleInstanceXtra(this_module);
+
+   int            n;
+
+
+   for (n = 0; n < SelectTimeStepStateSize; n++)
+      state[n] = 0.0;
+
+   if (instance_xtra == NULL)
+      return;
+
+   state[0] = (instance_xtra -> proposed_step);
+   state[1] = (instance_xtra -> have_stats);
+   state[2] = (instance_xtra -> after_failure);
+   state[3] = (instance_xtra -> num_nonlin_iter);
+   state[4] = (instance_xtra -> num_lin_iter);
+   state[5] = (instance_xtra -> pressure_change);
+   state[6] = (instance_xtra -> saturation_change);
+}
+
+
+/*--------------------------------------------------------------------------
+ * SelectTimeStepSetState:
+ *   Restore the state saved by SelectTimeStepGetState, so a restarted run
+ *   picks the same steps as the run that wrote the checkpoint.
+ *--------------------------------------------------------------------------*/
+
+void     SelectTimeStepSetState(
+PFModule    *this_module,
+double      *state)
+{
+   InstanceXtra  *instance_xtra = (InstanceXtra *)PFModuleInstanceXtra(this_module);
+
+
+   if (instance_xtra == NULL)
+      return;
+
+   (instance_xtra -> proposed_step)     = state[0];
+   (instance_xtra -> have_stats)        = (int) state[1];
+   (instance_xtra -> after_failure)     = (int) state[2];
+   (instance_xtra -> num_nonlin_iter)   = (int) state[3];
+   (instance_xtra -> num_lin_iter)      = (int) state[4];
+   (instance_xtra -> pressure_change)   = state[5];
+   (instance_xtra -> saturation_change) = state[6];
+}
+
+
 /*--------------------------------------------------------------------------
  * SelectTimeStepInitInstanceXtra
  *--------------------------------------------------------------------------*/
@@ -169,9 +428,14 @@ ProblemData *problem_data)
 PFModule  *SelectTimeStepInitInstanceXtra()
 {
    PFModule      *this_module  = ThisPFModule;
+   PublicXtra    *public_xtra  = (PublicXtra *)PFModulePublicXtra(this_module);
    InstanceXtra  *instance_xtra;
 
-   instance_xtra = NULL;
+   if ( PFModuleInstanceXtra(this_module) == NULL &&
+	(public_xtra -> type) == 2 )
+      instance_xtra = ctalloc(InstanceXtra, 1);
+   else
+      instance_xtra = (InstanceXtra *)PFModuleInstanceXtra(this_module);
 
    PFModuleInstanceXtra(this_module) = instance_xtra;
    return this_module;
@@ -207,12 +471,13 @@ PFModule  *SelectTimeStepNewPublicXtra()
 
    Type0            *dummy0;
    Type1            *dummy1;
+   Type2            *dummy2;
 
    char *switch_name;
 
    NameArray type_na;
 
-   type_na = NA_NewNameArray("Constant Growth");
+   type_na = NA_NewNameArray("Constant Growth Adaptive");
 
    public_xtra = ctalloc(PublicXtra, 1);
 
@@ -246,6 +511,64 @@ PFModule  *SelectTimeStepNewPublicXtra()
 	 break;
       }
 
+      case 2:
+      {
+	 dummy2 = ctalloc(Type2, 1);
+
+	 dummy2 -> initial_step = GetDouble("TimeStep.InitialStep");
+	 dummy2 -> max_step = GetDouble("TimeStep.MaxStep");
+	 dummy2 -> min_step = GetDouble("TimeStep.MinStep");
+
+	 dummy2 -> min_factor =
+	    GetDoubleDefault("TimeStep.Adaptive.MinFactor", 0.25);
+	 dummy2 -> max_factor =
+	    GetDoubleDefault("TimeStep.Adaptive.MaxFactor", 2.0);
+	 dummy2 -> safety =
+	    GetDoubleDefault("TimeStep.Adaptive.Safety", 0.9);
+	 dummy2 -> failure_factor =
+	    GetDoubleDefault("TimeStep.Adaptive.FailureFactor", 0.5);
+
+	 dummy2 -> target_nonlin_iter =
+	    GetIntDefault("TimeStep.Adaptive.TargetNonlinIter", 5);
+	 dummy2 -> target_lin_iter =
+	    GetIntDefault("TimeStep.Adaptive.TargetLinearIter", 0);
+	 dummy2 -> target_pressure_change =
+	    GetDoubleDefault("TimeStep.Adaptive.TargetPressureChange", 0.0);
+	 dummy2 -> target_saturation_change =
+	    GetDoubleDefault("TimeStep.Adaptive.TargetSaturationChange", 0.1);
+	 dummy2 -> pressure_scale =
+	    GetDoubleDefault("TimeStep.Adaptive.PressureScale", 1.0);
+
+	 if ((dummy2 -> min_factor) <= 0.0 || (dummy2 -> min_factor) > 1.0)
+	 {
+	    InputError("Error: invalid value <%s> for key <%s>\n",
+		       "must be in (0,1]", "TimeStep.Adaptive.MinFactor");
+	 }
+
+	 if ((dummy2 -> max_factor) < 1.0)
+	 {
+	    InputError("Error: invalid value <%s> for key <%s>\n",
+		       "must be at least 1", "TimeStep.Adaptive.MaxFactor");
+	 }
+
+	 if ((dummy2 -> failure_factor) <= 0.0 || 
+	     (dummy2 -> failure_factor) >= 1.0)
+	 {
+	    InputError("Error: invalid value <%s> for key <%s>\n",
+		       "must be in (0,1)", "TimeStep.Adaptive.FailureFactor");
+	 }
+
+	 if ((dummy2 -> pressure_scale) <= 0.0)
+	 {
+	    InputError("Error: invalid value <%s> for key <%s>\n",
+		       "must be positive", "TimeStep.Adaptive.PressureScale");
+	 }
+
+	 (public_xtra -> data) = (void *) dummy2;
+	 
+	 break;
+      }
+
       default:
       {
 	 InputError("Error: invalid type <%s> for key <%s>\n",
@@ -271,6 +594,7 @@ void  SelectTimeStepFreePublicXtra()
 
    Type0        *dummy0;
    Type1        *dummy1;
+   Type2        *dummy2;
 
    if ( public_xtra )
    {
@@ -288,6 +612,12 @@ void  SelectTimeStepFreePublicXtra()
 	 tfree(dummy1);
 	 break;
       }
+      case 2:
+      {
+	 dummy2 = (Type2 *)(public_xtra -> data);
+	 tfree(dummy2);
+	 break;
+      }
       }
 
       tfree(public_xtra);
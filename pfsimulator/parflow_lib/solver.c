@@ -36,6 +36,10 @@
 #include "parflow.h"
 #include "solver.h"
 
+#ifdef PARFLOW_HAVE_OMP
+#include <omp.h>
+#endif
+
 amps_ThreadLocalDcl(PFModule *, Solver_module);
 
 /*--------------------------------------------------------------------------
@@ -98,6 +102,84 @@ void
 
    GlobalsMaxRefLevel = 0;
 
+   {
+      NameArray matvec_na = NA_NewNameArray("Standard Fused");
+
+      switch_name = GetStringDefault("Solver.Matvec.Type", "Fused");
+      GlobalsMatvecType = NA_NameToIndex(matvec_na, switch_name);
+      if (GlobalsMatvecType < 0)
+      {
+	 InputError("Error: Invalid value <%s> for key <%s>\n", switch_name,
+		    "Solver.Matvec.Type");
+      }
+      NA_FreeNameArray(matvec_na);
+
+      GlobalsMatvecTileNY = GetIntDefault("Solver.Matvec.TileNY", 16);
+      GlobalsMatvecTileNZ = GetIntDefault("Solver.Matvec.TileNZ", 0);
+   }
+
+   {
+      NameArray layout_na = NA_NewNameArray("Planar Interleaved");
+
+      switch_name = GetStringDefault("Solver.Matrix.Layout", "Planar");
+      GlobalsMatrixLayout = NA_NameToIndex(layout_na, switch_name);
+      if (GlobalsMatrixLayout < 0)
+      {
+	 InputError("Error: Invalid value <%s> for key <%s>\n", switch_name,
+		    "Solver.Matrix.Layout");
+      }
+      NA_FreeNameArray(layout_na);
+   }
+
+   {
+      NameArray io_na = NA_NewNameArray("AMPS MPIIO");
+
+      switch_name = GetStringDefault("Solver.PFB.IOMode", "AMPS");
+      GlobalsPFBIOMode = NA_NameToIndex(io_na, switch_name);
+      if (GlobalsPFBIOMode < 0)
+      {
+	 InputError("Error: Invalid value <%s> for key <%s>\n", switch_name,
+		    "Solver.PFB.IOMode");
+      }
+      NA_FreeNameArray(io_na);
+
+#ifndef AMPS_HAVE_MPI_IO
+      if (GlobalsPFBIOMode == PFBIOModeMPIIO)
+      {
+	 amps_Printf("Warning: MPI-IO is not available with this AMPS layer, using AMPS for PFB files\n");
+	 GlobalsPFBIOMode = PFBIOModeAMPS;
+      }
+#endif
+   }
+
+   {
+      NameArray switch_na = NA_NewNameArray("False True");
+
+      switch_name = GetStringDefault("Solver.GrGeom.SpanCache", "True");
+      GlobalsGrGeomSpanCache = NA_NameToIndex(switch_na, switch_name);
+      if (GlobalsGrGeomSpanCache < 0)
+      {
+	 InputError("Error: Invalid value <%s> for key <%s>\n", switch_name,
+		    "Solver.GrGeom.SpanCache");
+      }
+      NA_FreeNameArray(switch_na);
+   }
+
+   {
+      int num_threads = GetIntDefault("Process.NumThreads", 0);
+
+#ifdef PARFLOW_HAVE_OMP
+      if (num_threads > 0)
+      {
+	 omp_set_num_threads(num_threads);
+      }
+#else
+      if (num_threads > 1)
+      {
+	 amps_Printf("Warning: ParFlow was not built with OpenMP, ignoring Process.NumThreads\n");
+      }
+#endif
+   }
 
 
    /*-----------------------------------------------------------------------
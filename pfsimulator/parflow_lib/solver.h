@@ -48,6 +48,10 @@
 
 #define CellFaceConductivity  HarmonicMean
 
+/* number of doubles of time step selector state kept in checkpoints,
+   see SelectTimeStepGetState */
+#define SelectTimeStepStateSize  7
+
 
 #endif
 
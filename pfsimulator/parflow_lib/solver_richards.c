@@ -119,6 +119,10 @@ typedef struct
    int                evap_trans_file_transient;                /* read evap_trans as a transient file before advance richards timestep */
    char              *evap_trans_filename;           /* File name for evap trans */
    int                evap_trans_file_looping;                /* Loop over the flux files if we run out */
+
+   double             checkpoint_interval;     /* time between checkpoints, 0 for none */
+   double             checkpoint_wall_clock_limit; /* wall clock seconds the run may use, 0 for no limit */
+   char              *restart_filename;        /* checkpoint to restart from, NULL for none */
     
     
 #ifdef HAVE_CLM                           /* VARIABLES FOR CLM ONLY */
@@ -136,6 +140,7 @@ typedef struct
    int                clm_metforce;       /* CLM met forcing  -- 1=uniform (default), 2=distributed, 3=distributed w/ multiple timesteps */
    int                clm_metnt;          /* CLM met forcing  -- if 3D, length of time axis in each file */
    int                clm_metsub;         /* Flag for met vars in subdirs of clm_metpath or all in clm_metpath */
+   int                clm_metprefetch;    /* Number of 2D/3D met forcing steps (files) to read ahead */
    char              *clm_metfile;        /* File name for 1D forcing *or* base name for 2D forcing */
    char              *clm_metpath;        /* Path to CLM met forcing file(s) */
    double            *sw1d,*lw1d,*prcp1d, /* 1D forcing variables */
@@ -251,6 +256,7 @@ typedef struct
    Vector      *z0m_forc;	          /* Aerodynamic roughness length [m] BH */
    Vector      *displa_forc;	      /* Displacement height [m] 		  BH */
    Vector      *veg_map_forc;	      /* Vegetation map [classes 1-18]	  BH */
+   PFBPrefetch *met_prefetch;         /* read-ahead of 2D/3D met forcing files */
    
    Grid        *snglclm;              /* NBE: New grid for single file CLM ouptut */
    Vector      *clm_out_grid;          /* NBE - Holds multi-layer, single file output of CLM */
@@ -268,6 +274,9 @@ typedef struct
    int          iteration_number;
    double       dump_index;
    double       clm_dump_index;
+   double       checkpoint_index;
+   double       wall_clock_start;     /* seconds, when SetupRichards ran */
+   int          restarted;            /* TRUE once the restart checkpoint is read */
 
 } InstanceXtra; 
 
@@ -569,6 +578,9 @@ void SetupRichards(PFModule *this_module) {
    instance_xtra -> iteration_number = instance_xtra -> file_number = start_count;
    instance_xtra -> dump_index = 1.0;
    instance_xtra -> clm_dump_index = 1.0;
+   instance_xtra -> checkpoint_index = 1.0;
+   instance_xtra -> wall_clock_start = (double)amps_Clock()/AMPS_TICKS_PER_SEC;
+   instance_xtra -> restarted = 0;
 
    if ( ( (t >= stop_time) || (instance_xtra -> iteration_number > public_xtra -> max_iterations) ) 
 	&& ( take_more_time_steps == 1) )
@@ -737,6 +749,9 @@ void SetupRichards(PFModule *this_module) {
       instance_xtra -> veg_map_forc = NewVectorType( metgrid, 1, 1, vector_met );
       InitVectorAll(instance_xtra -> veg_map_forc, 100.0);	
 	  /* BH: end add */
+
+      if ( (public_xtra -> clm_metforce >= 2) && (public_xtra -> clm_metprefetch > 0) )
+         instance_xtra -> met_prefetch = NewPFBPrefetch(public_xtra -> clm_metprefetch);
 	  
       /*IMF If 1D met forcing, read forcing vars to arrays */
       if (public_xtra -> clm_metforce == 1)
@@ -1118,6 +1133,70 @@ void SetupRichards(PFModule *this_module) {
    } /* End if take_more_time_steps */
 }
 
+#ifdef HAVE_CLM
+/*--------------------------------------------------------------------------
+ * MetForcingFilename:
+ *   Name of the 2D (one step at start) or 3D (clm_metnt steps from start)
+ *   met forcing file for variable var.
+ *--------------------------------------------------------------------------*/
+
+static void MetForcingFilename(char *filename, PublicXtra *public_xtra, 
+			       char *var, int start)
+{
+   if ( public_xtra -> clm_metforce == 2 )
+   {
+      if ( public_xtra -> clm_metsub )
+	 sprintf(filename, "%s/%s/%s.%s.%06d.pfb", public_xtra -> clm_metpath, var,
+		 public_xtra -> clm_metfile, var, start);
+      else
+	 sprintf(filename, "%s/%s.%s.%06d.pfb", public_xtra -> clm_metpath, 
+		 public_xtra -> clm_metfile, var, start);
+   }
+   else
+   {
+      if ( public_xtra -> clm_metsub )
+	 sprintf(filename, "%s/%s/%s.%s.%06d_to_%06d.pfb", public_xtra -> clm_metpath, var,
+		 public_xtra -> clm_metfile, var, start, start - 1 + public_xtra -> clm_metnt);
+      else
+	 sprintf(filename, "%s/%s.%s.%06d_to_%06d.pfb", public_xtra -> clm_metpath, 
+		 public_xtra -> clm_metfile, var, start, start - 1 + public_xtra -> clm_metnt);
+   }
+}
+
+/*--------------------------------------------------------------------------
+ * MetForcingPrefetch:
+ *   Start reading the met forcing files of the clm_metprefetch steps (2D)
+ *   or blocks of clm_metnt steps (3D) following the one starting at start.
+ *--------------------------------------------------------------------------*/
+
+static void MetForcingPrefetch(PublicXtra *public_xtra, InstanceXtra *instance_xtra, 
+			       int start)
+{
+   char   *vars[12] = {"DSWR", "DLWR", "APCP", "Temp", "UGRD", "VGRD", "Press", "SPFH",
+		       "LAI", "SAI", "Z0M", "DISPLA"};
+   char    names[12][255];
+   char   *filenames[12];
+   int     num_vars;
+   int     step, n, w;
+
+   step     = (public_xtra -> clm_metforce == 2) ? 1 : public_xtra -> clm_metnt;
+   num_vars = ( (public_xtra -> clm_metforce == 3) && 
+		(public_xtra -> clm_forc_veg == 1) ) ? 12 : 8;
+
+   for (w = 1; w <= public_xtra -> clm_metprefetch; w++)
+   {
+      for (n = 0; n < num_vars; n++)
+      {
+	 MetForcingFilename(names[n], public_xtra, vars[n], start + w*step);
+	 filenames[n] = names[n];
+      }
+
+      PFBPrefetchStart(instance_xtra -> met_prefetch, start + w*step, 
+		       filenames, num_vars);
+   }
+}
+#endif
+
 void AdvanceRichards(PFModule *this_module, 
 		     double start_time,      /* Starting time */
 		     double stop_time,       /* Stopping time */
@@ -1224,6 +1303,15 @@ void AdvanceRichards(PFModule *this_module,
    int           conv_failures;
    int           max_failures         = public_xtra -> max_convergence_failures;
 
+   int           write_checkpoint;
+   int           num_checkpoint_vectors;
+   Vector       *checkpoint_vectors[7];
+   double        checkpoint_scalars[11 + SelectTimeStepStateSize];
+   double        checkpoint_interval  = public_xtra -> checkpoint_interval;
+   double        wall_clock_limit     = public_xtra -> checkpoint_wall_clock_limit;
+   double        wall_clock, last_wall_clock;
+   double        max_step_wall_clock  = 0.0;
+
    double        t;
    double        dt = 0.0;
    double        ct = 0.0;
@@ -1324,6 +1412,66 @@ void AdvanceRichards(PFModule *this_module,
    fstop  = 0;                                  // init to something, only used with 3D met forcing
 #endif
 
+   /*
+    * State kept in checkpoints.  Everything else is either input or is
+    * recomputed from these at the start of the next step.
+    */
+   num_checkpoint_vectors = 0;
+   checkpoint_vectors[num_checkpoint_vectors++] = instance_xtra -> pressure;
+   checkpoint_vectors[num_checkpoint_vectors++] = instance_xtra -> saturation;
+   checkpoint_vectors[num_checkpoint_vectors++] = instance_xtra -> density;
+   checkpoint_vectors[num_checkpoint_vectors++] = instance_xtra -> ovrl_bc_flx;
+   checkpoint_vectors[num_checkpoint_vectors++] = evap_trans;
+   checkpoint_vectors[num_checkpoint_vectors++] = evap_trans_sum;
+   if (overland_sum)
+      checkpoint_vectors[num_checkpoint_vectors++] = overland_sum;
+
+   if ( (public_xtra -> restart_filename) && !(instance_xtra -> restarted) )
+   {
+      int n;
+
+      ReadCheckpoint(public_xtra -> restart_filename, 
+		     checkpoint_scalars, 11 + SelectTimeStepStateSize,
+		     checkpoint_vectors, num_checkpoint_vectors);
+
+      for(n = 0; n < num_checkpoint_vectors; n++)
+      {
+	 if (VectorNumGhost(checkpoint_vectors[n]) > 0)
+	 {
+	    handle = InitVectorUpdate(checkpoint_vectors[n], VectorUpdateAll);
+	    FinalizeVectorUpdate(handle);
+	 }
+      }
+
+      t  = checkpoint_scalars[0];
+      dt = checkpoint_scalars[1];
+      ct = t;
+      instance_xtra -> iteration_number = (int) checkpoint_scalars[2];
+      instance_xtra -> file_number      = (int) checkpoint_scalars[3];
+      instance_xtra -> dump_index       = checkpoint_scalars[4];
+      instance_xtra -> clm_dump_index   = checkpoint_scalars[5];
+      instance_xtra -> checkpoint_index = checkpoint_scalars[6];
+#ifdef HAVE_CLM
+      istep    = (int) checkpoint_scalars[7];
+      clm_next = (int) checkpoint_scalars[8];
+#endif
+      Stepcount = (int) checkpoint_scalars[9];
+      Loopcount = (int) checkpoint_scalars[10];
+
+      /* so the next step is chosen as it was in the run that wrote it */
+      SelectTimeStepSetState(select_time_step, &checkpoint_scalars[11]);
+
+      instance_xtra -> restarted = 1;
+
+      if(!amps_Rank(amps_CommWorld))
+      {
+	 amps_Printf("Restarting from checkpoint %s at time %e\n",
+		     public_xtra -> restart_filename, t);
+      }
+   }
+
+   last_wall_clock = (double)amps_Clock()/AMPS_TICKS_PER_SEC;
+
    do  /* while take_more_time_steps */
    {
       if (t == ct)
@@ -1441,41 +1589,45 @@ void AdvanceRichards(PFModule *this_module,
             if ( public_xtra -> clm_metsub )
             {
                sprintf(filename, "%s/%s/%s.%s.%06d.pfb", public_xtra -> clm_metpath, "DSWR",  public_xtra -> clm_metfile, "DSWR",  istep);
-               ReadPFBinary( filename, instance_xtra -> sw_forc );  
+               PFBPrefetchReadPFBinary( instance_xtra -> met_prefetch, filename, instance_xtra -> sw_forc );  
                sprintf(filename, "%s/%s/%s.%s.%06d.pfb", public_xtra -> clm_metpath, "DLWR",  public_xtra -> clm_metfile, "DLWR",  istep);
-               ReadPFBinary( filename, instance_xtra -> lw_forc );
+               PFBPrefetchReadPFBinary( instance_xtra -> met_prefetch, filename, instance_xtra -> lw_forc );
                sprintf(filename, "%s/%s/%s.%s.%06d.pfb", public_xtra -> clm_metpath, "APCP",  public_xtra -> clm_metfile, "APCP",  istep);
-               ReadPFBinary( filename, instance_xtra -> prcp_forc );
+               PFBPrefetchReadPFBinary( instance_xtra -> met_prefetch, filename, instance_xtra -> prcp_forc );
                sprintf(filename, "%s/%s/%s.%s.%06d.pfb", public_xtra -> clm_metpath, "Temp",  public_xtra -> clm_metfile, "Temp",  istep);
-               ReadPFBinary( filename, instance_xtra -> tas_forc );
+               PFBPrefetchReadPFBinary( instance_xtra -> met_prefetch, filename, instance_xtra -> tas_forc );
                sprintf(filename, "%s/%s/%s.%s.%06d.pfb", public_xtra -> clm_metpath, "UGRD",  public_xtra -> clm_metfile, "UGRD",  istep);
-               ReadPFBinary( filename, instance_xtra -> u_forc );
+               PFBPrefetchReadPFBinary( instance_xtra -> met_prefetch, filename, instance_xtra -> u_forc );
                sprintf(filename, "%s/%s/%s.%s.%06d.pfb", public_xtra -> clm_metpath, "VGRD",  public_xtra -> clm_metfile, "VGRD",  istep);
-               ReadPFBinary( filename, instance_xtra -> v_forc );
+               PFBPrefetchReadPFBinary( instance_xtra -> met_prefetch, filename, instance_xtra -> v_forc );
                sprintf(filename, "%s/%s/%s.%s.%06d.pfb", public_xtra -> clm_metpath, "Press", public_xtra -> clm_metfile, "Press", istep);
-               ReadPFBinary( filename, instance_xtra -> patm_forc );
+               PFBPrefetchReadPFBinary( instance_xtra -> met_prefetch, filename, instance_xtra -> patm_forc );
                sprintf(filename, "%s/%s/%s.%s.%06d.pfb", public_xtra -> clm_metpath, "SPFH",  public_xtra -> clm_metfile, "SPFH",  istep);
-               ReadPFBinary( filename, instance_xtra -> qatm_forc );
+               PFBPrefetchReadPFBinary( instance_xtra -> met_prefetch, filename, instance_xtra -> qatm_forc );
             }
             else
             {
                sprintf(filename, "%s/%s.%s.%06d.pfb", public_xtra -> clm_metpath, public_xtra -> clm_metfile, "DSWR", istep);
-               ReadPFBinary( filename, instance_xtra -> sw_forc );
+               PFBPrefetchReadPFBinary( instance_xtra -> met_prefetch, filename, instance_xtra -> sw_forc );
                sprintf(filename, "%s/%s.%s.%06d.pfb", public_xtra -> clm_metpath, public_xtra -> clm_metfile, "DLWR", istep);
-               ReadPFBinary( filename, instance_xtra -> lw_forc );
+               PFBPrefetchReadPFBinary( instance_xtra -> met_prefetch, filename, instance_xtra -> lw_forc );
                sprintf(filename, "%s/%s.%s.%06d.pfb", public_xtra -> clm_metpath, public_xtra -> clm_metfile, "APCP", istep);
-               ReadPFBinary( filename, instance_xtra -> prcp_forc );
+               PFBPrefetchReadPFBinary( instance_xtra -> met_prefetch, filename, instance_xtra -> prcp_forc );
                sprintf(filename, "%s/%s.%s.%06d.pfb", public_xtra -> clm_metpath, public_xtra -> clm_metfile, "Temp", istep);
-               ReadPFBinary( filename, instance_xtra -> tas_forc );
+               PFBPrefetchReadPFBinary( instance_xtra -> met_prefetch, filename, instance_xtra -> tas_forc );
                sprintf(filename, "%s/%s.%s.%06d.pfb", public_xtra -> clm_metpath, public_xtra -> clm_metfile, "UGRD", istep);
-               ReadPFBinary( filename, instance_xtra -> u_forc );
+               PFBPrefetchReadPFBinary( instance_xtra -> met_prefetch, filename, instance_xtra -> u_forc );
                sprintf(filename, "%s/%s.%s.%06d.pfb", public_xtra -> clm_metpath, public_xtra -> clm_metfile, "VGRD", istep);
-               ReadPFBinary( filename, instance_xtra -> v_forc );
+               PFBPrefetchReadPFBinary( instance_xtra -> met_prefetch, filename, instance_xtra -> v_forc );
                sprintf(filename, "%s/%s.%s.%06d.pfb", public_xtra -> clm_metpath, public_xtra -> clm_metfile, "Press", istep);
-               ReadPFBinary( filename, instance_xtra -> patm_forc );
+               PFBPrefetchReadPFBinary( instance_xtra -> met_prefetch, filename, instance_xtra -> patm_forc );
                sprintf(filename, "%s/%s.%s.%06d.pfb", public_xtra -> clm_metpath, public_xtra -> clm_metfile, "SPFH", istep);
-               ReadPFBinary( filename, instance_xtra -> qatm_forc );
+               PFBPrefetchReadPFBinary( instance_xtra -> met_prefetch, filename, instance_xtra -> qatm_forc );
             }  //end if/else (clm_metsub==True)
+
+            // Read the following steps' files while this step is solved
+            if ( instance_xtra -> met_prefetch )
+               MetForcingPrefetch(public_xtra, instance_xtra, istep);
          }  //end if (clm_metforce==2)         
 
          /* IMF: If 3D met forcing... */
@@ -1508,54 +1660,54 @@ void AdvanceRichards(PFModule *this_module,
 
                   sprintf(filename, "%s/%s/%s.%s.%06d_to_%06d.pfb", public_xtra -> clm_metpath, "DSWR", 
                           public_xtra -> clm_metfile, "DSWR", fstart, fstop );
-                  ReadPFBinary( filename, instance_xtra -> sw_forc );
+                  PFBPrefetchReadPFBinary( instance_xtra -> met_prefetch, filename, instance_xtra -> sw_forc );
 
                   sprintf(filename, "%s/%s/%s.%s.%06d_to_%06d.pfb", public_xtra -> clm_metpath, "DLWR", 
                           public_xtra -> clm_metfile, "DLWR", fstart, fstop );
-                  ReadPFBinary( filename, instance_xtra -> lw_forc );
+                  PFBPrefetchReadPFBinary( instance_xtra -> met_prefetch, filename, instance_xtra -> lw_forc );
 
                   sprintf(filename, "%s/%s/%s.%s.%06d_to_%06d.pfb", public_xtra -> clm_metpath, "APCP", 
                           public_xtra -> clm_metfile, "APCP", fstart, fstop );
-                  ReadPFBinary( filename, instance_xtra -> prcp_forc );
+                  PFBPrefetchReadPFBinary( instance_xtra -> met_prefetch, filename, instance_xtra -> prcp_forc );
 
                   sprintf(filename, "%s/%s/%s.%s.%06d_to_%06d.pfb", public_xtra -> clm_metpath, "Temp", 
                           public_xtra -> clm_metfile, "Temp", fstart, fstop );
-                  ReadPFBinary( filename, instance_xtra -> tas_forc );
+                  PFBPrefetchReadPFBinary( instance_xtra -> met_prefetch, filename, instance_xtra -> tas_forc );
 
                   sprintf(filename, "%s/%s/%s.%s.%06d_to_%06d.pfb", public_xtra -> clm_metpath, "UGRD", 
                           public_xtra -> clm_metfile, "UGRD", fstart, fstop);
-                  ReadPFBinary( filename, instance_xtra -> u_forc );
+                  PFBPrefetchReadPFBinary( instance_xtra -> met_prefetch, filename, instance_xtra -> u_forc );
 
                   sprintf(filename, "%s/%s/%s.%s.%06d_to_%06d.pfb", public_xtra -> clm_metpath, "VGRD", 
                           public_xtra -> clm_metfile, "VGRD", fstart, fstop );
-                  ReadPFBinary( filename, instance_xtra -> v_forc );
+                  PFBPrefetchReadPFBinary( instance_xtra -> met_prefetch, filename, instance_xtra -> v_forc );
 
                   sprintf(filename, "%s/%s/%s.%s.%06d_to_%06d.pfb", public_xtra -> clm_metpath, "Press",
                           public_xtra -> clm_metfile, "Press", fstart, fstop );
-                  ReadPFBinary( filename, instance_xtra -> patm_forc );
+                  PFBPrefetchReadPFBinary( instance_xtra -> met_prefetch, filename, instance_xtra -> patm_forc );
 
                   sprintf(filename, "%s/%s/%s.%s.%06d_to_%06d.pfb", public_xtra -> clm_metpath, "SPFH", 
                           public_xtra -> clm_metfile, "SPFH", fstart, fstop );
-                  ReadPFBinary( filename, instance_xtra -> qatm_forc );
+                  PFBPrefetchReadPFBinary( instance_xtra -> met_prefetch, filename, instance_xtra -> qatm_forc );
 				  
 				  /*BH: added the option to force vegetation or not*/
 				  if (public_xtra -> clm_forc_veg == 1)
 				  {
 					  sprintf(filename, "%s/%s/%s.%s.%06d_to_%06d.pfb", public_xtra -> clm_metpath, "LAI",
 							  public_xtra -> clm_metfile, "LAI", fstart, fstop );
-					  ReadPFBinary( filename, instance_xtra -> lai_forc );
+					  PFBPrefetchReadPFBinary( instance_xtra -> met_prefetch, filename, instance_xtra -> lai_forc );
 
 					  sprintf(filename, "%s/%s/%s.%s.%06d_to_%06d.pfb", public_xtra -> clm_metpath, "SAI",
 							  public_xtra -> clm_metfile, "SAI", fstart, fstop );
-					  ReadPFBinary( filename, instance_xtra -> sai_forc );
+					  PFBPrefetchReadPFBinary( instance_xtra -> met_prefetch, filename, instance_xtra -> sai_forc );
 
 					  sprintf(filename, "%s/%s/%s.%s.%06d_to_%06d.pfb", public_xtra -> clm_metpath, "Z0M", 
 							  public_xtra -> clm_metfile, "Z0M", fstart, fstop );
-					  ReadPFBinary( filename, instance_xtra -> z0m_forc );
+					  PFBPrefetchReadPFBinary( instance_xtra -> met_prefetch, filename, instance_xtra -> z0m_forc );
 
 					  sprintf(filename, "%s/%s/%s.%s.%06d_to_%06d.pfb", public_xtra -> clm_metpath, "DISPLA", 
 							  public_xtra -> clm_metfile, "DISPLA", fstart, fstop );
-					  ReadPFBinary( filename, instance_xtra -> displa_forc );
+					  PFBPrefetchReadPFBinary( instance_xtra -> met_prefetch, filename, instance_xtra -> displa_forc );
 				 }
 				 /*BH: end added the option to force vegetation or not*/
 				  
@@ -1565,58 +1717,62 @@ void AdvanceRichards(PFModule *this_module,
 
                   sprintf(filename, "%s/%s.%s.%06d_to_%06d.pfb", public_xtra -> clm_metpath, 
                           public_xtra -> clm_metfile, "DSWR", fstart, fstop );
-                  ReadPFBinary( filename, instance_xtra -> sw_forc );
+                  PFBPrefetchReadPFBinary( instance_xtra -> met_prefetch, filename, instance_xtra -> sw_forc );
 
                   sprintf(filename, "%s/%s.%s.%06d_to_%06d.pfb", public_xtra -> clm_metpath, 
                           public_xtra -> clm_metfile, "DLWR", fstart, fstop );
-                  ReadPFBinary( filename, instance_xtra -> lw_forc );
+                  PFBPrefetchReadPFBinary( instance_xtra -> met_prefetch, filename, instance_xtra -> lw_forc );
 
                   sprintf(filename, "%s/%s.%s.%06d_to_%06d.pfb", public_xtra -> clm_metpath,  
                           public_xtra -> clm_metfile, "APCP", fstart, fstop );
-                  ReadPFBinary( filename, instance_xtra -> prcp_forc );
+                  PFBPrefetchReadPFBinary( instance_xtra -> met_prefetch, filename, instance_xtra -> prcp_forc );
 
                   sprintf(filename, "%s/%s.%s.%06d_to_%06d.pfb", public_xtra -> clm_metpath, 
                           public_xtra -> clm_metfile, "Temp", fstart, fstop );
-                  ReadPFBinary( filename, instance_xtra -> tas_forc );
+                  PFBPrefetchReadPFBinary( instance_xtra -> met_prefetch, filename, instance_xtra -> tas_forc );
 
                   sprintf(filename, "%s/%s.%s.%06d_to_%06d.pfb", public_xtra -> clm_metpath, 
                           public_xtra -> clm_metfile, "UGRD", fstart, fstop );
-                  ReadPFBinary( filename, instance_xtra -> u_forc );
+                  PFBPrefetchReadPFBinary( instance_xtra -> met_prefetch, filename, instance_xtra -> u_forc );
 
                   sprintf(filename, "%s/%s.%s.%06d_to_%06d.pfb", public_xtra -> clm_metpath, 
                           public_xtra -> clm_metfile, "VGRD", fstart, fstop );
-                  ReadPFBinary( filename, instance_xtra -> v_forc );
+                  PFBPrefetchReadPFBinary( instance_xtra -> met_prefetch, filename, instance_xtra -> v_forc );
 
                   sprintf(filename, "%s/%s.%s.%06d_to_%06d.pfb", public_xtra -> clm_metpath, 
                           public_xtra -> clm_metfile, "Press", fstart, fstop );
-                  ReadPFBinary( filename, instance_xtra -> patm_forc );
+                  PFBPrefetchReadPFBinary( instance_xtra -> met_prefetch, filename, instance_xtra -> patm_forc );
 
                   sprintf(filename, "%s/%s.%s.%06d_to_%06d.pfb", public_xtra -> clm_metpath, 
                           public_xtra -> clm_metfile, "SPFH", fstart, fstop );
-                  ReadPFBinary( filename, instance_xtra -> qatm_forc );
+                  PFBPrefetchReadPFBinary( instance_xtra -> met_prefetch, filename, instance_xtra -> qatm_forc );
 				  
 				   /*BH: added the option to force vegetation or not*/
 				 if (public_xtra -> clm_forc_veg == 1)
 				 {
                   sprintf(filename, "%s/%s.%s.%06d_to_%06d.pfb", public_xtra -> clm_metpath,
                           public_xtra -> clm_metfile, "LAI", fstart, fstop );
-                  ReadPFBinary( filename, instance_xtra -> lai_forc );	
+                  PFBPrefetchReadPFBinary( instance_xtra -> met_prefetch, filename, instance_xtra -> lai_forc );	
 
                   sprintf(filename, "%s/%s.%s.%06d_to_%06d.pfb", public_xtra -> clm_metpath,
                           public_xtra -> clm_metfile, "SAI", fstart, fstop );	
-                  ReadPFBinary( filename, instance_xtra -> sai_forc );	
+                  PFBPrefetchReadPFBinary( instance_xtra -> met_prefetch, filename, instance_xtra -> sai_forc );	
 
                   sprintf(filename, "%s/%s.%s.%06d_to_%06d.pfb", public_xtra -> clm_metpath,
                           public_xtra -> clm_metfile, "Z0M", fstart, fstop );	
-                  ReadPFBinary( filename, instance_xtra -> z0m_forc );	
+                  PFBPrefetchReadPFBinary( instance_xtra -> met_prefetch, filename, instance_xtra -> z0m_forc );	
 
                   sprintf(filename, "%s/%s.%s.%06d_to_%06d.pfb", public_xtra -> clm_metpath,
                           public_xtra -> clm_metfile, "DISPLA", fstart, fstop );	
-                  ReadPFBinary( filename, instance_xtra -> displa_forc );			
+                  PFBPrefetchReadPFBinary( instance_xtra -> met_prefetch, filename, instance_xtra -> displa_forc );			
 				 }		
                  /*BH: end added the option to force vegetation or not*/				 
 				  
                }  // end if/else clm_metsub==False
+
+               // Read the following blocks while these are used
+               if ( instance_xtra -> met_prefetch )
+                  MetForcingPrefetch(public_xtra, instance_xtra, fstart);
              }  //end if (fstep==0)
          }  //end if (clm_metforce==3)
               
@@ -1960,6 +2116,10 @@ void AdvanceRichards(PFModule *this_module,
 
 	    double new_dt = 0.5 * dt;
 
+	    if(!time_step_control) {
+	       new_dt = SelectTimeStepFailedStep(select_time_step, dt);
+	    }
+
 	    // If time increment is too small don't try to cut in half.
 	    {
 	       double test_time = t + new_dt;
@@ -2280,6 +2440,23 @@ void AdvanceRichards(PFModule *this_module,
 		      instance_xtra -> density, gravity, problem_data,
 		      CALCFCN));
 
+      /* Tell the time step selector how the step went; this has to come
+	 after the saturations are recomputed since the nonlinear solver
+	 uses the saturation vector as work space. */
+      if(converged && !time_step_control) {
+	 int num_nonlin_iter, num_lin_iter;
+
+	 KinsolNonlinSolverStepStats(nonlin_solver, 
+				     &num_nonlin_iter, &num_lin_iter);
+	 SelectTimeStepReportStep(select_time_step, 
+				  num_nonlin_iter, num_lin_iter,
+				  instance_xtra -> pressure, 
+				  instance_xtra -> old_pressure,
+				  instance_xtra -> saturation, 
+				  instance_xtra -> old_saturation,
+				  ProblemDataGrDomain(problem_data));
+      }
+
       /***************************************************************
        * Compute running sum of evap trans for water balance 
        **************************************************************/
@@ -2783,6 +2960,53 @@ void AdvanceRichards(PFModule *this_module,
 	    (t < stop_time);
       }
 
+      /*-----------------------------------------------------------------
+       * Checkpoint every checkpoint_interval of simulated time, and stop
+       * with a checkpoint when the next step might not finish within
+       * the wall clock limit.  The longest step so far is taken as the
+       * estimate of the next one.
+       *-----------------------------------------------------------------*/
+
+      write_checkpoint = 0;
+
+      if ( checkpoint_interval > 0.0 )
+      {
+	 while ( (t + TIME_EPSILON) >= ProblemStartTime(problem) + 
+		 instance_xtra -> checkpoint_index * checkpoint_interval )
+	 {
+	    instance_xtra -> checkpoint_index++;
+	    write_checkpoint = 1;
+	 }
+      }
+
+      if ( wall_clock_limit > 0.0 && take_more_time_steps )
+      {
+	 amps_Invoice invoice;
+
+	 wall_clock = (double)amps_Clock()/AMPS_TICKS_PER_SEC;
+	 max_step_wall_clock = pfmax(max_step_wall_clock, 
+				     wall_clock - last_wall_clock);
+	 last_wall_clock = wall_clock;
+
+	 /* all processes have to make the same decision */
+	 wall_clock -= instance_xtra -> wall_clock_start;
+	 invoice = amps_NewInvoice("%d%d", &wall_clock, &max_step_wall_clock);
+	 amps_AllReduce(amps_CommWorld, invoice, amps_Max);
+	 amps_FreeInvoice(invoice);
+
+	 if ( wall_clock + max_step_wall_clock >= wall_clock_limit )
+	 {
+	    if(!amps_Rank(amps_CommWorld))
+	    {
+	       amps_Printf("Wall clock limit %g (s) nearly reached after %g (s), halting execution\n",
+			   wall_clock_limit, wall_clock);
+	    }
+
+	    take_more_time_steps = 0;
+	    write_checkpoint = 1;
+	 }
+      }
+
 #ifdef HAVE_SLURM
       /*
        * If at end of a dump_interval and user requests halt if
@@ -2807,10 +3031,44 @@ void AdvanceRichards(PFModule *this_module,
 	    }
 	    
 	    take_more_time_steps = 0;
+	    write_checkpoint = 1;
 	 }
       }
 #endif
 
+      if ( write_checkpoint && converged )
+      {
+	 checkpoint_scalars[0]  = t;
+	 checkpoint_scalars[1]  = dt;
+	 checkpoint_scalars[2]  = instance_xtra -> iteration_number;
+	 checkpoint_scalars[3]  = instance_xtra -> file_number;
+	 checkpoint_scalars[4]  = instance_xtra -> dump_index;
+	 checkpoint_scalars[5]  = instance_xtra -> clm_dump_index;
+	 checkpoint_scalars[6]  = instance_xtra -> checkpoint_index;
+#ifdef HAVE_CLM
+	 checkpoint_scalars[7]  = istep;
+	 checkpoint_scalars[8]  = clm_next;
+#else
+	 checkpoint_scalars[7]  = 0;
+	 checkpoint_scalars[8]  = 0;
+#endif
+	 checkpoint_scalars[9]  = Stepcount;
+	 checkpoint_scalars[10] = Loopcount;
+
+	 SelectTimeStepGetState(select_time_step, &checkpoint_scalars[11]);
+
+	 sprintf(file_postfix, "checkpoint.%05d", instance_xtra -> iteration_number);
+	 WriteCheckpoint(file_prefix, file_postfix, 
+			 checkpoint_scalars, 11 + SelectTimeStepStateSize,
+			 checkpoint_vectors, num_checkpoint_vectors);
+
+	 if(!amps_Rank(amps_CommWorld))
+	 {
+	    amps_Printf("Wrote checkpoint %s.%s.pfcp at time %e\n",
+			file_prefix, file_postfix, t);
+	 }
+      }
+
    }   /* ends do for time loop */
    while( take_more_time_steps );
 
@@ -3015,6 +3273,9 @@ void TeardownRichards(PFModule *this_module) {
       FreeVector(instance_xtra -> z0m_forc);
       FreeVector(instance_xtra -> displa_forc);	
       FreeVector(instance_xtra -> veg_map_forc);
+
+      FreePFBPrefetch(instance_xtra -> met_prefetch);
+      instance_xtra -> met_prefetch = NULL;
    }
 
 
@@ -3835,6 +4096,15 @@ PFModule   *SolverRichardsNewPublicXtra(char *name)
    }
    public_xtra -> clm_metsub = switch_value;
 
+   /* Number of 2D met forcing steps, or 3D blocks of MetFileNT steps, 
+      to read ahead in the background (0 turns read-ahead off) */
+   sprintf(key, "%s.CLM.MetForcingPrefetch", name);
+   public_xtra -> clm_metprefetch = GetIntDefault(key, 0);
+   if (public_xtra -> clm_metprefetch < 0)
+   {
+      public_xtra -> clm_metprefetch = 0;
+   }
+
    /* IMF Key for CLM met file name...
       for 1D forcing, is complete file name
       for 2D/3D forcing, is base file name (w/o timestep extension) */
@@ -4618,6 +4888,17 @@ PFModule   *SolverRichardsNewPublicXtra(char *name)
     sprintf(key, "%s.EvapTrans.FileName", name);
     public_xtra -> evap_trans_filename = GetStringDefault(key, "");
 
+    /* checkpoint/restart */
+    sprintf(key, "%s.Checkpoint.Interval", name);
+    public_xtra -> checkpoint_interval = GetDoubleDefault(key, 0.0);
+
+    sprintf(key, "%s.Checkpoint.WallClockLimit", name);
+    public_xtra -> checkpoint_wall_clock_limit = GetDoubleDefault(key, 0.0);
+
+    sprintf(key, "%s.Checkpoint.RestartFile", name);
+    switch_name = GetStringDefault(key, "");
+    public_xtra -> restart_filename = (strlen(switch_name) > 0) ? switch_name : NULL;
+
     
     /* Initialize silo if necessary */
     if( public_xtra -> write_silopmpio_subsurf_data || 
@@ -116,15 +116,22 @@ void  PrintTiming()
 {
    amps_File     file = NULL;
    amps_Invoice  max_invoice;
+   amps_Invoice  count_invoice;
 
    double time_ticks;
    double cpu_ticks;
    double mflops;
 
+   int    vector_allocs;
+   int    pool_checkouts;
+   int    pool_allocs;
+
    int     i;
 
 
    max_invoice = amps_NewInvoice("%d%d", &time_ticks, &cpu_ticks);
+   count_invoice = amps_NewInvoice("%i%i%i", &vector_allocs,
+				   &pool_checkouts, &pool_allocs);
 
    IfLogging(0)
       file = OpenLogFile("Timing");
@@ -162,6 +169,21 @@ void  PrintTiming()
       }
    }
 
+   /* Vector allocation counts, a rise in NewVectorType calls per
+      time step shows work vectors being allocated in a hot loop */
+   vector_allocs  = TimingVectorAllocCount;
+   pool_checkouts = TimingPoolCheckoutCount;
+   pool_allocs    = TimingPoolAllocCount;
+   amps_AllReduce(amps_CommWorld, count_invoice, amps_Max);
+
+   IfLogging(0)
+   {
+      amps_Fprintf(file,"Vector Allocations:\n");
+      amps_Fprintf(file,"  NewVectorType calls  = %d\n", vector_allocs);
+      amps_Fprintf(file,"  pool checkouts       = %d\n", pool_checkouts);
+      amps_Fprintf(file,"  pool allocations     = %d\n", pool_allocs);
+   }
+
    IfLogging(0)
       CloseLogFile(file);
 
@@ -191,6 +213,7 @@ void  PrintTiming()
 #endif
 
    amps_FreeInvoice(max_invoice);
+   amps_FreeInvoice(count_invoice);
 }
 
 
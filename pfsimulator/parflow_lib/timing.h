@@ -72,6 +72,10 @@ typedef struct
    amps_CPUClock_t   CPU_count;
    FLOPType          FLOP_count;
 
+   int               vector_alloc_count;   /* NewVectorType calls */
+   int               pool_checkout_count;  /* CheckoutVector calls */
+   int               pool_alloc_count;     /* CheckoutVector allocations */
+
 } TimingType;
 
 #ifdef PARFLOW_GLOBALS
@@ -97,11 +101,18 @@ amps_ThreadLocalDcl(extern TimingType *, timing_ptr);
 #define TimingCPUCount   (timing -> CPU_count)
 #define TimingFLOPCount  (timing -> FLOP_count)
 
+#define TimingVectorAllocCount  (timing -> vector_alloc_count)
+#define TimingPoolCheckoutCount (timing -> pool_checkout_count)
+#define TimingPoolAllocCount    (timing -> pool_alloc_count)
+
 /*--------------------------------------------------------------------------
  * Timing macros
  *--------------------------------------------------------------------------*/
 
 #define IncFLOPCount(inc) TimingFLOPCount += (FLOPType) inc
+#define IncVectorAllocCount()   TimingVectorAllocCount++
+#define IncPoolCheckoutCount()  TimingPoolCheckoutCount++
+#define IncPoolAllocCount()     TimingPoolAllocCount++
 #define StartTiming()     TimingTimeCount -= amps_Clock(); \
                           TimingCPUCount -= amps_CPUClock()
 #define StopTiming()      TimingTimeCount += amps_Clock(); \
@@ -164,6 +175,9 @@ extern EventTiming[][6];
  *--------------------------------------------------------------------------*/
 
 #define IncFLOPCount(inc)
+#define IncVectorAllocCount()
+#define IncPoolCheckoutCount()
+#define IncPoolAllocCount()
 #define StartTiming()
 #define StopTiming()
 #define BeginTiming(i) if(i == 0)
@@ -0,0 +1,521 @@
+/*BHEADER**********************************************************************
+
+  Copyright (c) 1995-2009, Lawrence Livermore National Security,
+  LLC. Produced at the Lawrence Livermore National Laboratory. Written
+  by the Parflow Team (see the CONTRIBUTORS file)
+  <parflow@lists.llnl.gov> CODE-OCEC-08-103. All rights reserved.
+
+  This file is part of Parflow. For details, see
+  http://www.llnl.gov/casc/parflow
+
+  Please read the COPYRIGHT file or Our Notice and the LICENSE file
+  for the GNU Lesser General Public License.
+
+  This program is free software; you can redistribute it and/or modify
+  it under the terms of the GNU General Public License (as published
+  by the Free Software Foundation) version 2.1 dated February 1999.
+
+  This program is distributed in the hope that it will be useful, but
+  WITHOUT ANY WARRANTY; without even the IMPLIED WARRANTY OF
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the terms
+  and conditions of the GNU General Public License for more details.
+
+  You should have received a copy of the GNU Lesser General Public
+  License along with this program; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307
+  USA
+**********************************************************************EHEADER*/
+/******************************************************************************
+ *
+ * Van Genuchten lookup tables shared by the relative permeability and
+ * saturation modules.  The module supplies the curve as a VanGFunction;
+ * the table samples the curve and its derivative and sets up the spline
+ * or linear interpolation, the lookups are inlined from vang_table.h.
+ *
+ *****************************************************************************/
+
+#include "parflow.h"
+
+#include <float.h>
+
+
+/*--------------------------------------------------------------------------
+ * NewVanGTable
+ *--------------------------------------------------------------------------*/
+
+VanGTable *NewVanGTable(
+   int          interpolation_method,
+   int          num_sample_points,
+   double       min_pressure_head,
+   double       alpha,
+   double       n,
+   VanGFunction function)
+{
+   double *x,*a,*d,*a_der,*d_der;
+   
+   VanGTable *new_table = ctalloc(VanGTable, 1);
+
+   new_table -> interpolation_method = interpolation_method;
+
+   new_table -> num_sample_points = num_sample_points;
+   new_table -> min_pressure_head = min_pressure_head;
+
+   new_table -> function = function;
+   new_table -> alpha    = alpha;
+   new_table -> n        = n;
+
+   new_table -> x = ctalloc(double, num_sample_points+1);// interpolation points
+   new_table -> a = ctalloc(double, num_sample_points+1);// function value at interpolation point
+   new_table -> d = ctalloc(double, num_sample_points+1);// derivative used in monotonic spline
+   new_table -> a_der = ctalloc(double, num_sample_points+1);// function derivative value
+   new_table -> d_der = ctalloc(double, num_sample_points+1);// derivative of function derivative
+
+   /* Fill in slope for linear interpolation */
+   if(interpolation_method == 1) {
+      new_table -> slope     = ctalloc(double, num_sample_points+1);// slope for linear interpolation
+      new_table -> slope_der = ctalloc(double, num_sample_points+1);// slope for linear interpolation
+   }
+ 
+   x = new_table -> x;
+   a = new_table -> a;
+   d = new_table -> d;
+   a_der = new_table -> a_der;
+   d_der = new_table -> d_der;
+
+   double h[num_sample_points+1];
+   double f[num_sample_points+1],del[num_sample_points+1],f_der[num_sample_points+1];
+   double del_der[num_sample_points+1];
+   double alph, beta, magn;
+   int index;
+   double interval;
+   
+   // Loop over sample min_pressure_head to 0.0, min_pressure_head/num_sample_points step
+   interval = min_pressure_head/(double)(num_sample_points - 1);
+   new_table -> interval = fabs(interval);
+
+   // evenly spaced interpolation points (future: variably spaced points)
+   for(index = 0; index <= num_sample_points; index++)
+   {
+      x[index]     = fabs(index*interval); 
+      // calculating function and derivative at interpolation points
+      a[index]     = function(x[index], alpha, n, CALCFCN);
+      a_der[index] = function(x[index], alpha, n, CALCDER);
+   }
+
+   /* Fill in slope for linear interpolation */
+   if(interpolation_method == 1) {
+      for(index = 0; index < num_sample_points; index++) 
+      {
+	 new_table -> slope[index]     = (a[index+1] - a[index]) / 
+	    new_table -> interval;
+	 new_table -> slope_der[index] = (a_der[index+1] - a_der[index]) / 
+	    new_table -> interval;
+      }
+   }
+
+   // begin monotonic spline (see Fritsch and Carlson, SIAM J. Num. Anal., 17 (2), 1980)
+   // (num_sample_points is positive, so the loop sets these; gcc can not tell)
+   del[0]     = 0.0;
+   del_der[0] = 0.0;
+   for(index = 0; index < num_sample_points; index++)
+   {
+      h[index] = x[index + 1] - x[index];
+      f[index] = a[index + 1] - a[index];
+      del[index] = f[index]/h[index]; 
+      f_der[index] = a_der[index + 1] - a_der[index];
+      del_der[index] = f_der[index]/h[index];
+   }
+   d[0] = del[0];
+   d[num_sample_points] = del[num_sample_points - 1];
+   d_der[0] = del_der[0];
+   d_der[num_sample_points] = del_der[num_sample_points - 1];
+
+   for(index = 1; index < num_sample_points; index++)
+   {
+      d[index] = (del[index - 1] + del[index])/2;
+      d_der[index] = (del_der[index - 1] + del_der[index])/2;
+   }
+
+
+   for(index = 0; index < num_sample_points; index++)
+   {
+      if(del[index] == 0.0)   
+      {
+         d[index] = 0;
+         d[index+1] = 0;
+      }
+      else
+      {
+         alph = d[index]/del[index];
+         beta = d[index+1]/del[index];
+         magn = pow(alph,2) + pow(beta,2);
+         if(magn > 9.0)
+         {
+            d[index] = 3*alph*del[index]/magn;
+            d[index+1] = 3*beta*del[index]/magn;
+         }
+      }
+
+      if(del_der[index] == 0.0)   
+      {
+         d_der[index] = 0;
+         d_der[index+1] = 0;
+      }
+      else
+      {
+	 // to ensure monotonicity
+         alph = d_der[index]/del_der[index];
+         beta = d_der[index+1]/del_der[index];
+         magn = pow(alph,2) + pow(beta,2);
+         if(magn > 9.0)
+         {
+            d_der[index] = 3*alph*del_der[index]/magn;
+            d_der[index+1] = 3*beta*del_der[index]/magn;
+         }
+      }
+   }
+   return new_table;
+}
+
+
+/*--------------------------------------------------------------------------
+ * FreeVanGTable
+ *--------------------------------------------------------------------------*/
+
+void  FreeVanGTable(
+   VanGTable *table)
+{
+   if (table)
+   {
+      tfree(table -> x);
+      tfree(table -> a);
+      tfree(table -> d);
+      tfree(table -> a_der);
+      tfree(table -> d_der);
+
+      tfree(table -> slope);
+      tfree(table -> slope_der);
+
+      tfree(table);
+   }
+}
+
+
+/*--------------------------------------------------------------------------
+ * LogVanGTable:
+ *   Log the accuracy and speed of the table against the function it
+ *   samples.  The error is measured halfway between the sample points,
+ *   where the interpolation error is largest, and the speed over the
+ *   same heads.
+ *--------------------------------------------------------------------------*/
+
+void  LogVanGTable(
+   char      *name,
+   VanGTable *table)
+{
+   IfLogging(1)
+   {
+      FILE            *log_file;
+
+      VanGFunction     function = (table -> function);
+      double           alpha    = (table -> alpha);
+      double           n        = (table -> n);
+
+      double           head, exact;
+      double           max_err_fcn = 0.0, max_err_der = 0.0;
+      double           max_der = 0.0;
+      volatile double  sum = 0.0;
+
+      amps_Clock_t     t_start, t_function, t_table;
+      int              index, rep;
+      int              num_reps;
+
+      for(index = 0; index < (table -> num_sample_points) - 1; index++)
+      {
+	 head = (table -> x)[index] + 0.5*(table -> interval);
+
+	 exact       = function(head, alpha, n, CALCFCN);
+	 max_err_fcn = pfmax(max_err_fcn,
+			     fabs(VanGLookup(head, table, CALCFCN) - exact));
+
+	 exact       = function(head, alpha, n, CALCDER);
+	 max_err_der = pfmax(max_err_der,
+			     fabs(VanGLookup(head, table, CALCDER) - exact));
+	 max_der     = pfmax(max_der, fabs(exact));
+      }
+
+      /* enough passes over the table for the clock to resolve */
+      num_reps = pfmax(1, 100000/(table -> num_sample_points));
+
+      t_start = amps_Clock();
+      for(rep = 0; rep < num_reps; rep++)
+	 for(index = 0; index < (table -> num_sample_points) - 1; index++)
+	 {
+	    head = (table -> x)[index] + 0.5*(table -> interval);
+	    sum += function(head, alpha, n, CALCFCN) +
+	           function(head, alpha, n, CALCDER);
+	 }
+      t_function = amps_Clock() - t_start;
+
+      t_start = amps_Clock();
+      for(rep = 0; rep < num_reps; rep++)
+	 for(index = 0; index < (table -> num_sample_points) - 1; index++)
+	 {
+	    head = (table -> x)[index] + 0.5*(table -> interval);
+	    sum += VanGLookup(head, table, CALCFCN) + 
+	           VanGLookup(head, table, CALCDER);
+	 }
+      t_table = amps_Clock() - t_start;
+
+      log_file = OpenLogFile("VanGTable");
+
+      fprintf(log_file, "%s: %d points to head %g, %s interpolation\n",
+	      name, (table -> num_sample_points), 
+	      fabs(table -> min_pressure_head),
+	      (table -> interpolation_method == 0) ? "spline" : "linear");
+      fprintf(log_file, "   max error: function %e, derivative %e "
+	      "(max derivative %e)\n", max_err_fcn, max_err_der, max_der);
+      fprintf(log_file, "   time for %d evaluations: function %e s, "
+	      "table %e s\n", 2*num_reps*((table -> num_sample_points) - 1),
+	      (double)t_function/AMPS_TICKS_PER_SEC,
+	      (double)t_table/AMPS_TICKS_PER_SEC);
+
+      CloseLogFile(log_file);
+   }
+}
+
+
+/*--------------------------------------------------------------------------
+ * ClassifyVanG:
+ *   Put the cells of n_values into num_classes classes splitting the
+ *   global range of n, [-range[0], range[1]], evenly.  Sets the class of
+ *   each cell in class_values (-1 for cells with n <= 1 or alpha <= 0)
+ *   and the global range of n in each class, and returns the largest
+ *   difference of n from the middle of its class range.
+ *--------------------------------------------------------------------------*/
+
+static double ClassifyVanG(
+   Vector       *alpha_values,
+   Vector       *n_values,
+   double       *range,
+   int           num_classes,
+   double       *class_min,
+   double       *class_max,
+   Vector       *class_values)
+{
+   Grid           *grid = VectorGrid(n_values);
+   Subvector      *a_sub, *n_sub, *c_sub;
+   double         *a_dat, *n_dat, *c_dat;
+
+   double          width, max_err;
+   int             sg, i, c;
+
+   amps_Invoice    invoice;
+
+   width = (range[1] + range[0])/(double)num_classes;
+
+   for(c = 0; c < num_classes; c++)
+   {
+      class_min[c] =  DBL_MAX;
+      class_max[c] = -DBL_MAX;
+   }
+
+   ForSubgridI(sg, GridSubgrids(grid))
+   {
+      a_sub = VectorSubvector(alpha_values, sg);
+      n_sub = VectorSubvector(n_values, sg);
+      c_sub = VectorSubvector(class_values, sg);
+
+      a_dat = SubvectorData(a_sub);
+      n_dat = SubvectorData(n_sub);
+      c_dat = SubvectorData(c_sub);
+
+      for(i = 0; i < SubvectorDataSize(n_sub); i++)
+      {
+	 if ( n_dat[i] > 1.0 && a_dat[i] > 0.0 )
+	 {
+	    if ( width > 0.0 )
+	       c = pfmin((int)((n_dat[i] + range[0])/width), num_classes - 1);
+	    else
+	       c = 0;
+
+	    class_min[c] = pfmin(class_min[c], n_dat[i]);
+	    class_max[c] = pfmax(class_max[c], n_dat[i]);
+
+	    c_dat[i] = (double)c;
+	 }
+	 else
+	    c_dat[i] = -1.0;
+      }
+   }
+
+   invoice = amps_NewInvoice("%*d", num_classes, class_min);
+   amps_AllReduce(amps_CommWorld, invoice, amps_Min);
+   amps_FreeInvoice(invoice);
+
+   invoice = amps_NewInvoice("%*d", num_classes, class_max);
+   amps_AllReduce(amps_CommWorld, invoice, amps_Max);
+   amps_FreeInvoice(invoice);
+
+   max_err = 0.0;
+   for(c = 0; c < num_classes; c++)
+      if ( class_min[c] <= class_max[c] )
+	 max_err = pfmax(max_err, 0.5*(class_max[c] - class_min[c]));
+
+   return max_err;
+}
+
+
+/*--------------------------------------------------------------------------
+ * NewVanGClasses:
+ *   Group the cells of n_values into classes and build a table for each.
+ *   The classes split the global range of n evenly and each table uses
+ *   the midpoint of the n values in its class, so a class holding a
+ *   single soil is exact.  The number of classes is doubled, starting
+ *   from one, until no n is more than max_n_error from its table's n or
+ *   max_classes is reached; a warning is printed if max_n_error is still
+ *   not met then.  The tables reach alpha*head =
+ *   max(alpha)*|min_pressure_head|, covering at least min_pressure_head
+ *   for every cell.  Cells with n <= 1 or alpha <= 0 (usually outside the
+ *   domain) get no class.
+ *
+ *   The classes are the same on every process, so this must be called by
+ *   all of them.
+ *--------------------------------------------------------------------------*/
+
+VanGClasses *NewVanGClasses(
+   char         *name,
+   Vector       *alpha_values,
+   Vector       *n_values,
+   int           max_classes,
+   double        max_n_error,
+   int           interpolation_method,
+   int           num_sample_points,
+   double        min_pressure_head,
+   VanGFunction  function)
+{
+   VanGClasses    *classes;
+
+   Grid           *grid = VectorGrid(n_values);
+   double         *a_dat, *n_dat;
+
+   double          range[3];
+   double         *class_min, *class_max;
+   double          class_n;
+   double          max_err;
+   int             num_classes;
+   int             sg, i, c;
+
+   amps_Invoice    invoice;
+
+   FILE           *log_file;
+   char            class_name[IDB_MAX_KEY_LEN];
+
+   classes = ctalloc(VanGClasses, 1);
+
+   classes -> class_values = NewVectorType(grid, 1, 1, vector_cell_centered);
+
+   /* global range of n (negated min so one reduction does) and max alpha */
+   range[0] = -DBL_MAX;
+   range[1] = -DBL_MAX;
+   range[2] = 0.0;
+
+   ForSubgridI(sg, GridSubgrids(grid))
+   {
+      a_dat = SubvectorData(VectorSubvector(alpha_values, sg));
+      n_dat = SubvectorData(VectorSubvector(n_values, sg));
+
+      for(i = 0; i < SubvectorDataSize(VectorSubvector(n_values, sg)); i++)
+	 if ( n_dat[i] > 1.0 && a_dat[i] > 0.0 )
+	 {
+	    range[0] = pfmax(range[0], -n_dat[i]);
+	    range[1] = pfmax(range[1],  n_dat[i]);
+	    range[2] = pfmax(range[2],  a_dat[i]);
+	 }
+   }
+
+   invoice = amps_NewInvoice("%*d", 3, range);
+   amps_AllReduce(amps_CommWorld, invoice, amps_Max);
+   amps_FreeInvoice(invoice);
+
+   /* classify the cells with as few classes as meet max_n_error */
+   class_min = talloc(double, max_classes);
+   class_max = talloc(double, max_classes);
+
+   num_classes = 1;
+   while ( ((max_err = ClassifyVanG(alpha_values, n_values, range,
+				    num_classes, class_min, class_max,
+				    classes -> class_values)) > max_n_error) &&
+	   (num_classes < max_classes) )
+   {
+      num_classes = pfmin(2*num_classes, max_classes);
+   }
+
+   if ( (max_err > max_n_error) && !amps_Rank(amps_CommWorld) )
+      amps_Printf("Warning: %s n is up to %e from its table's n with %d "
+		  "classes, more than the %e allowed\n", name, max_err,
+		  num_classes, max_n_error);
+
+   classes -> num_classes = num_classes;
+   classes -> tables      = ctalloc(VanGTable *, num_classes);
+
+   /* a table for each class that has cells */
+   for(c = 0; c < num_classes; c++)
+   {
+      if ( class_min[c] <= class_max[c] )
+      {
+	 class_n = 0.5*(class_min[c] + class_max[c]);
+
+	 (classes -> tables)[c] = 
+	    NewVanGTable(interpolation_method, num_sample_points,
+			 -range[2]*fabs(min_pressure_head), 1.0, class_n,
+			 function);
+
+	 sprintf(class_name, "%s class %d", name, c);
+	 LogVanGTable(class_name, (classes -> tables)[c]);
+      }
+   }
+
+   IfLogging(1)
+   {
+      log_file = OpenLogFile("VanGClasses");
+
+      fprintf(log_file, "%s: n from %g to %g in %d classes\n", name,
+	      -range[0], range[1], num_classes);
+      for(c = 0; c < num_classes; c++)
+	 if ( (classes -> tables)[c] )
+	    fprintf(log_file, "   class %d: n from %g to %g, table n %g\n", c,
+		    class_min[c], class_max[c], (classes -> tables)[c] -> n);
+      fprintf(log_file, "   max difference of n from its table %e "
+	      "(allowed %e)\n", max_err, max_n_error);
+
+      CloseLogFile(log_file);
+   }
+
+   tfree(class_min);
+   tfree(class_max);
+
+   return classes;
+}
+
+
+/*--------------------------------------------------------------------------
+ * FreeVanGClasses
+ *--------------------------------------------------------------------------*/
+
+void  FreeVanGClasses(
+   VanGClasses *classes)
+{
+   int  c;
+
+   if (classes)
+   {
+      for(c = 0; c < (classes -> num_classes); c++)
+	 FreeVanGTable((classes -> tables)[c]);
+      tfree(classes -> tables);
+
+      FreeVector(classes -> class_values);
+
+      tfree(classes);
+   }
+}
@@ -0,0 +1,230 @@
+/*BHEADER**********************************************************************
+
+  Copyright (c) 1995-2009, Lawrence Livermore National Security,
+  LLC. Produced at the Lawrence Livermore National Laboratory. Written
+  by the Parflow Team (see the CONTRIBUTORS file)
+  <parflow@lists.llnl.gov> CODE-OCEC-08-103. All rights reserved.
+
+  This file is part of Parflow. For details, see
+  http://www.llnl.gov/casc/parflow
+
+  Please read the COPYRIGHT file or Our Notice and the LICENSE file
+  for the GNU Lesser General Public License.
+
+  This program is free software; you can redistribute it and/or modify
+  it under the terms of the GNU General Public License (as published
+  by the Free Software Foundation) version 2.1 dated February 1999.
+
+  This program is distributed in the hope that it will be useful, but
+  WITHOUT ANY WARRANTY; without even the IMPLIED WARRANTY OF
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the terms
+  and conditions of the GNU General Public License for more details.
+
+  You should have received a copy of the GNU Lesser General Public
+  License along with this program; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307
+  USA
+**********************************************************************EHEADER*/
+
+/******************************************************************************
+ *
+ * Header info for the Van Genuchten lookup tables
+ *
+ *****************************************************************************/
+
+#ifndef _VANG_TABLE_HEADER
+#define _VANG_TABLE_HEADER
+
+#include <assert.h>
+#include <math.h>
+
+/*--------------------------------------------------------------------------
+ * VanGFunction:
+ *   A Van Genuchten curve (fcn = CALCFCN) or its derivative (fcn =
+ *   CALCDER) as a function of the pressure head magnitude.
+ *--------------------------------------------------------------------------*/
+
+typedef double (*VanGFunction)(double head, double alpha, double n, int fcn);
+
+/*--------------------------------------------------------------------------
+ * VanGTable:
+ *   A Van Genuchten curve and its derivative sampled at evenly spaced
+ *   heads from 0 to |min_pressure_head|, interpolated with a monotone
+ *   cubic spline (interpolation_method 0) or linearly (1).  Heads past
+ *   the end of the table give 0.
+ *--------------------------------------------------------------------------*/
+
+typedef struct {
+   double min_pressure_head;
+   int    num_sample_points;
+
+   double *x;
+   double *a;
+   double *d;
+   double *a_der;
+   double *d_der;
+
+   /* used by linear interpolation method */
+   double *slope;
+   double *slope_der;
+
+   int interpolation_method;
+
+   double interval;
+
+   /* the function sampled, kept for the accuracy report */
+   VanGFunction function;
+   double       alpha;
+   double       n;
+  
+} VanGTable;
+
+/*--------------------------------------------------------------------------
+ * VanGClasses:
+ *   Lookup tables for Van Genuchten parameters that vary cell by cell.
+ *   The curves depend on alpha only through alpha*head, so the tables are
+ *   sampled with alpha = 1 and looked up at alpha*head; the cells are
+ *   grouped into classes by n, one table per class.  class_values holds
+ *   the class of each cell, or -1 for cells evaluated directly.
+ *--------------------------------------------------------------------------*/
+
+typedef struct {
+   int          num_classes;
+   VanGTable  **tables;        /* NULL for classes with no cells */
+   Vector      *class_values;
+} VanGClasses;
+
+/*--------------------------------------------------------------------------
+ * Table lookups
+ *--------------------------------------------------------------------------*/
+
+static inline double VanGLookupSpline(
+   double pressure_head,
+   VanGTable *lookup_table,
+   int fcn)
+{
+   double rel_perm, t;
+   int pt = 0;
+   int num_sample_points = lookup_table -> num_sample_points;
+   double min_pressure_head = lookup_table -> min_pressure_head;
+   int max = num_sample_points +1;
+
+   // This table goes from 0 to fabs(min_pressure_head)
+   assert(pressure_head >= 0);
+
+   // SGS TODO add warning in output?
+   // Make sure values are in the table range, if lower then set to the 0.0 which is limit of VG curve
+   if(pressure_head >= fabs(min_pressure_head)){
+      return 0.0;
+   } else {
+
+      // Use direct table lookup to avoid using this binary search since
+      // we have uniformly spaced points.
+      double interval = lookup_table -> interval;
+      pt = (int)floor(pressure_head / interval);
+      if(pt > max) {
+	 pt = max-1;
+      }
+
+#if 0
+      // When using variably spaced interpolation points, use binary
+      // search to find the interval
+      {
+	 int min = 0;
+	 int mid;
+	 
+	 while(max != min+1){
+	    mid = min + floor((max - min)/2);
+	    if(pressure_head == lookup_table -> x[mid]){
+	       min = mid;
+	       max = min+1;
+	    }
+	    if(pressure_head < lookup_table -> x[mid]){
+	       max = mid;
+	    } else {
+	       min = mid;
+	    }
+	 }
+	 pt = min;
+      }
+#endif 
+   }
+
+   double x = lookup_table -> x[pt];
+   double a = lookup_table -> a[pt];
+   double d = lookup_table -> d[pt];
+   double a_der = lookup_table -> a_der[pt];
+   double d_der = lookup_table -> d_der[pt];
+
+   // using cubic Hermite interpolation
+   double dx = lookup_table -> x[pt+1] - x;
+   t = (pressure_head - x)/dx;
+
+   double t2 = t*t;
+   double t3 = t2*t;
+   double h00 = 2.0*t3 - 3.0*t2 + 1.0;
+   double h10 = t3 - 2.0*t2 + t;
+   double h01 = -2.0*t3 + 3.0*t2;
+   double h11 = t3 - t2;
+
+   if(fcn == CALCFCN){
+      rel_perm = h00*a + h10*dx*d + h01*(lookup_table -> a[pt+1])
+	 + h11*dx*(lookup_table -> d[pt+1]);
+   } else {
+      rel_perm = h00*a_der + h10*dx*d_der + h01*(lookup_table -> a_der[pt+1])
+	 + h11*dx*(lookup_table -> d_der[pt+1]);
+   }
+
+   return rel_perm;
+}
+
+static inline double VanGLookupLinear(
+   double pressure_head,
+   VanGTable *lookup_table,
+   int fcn)
+{
+   double rel_perm = 0.0;
+   int pt = 0;
+   int num_sample_points = lookup_table -> num_sample_points;
+   double min_pressure_head = lookup_table -> min_pressure_head;
+   int max = num_sample_points +1;
+
+   // This table goes from 0 to fabs(min_pressure_head)
+   assert(pressure_head >= 0);
+
+   // SGS TODO add warning in output?
+   // Make sure values are in the table range, if lower then set to the 0.0 which is limit of VG curve
+   if(pressure_head < fabs(min_pressure_head)){
+      double interval = lookup_table -> interval;
+
+      // Use direct table lookup to avoid using this binary search since
+      // we have uniformly spaced points.
+
+      pt = (int)floor(pressure_head / interval);
+      assert(pt < max);
+
+      // using cubic Hermite interpolation
+
+
+      if(fcn == CALCFCN) {
+	 rel_perm = lookup_table -> a[pt] + lookup_table -> slope[pt] * (pressure_head - lookup_table -> x[pt]);
+      } else {
+	 rel_perm = lookup_table -> a_der[pt] + lookup_table -> slope_der[pt] * (pressure_head - lookup_table -> x[pt]);
+      }
+   }
+
+   return rel_perm;
+}
+
+static inline double VanGLookup(
+   double pressure_head,
+   VanGTable *lookup_table,
+   int fcn)
+{
+   if (lookup_table -> interpolation_method == 0)
+      return VanGLookupSpline(pressure_head, lookup_table, fcn);
+   else
+      return VanGLookupLinear(pressure_head, lookup_table, fcn);
+}
+
+#endif
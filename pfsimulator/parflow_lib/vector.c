@@ -73,6 +73,60 @@ CommPkg  *NewVectorCommPkg(
    return new_commpkg;
 }
 
+/*--------------------------------------------------------------------------
+ * NewVectorUpdatePkg:
+ *   CommPkg for one of the grid's update modes, bound to the shared plan
+ *   for the vector's data space.
+ *--------------------------------------------------------------------------*/
+
+static CommPkg  *NewVectorUpdatePkg(
+   Vector   *vector,
+   int       update_mode)
+{
+   CommPlan    *plan;
+
+   Grid *grid = VectorGrid(vector);
+
+   if(GridNumSubgrids(grid) > 1) {
+      PARFLOW_ERROR("NewVectorUpdatePkg can't be used with number subgrids > 1");
+   }
+
+   plan = GridCommPlan(grid, update_mode, VectorDataSpace(vector), 1);
+
+   return NewCommPkgFromPlan(plan, SubvectorData(VectorSubvector(vector,0)));
+}
+
+/*--------------------------------------------------------------------------
+ * GetVectorCommPkg:
+ *   Return the CommPkg for update_mode, building it the first time the
+ *   mode is used on this vector.  Modes whose stencil is wider than the
+ *   vector's ghost layer are an error.
+ *--------------------------------------------------------------------------*/
+
+CommPkg  *GetVectorCommPkg(
+   Vector   *vector,
+   int       update_mode)
+{
+   static const int ghost_widths[NumUpdateModes] = VectorUpdateGhostWidths;
+
+
+   if(VectorCommPkg(vector, update_mode) == NULL)
+   {
+      if(VectorNumGhost(vector) < ghost_widths[update_mode])
+      {
+	 amps_Printf("Error: update mode %d needs a ghost width of %d, vector has %d\n",
+		     update_mode, ghost_widths[update_mode],
+		     VectorNumGhost(vector));
+	 PARFLOW_ERROR("Vector ghost layer too small for update mode");
+      }
+
+      VectorCommPkg(vector, update_mode) =
+	 NewVectorUpdatePkg(vector, update_mode);
+   }
+
+   return VectorCommPkg(vector, update_mode);
+}
+
 /*--------------------------------------------------------------------------
  * InitVectorUpdate
  *--------------------------------------------------------------------------*/
@@ -129,7 +183,7 @@ VectorUpdateCommHandle  *InitVectorUpdate(
 #ifdef NO_VECTOR_UPDATE
       amps_com_handle = NULL;
 #else
-      amps_com_handle = InitCommunication(VectorCommPkg(vector, update_mode));
+      amps_com_handle = InitCommunication(GetVectorCommPkg(vector, update_mode));
 #endif
       
 #endif
@@ -278,6 +332,8 @@ static Vector  *NewTempVector(
 
    VectorSize(new_vector) = GridSize(grid); /* VectorSize(vector) is vector->size, which is the total number of coefficients */
 
+   VectorNumGhost(new_vector) = num_ghost;
+
 
 #ifdef HAVE_SAMRAI
    new_vector -> samrai_id = -1;
@@ -299,9 +355,13 @@ static void     AllocateVectorData(
 
    int         i;
 
-   /* if necessary, free old CommPkg's */
+   /* if necessary, free old CommPkg's, new ones are built on first use
+      by GetVectorCommPkg */
    for(i = 0; i < NumUpdateModes; i++)
+   {
       FreeCommPkg(VectorCommPkg(vector, i));
+      VectorCommPkg(vector, i) = NULL;
+   }
 
 
    ForSubgridI(i, GridSubgrids(grid)) {
@@ -315,12 +375,6 @@ static void     AllocateVectorData(
 
       SubvectorData(VectorSubvector(vector, i)) = data;
    }
-
-   for(i = 0; i < NumUpdateModes; i++)
-   {
-      VectorCommPkg(vector, i) =
-	 NewVectorCommPkg(vector, GridComputePkg(grid, i));
-   }
 }
 
 
@@ -338,6 +392,8 @@ Vector  *NewVectorType(
 
     new_vector = NewTempVector(grid, nc, num_ghost);
 
+    IncVectorAllocCount();
+
     enum ParflowGridType grid_type = invalid_grid_type;
 
 #ifdef HAVE_SAMRAI
@@ -698,6 +754,117 @@ void     FreeVector(
 }
 
 
+/*--------------------------------------------------------------------------
+ * CheckoutVector:
+ *   Return a work vector from the pool kept on grid, allocating one only
+ *   if no free vector of the same shape exists.  The data (including the
+ *   ghost layer) is zeroed so callers see the same state as NewVectorType.
+ *   Vectors must be given back with ReturnVector, not FreeVector.
+ *--------------------------------------------------------------------------*/
+
+Vector  *CheckoutVector(
+   Grid    *grid,
+   int      nc,
+   int      num_ghost,
+   enum vector_type type)
+{
+   VectorPoolEntry  *entry;
+   VectorPoolEntry  *last = NULL;
+
+
+   IncPoolCheckoutCount();
+
+   for(entry = GridVectorPool(grid); entry; entry = entry -> next)
+   {
+      if( !(entry -> in_use) &&
+	  (entry -> nc == nc) &&
+	  (entry -> num_ghost == num_ghost) &&
+	  (entry -> type == type) )
+      {
+	 break;
+      }
+      last = entry;
+   }
+
+   if(entry)
+   {
+      InitVectorAll(entry -> vector, 0.0);
+   }
+   else
+   {
+      IncPoolAllocCount();
+
+      entry = ctalloc(VectorPoolEntry, 1);
+      entry -> vector    = NewVectorType(grid, nc, num_ghost, type);
+      entry -> nc        = nc;
+      entry -> num_ghost = num_ghost;
+      entry -> type      = type;
+      entry -> next      = NULL;
+
+      if(last)
+	 last -> next = entry;
+      else
+	 GridVectorPool(grid) = entry;
+   }
+
+   entry -> in_use = TRUE;
+
+   return entry -> vector;
+}
+
+
+/*--------------------------------------------------------------------------
+ * ReturnVector:
+ *   Give a vector obtained from CheckoutVector back to its grid's pool.
+ *   The vector stays allocated until the grid is freed.
+ *--------------------------------------------------------------------------*/
+
+void     ReturnVector(
+   Vector  *vector)
+{
+   VectorPoolEntry  *entry;
+
+
+   if(vector == NULL)
+      return;
+
+   for(entry = GridVectorPool(VectorGrid(vector)); entry; entry = entry -> next)
+   {
+      if(entry -> vector == vector)
+      {
+	 entry -> in_use = FALSE;
+	 return;
+      }
+   }
+
+   /* not a pooled vector */
+   FreeVector(vector);
+}
+
+
+/*--------------------------------------------------------------------------
+ * FreeGridVectorPool
+ *--------------------------------------------------------------------------*/
+
+void     FreeGridVectorPool(
+   Grid    *grid)
+{
+   VectorPoolEntry  *entry;
+   VectorPoolEntry  *next;
+
+
+   for(entry = GridVectorPool(grid); entry; entry = next)
+   {
+      next = entry -> next;
+
+      FreeVector(entry -> vector);
+      tfree(entry);
+   }
+
+   GridVectorPool(grid) = NULL;
+}
+
+
 /*--------------------------------------------------------------------------
  * InitVector
  *--------------------------------------------------------------------------*/
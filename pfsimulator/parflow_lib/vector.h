@@ -92,7 +92,10 @@ typedef struct _Vector
 
    int            size;         /* Total number of coefficients */
 
-                                /* Information on how to update boundary */
+   int            num_ghost;    /* Width of ghost layer */
+
+                                /* Information on how to update boundary,
+				   built on first use of each mode */
    CommPkg *comm_pkg[NumUpdateModes]; 
 
    enum vector_type type;
@@ -111,6 +114,26 @@ typedef struct _Vector
 
 typedef Vector *N_Vector;
 
+/*--------------------------------------------------------------------------
+ * VectorPoolEntry:
+ *   Work vector kept alive on a grid between CheckoutVector and
+ *   ReturnVector calls so the data and CommPkg's are only built once.
+ *--------------------------------------------------------------------------*/
+
+typedef struct _VectorPoolEntry
+{
+   Vector                  *vector;
+
+   int                      nc;
+   int                      num_ghost;
+   enum vector_type         type;
+
+   int                      in_use;
+
+   struct _VectorPoolEntry *next;
+
+} VectorPoolEntry;
+
 typedef struct _VectorUpdateCommHandle {
    Vector *vector;
    CommHandle *comm_handle;
@@ -152,6 +175,7 @@ typedef struct _VectorUpdateCommHandle {
 #define VectorGrid(vector)          ((vector)-> grid)
 #define VectorDataSpace(vector)     ((vector)-> data_space)
 #define VectorSize(vector)          ((vector)-> size)
+#define VectorNumGhost(vector)      ((vector)-> num_ghost)
 #define VectorCommPkg(vector, mode) ((vector) -> comm_pkg[mode])
 
 #define SizeOfVector(vector)  ((vector) -> data_size)
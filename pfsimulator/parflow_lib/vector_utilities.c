@@ -41,7 +41,9 @@
  * PFVInv(x, z)                      z_i = 1 / x_i
  * PFVAddConst(x, b, z)              z_i = x_i + b
  * PFVDotProd(x, y)                  Returns x dot y
+ * PFVDotProdMulti(n, x, y, r)       r_m = x_m dot y, m = 0..n-1
  * PFVMaxNorm(x)                     Returns ||x||_{max}
+ * PFVMaxRelChange(x, y, s, d)       Returns max_i |x_i - y_i| / max(|y_i|, s), i in d
  * PFVWrmsNorm(x, w)                 Returns sqrt((sum_i (x_i + w_i)^2)/length)
  * PFVWL2Norm(x, w)                  Returns sqrt(sum_i (x_i * w_i)^2)
  * PFVL1Norm(x)                      Returns sum_i |x_i|
@@ -63,6 +65,19 @@
  * PFVScaleBy(a, x)                  x = x * a
  *
  * PFVLayerCopy (a, b, x, y)         NBE: Extracts layer b from vector y, inserts into layer a of vector x
+ *
+ * Fused operations (one sweep, at most one reduction):
+ *
+ * PFVLinearCombination(n, c, x, z)  z = sum_m c_m * x_m
+ * PFVMultiAxpy(n, c, x, y)          y = y + sum_m c_m * x_m
+ * PFVMultiAxpyDot(n, c, x, y, d)    y = y + sum_m c_m * x_m, returns y dot y
+ *                                      if d
+ * PFVWMaxNorm(x, w)                 Returns max_i |x_i * w_i|
+ * PFVStepMaxNorm(u, p, w)           Returns max_i |p_i / (1 / w_i + |u_i|)|
+ * PFVWL2NormDot(x, w, y, dot)       Returns PFVWL2Norm(x, w),
+ *                                      dot = sum_i y_i * x_i * w_i^2
+ * PFVWDotProdL1(u, v, w, r)         r = ((w*u) dot (w*v), (w*v) dot (w*v),
+ *                                        ||w*v||_1)
  ****************************************************************************/
 
 #include "parflow.h"
@@ -202,7 +217,7 @@ Vector *z)
      i_x = 0;
      i_y = 0;
      i_z = 0;
-     BoxLoopI3(i, j, k, ix, iy, iz, nx, ny, nz,
+     ThreadedBoxLoopI3(NoThreadClauses, i, j, k, ix, iy, iz, nx, ny, nz,
 	       i_x, nx_x, ny_x, nz_x, 1, 1, 1,
 	       i_y, nx_y, ny_y, nz_y, 1, 1, 1,
 	       i_z, nx_z, ny_z, nz_z, 1, 1, 1,
@@ -252,7 +267,7 @@ void PFVConstInit(
      zp = SubvectorElt(z_sub, ix, iy, iz);
 
      i_z = 0;
-     BoxLoopI1(i, j, k, ix, iy, iz, nx, ny, nz,
+     ThreadedBoxLoopI1(NoThreadClauses, i, j, k, ix, iy, iz, nx, ny, nz,
 	       i_z, nx_z, ny_z, nz_z, 1, 1, 1,
 	       {
 		  zp[i_z] = c;
@@ -319,7 +334,7 @@ void PFVProd(
      i_x = 0;
      i_y = 0;
      i_z = 0;
-     BoxLoopI3(i, j, k, ix, iy, iz, nx, ny, nz,
+     ThreadedBoxLoopI3(NoThreadClauses, i, j, k, ix, iy, iz, nx, ny, nz,
 	       i_x, nx_x, ny_x, nz_x, 1, 1, 1,
 	       i_y, nx_y, ny_y, nz_y, 1, 1, 1,
 	       i_z, nx_z, ny_z, nz_z, 1, 1, 1,
@@ -388,7 +403,7 @@ Vector *z)
      i_x = 0;
      i_y = 0;
      i_z = 0;
-     BoxLoopI3(i, j, k, ix, iy, iz, nx, ny, nz,
+     ThreadedBoxLoopI3(NoThreadClauses, i, j, k, ix, iy, iz, nx, ny, nz,
 	       i_x, nx_x, ny_x, nz_x, 1, 1, 1,
 	       i_y, nx_y, ny_y, nz_y, 1, 1, 1,
 	       i_z, nx_z, ny_z, nz_z, 1, 1, 1,
@@ -464,7 +479,7 @@ void PFVScale(
 
 	i_x = 0;
 	i_z = 0;
-	BoxLoopI2(i, j, k, ix, iy, iz, nx, ny, nz,
+	ThreadedBoxLoopI2(NoThreadClauses, i, j, k, ix, iy, iz, nx, ny, nz,
 		  i_x, nx_x, ny_x, nz_x, 1, 1, 1,
 		  i_z, nx_z, ny_z, nz_z, 1, 1, 1,
 		  {
@@ -523,7 +538,7 @@ void PFVAbs(
 
      i_x = 0;
      i_z = 0;
-     BoxLoopI2(i, j, k, ix, iy, iz, nx, ny, nz,
+     ThreadedBoxLoopI2(NoThreadClauses, i, j, k, ix, iy, iz, nx, ny, nz,
 	       i_x, nx_x, ny_x, nz_x, 1, 1, 1,
 	       i_z, nx_z, ny_z, nz_z, 1, 1, 1,
 	       {
@@ -580,7 +595,7 @@ void PFVInv(
 
      i_x = 0;
      i_z = 0;
-     BoxLoopI2(i, j, k, ix, iy, iz, nx, ny, nz,
+     ThreadedBoxLoopI2(NoThreadClauses, i, j, k, ix, iy, iz, nx, ny, nz,
 	       i_x, nx_x, ny_x, nz_x, 1, 1, 1,
 	       i_z, nx_z, ny_z, nz_z, 1, 1, 1,
 	       {
@@ -639,7 +654,7 @@ void PFVAddConst(
 
      i_x = 0;
      i_z = 0;
-     BoxLoopI2(i, j, k, ix, iy, iz, nx, ny, nz,
+     ThreadedBoxLoopI2(NoThreadClauses, i, j, k, ix, iy, iz, nx, ny, nz,
 	       i_x, nx_x, ny_x, nz_x, 1, 1, 1,
 	       i_z, nx_z, ny_z, nz_z, 1, 1, 1,
 	       {
@@ -700,7 +715,7 @@ double PFVDotProd(
 
      i_x = 0;
      i_y = 0;
-     BoxLoopI2(i, j, k, ix, iy, iz, nx, ny, nz,
+     ThreadedBoxLoopI2(ThreadReduction(+, sum), i, j, k, ix, iy, iz, nx, ny, nz,
                i_x, nx_x, ny_x, nz_x, 1, 1, 1,
                i_y, nx_y, ny_y, nz_y, 1, 1, 1,
 	       {
@@ -717,6 +732,81 @@ double PFVDotProd(
   return(sum);
 }
 
+void PFVDotProdMulti(
+/* DotProdMulti : result[m] = x[m] dot y, m = 0, ..., nvec-1.
+   All the dot products are summed in a single global reduction. */
+   int      nvec,
+   Vector **x,
+   Vector  *y,
+   double  *result)
+{
+  Grid       *grid     = VectorGrid(y);
+  Subgrid    *subgrid;
+ 
+  Subvector  *y_sub;
+
+  double     *yp, **xp;
+  double      yval;
+
+  int         ix,   iy,   iz;
+  int         nx,   ny,   nz;
+  int         nx_y, ny_y, nz_y;
+
+  int         sg, i, j, k, m, i_y;
+
+  amps_Invoice   result_invoice;
+
+  if (nvec <= 0)
+     return;
+
+  xp = talloc(double *, nvec);
+
+  for (m = 0; m < nvec; m++)
+     result[m] = ZERO;
+
+  ForSubgridI(sg, GridSubgrids(grid))
+  {
+     subgrid = GridSubgrid(grid, sg);
+
+     y_sub = VectorSubvector(y, sg);
+
+     ix = SubgridIX(subgrid);
+     iy = SubgridIY(subgrid);
+     iz = SubgridIZ(subgrid);
+
+     nx = SubgridNX(subgrid);
+     ny = SubgridNY(subgrid);
+     nz = SubgridNZ(subgrid);
+
+     nx_y = SubvectorNX(y_sub);
+     ny_y = SubvectorNY(y_sub);
+     nz_y = SubvectorNZ(y_sub);
+
+     /* The vectors share a grid, so they share the data layout of y */
+     yp = SubvectorElt(y_sub, ix, iy, iz);
+     for (m = 0; m < nvec; m++)
+        xp[m] = SubvectorElt(VectorSubvector(x[m], sg), ix, iy, iz);
+
+     i_y = 0;
+     ThreadedBoxLoopI1(ThreadPrivate(m, yval) ThreadReduction(+, result[:nvec]),
+               i, j, k, ix, iy, iz, nx, ny, nz,
+               i_y, nx_y, ny_y, nz_y, 1, 1, 1,
+	       {
+		  yval = yp[i_y];
+		  for (m = 0; m < nvec; m++)
+		     result[m] += xp[m][i_y] * yval;
+               });
+  }
+
+  tfree(xp);
+
+  result_invoice = amps_NewInvoice("%*d", nvec, result);
+  amps_AllReduce(amps_CommWorld, result_invoice, amps_Add);
+  amps_FreeInvoice(result_invoice);
+
+  IncFLOPCount( 2 * nvec * VectorSize(y) );
+}
+
 double PFVMaxNorm(
 /* MaxNorm = || x ||_{max}   */
    Vector *x)
@@ -758,7 +848,8 @@ double PFVMaxNorm(
     xp = SubvectorElt(x_sub, ix, iy, iz);
 
      i_x = 0;
-     BoxLoopI1(i, j, k, ix, iy, iz, nx, ny, nz,
+     ThreadedBoxLoopI1(ThreadReduction(max, max_val),
+               i, j, k, ix, iy, iz, nx, ny, nz,
                i_x, nx_x, ny_x, nz_x, 1, 1, 1,
 	       {
                   if (fabs(xp[i_x]) > max_val) max_val = fabs(xp[i_x]);
@@ -772,6 +863,72 @@ double PFVMaxNorm(
   return(max_val);
 }
 
+double PFVMaxRelChange(
+/* MaxRelChange = max_i |x_i - y_i| / max(|y_i|, scale)  */
+/* over the cells of x inside gr_domain */
+   Vector      *x,
+   Vector      *y,
+   double       scale,
+   GrGeomSolid *gr_domain)
+{
+  Grid       *grid     = VectorGrid(x);
+  Subgrid    *subgrid;
+ 
+  Subvector  *x_sub;
+  Subvector  *y_sub;
+
+  double     *xp, *yp;
+  double      change, max_val = ZERO;
+
+  int         ix,   iy,   iz;
+  int         nx,   ny,   nz;
+  int         r;
+
+  int         sg, i, j, k, i_x, i_y;
+
+  amps_Invoice    result_invoice;
+
+  ForSubgridI(sg, GridSubgrids(grid))
+  {
+     subgrid = GridSubgrid(grid, sg);
+
+     x_sub = VectorSubvector(x, sg);
+     y_sub = VectorSubvector(y, sg);
+
+     ix = SubgridIX(subgrid);
+     iy = SubgridIY(subgrid);
+     iz = SubgridIZ(subgrid);
+
+     nx = SubgridNX(subgrid);
+     ny = SubgridNY(subgrid);
+     nz = SubgridNZ(subgrid);
+
+     r = SubgridRX(subgrid);
+
+     xp = SubvectorData(x_sub);
+     yp = SubvectorData(y_sub);
+
+     ThreadedGrGeomInLoop(ThreadPrivate(i_x, i_y, change)
+			  ThreadReduction(max, max_val),
+			  i, j, k, gr_domain, r, ix, iy, iz, nx, ny, nz,
+	       {
+		  i_x = SubvectorEltIndex(x_sub, i, j, k);
+		  i_y = SubvectorEltIndex(y_sub, i, j, k);
+
+		  change = fabs(xp[i_x] - yp[i_y]) / pfmax(fabs(yp[i_y]), scale);
+                  if (change > max_val) max_val = change;
+	       });
+  }
+
+  result_invoice = amps_NewInvoice("%d", &max_val);
+  amps_AllReduce(amps_CommWorld, result_invoice, amps_Max);
+  amps_FreeInvoice(result_invoice);
+
+  IncFLOPCount( 3 * VectorSize(x) );
+
+  return(max_val);
+}
+
 double PFVWrmsNorm(
 /* WrmsNorm = sqrt((sum_i (x_i * w_i)^2)/length)  */
    Vector *x,
@@ -823,7 +980,8 @@ double PFVWrmsNorm(
 
      i_x = 0;
      i_w = 0;
-     BoxLoopI2(i, j, k, ix, iy, iz, nx, ny, nz,
+     ThreadedBoxLoopI2(ThreadPrivate(prod) ThreadReduction(+, sum),
+	       i, j, k, ix, iy, iz, nx, ny, nz,
 	       i_x, nx_x, ny_x, nz_x, 1, 1, 1,
 	       i_w, nx_w, ny_w, nz_w, 1, 1, 1,
 	       {
@@ -892,7 +1050,8 @@ double PFVWL2Norm(
 
      i_x = 0;
      i_w = 0;
-     BoxLoopI2(i, j, k, ix, iy, iz, nx, ny, nz,
+     ThreadedBoxLoopI2(ThreadPrivate(prod) ThreadReduction(+, sum),
+	       i, j, k, ix, iy, iz, nx, ny, nz,
 	       i_x, nx_x, ny_x, nz_x, 1, 1, 1,
 	       i_w, nx_w, ny_w, nz_w, 1, 1, 1,
 	       {
@@ -951,7 +1110,7 @@ double PFVL1Norm(
      xp = SubvectorElt(x_sub, ix, iy, iz);
 
      i_x = 0;
-     BoxLoopI1(i, j, k, ix, iy, iz, nx, ny, nz,
+     ThreadedBoxLoopI1(ThreadReduction(+, sum), i, j, k, ix, iy, iz, nx, ny, nz,
 	       i_x, nx_x, ny_x, nz_x, 1, 1, 1,
 	       {
 		  sum += fabs(xp[i_x]);
@@ -1021,7 +1180,8 @@ double PFVMin(
      }
 
      i_x = 0;
-     BoxLoopI1(i, j, k, ix, iy, iz, nx, ny, nz,
+     ThreadedBoxLoopI1(ThreadReduction(min, min_val),
+	       i, j, k, ix, iy, iz, nx, ny, nz,
 	       i_x, nx_x, ny_x, nz_x, 1, 1, 1,
 	       {
 		  if (xp[i_x] < min_val) min_val = xp[i_x];
@@ -1086,7 +1246,8 @@ double PFVMax(
      }
 
      i_x = 0;
-     BoxLoopI1(i, j, k, ix, iy, iz, nx, ny, nz,
+     ThreadedBoxLoopI1(ThreadReduction(max, max_val),
+	       i, j, k, ix, iy, iz, nx, ny, nz,
 	       i_x, nx_x, ny_x, nz_x, 1, 1, 1,
 	       {
 		  if (xp[i_x] > max_val) max_val = xp[i_x];
@@ -1154,7 +1315,8 @@ int PFVConstrProdPos(
      val = 1;
      i_c = 0;
      i_x = 0;
-     BoxLoopI2(i, j, k, ix, iy, iz, nx, ny, nz,
+     ThreadedBoxLoopI2(ThreadReduction(min, val),
+	       i, j, k, ix, iy, iz, nx, ny, nz,
 	       i_x, nx_x, ny_x, nz_x, 1, 1, 1,
 	       i_c, nx_c, ny_c, nz_c, 1, 1, 1,
 	       {
@@ -1225,7 +1387,7 @@ void PFVCompare(
 
      i_x = 0;
      i_z = 0;
-     BoxLoopI2(i, j, k, ix, iy, iz, nx, ny, nz,
+     ThreadedBoxLoopI2(NoThreadClauses, i, j, k, ix, iy, iz, nx, ny, nz,
 	       i_x, nx_x, ny_x, nz_x, 1, 1, 1,
 	       i_z, nx_z, ny_z, nz_z, 1, 1, 1,
 	       {
@@ -1287,7 +1449,8 @@ int PFVInvTest(
      i_x = 0;
      i_z = 0;
      val = 1;
-     BoxLoopI2(i, j, k, ix, iy, iz, nx, ny, nz,
+     ThreadedBoxLoopI2(ThreadReduction(min, val),
+	       i, j, k, ix, iy, iz, nx, ny, nz,
 	       i_x, nx_x, ny_x, nz_x, 1, 1, 1,
 	       i_z, nx_z, ny_z, nz_z, 1, 1, 1,
 	       {
@@ -1361,7 +1524,7 @@ void PFVCopy(
          
       i_x = 0;
       i_y = 0;
-      BoxLoopI2(i, j, k, ix, iy, iz, nx, ny, nz,
+      ThreadedBoxLoopI2(NoThreadClauses, i, j, k, ix, iy, iz, nx, ny, nz,
                 i_x, nx_x, ny_x, nz_x, 1, 1, 1,
                 i_y, nx_y, ny_y, nz_y, 1, 1, 1,
                 {
@@ -1428,7 +1591,7 @@ void PFVSum(
       i_x = 0;
       i_y = 0;
       i_z = 0;
-      BoxLoopI3(i, j, k, ix, iy, iz, nx, ny, nz,
+      ThreadedBoxLoopI3(NoThreadClauses, i, j, k, ix, iy, iz, nx, ny, nz,
                 i_x, nx_x, ny_x, nz_x, 1, 1, 1,
                 i_y, nx_y, ny_y, nz_y, 1, 1, 1,
                 i_z, nx_z, ny_z, nz_z, 1, 1, 1,
@@ -1498,7 +1661,7 @@ void PFVDiff(
       i_x = 0;
       i_y = 0;
       i_z = 0;
-      BoxLoopI3(i, j, k, ix, iy, iz, nx, ny, nz,
+      ThreadedBoxLoopI3(NoThreadClauses, i, j, k, ix, iy, iz, nx, ny, nz,
                 i_x, nx_x, ny_x, nz_x, 1, 1, 1,
                 i_y, nx_y, ny_y, nz_y, 1, 1, 1,
                 i_z, nx_z, ny_z, nz_z, 1, 1, 1,
@@ -1558,7 +1721,7 @@ void PFVNeg(
          
       i_x = 0;
       i_z = 0;
-      BoxLoopI2(i, j, k, ix, iy, iz, nx, ny, nz,
+      ThreadedBoxLoopI2(NoThreadClauses, i, j, k, ix, iy, iz, nx, ny, nz,
                 i_x, nx_x, ny_x, nz_x, 1, 1, 1,
                 i_z, nx_z, ny_z, nz_z, 1, 1, 1,
                 {
@@ -1627,7 +1790,7 @@ void PFVScaleSum(
       i_x = 0;
       i_y = 0;
       i_z = 0;
-      BoxLoopI3(i, j, k, ix, iy, iz, nx, ny, nz,
+      ThreadedBoxLoopI3(NoThreadClauses, i, j, k, ix, iy, iz, nx, ny, nz,
                 i_x, nx_x, ny_x, nz_x, 1, 1, 1,
                 i_y, nx_y, ny_y, nz_y, 1, 1, 1,
                 i_z, nx_z, ny_z, nz_z, 1, 1, 1,
@@ -1698,7 +1861,7 @@ Vector *z)
       i_x = 0;
       i_y = 0;
       i_z = 0;
-      BoxLoopI3(i, j, k, ix, iy, iz, nx, ny, nz,
+      ThreadedBoxLoopI3(NoThreadClauses, i, j, k, ix, iy, iz, nx, ny, nz,
                 i_x, nx_x, ny_x, nz_x, 1, 1, 1,
                 i_y, nx_y, ny_y, nz_y, 1, 1, 1,
                 i_z, nx_z, ny_z, nz_z, 1, 1, 1,
@@ -1769,7 +1932,7 @@ Vector *z)
       i_x = 0;
       i_y = 0;
       i_z = 0;
-      BoxLoopI3(i, j, k, ix, iy, iz, nx, ny, nz,
+      ThreadedBoxLoopI3(NoThreadClauses, i, j, k, ix, iy, iz, nx, ny, nz,
                 i_x, nx_x, ny_x, nz_x, 1, 1, 1,
                 i_y, nx_y, ny_y, nz_y, 1, 1, 1,
                 i_z, nx_z, ny_z, nz_z, 1, 1, 1,
@@ -1840,7 +2003,7 @@ Vector *y,
       i_x = 0;
       i_y = 0;
       i_z = 0;
-      BoxLoopI3(i, j, k, ix, iy, iz, nx, ny, nz,
+      ThreadedBoxLoopI3(NoThreadClauses, i, j, k, ix, iy, iz, nx, ny, nz,
                 i_x, nx_x, ny_x, nz_x, 1, 1, 1,
                 i_y, nx_y, ny_y, nz_y, 1, 1, 1,
                 i_z, nx_z, ny_z, nz_z, 1, 1, 1,
@@ -1901,7 +2064,7 @@ Vector *y)
          
       i_x = 0;
       i_y = 0;
-      BoxLoopI2(i, j, k, ix, iy, iz, nx, ny, nz,
+      ThreadedBoxLoopI2(NoThreadClauses, i, j, k, ix, iy, iz, nx, ny, nz,
                 i_x, nx_x, ny_x, nz_x, 1, 1, 1,
                 i_y, nx_y, ny_y, nz_y, 1, 1, 1,
                 {
@@ -1951,7 +2114,7 @@ void PFVScaleBy(
       xp = SubvectorElt(x_sub, ix, iy, iz);
          
       i_x = 0;
-      BoxLoopI1(i, j, k, ix, iy, iz, nx, ny, nz,
+      ThreadedBoxLoopI1(NoThreadClauses, i, j, k, ix, iy, iz, nx, ny, nz,
                 i_x, nx_x, ny_x, nz_x, 1, 1, 1,
                 {
                    xp[i_x] = xp[i_x] * a;
@@ -2044,4 +2207,442 @@ Vector *y)
         }
     }
     IncFLOPCount( 2 * VectorSize(x) );
-}
\ No newline at end of file
+}
+
+/*--------------------------------------------------------------------------
+ * Fused operations.
+ *
+ * Each of these does in a single sweep over the vectors, and at most a
+ * single global reduction, what would otherwise take a chain of the
+ * routines above.  The vectors must all be on the same grid; they then
+ * share a data layout, so one index walks all of them.
+ *--------------------------------------------------------------------------*/
+
+void PFVLinearCombination(
+/* LinearCombination : z = sum_m c[m] * x[m], m = 0, ..., nvec-1.
+   z may be one of the x[m]. */
+   int      nvec,
+   double  *c,
+   Vector **x,
+   Vector  *z)
+{
+  Grid       *grid     = VectorGrid(z);
+  Subgrid    *subgrid;
+ 
+  Subvector  *z_sub;
+
+  double     *zp, **xp;
+  double      sum;
+
+  int         ix,   iy,   iz;
+  int         nx,   ny,   nz;
+  int         nx_z, ny_z;
+
+  int         sg, i, j, k, m, i_z;
+
+  if (nvec <= 0)
+     return;
+
+  xp = talloc(double *, nvec);
+
+  ForSubgridI(sg, GridSubgrids(grid))
+  {
+     subgrid = GridSubgrid(grid, sg);
+
+     z_sub = VectorSubvector(z, sg);
+
+     ix = SubgridIX(subgrid);
+     iy = SubgridIY(subgrid);
+     iz = SubgridIZ(subgrid);
+
+     nx = SubgridNX(subgrid);
+     ny = SubgridNY(subgrid);
+     nz = SubgridNZ(subgrid);
+
+     nx_z = SubvectorNX(z_sub);
+     ny_z = SubvectorNY(z_sub);
+
+     zp = SubvectorElt(z_sub, ix, iy, iz);
+     for (m = 0; m < nvec; m++)
+        xp[m] = SubvectorElt(VectorSubvector(x[m], sg), ix, iy, iz);
+
+     i_z = 0;
+     ThreadedBoxLoopI1(ThreadPrivate(m, sum), i, j, k, ix, iy, iz, nx, ny, nz,
+               i_z, nx_z, ny_z, SubvectorNZ(z_sub), 1, 1, 1,
+	       {
+		  sum = c[0] * xp[0][i_z];
+		  for (m = 1; m < nvec; m++)
+		     sum += c[m] * xp[m][i_z];
+		  zp[i_z] = sum;
+               });
+  }
+
+  tfree(xp);
+
+  IncFLOPCount( (2 * nvec - 1) * VectorSize(z) );
+}
+
+void PFVMultiAxpy(
+/* MultiAxpy : y = y + sum_m c[m] * x[m], m = 0, ..., nvec-1 */
+   int      nvec,
+   double  *c,
+   Vector **x,
+   Vector  *y)
+{
+  PFVMultiAxpyDot(nvec, c, x, y, FALSE);
+}
+
+double PFVMultiAxpyDot(
+/* MultiAxpyDot : y = y + sum_m c[m] * x[m], m = 0, ..., nvec-1.
+   If dot is TRUE also returns y dot y (after the update), else 0. */
+   int      nvec,
+   double  *c,
+   Vector **x,
+   Vector  *y,
+   int      dot)
+{
+  Grid       *grid     = VectorGrid(y);
+  Subgrid    *subgrid;
+ 
+  Subvector  *y_sub;
+
+  double     *yp, **xp;
+  double      yval, sum = ZERO;
+
+  int         ix,   iy,   iz;
+  int         nx,   ny,   nz;
+  int         nx_y, ny_y;
+
+  int         sg, i, j, k, m, i_y;
+
+  amps_Invoice   result_invoice;
+
+  xp = talloc(double *, pfmax(nvec, 1));
+
+  ForSubgridI(sg, GridSubgrids(grid))
+  {
+     subgrid = GridSubgrid(grid, sg);
+
+     y_sub = VectorSubvector(y, sg);
+
+     ix = SubgridIX(subgrid);
+     iy = SubgridIY(subgrid);
+     iz = SubgridIZ(subgrid);
+
+     nx = SubgridNX(subgrid);
+     ny = SubgridNY(subgrid);
+     nz = SubgridNZ(subgrid);
+
+     nx_y = SubvectorNX(y_sub);
+     ny_y = SubvectorNY(y_sub);
+
+     yp = SubvectorElt(y_sub, ix, iy, iz);
+     for (m = 0; m < nvec; m++)
+        xp[m] = SubvectorElt(VectorSubvector(x[m], sg), ix, iy, iz);
+
+     i_y = 0;
+     if (dot)
+     {
+	ThreadedBoxLoopI1(ThreadPrivate(m, yval) ThreadReduction(+, sum),
+		  i, j, k, ix, iy, iz, nx, ny, nz,
+		  i_y, nx_y, ny_y, SubvectorNZ(y_sub), 1, 1, 1,
+		  {
+		     yval = yp[i_y];
+		     for (m = 0; m < nvec; m++)
+			yval += c[m] * xp[m][i_y];
+		     yp[i_y] = yval;
+		     sum += yval * yval;
+		  });
+     }
+     else
+     {
+	ThreadedBoxLoopI1(ThreadPrivate(m, yval),
+		  i, j, k, ix, iy, iz, nx, ny, nz,
+		  i_y, nx_y, ny_y, SubvectorNZ(y_sub), 1, 1, 1,
+		  {
+		     yval = yp[i_y];
+		     for (m = 0; m < nvec; m++)
+			yval += c[m] * xp[m][i_y];
+		     yp[i_y] = yval;
+		  });
+     }
+  }
+
+  tfree(xp);
+
+  IncFLOPCount( 2 * nvec * VectorSize(y) );
+
+  if (dot)
+  {
+     result_invoice = amps_NewInvoice("%d", &sum);
+     amps_AllReduce(amps_CommWorld, result_invoice, amps_Add);
+     amps_FreeInvoice(result_invoice);
+
+     IncFLOPCount( 2 * VectorSize(y) );
+  }
+
+  return(sum);
+}
+
+double PFVWMaxNorm(
+/* WMaxNorm = max_i |x_i * w_i|  */
+   Vector *x,
+   Vector *w)
+{
+  Grid       *grid     = VectorGrid(x);
+  Subgrid    *subgrid;
+ 
+  Subvector  *x_sub;
+  Subvector  *w_sub;
+
+  double     *xp, *wp;
+  double      prod, max_val = ZERO;
+
+  int         ix,   iy,   iz;
+  int         nx,   ny,   nz;
+  int         nx_x, ny_x;
+
+  int         sg, i, j, k, i_x;
+
+  amps_Invoice    result_invoice;
+
+  ForSubgridI(sg, GridSubgrids(grid))
+  {
+     subgrid = GridSubgrid(grid, sg);
+
+     x_sub = VectorSubvector(x, sg);
+     w_sub = VectorSubvector(w, sg);
+
+     ix = SubgridIX(subgrid);
+     iy = SubgridIY(subgrid);
+     iz = SubgridIZ(subgrid);
+
+     nx = SubgridNX(subgrid);
+     ny = SubgridNY(subgrid);
+     nz = SubgridNZ(subgrid);
+
+     nx_x = SubvectorNX(x_sub);
+     ny_x = SubvectorNY(x_sub);
+
+     xp = SubvectorElt(x_sub, ix, iy, iz);
+     wp = SubvectorElt(w_sub, ix, iy, iz);
+
+     i_x = 0;
+     ThreadedBoxLoopI1(ThreadPrivate(prod) ThreadReduction(max, max_val),
+               i, j, k, ix, iy, iz, nx, ny, nz,
+               i_x, nx_x, ny_x, SubvectorNZ(x_sub), 1, 1, 1,
+	       {
+		  prod = fabs(wp[i_x] * fabs(xp[i_x]));
+                  if (prod > max_val) max_val = prod;
+	       });
+  }
+
+  result_invoice = amps_NewInvoice("%d", &max_val);
+  amps_AllReduce(amps_CommWorld, result_invoice, amps_Max);
+  amps_FreeInvoice(result_invoice);
+
+  IncFLOPCount( VectorSize(x) );
+
+  return(max_val);
+}
+
+double PFVStepMaxNorm(
+/* StepMaxNorm = max_i |p_i / (1 / w_i + |u_i|)|  */
+   Vector *u,
+   Vector *p,
+   Vector *w)
+{
+  Grid       *grid     = VectorGrid(u);
+  Subgrid    *subgrid;
+ 
+  Subvector  *u_sub;
+
+  double     *up, *pp, *wp;
+  double      ratio, max_val = ZERO;
+
+  int         ix,   iy,   iz;
+  int         nx,   ny,   nz;
+  int         nx_u, ny_u;
+
+  int         sg, i, j, k, i_u;
+
+  amps_Invoice    result_invoice;
+
+  ForSubgridI(sg, GridSubgrids(grid))
+  {
+     subgrid = GridSubgrid(grid, sg);
+
+     u_sub = VectorSubvector(u, sg);
+
+     ix = SubgridIX(subgrid);
+     iy = SubgridIY(subgrid);
+     iz = SubgridIZ(subgrid);
+
+     nx = SubgridNX(subgrid);
+     ny = SubgridNY(subgrid);
+     nz = SubgridNZ(subgrid);
+
+     nx_u = SubvectorNX(u_sub);
+     ny_u = SubvectorNY(u_sub);
+
+     up = SubvectorElt(u_sub, ix, iy, iz);
+     pp = SubvectorElt(VectorSubvector(p, sg), ix, iy, iz);
+     wp = SubvectorElt(VectorSubvector(w, sg), ix, iy, iz);
+
+     i_u = 0;
+     ThreadedBoxLoopI1(ThreadPrivate(ratio) ThreadReduction(max, max_val),
+               i, j, k, ix, iy, iz, nx, ny, nz,
+               i_u, nx_u, ny_u, SubvectorNZ(u_sub), 1, 1, 1,
+	       {
+		  ratio = fabs(pp[i_u] / (ONE / wp[i_u] + fabs(up[i_u])));
+                  if (ratio > max_val) max_val = ratio;
+	       });
+  }
+
+  result_invoice = amps_NewInvoice("%d", &max_val);
+  amps_AllReduce(amps_CommWorld, result_invoice, amps_Max);
+  amps_FreeInvoice(result_invoice);
+
+  IncFLOPCount( 3 * VectorSize(u) );
+
+  return(max_val);
+}
+
+double PFVWL2NormDot(
+/* WL2NormDot = sqrt(sum_i (x_i * w_i)^2); also
+   dot = sum_i y_i * (x_i * w_i) * w_i */
+   Vector *x,
+   Vector *w,
+   Vector *y,
+   double *dot)
+{
+  Grid       *grid     = VectorGrid(x);
+  Subgrid    *subgrid;
+ 
+  Subvector  *x_sub;
+
+  double     *xp, *wp, *yp;
+  double      prod, sums[2];
+
+  int         ix,   iy,   iz;
+  int         nx,   ny,   nz;
+  int         nx_x, ny_x;
+
+  int         sg, i, j, k, i_x;
+
+  amps_Invoice    result_invoice;
+
+  sums[0] = ZERO;
+  sums[1] = ZERO;
+
+  ForSubgridI(sg, GridSubgrids(grid))
+  {
+     subgrid = GridSubgrid(grid, sg);
+
+     x_sub = VectorSubvector(x, sg);
+
+     ix = SubgridIX(subgrid);
+     iy = SubgridIY(subgrid);
+     iz = SubgridIZ(subgrid);
+
+     nx = SubgridNX(subgrid);
+     ny = SubgridNY(subgrid);
+     nz = SubgridNZ(subgrid);
+
+     nx_x = SubvectorNX(x_sub);
+     ny_x = SubvectorNY(x_sub);
+
+     xp = SubvectorElt(x_sub, ix, iy, iz);
+     wp = SubvectorElt(VectorSubvector(w, sg), ix, iy, iz);
+     yp = SubvectorElt(VectorSubvector(y, sg), ix, iy, iz);
+
+     i_x = 0;
+     ThreadedBoxLoopI1(ThreadPrivate(prod) ThreadReduction(+, sums[:2]),
+               i, j, k, ix, iy, iz, nx, ny, nz,
+               i_x, nx_x, ny_x, SubvectorNZ(x_sub), 1, 1, 1,
+	       {
+                  prod = xp[i_x] * wp[i_x];
+		  sums[0] += prod * prod;
+		  sums[1] += yp[i_x] * (prod * wp[i_x]);
+	       });
+  }
+
+  result_invoice = amps_NewInvoice("%*d", 2, sums);
+  amps_AllReduce(amps_CommWorld, result_invoice, amps_Add);
+  amps_FreeInvoice(result_invoice);
+
+  IncFLOPCount( 6 * VectorSize(x) );
+
+  *dot = sums[1];
+  return(sqrt(sums[0]));
+}
+
+void PFVWDotProdL1(
+/* WDotProdL1 : with a = w * u and b = w * v (elementwise),
+   result[0] = a dot b, result[1] = b dot b, result[2] = sum_i |b_i| */
+   Vector *u,
+   Vector *v,
+   Vector *w,
+   double *result)
+{
+  Grid       *grid     = VectorGrid(u);
+  Subgrid    *subgrid;
+ 
+  Subvector  *u_sub;
+
+  double     *up, *vp, *wp;
+  double      a, b;
+
+  int         ix,   iy,   iz;
+  int         nx,   ny,   nz;
+  int         nx_u, ny_u;
+
+  int         sg, i, j, k, i_u;
+
+  amps_Invoice    result_invoice;
+
+  result[0] = ZERO;
+  result[1] = ZERO;
+  result[2] = ZERO;
+
+  ForSubgridI(sg, GridSubgrids(grid))
+  {
+     subgrid = GridSubgrid(grid, sg);
+
+     u_sub = VectorSubvector(u, sg);
+
+     ix = SubgridIX(subgrid);
+     iy = SubgridIY(subgrid);
+     iz = SubgridIZ(subgrid);
+
+     nx = SubgridNX(subgrid);
+     ny = SubgridNY(subgrid);
+     nz = SubgridNZ(subgrid);
+
+     nx_u = SubvectorNX(u_sub);
+     ny_u = SubvectorNY(u_sub);
+
+     up = SubvectorElt(u_sub, ix, iy, iz);
+     vp = SubvectorElt(VectorSubvector(v, sg), ix, iy, iz);
+     wp = SubvectorElt(VectorSubvector(w, sg), ix, iy, iz);
+
+     i_u = 0;
+     ThreadedBoxLoopI1(ThreadPrivate(a, b) ThreadReduction(+, result[:3]),
+               i, j, k, ix, iy, iz, nx, ny, nz,
+               i_u, nx_u, ny_u, SubvectorNZ(u_sub), 1, 1, 1,
+	       {
+		  a = up[i_u] * wp[i_u];
+		  b = vp[i_u] * wp[i_u];
+		  result[0] += a * b;
+		  result[1] += b * b;
+		  result[2] += fabs(b);
+	       });
+  }
+
+  result_invoice = amps_NewInvoice("%*d", 3, result);
+  amps_AllReduce(amps_CommWorld, result_invoice, amps_Add);
+  amps_FreeInvoice(result_invoice);
+
+  IncFLOPCount( 7 * VectorSize(u) );
+}
+
@@ -101,7 +101,7 @@ int    	 zero)
    int       	   sx,   sy,   sz;
 	      
    int       	   nx_v = 0, ny_v = 0, nz_v = 0;
-   int       	   nx_m = 0, ny_m = 0, nz_m;
+   int       	   nx_m = 0, ny_m = 0, nz_m, sx_m = 1;
 
    int             compute_i, i_sa, i_s, si, i, j, k;
    int             im, iv;
@@ -155,6 +155,7 @@ int    	 zero)
 	 nx_m = SubmatrixNX(A_sub);
 	 ny_m = SubmatrixNY(A_sub);
 	 nz_m = SubmatrixNZ(A_sub);
+	 sx_m = SubmatrixStride(A_sub);
 
 	 nx_v = SubvectorNX(x_sub);
 	 ny_v = SubvectorNY(x_sub);
@@ -179,7 +180,7 @@ int    	 zero)
 	 iv = im = 0;
 	 BoxLoopI2(i, j, k, ix, iy, iz, nx, ny, nz,
 		   iv, nx_v, ny_v, nz_v, sx, sy, sz,
-		   im, nx_m, ny_m, nz_m, sx, sy, sz,
+		   im, nx_m*sx_m, ny_m, nz_m, sx*sx_m, sy, sz,
 		   {
 		      xp[iv] = bp[iv] / ap[im];
 		   });
@@ -229,6 +230,7 @@ int    	 zero)
                nx_m = SubmatrixNX(A_sub);
                ny_m = SubmatrixNY(A_sub);
                nz_m = SubmatrixNZ(A_sub);
+               sx_m = SubmatrixStride(A_sub);
 
                nx_v = SubvectorNX(x_sub);
                ny_v = SubvectorNY(x_sub);
@@ -268,7 +270,7 @@ int    	 zero)
 		  iv = im = 0;
 		  BoxLoopI2(i, j, k, ix, iy, iz, nx, ny, nz,
 			    iv, nx_v, ny_v, nz_v, sx, sy, sz,
-			    im, nx_m, ny_m, nz_m, sx, sy, sz,
+			    im, nx_m*sx_m, ny_m, nz_m, sx*sx_m, sy, sz,
 			    {
 			       tp[iv] -= ap[im] * xp[iv];
 			    });
@@ -278,7 +280,7 @@ int    	 zero)
 	       iv = im = 0;
 	       BoxLoopI2(i, j, k, ix, iy, iz, nx, ny, nz,
 			 iv, nx_v, ny_v, nz_v, sx, sy, sz,
-			 im, nx_m, ny_m, nz_m, sx, sy, sz,
+			 im, nx_m*sx_m, ny_m, nz_m, sx*sx_m, sy, sz,
 			 {
 			    tp[iv] /= ap[im];
 			 });
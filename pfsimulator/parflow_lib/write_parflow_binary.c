@@ -34,35 +34,23 @@
 #include "parflow.h"
 
 #include <math.h>
+#include <string.h>
 
 long SizeofPFBinarySubvector(
    Subvector *subvector,
    Subgrid   *subgrid)
 {
-   int ix = SubgridIX(subgrid);
-   int iy = SubgridIY(subgrid);
-   int iz = SubgridIZ(subgrid);
-
-   int             nx = SubgridNX(subgrid);
-   int             ny = SubgridNY(subgrid);
-   int             nz = SubgridNZ(subgrid);
-
-   int             nx_v = SubvectorNX(subvector);
-   int             ny_v = SubvectorNY(subvector);
-
-   int            i, j, k, ai;
+   long            nx = SubgridNX(subgrid);
+   long            ny = SubgridNY(subgrid);
+   long            nz = SubgridNZ(subgrid);
 
    long size;
 
+   (void) subvector;
+
    size = 9*amps_SizeofInt;
 
-   ai = 0;
-   BoxLoopI1(i,j,k,
-	     ix,iy,iz,nx,ny,nz,
-	     ai,nx_v,ny_v,nz_v,1,1,1,
-	     {
-		size += amps_SizeofDouble;
-	     });
+   size += nx*ny*nz*(long)amps_SizeofDouble;
 
    return size;
 }
@@ -84,8 +72,9 @@ Subgrid   *subgrid)
    int             nx_v = SubvectorNX(subvector);
    int             ny_v = SubvectorNY(subvector);
 
-   int            i, j, k, ai;
+   int            j, k, ai, bi, n;
    double         *data;
+   double         *buffer;
 
    amps_WriteInt(file, &ix, 1);
    amps_WriteInt(file, &iy, 1);
@@ -100,20 +89,138 @@ Subgrid   *subgrid)
    amps_WriteInt(file, &SubgridRZ(subgrid), 1);
 
    data = SubvectorElt(subvector, ix, iy, iz);
-	 
-   /* SGS Note:
-      this is way to slow we need better boxloops that operate
-      on arrays */
 
-   ai = 0;
-   BoxLoopI1(i,j,k,
-	     ix,iy,iz,nx,ny,nz,
-	     ai,nx_v,ny_v,nz_v,1,1,1,
-	     {
-		amps_WriteDouble(file, &data[ai], 1);
-	     });
+   /* Gather the subgrid without ghost points into a staging buffer one
+      x-pencil at a time and write it with a single call */
+   n = nx*ny*nz;
+   buffer = talloc(double, n);
+
+   bi = 0;
+   for(k = 0; k < nz; k++)
+   {
+      for(j = 0; j < ny; j++)
+      {
+	 ai = (k*ny_v + j)*nx_v;
+	 memcpy(buffer + bi, data + ai, (size_t)nx*sizeof(double));
+	 bi += nx;
+      }
+   }
+
+   amps_WriteDouble(file, buffer, n);
+
+   tfree(buffer);
+}
+
+
+#ifdef AMPS_HAVE_MPI_IO
+
+/*--------------------------------------------------------------------------
+ * MPI-IO PFB writer.
+ *
+ *   Each rank packs its part of the file (big endian, same layout as the
+ *   amps writer) into memory, the offsets come from an exclusive scan of
+ *   the sizes and the data is written with one collective write.  The
+ *   .dist file is still written so the file can be read by the amps
+ *   reader and pftools.
+ *--------------------------------------------------------------------------*/
+
+static void  WritePFBinaryMPIIO(
+char    *filename,
+Vector  *v,
+long     size,
+int      num_subgrids)
+{
+   Grid           *grid     = VectorGrid(v);
+   SubgridArray   *subgrids = GridSubgrids(grid);
+
+   int             g;
+   int             p, P;
+
+   char           *buffer;
+   char           *pos;
+
+   long            start;
+   long           *starts = NULL;
+
+   char            dist_filename[255];
+   FILE           *dfile;
+
+   MPI_File        fh;
+
+   p = amps_Rank(amps_CommWorld);
+   P = amps_Size(amps_CommWorld);
+
+   buffer = talloc(char, size);
+   pos    = buffer;
+
+   if ( p == 0 )
+   {
+      int nxyz[3];
+
+      nxyz[0] = SubgridNX(GridBackground(grid));
+      nxyz[1] = SubgridNY(GridBackground(grid));
+      nxyz[2] = SubgridNZ(GridBackground(grid));
+
+      pos = PFBPackDoubles(pos, &BackgroundX(GlobalsBackground), 1);
+      pos = PFBPackDoubles(pos, &BackgroundY(GlobalsBackground), 1);
+      pos = PFBPackDoubles(pos, &BackgroundZ(GlobalsBackground), 1);
+      pos = PFBPackInts(pos, nxyz, 3);
+      pos = PFBPackDoubles(pos, &BackgroundDX(GlobalsBackground), 1);
+      pos = PFBPackDoubles(pos, &BackgroundDY(GlobalsBackground), 1);
+      pos = PFBPackDoubles(pos, &BackgroundDZ(GlobalsBackground), 1);
+      pos = PFBPackInts(pos, &num_subgrids, 1);
+   }
+
+   ForSubgridI(g, subgrids)
+   {
+      pos = PFBPackSubvector(pos, VectorSubvector(v, g),
+			     SubgridArraySubgrid(subgrids, g));
+   }
+
+   /* offset of this rank's part of the file */
+   start = 0;
+   MPI_Exscan(&size, &start, 1, MPI_LONG, MPI_SUM, amps_CommWorld);
+   if ( p == 0 )
+      start = 0;
+
+   /* keep the .dist file for the amps reader and pftools */
+   if ( p == 0 )
+      starts = talloc(long, P);
+
+   MPI_Gather(&start, 1, MPI_LONG, starts, 1, MPI_LONG, 0, amps_CommWorld);
+
+   if ( p == 0 )
+   {
+      sprintf(dist_filename, "%s.dist", filename);
+      if( (dfile = fopen(dist_filename, "w")) == NULL)
+      {
+	 amps_Printf("Error: can't open distribution file %s\n",
+		     dist_filename);
+	 exit(1);
+      }
+      for(g = 0; g < P; g++)
+	 fprintf(dfile, "%ld\n", starts[g]);
+      fclose(dfile);
+
+      tfree(starts);
+   }
+
+   PFBMPIIOCheck(MPI_File_open(amps_CommWorld, filename,
+			       MPI_MODE_CREATE | MPI_MODE_WRONLY,
+			       MPI_INFO_NULL, &fh),
+		 "open", filename);
+
+   PFBMPIIOCheck(MPI_File_set_size(fh, 0), "truncation", filename);
+
+   PFBMPIIOWriteAtAll(fh, filename, start, buffer, size);
+
+   PFBMPIIOCheck(MPI_File_close(&fh), "close", filename);
+
+   tfree(buffer);
 }
 
+#endif
+
 
 void     WritePFBinary(
 char    *file_prefix,
@@ -152,15 +259,8 @@ Vector  *v)
       size += SizeofPFBinarySubvector(subvector, subgrid);
    }
 
-   /* open file */
    sprintf(filename, "%s.%s.%s", file_prefix, file_suffix, file_extn);
 
-   if ((file = amps_FFopen(amps_CommWorld, filename, "wb", size)) == NULL)
-   {
-      amps_Printf("Error: can't open output file %s\n", filename);
-      exit(1);
-   }
-
    /* Compute number of patches to write */
    int num_subgrids = GridNumSubgrids(grid);
    {
@@ -171,6 +271,23 @@ Vector  *v)
       amps_FreeInvoice(invoice);
    }
 
+#ifdef AMPS_HAVE_MPI_IO
+   if ( GlobalsPFBIOMode == PFBIOModeMPIIO )
+   {
+      WritePFBinaryMPIIO(filename, v, size, num_subgrids);
+
+      EndTiming(PFBTimingIndex);
+      return;
+   }
+#endif
+
+   /* open file */
+   if ((file = amps_FFopen(amps_CommWorld, filename, "wb", size)) == NULL)
+   {
+      amps_Printf("Error: can't open output file %s\n", filename);
+      exit(1);
+   }
+
 
    if ( p == 0 )
    {
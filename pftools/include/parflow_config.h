@@ -0,0 +1,93 @@
+/* include/parflow_config.h.  Generated from parflow_config.h.in by configure.  */
+/*
+ * File:        $URL: svn+ssh://tux262.llnl.gov/usr/casc/samrai/repository/PARFLOW/trunk/config/PARFLOW_config.h.in $
+ * Package:     PARFLOW autoconf
+ * Copyright:   (c) 1997-2008 Lawrence Livermore National Security, LLC
+ * Revision:    $LastChangedRevision: 2180 $
+ * Modified:    $LastChangedDate: 2008-05-05 16:49:32 -0700 (Mon, 05 May 2008) $
+ * Description: PARFLOW configuration file
+ */  
+
+/*
+*************************************************************************
+*                                                                       *
+* IMPORTANT NOTE:  This file may be included in C source and/or         *
+*                  header files.  Thus, all syntax, including           *
+*                  comments must be standard C.                         *
+*                                                                       *
+*************************************************************************
+*/
+
+#ifndef included_PARFLOW_config
+#define included_PARFLOW_config
+
+#ifndef AMPS_SPLIT_FILE
+#define AMPS_SPLIT_FILE 1
+#endif
+
+#ifndef CASC_HAVE_GETTIMEOFDAY
+/* #undef CASC_HAVE_GETTIMEOFDAY */
+#endif
+
+#ifndef CASC_HAVE_BIGENDIAN
+/* #undef CASC_HAVE_BIGENDIAN */
+#endif
+
+/*
+ * X11 libraries
+ */
+
+#ifndef LACKS_X11
+#define LACKS_X11 1
+#endif
+
+/*
+ * Fortran compiler name mangling
+ */
+
+/* #undef FORTRAN_DOUBLE_UNDERSCORE */
+/* #undef FORTRAN_UNDERSCORE */
+/* #undef FORTRAN_CAPS */
+/* #undef FORTRAN_NO_UNDERSCORE */
+
+/*
+ * HDF5 common data format library
+ */
+
+// HDF is not working
+#ifndef HAVE_HDF5
+/* #undef HAVE_HDF5 */
+#endif
+
+/*
+ * Silo 
+ */
+
+#ifndef HAVE_SILO
+/* #undef HAVE_SILO */
+#endif
+
+/*
+ * Building with XDR
+ */
+#ifndef HAVE_XDR
+/* #undef HAVE_XDR */
+#endif
+
+/*
+ * MPI parallel message passing package
+ */
+
+#ifndef HAVE_MPI
+/* #undef HAVE_MPI */
+#endif
+
+/*
+ * Sundials solver package
+ */
+
+#ifndef HAVE_SUNDIALS
+/* #undef HAVE_SUNDIALS */
+#endif
+
+#endif
@@ -0,0 +1,399 @@
+#  This runs the CLM test case with 2D met forcing files, once reading
+#  each file on its timestep and once with the files read ahead
+#  (Solver.CLM.MetForcingPrefetch).  The forcing files are written here
+#  from the 1D forcing of the CLM test case, with the same values over the
+#  whole domain.  The two runs have to give the same output bit for bit.
+#  No preconditioner is used, so the runs are not compared with the PFMG
+#  correct output.
+
+#
+# Import the ParFlow TCL package
+#
+lappend auto_path $env(PARFLOW_DIR)/bin 
+package require parflow
+namespace import Parflow::*
+
+foreach dir {qflx_evap_grnd eflx_lh_tot qflx_evap_tot qflx_tran_veg correct_output qflx_infl swe_out eflx_lwrad_out t_grnd diag_out qflx_evap_soi eflx_soil_grnd eflx_sh_tot qflx_evap_veg qflx_top_soil} {
+    file mkdir $dir
+}
+
+#-----------------------------------------------------------------------------
+# File input version number
+#-----------------------------------------------------------------------------
+pfset FileVersion 4
+
+#-----------------------------------------------------------------------------
+# Process Topology
+#-----------------------------------------------------------------------------
+
+pfset Process.Topology.P        [lindex $argv 0]
+pfset Process.Topology.Q        [lindex $argv 1]
+pfset Process.Topology.R        [lindex $argv 2]
+
+#-----------------------------------------------------------------------------
+# Computational Grid
+#-----------------------------------------------------------------------------
+pfset ComputationalGrid.Lower.X                0.0
+pfset ComputationalGrid.Lower.Y                0.0
+pfset ComputationalGrid.Lower.Z                 0.0
+
+pfset ComputationalGrid.DX	               1000.
+pfset ComputationalGrid.DY                     1000. 
+pfset ComputationalGrid.DZ	                 0.5
+
+pfset ComputationalGrid.NX                      5
+pfset ComputationalGrid.NY                      5
+pfset ComputationalGrid.NZ                     10 
+
+#-----------------------------------------------------------------------------
+# The Names of the GeomInputs
+#-----------------------------------------------------------------------------
+pfset GeomInput.Names "domain_input"
+
+
+#-----------------------------------------------------------------------------
+# Domain Geometry Input
+#-----------------------------------------------------------------------------
+pfset GeomInput.domain_input.InputType            Box
+pfset GeomInput.domain_input.GeomName             domain
+
+#-----------------------------------------------------------------------------
+# Domain Geometry
+#-----------------------------------------------------------------------------
+pfset Geom.domain.Lower.X                        0.0 
+pfset Geom.domain.Lower.Y                        0.0
+pfset Geom.domain.Lower.Z                          0.0
+
+pfset Geom.domain.Upper.X                        5000.
+pfset Geom.domain.Upper.Y                        5000.
+pfset Geom.domain.Upper.Z                       5. 
+
+pfset Geom.domain.Patches  "x-lower x-upper y-lower y-upper z-lower z-upper"
+
+#-----------------------------------------------------------------------------
+# Perm
+#-----------------------------------------------------------------------------
+pfset Geom.Perm.Names "domain"
+
+pfset Geom.domain.Perm.Type            Constant
+pfset Geom.domain.Perm.Value           0.2
+
+
+pfset Perm.TensorType               TensorByGeom
+
+pfset Geom.Perm.TensorByGeom.Names  "domain"
+
+pfset Geom.domain.Perm.TensorValX  1.0
+pfset Geom.domain.Perm.TensorValY  1.0
+pfset Geom.domain.Perm.TensorValZ  1.0
+
+#-----------------------------------------------------------------------------
+# Specific Storage
+#-----------------------------------------------------------------------------
+# specific storage does not figure into the impes (fully sat) case but we still
+# need a key for it
+
+pfset SpecificStorage.Type            Constant
+pfset SpecificStorage.GeomNames       "domain"
+pfset Geom.domain.SpecificStorage.Value 1.0e-6
+
+#-----------------------------------------------------------------------------
+# Phases
+#-----------------------------------------------------------------------------
+
+pfset Phase.Names "water"
+
+pfset Phase.water.Density.Type	Constant
+pfset Phase.water.Density.Value	1.0
+
+pfset Phase.water.Viscosity.Type	Constant
+pfset Phase.water.Viscosity.Value	1.0
+
+#-----------------------------------------------------------------------------
+# Contaminants
+#-----------------------------------------------------------------------------
+pfset Contaminants.Names			""
+
+
+#-----------------------------------------------------------------------------
+# Gravity
+#-----------------------------------------------------------------------------
+
+pfset Gravity				1.0
+
+#-----------------------------------------------------------------------------
+# Setup timing info
+#-----------------------------------------------------------------------------
+ 
+pfset TimingInfo.BaseUnit        1.0
+pfset TimingInfo.StartCount      0
+pfset TimingInfo.StartTime       0.0
+pfset TimingInfo.StopTime        5
+pfset TimingInfo.DumpInterval    -1
+pfset TimeStep.Type              Constant
+pfset TimeStep.Value             1.0
+ 
+
+#-----------------------------------------------------------------------------
+# Porosity
+#-----------------------------------------------------------------------------
+
+pfset Geom.Porosity.GeomNames          domain
+
+pfset Geom.domain.Porosity.Type    Constant
+pfset Geom.domain.Porosity.Value   0.390
+
+#-----------------------------------------------------------------------------
+# Domain
+#-----------------------------------------------------------------------------
+pfset Domain.GeomName domain
+
+#-----------------------------------------------------------------------------
+# Mobility
+#-----------------------------------------------------------------------------
+pfset Phase.water.Mobility.Type        Constant
+pfset Phase.water.Mobility.Value       1.0
+
+#-----------------------------------------------------------------------------
+# Relative Permeability
+#-----------------------------------------------------------------------------
+ 
+pfset Phase.RelPerm.Type               VanGenuchten
+pfset Phase.RelPerm.GeomNames          "domain"
+ 
+pfset Geom.domain.RelPerm.Alpha         3.5
+pfset Geom.domain.RelPerm.N             2.
+
+#---------------------------------------------------------
+# Saturation
+#---------------------------------------------------------
+
+pfset Phase.Saturation.Type              VanGenuchten 
+pfset Phase.Saturation.GeomNames         "domain"
+ 
+pfset Geom.domain.Saturation.Alpha        3.5
+pfset Geom.domain.Saturation.N            2.
+pfset Geom.domain.Saturation.SRes         0.01
+pfset Geom.domain.Saturation.SSat         1.0
+
+#-----------------------------------------------------------------------------
+# Wells
+#-----------------------------------------------------------------------------
+pfset Wells.Names ""
+
+
+#-----------------------------------------------------------------------------
+# Time Cycles
+#-----------------------------------------------------------------------------
+pfset Cycle.Names constant
+pfset Cycle.constant.Names		"alltime"
+pfset Cycle.constant.alltime.Length	 1
+pfset Cycle.constant.Repeat		-1
+
+#-----------------------------------------------------------------------------
+# Boundary Conditions: Pressure
+#-----------------------------------------------------------------------------
+pfset BCPressure.PatchNames                   [pfget Geom.domain.Patches]
+ 
+pfset Patch.x-lower.BCPressure.Type                   FluxConst
+pfset Patch.x-lower.BCPressure.Cycle                  "constant"
+pfset Patch.x-lower.BCPressure.alltime.Value          0.0
+ 
+pfset Patch.y-lower.BCPressure.Type                   FluxConst
+pfset Patch.y-lower.BCPressure.Cycle                  "constant"
+pfset Patch.y-lower.BCPressure.alltime.Value          0.0
+ 
+pfset Patch.z-lower.BCPressure.Type                   FluxConst
+pfset Patch.z-lower.BCPressure.Cycle                  "constant"
+pfset Patch.z-lower.BCPressure.alltime.Value          0.0
+ 
+pfset Patch.x-upper.BCPressure.Type                   FluxConst
+pfset Patch.x-upper.BCPressure.Cycle                  "constant"
+pfset Patch.x-upper.BCPressure.alltime.Value          0.0
+ 
+pfset Patch.y-upper.BCPressure.Type                   FluxConst
+pfset Patch.y-upper.BCPressure.Cycle                  "constant"
+pfset Patch.y-upper.BCPressure.alltime.Value          0.0
+ 
+pfset Patch.z-upper.BCPressure.Type                   OverlandFlow
+##pfset Patch.z-upper.BCPressure.Type                FluxConst 
+pfset Patch.z-upper.BCPressure.Cycle                  "constant"
+pfset Patch.z-upper.BCPressure.alltime.Value          0.0
+
+#---------------------------------------------------------
+# Topo slopes in x-direction
+#---------------------------------------------------------
+ 
+pfset TopoSlopesX.Type "Constant"
+pfset TopoSlopesX.GeomNames "domain"
+pfset TopoSlopesX.Geom.domain.Value -0.001
+ 
+#---------------------------------------------------------
+# Topo slopes in y-direction
+#---------------------------------------------------------
+ 
+pfset TopoSlopesY.Type "Constant"
+pfset TopoSlopesY.GeomNames "domain"
+pfset TopoSlopesY.Geom.domain.Value 0.001
+ 
+#---------------------------------------------------------
+# Mannings coefficient 
+#---------------------------------------------------------
+ 
+pfset Mannings.Type "Constant"
+pfset Mannings.GeomNames "domain"
+pfset Mannings.Geom.domain.Value 5.52e-6
+
+#-----------------------------------------------------------------------------
+# Phase sources:
+#-----------------------------------------------------------------------------
+
+pfset PhaseSources.water.Type                         Constant
+pfset PhaseSources.water.GeomNames                    domain
+pfset PhaseSources.water.Geom.domain.Value        0.0
+ 
+#-----------------------------------------------------------------------------
+# Exact solution specification for error calculations
+#-----------------------------------------------------------------------------
+ 
+pfset KnownSolution                                      NoKnownSolution
+
+#-----------------------------------------------------------------------------
+# Set solver parameters
+#-----------------------------------------------------------------------------
+ 
+pfset Solver                                             Richards
+pfset Solver.MaxIter                                     500
+ 
+pfset Solver.Nonlinear.MaxIter                           15
+pfset Solver.Nonlinear.ResidualTol                       1e-9
+pfset Solver.Nonlinear.EtaChoice                         EtaConstant
+pfset Solver.Nonlinear.EtaValue                          0.01
+pfset Solver.Nonlinear.UseJacobian                       True 
+pfset Solver.Nonlinear.StepTol                           1e-20
+pfset Solver.Nonlinear.Globalization                     LineSearch
+pfset Solver.Linear.KrylovDimension                      15
+pfset Solver.Linear.MaxRestart                           2
+ 
+pfset Solver.Linear.Preconditioner                       NoPC
+pfset Solver.PrintSubsurf                                False
+pfset Solver.Drop                                        1E-20
+pfset Solver.AbsTol                                      1E-9
+ 
+pfset Solver.LSM                                         CLM
+pfset Solver.CLM.MetForcing                              2D
+pfset Solver.CLM.MetFileName                             met
+pfset Solver.CLM.MetFilePath                             ./
+
+
+pfset Solver.PrintCLM  True
+
+# Initial conditions: water pressure
+#---------------------------------------------------------
+ 
+pfset ICPressure.Type                                   HydroStaticPatch
+pfset ICPressure.GeomNames                              domain
+pfset Geom.domain.ICPressure.Value                      -2.0
+ 
+pfset Geom.domain.ICPressure.RefGeom                    domain
+pfset Geom.domain.ICPressure.RefPatch                   z-upper
+
+
+
+set num_processors [expr [pfget Process.Topology.P] * [pfget Process.Topology.Q] * [pfget Process.Topology.R]]
+for {set i 0} { $i <= $num_processors } {incr i} {
+    file delete drv_vegm.dat.$i
+    file copy  drv_vegm.dat drv_vegm.dat.$i
+    file delete drv_clmin.dat.$i
+    file copy drv_clmin.dat drv_clmin.dat.$i
+}
+
+#-----------------------------------------------------------------------------
+# Write the 2D forcing files, one per variable and timestep
+#-----------------------------------------------------------------------------
+
+proc writeMetPFB {filename value} {
+    set nx [pfget ComputationalGrid.NX]
+    set ny [pfget ComputationalGrid.NY]
+    set f [open $filename w]
+    fconfigure $f -translation binary
+    puts -nonewline $f [binary format "QQQIIIQQQI" \
+	[pfget ComputationalGrid.Lower.X] [pfget ComputationalGrid.Lower.Y] \
+	[pfget ComputationalGrid.Lower.Z] $nx $ny 1 \
+	[pfget ComputationalGrid.DX] [pfget ComputationalGrid.DY] 1.0 1]
+    puts -nonewline $f [binary format "IIIIIIIII" 0 0 0 $nx $ny 1 0 0 0]
+    puts -nonewline $f [binary format "Q*" [lrepeat [expr $nx * $ny] $value]]
+    close $f
+}
+
+set num_met_steps 8
+set vars "DSWR DLWR APCP Temp UGRD VGRD Press SPFH"
+set f [open narr_1hr.sc3.txt.0 r]
+for {set i 1} {$i <= $num_met_steps} {incr i} {
+    set values [gets $f]
+    for {set n 0} {$n < 8} {incr n} {
+	set filename [format "met.%s.%06d.pfb" [lindex $vars $n] $i]
+	writeMetPFB $filename [lindex $values $n]
+	pfset ComputationalGrid.NZ 1
+	pfdist $filename
+	pfset ComputationalGrid.NZ 10
+    }
+}
+close $f
+
+#-----------------------------------------------------------------------------
+# Run and Unload the ParFlow output files
+#-----------------------------------------------------------------------------
+
+pfset Solver.CLM.MetForcingPrefetch                      0
+pfrun clm_noprefetch
+pfundist clm_noprefetch
+
+pfset Solver.CLM.MetForcingPrefetch                      2
+pfrun clm_prefetch
+pfundist clm_prefetch
+
+for {set i 1} {$i <= $num_met_steps} {incr i} {
+    foreach var $vars {
+	pfundist [format "met.%s.%06d.pfb" $var $i]
+    }
+}
+
+#
+# Tests 
+#
+proc readBinary {file} {
+    set f [open $file r]
+    fconfigure $f -translation binary
+    set data [read $f]
+    close $f
+    return $data
+}
+
+set passed 1
+
+for {set i 1} {$i <= 5} {incr i} {
+    set i_string [format "%05d" $i]
+    set files [glob -nocomplain clm_noprefetch.out.*.$i_string.pfb*]
+    if {[llength $files] == 0} {
+	puts "FAILED : no output for timestep $i_string"
+	set passed 0
+    }
+    foreach file $files {
+	regsub clm_noprefetch $file clm_prefetch prefetch_file
+	if {![file exists $prefetch_file]} {
+	    puts "FAILED : $prefetch_file not written"
+	    set passed 0
+	} elseif {![string equal [readBinary $file] [readBinary $prefetch_file]]} {
+	    puts "FAILED : $prefetch_file differs from the run without read-ahead"
+	    set passed 0
+	}
+    }
+}
+
+
+if $passed {
+    puts "clm_met_prefetch : PASSED"
+} {
+    puts "clm_met_prefetch : FAILED"
+}
@@ -0,0 +1,408 @@
+#  Runs default_richards with a left pressure patch cycling between two
+#  values and a flux on the top patch, first with DirEquilRefPatch and
+#  FluxConst and then with PressureFile and FluxFile patches reading the
+#  same values from pfb files.  The file driven run re-reads its patch
+#  values whenever the cycle switches files and should match the first.
+#
+# Import the ParFlow TCL package
+#
+lappend auto_path $env(PARFLOW_DIR)/bin 
+package require parflow
+namespace import Parflow::*
+
+pfset FileVersion 4
+
+pfset Process.Topology.P        [lindex $argv 0]
+pfset Process.Topology.Q        [lindex $argv 1]
+pfset Process.Topology.R        [lindex $argv 2]
+
+#---------------------------------------------------------
+# Computational Grid
+#---------------------------------------------------------
+pfset ComputationalGrid.Lower.X                -10.0
+pfset ComputationalGrid.Lower.Y                 10.0
+pfset ComputationalGrid.Lower.Z                  1.0
+
+pfset ComputationalGrid.DX	                 8.8888888888888893
+pfset ComputationalGrid.DY                      10.666666666666666
+pfset ComputationalGrid.DZ	                 1.0
+
+pfset ComputationalGrid.NX                      10
+pfset ComputationalGrid.NY                      10
+pfset ComputationalGrid.NZ                       8
+
+#---------------------------------------------------------
+# The Names of the GeomInputs
+#---------------------------------------------------------
+pfset GeomInput.Names "domain_input background_input source_region_input \
+		       concen_region_input"
+
+
+#---------------------------------------------------------
+# Domain Geometry Input
+#---------------------------------------------------------
+pfset GeomInput.domain_input.InputType            Box
+pfset GeomInput.domain_input.GeomName             domain
+
+#---------------------------------------------------------
+# Domain Geometry
+#---------------------------------------------------------
+pfset Geom.domain.Lower.X                        -10.0 
+pfset Geom.domain.Lower.Y                         10.0
+pfset Geom.domain.Lower.Z                          1.0
+
+pfset Geom.domain.Upper.X                        150.0
+pfset Geom.domain.Upper.Y                        170.0
+pfset Geom.domain.Upper.Z                          9.0
+
+pfset Geom.domain.Patches "left right front back bottom top"
+
+#---------------------------------------------------------
+# Background Geometry Input
+#---------------------------------------------------------
+pfset GeomInput.background_input.InputType         Box
+pfset GeomInput.background_input.GeomName          background
+
+#---------------------------------------------------------
+# Background Geometry
+#---------------------------------------------------------
+pfset Geom.background.Lower.X -99999999.0
+pfset Geom.background.Lower.Y -99999999.0
+pfset Geom.background.Lower.Z -99999999.0
+
+pfset Geom.background.Upper.X  99999999.0
+pfset Geom.background.Upper.Y  99999999.0
+pfset Geom.background.Upper.Z  99999999.0
+
+
+#---------------------------------------------------------
+# Source_Region Geometry Input
+#---------------------------------------------------------
+pfset GeomInput.source_region_input.InputType      Box
+pfset GeomInput.source_region_input.GeomName       source_region
+
+#---------------------------------------------------------
+# Source_Region Geometry
+#---------------------------------------------------------
+pfset Geom.source_region.Lower.X    65.56
+pfset Geom.source_region.Lower.Y    79.34
+pfset Geom.source_region.Lower.Z     4.5
+
+pfset Geom.source_region.Upper.X    74.44
+pfset Geom.source_region.Upper.Y    89.99
+pfset Geom.source_region.Upper.Z     5.5
+
+
+#---------------------------------------------------------
+# Concen_Region Geometry Input
+#---------------------------------------------------------
+pfset GeomInput.concen_region_input.InputType       Box
+pfset GeomInput.concen_region_input.GeomName        concen_region
+
+#---------------------------------------------------------
+# Concen_Region Geometry
+#---------------------------------------------------------
+pfset Geom.concen_region.Lower.X   60.0
+pfset Geom.concen_region.Lower.Y   80.0
+pfset Geom.concen_region.Lower.Z    4.0
+
+pfset Geom.concen_region.Upper.X   80.0
+pfset Geom.concen_region.Upper.Y  100.0
+pfset Geom.concen_region.Upper.Z    6.0
+
+#-----------------------------------------------------------------------------
+# Perm
+#-----------------------------------------------------------------------------
+pfset Geom.Perm.Names "background"
+
+pfset Geom.background.Perm.Type     Constant
+pfset Geom.background.Perm.Value    4.0
+
+pfset Perm.TensorType               TensorByGeom
+
+pfset Geom.Perm.TensorByGeom.Names  "background"
+
+pfset Geom.background.Perm.TensorValX  1.0
+pfset Geom.background.Perm.TensorValY  1.0
+pfset Geom.background.Perm.TensorValZ  1.0
+
+#-----------------------------------------------------------------------------
+# Specific Storage
+#-----------------------------------------------------------------------------
+
+pfset SpecificStorage.Type            Constant
+pfset SpecificStorage.GeomNames       "domain"
+pfset Geom.domain.SpecificStorage.Value 1.0e-4
+
+#-----------------------------------------------------------------------------
+# Phases
+#-----------------------------------------------------------------------------
+
+pfset Phase.Names "water"
+
+pfset Phase.water.Density.Type	Constant
+pfset Phase.water.Density.Value	1.0
+
+pfset Phase.water.Viscosity.Type	Constant
+pfset Phase.water.Viscosity.Value	1.0
+
+#-----------------------------------------------------------------------------
+# Contaminants
+#-----------------------------------------------------------------------------
+pfset Contaminants.Names			""
+
+#-----------------------------------------------------------------------------
+# Retardation
+#-----------------------------------------------------------------------------
+pfset Geom.Retardation.GeomNames           ""
+
+#-----------------------------------------------------------------------------
+# Gravity
+#-----------------------------------------------------------------------------
+
+pfset Gravity				1.0
+
+#-----------------------------------------------------------------------------
+# Setup timing info
+#-----------------------------------------------------------------------------
+
+pfset TimingInfo.BaseUnit		0.001
+pfset TimingInfo.StartCount		0
+pfset TimingInfo.StartTime		0.0
+pfset TimingInfo.StopTime               0.010
+pfset TimingInfo.DumpInterval	       -1
+pfset TimeStep.Type                     Constant
+pfset TimeStep.Value                    0.001
+
+#-----------------------------------------------------------------------------
+# Porosity
+#-----------------------------------------------------------------------------
+
+pfset Geom.Porosity.GeomNames          background
+
+pfset Geom.background.Porosity.Type    Constant
+pfset Geom.background.Porosity.Value   1.0
+
+#-----------------------------------------------------------------------------
+# Domain
+#-----------------------------------------------------------------------------
+pfset Domain.GeomName domain
+
+#-----------------------------------------------------------------------------
+# Relative Permeability
+#-----------------------------------------------------------------------------
+
+pfset Phase.RelPerm.Type               VanGenuchten
+pfset Phase.RelPerm.GeomNames          domain
+pfset Geom.domain.RelPerm.Alpha        0.005
+pfset Geom.domain.RelPerm.N            2.0    
+
+#---------------------------------------------------------
+# Saturation
+#---------------------------------------------------------
+
+pfset Phase.Saturation.Type            VanGenuchten
+pfset Phase.Saturation.GeomNames       domain
+pfset Geom.domain.Saturation.Alpha     0.005
+pfset Geom.domain.Saturation.N         2.0
+pfset Geom.domain.Saturation.SRes      0.2
+pfset Geom.domain.Saturation.SSat      0.99
+
+#-----------------------------------------------------------------------------
+# Wells
+#-----------------------------------------------------------------------------
+pfset Wells.Names                           ""
+
+#-----------------------------------------------------------------------------
+# Time Cycles
+#-----------------------------------------------------------------------------
+pfset Cycle.Names "constant onoff"
+pfset Cycle.onoff.Names "on off"
+pfset Cycle.onoff.on.Length 3
+pfset Cycle.onoff.off.Length 2
+pfset Cycle.onoff.Repeat -1
+pfset Cycle.constant.Names		"alltime"
+pfset Cycle.constant.alltime.Length	 1
+pfset Cycle.constant.Repeat		-1
+
+#-----------------------------------------------------------------------------
+# Boundary Conditions: Pressure
+#-----------------------------------------------------------------------------
+pfset BCPressure.PatchNames "left right front back bottom top"
+
+pfset Patch.left.BCPressure.Type			DirEquilRefPatch
+pfset Patch.left.BCPressure.Cycle			"onoff"
+pfset Patch.left.BCPressure.RefGeom			domain
+pfset Patch.left.BCPressure.RefPatch			bottom
+pfset Patch.left.BCPressure.on.Value			5.0
+pfset Patch.left.BCPressure.off.Value			4.0
+
+pfset Patch.right.BCPressure.Type			DirEquilRefPatch
+pfset Patch.right.BCPressure.Cycle			"constant"
+pfset Patch.right.BCPressure.RefGeom			domain
+pfset Patch.right.BCPressure.RefPatch			bottom
+pfset Patch.right.BCPressure.alltime.Value		3.0
+
+pfset Patch.front.BCPressure.Type			FluxConst
+pfset Patch.front.BCPressure.Cycle			"constant"
+pfset Patch.front.BCPressure.alltime.Value		0.0
+
+pfset Patch.back.BCPressure.Type			FluxConst
+pfset Patch.back.BCPressure.Cycle			"constant"
+pfset Patch.back.BCPressure.alltime.Value		0.0
+
+pfset Patch.bottom.BCPressure.Type			FluxConst
+pfset Patch.bottom.BCPressure.Cycle			"constant"
+pfset Patch.bottom.BCPressure.alltime.Value		0.0
+
+pfset Patch.top.BCPressure.Type			        FluxConst
+pfset Patch.top.BCPressure.Cycle			"constant"
+pfset Patch.top.BCPressure.alltime.Value		-0.005
+
+#---------------------------------------------------------
+# Topo slopes in x-direction
+#---------------------------------------------------------
+
+pfset TopoSlopesX.Type "Constant"
+pfset TopoSlopesX.GeomNames ""
+
+pfset TopoSlopesX.Geom.domain.Value 0.0
+
+#---------------------------------------------------------
+# Topo slopes in y-direction
+#---------------------------------------------------------
+
+pfset TopoSlopesY.Type "Constant"
+pfset TopoSlopesY.GeomNames ""
+
+pfset TopoSlopesY.Geom.domain.Value 0.0
+
+#---------------------------------------------------------
+# Mannings coefficient 
+#---------------------------------------------------------
+
+pfset Mannings.Type "Constant"
+pfset Mannings.GeomNames ""
+pfset Mannings.Geom.domain.Value 0.
+
+#---------------------------------------------------------
+# Initial conditions: water pressure
+#---------------------------------------------------------
+
+pfset ICPressure.Type                                   HydroStaticPatch
+pfset ICPressure.GeomNames                              domain
+pfset Geom.domain.ICPressure.Value                      3.0
+pfset Geom.domain.ICPressure.RefGeom                    domain
+pfset Geom.domain.ICPressure.RefPatch                   bottom
+
+#-----------------------------------------------------------------------------
+# Phase sources:
+#-----------------------------------------------------------------------------
+
+pfset PhaseSources.water.Type                         Constant
+pfset PhaseSources.water.GeomNames                    background
+pfset PhaseSources.water.Geom.background.Value        0.0
+
+
+#-----------------------------------------------------------------------------
+# Exact solution specification for error calculations
+#-----------------------------------------------------------------------------
+
+pfset KnownSolution                                    NoKnownSolution
+
+
+#-----------------------------------------------------------------------------
+# Set solver parameters
+#-----------------------------------------------------------------------------
+pfset Solver                                             Richards
+pfset Solver.MaxIter                                     10
+
+pfset Solver.Nonlinear.MaxIter                           10
+pfset Solver.Nonlinear.ResidualTol                       1e-9
+pfset Solver.Nonlinear.EtaChoice                         EtaConstant
+pfset Solver.Nonlinear.EtaValue                          1e-5
+pfset Solver.Nonlinear.UseJacobian                       True
+pfset Solver.Nonlinear.DerivativeEpsilon                 1e-2
+
+pfset Solver.Linear.KrylovDimension                      10
+
+pfset Solver.Linear.Preconditioner                       MGSemi
+pfset Solver.Linear.Preconditioner.MGSemi.MaxIter        1
+pfset Solver.Linear.Preconditioner.MGSemi.MaxLevels      100
+
+#-----------------------------------------------------------------------------
+# Run with the constant patch types
+#-----------------------------------------------------------------------------
+pfrun default_richards
+pfundist default_richards
+
+set steps "00000 00001 00002 00003 00004 00005 00006 00007 00008 00009 00010"
+
+foreach i $steps {
+    set const_press($i) [pfload default_richards.out.press.$i.pfb]
+    set const_satur($i) [pfload default_richards.out.satur.$i.pfb]
+}
+
+#-----------------------------------------------------------------------------
+# Write the same patch values to files.  Density is constant, so the
+# hydrostatic values on the left patch are the initial condition
+# (hydrostatic with 3.0 on the bottom) shifted by the difference in the
+# reference pressure.
+#-----------------------------------------------------------------------------
+set ic   [pfload default_richards.out.press.00000.pfb]
+set mask [pfload default_richards.out.mask.pfb]
+
+set on [pfcellsumconst $ic 2.0 $mask]
+pfsave $on -pfb bcfile_on.pfb
+set off [pfcellsumconst $ic 1.0 $mask]
+pfsave $off -pfb bcfile_off.pfb
+set flux [pfcellsumconst [pfcellmultconst $ic 0.0 $mask] -0.005 $mask]
+pfsave $flux -pfb bcfile_flux.pfb
+
+pfdist bcfile_on.pfb
+pfdist bcfile_off.pfb
+pfdist bcfile_flux.pfb
+
+#-----------------------------------------------------------------------------
+# Run with the file driven patch types
+#-----------------------------------------------------------------------------
+pfset Patch.left.BCPressure.Type			PressureFile
+pfset Patch.left.BCPressure.on.FileName			bcfile_on.pfb
+pfset Patch.left.BCPressure.off.FileName		bcfile_off.pfb
+
+pfset Patch.top.BCPressure.Type			        FluxFile
+pfset Patch.top.BCPressure.alltime.FileName		bcfile_flux.pfb
+
+pfrun default_richards
+pfundist default_richards
+
+pfundist bcfile_on.pfb
+pfundist bcfile_off.pfb
+pfundist bcfile_flux.pfb
+
+#
+# Tests 
+#
+source pftest.tcl
+set passed 1
+
+foreach i $steps {
+    set file_press [pfload default_richards.out.press.$i.pfb]
+    set file_satur [pfload default_richards.out.satur.$i.pfb]
+
+    if {[string length [pfmdiff $file_press $const_press($i) $sig_digits]] != 0} {
+	puts "FAILED : Pressure from the BC files differs for timestep $i"
+	set passed 0
+    }
+    if {[string length [pfmdiff $file_satur $const_satur($i) $sig_digits]] != 0} {
+	puts "FAILED : Saturation from the BC files differs for timestep $i"
+	set passed 0
+    }
+}
+
+
+if $passed {
+    puts "default_richards_bcfile : PASSED"
+} {
+    puts "default_richards_bcfile : FAILED"
+}
@@ -0,0 +1,553 @@
+#  This runs Problem 2 in the paper
+#     "Robust Numerical Methods for Saturated-Unsaturated Flow with
+#      Dry Initial Conditions", Forsyth, Wu and Pruess, 
+#      Advances in Water Resources, 1995.
+#
+#  Same as forsyth2.tcl but run for ten steps with the preconditioner
+#  reused across time steps.  With ReuseTimeSteps 5 it is set up on steps
+#  1 and 6 only.  The run is repeated with ReuseLinIterRatio 1, which sets
+#  it up again after every step needing more linear iterations per Newton
+#  iteration than the step that set it up.  Both runs have to match the
+#  correct output, computed without reuse.
+
+#
+# Import the ParFlow TCL package
+#
+lappend auto_path $env(PARFLOW_DIR)/bin 
+package require parflow
+namespace import Parflow::*
+
+pfset FileVersion 4
+
+pfset Process.Topology.P 1
+pfset Process.Topology.Q 1
+pfset Process.Topology.R 1
+
+#---------------------------------------------------------
+# Computational Grid
+#---------------------------------------------------------
+pfset ComputationalGrid.Lower.X           0.0
+pfset ComputationalGrid.Lower.Y           0.0
+pfset ComputationalGrid.Lower.Z           0.0
+
+pfset ComputationalGrid.NX                96
+pfset ComputationalGrid.NY                1
+pfset ComputationalGrid.NZ                67
+
+set   UpperX                              800.0
+set   UpperY                              1.0
+set   UpperZ                              650.0
+
+set   LowerX                              [pfget ComputationalGrid.Lower.X]
+set   LowerY                              [pfget ComputationalGrid.Lower.Y]
+set   LowerZ                              [pfget ComputationalGrid.Lower.Z]
+
+set   NX                                  [pfget ComputationalGrid.NX]
+set   NY                                  [pfget ComputationalGrid.NY]
+set   NZ                                  [pfget ComputationalGrid.NZ]
+
+pfset ComputationalGrid.DX	          [expr ($UpperX - $LowerX) / $NX]
+pfset ComputationalGrid.DY                [expr ($UpperY - $LowerY) / $NY]
+pfset ComputationalGrid.DZ	          [expr ($UpperZ - $LowerZ) / $NZ]
+
+#---------------------------------------------------------
+# The Names of the GeomInputs
+#---------------------------------------------------------
+set   Zones                           "zone1 zone2 zone3above4 zone3left4 \
+                                      zone3right4 zone3below4 zone4"
+
+pfset GeomInput.Names                 "solidinput $Zones background"
+
+pfset GeomInput.solidinput.InputType  SolidFile
+pfset GeomInput.solidinput.GeomNames  domain
+pfset GeomInput.solidinput.FileName   fors2_hf.pfsol
+
+pfset GeomInput.zone1.InputType       Box
+pfset GeomInput.zone1.GeomName        zone1
+
+pfset Geom.zone1.Lower.X              0.0
+pfset Geom.zone1.Lower.Y              0.0
+pfset Geom.zone1.Lower.Z              610.0
+pfset Geom.zone1.Upper.X              800.0
+pfset Geom.zone1.Upper.Y              1.0
+pfset Geom.zone1.Upper.Z              650.0
+
+pfset GeomInput.zone2.InputType       Box
+pfset GeomInput.zone2.GeomName        zone2
+
+pfset Geom.zone2.Lower.X              0.0
+pfset Geom.zone2.Lower.Y              0.0
+pfset Geom.zone2.Lower.Z              560.0
+pfset Geom.zone2.Upper.X              800.0
+pfset Geom.zone2.Upper.Y              1.0
+pfset Geom.zone2.Upper.Z              610.0
+
+pfset GeomInput.zone3above4.InputType Box
+pfset GeomInput.zone3above4.GeomName  zone3above4
+
+pfset Geom.zone3above4.Lower.X        0.0
+pfset Geom.zone3above4.Lower.Y        0.0
+pfset Geom.zone3above4.Lower.Z        500.0
+pfset Geom.zone3above4.Upper.X        800.0
+pfset Geom.zone3above4.Upper.Y        1.0
+pfset Geom.zone3above4.Upper.Z        560.0
+
+pfset GeomInput.zone3left4.InputType  Box
+pfset GeomInput.zone3left4.GeomName   zone3left4
+
+pfset Geom.zone3left4.Lower.X         0.0
+pfset Geom.zone3left4.Lower.Y         0.0
+pfset Geom.zone3left4.Lower.Z         400.0
+pfset Geom.zone3left4.Upper.X         100.0
+pfset Geom.zone3left4.Upper.Y         1.0
+pfset Geom.zone3left4.Upper.Z         500.0
+
+pfset GeomInput.zone3right4.InputType  Box
+pfset GeomInput.zone3right4.GeomName   zone3right4
+
+pfset Geom.zone3right4.Lower.X        300.0
+pfset Geom.zone3right4.Lower.Y        0.0
+pfset Geom.zone3right4.Lower.Z        400.0
+pfset Geom.zone3right4.Upper.X        800.0
+pfset Geom.zone3right4.Upper.Y        1.0
+pfset Geom.zone3right4.Upper.Z        500.0
+
+pfset GeomInput.zone3below4.InputType Box
+pfset GeomInput.zone3below4.GeomName  zone3below4
+
+pfset Geom.zone3below4.Lower.X        0.0
+pfset Geom.zone3below4.Lower.Y        0.0
+pfset Geom.zone3below4.Lower.Z        0.0
+pfset Geom.zone3below4.Upper.X        800.0
+pfset Geom.zone3below4.Upper.Y        1.0
+pfset Geom.zone3below4.Upper.Z        400.0
+
+pfset GeomInput.zone4.InputType       Box
+pfset GeomInput.zone4.GeomName        zone4
+
+pfset Geom.zone4.Lower.X              100.0
+pfset Geom.zone4.Lower.Y              0.0
+pfset Geom.zone4.Lower.Z              400.0
+pfset Geom.zone4.Upper.X              300.0
+pfset Geom.zone4.Upper.Y              1.0
+pfset Geom.zone4.Upper.Z              500.0
+
+pfset GeomInput.background.InputType  Box
+pfset GeomInput.background.GeomName   background
+
+pfset Geom.background.Lower.X         -99999999.0
+pfset Geom.background.Lower.Y         -99999999.0
+pfset Geom.background.Lower.Z         -99999999.0
+pfset Geom.background.Upper.X         99999999.0
+pfset Geom.background.Upper.Y         99999999.0
+pfset Geom.background.Upper.Z         99999999.0
+
+pfset Geom.domain.Patches             "infiltration z-upper x-lower y-lower \
+                                      x-upper y-upper z-lower"
+
+
+#-----------------------------------------------------------------------------
+# Perm
+#-----------------------------------------------------------------------------
+pfset Geom.Perm.Names                 $Zones
+
+# Values in cm^2
+
+pfset Geom.zone1.Perm.Type            Constant
+pfset Geom.zone1.Perm.Value           9.1496e-5
+
+pfset Geom.zone2.Perm.Type            Constant
+pfset Geom.zone2.Perm.Value           5.4427e-5
+
+pfset Geom.zone3above4.Perm.Type      Constant
+pfset Geom.zone3above4.Perm.Value     4.8033e-5
+
+pfset Geom.zone3left4.Perm.Type       Constant
+pfset Geom.zone3left4.Perm.Value      4.8033e-5
+
+pfset Geom.zone3right4.Perm.Type      Constant
+pfset Geom.zone3right4.Perm.Value     4.8033e-5
+
+pfset Geom.zone3below4.Perm.Type      Constant
+pfset Geom.zone3below4.Perm.Value     4.8033e-5
+
+pfset Geom.zone4.Perm.Type            Constant
+pfset Geom.zone4.Perm.Value           4.8033e-4
+
+pfset Perm.TensorType               TensorByGeom
+
+pfset Geom.Perm.TensorByGeom.Names  "background"
+
+pfset Geom.background.Perm.TensorValX  1.0
+pfset Geom.background.Perm.TensorValY  1.0
+pfset Geom.background.Perm.TensorValZ  1.0
+
+#-----------------------------------------------------------------------------
+# Specific Storage
+#-----------------------------------------------------------------------------
+
+pfset SpecificStorage.Type            Constant
+pfset SpecificStorage.GeomNames       "domain"
+pfset Geom.domain.SpecificStorage.Value 1.0e-4
+
+#-----------------------------------------------------------------------------
+# Phases
+#-----------------------------------------------------------------------------
+
+pfset Phase.Names "water"
+
+pfset Phase.water.Density.Type	        Constant
+pfset Phase.water.Density.Value	        1.0
+
+pfset Phase.water.Viscosity.Type	Constant
+pfset Phase.water.Viscosity.Value	1.124e-2
+
+#-----------------------------------------------------------------------------
+# Contaminants
+#-----------------------------------------------------------------------------
+
+pfset Contaminants.Names			"tce"
+pfset Contaminants.tce.Degradation.Value	 0.0
+
+pfset PhaseConcen.water.tce.Type                 Constant
+pfset PhaseConcen.water.tce.GeomNames            domain
+pfset PhaseConcen.water.tce.Geom.domain.Value    0.0
+
+#-----------------------------------------------------------------------------
+# Retardation
+#-----------------------------------------------------------------------------
+
+pfset Geom.Retardation.GeomNames           background
+pfset Geom.background.tce.Retardation.Type     Linear
+pfset Geom.background.tce.Retardation.Rate     0.0
+
+#-----------------------------------------------------------------------------
+# Gravity
+#-----------------------------------------------------------------------------
+
+pfset Gravity				1.0
+
+#-----------------------------------------------------------------------------
+# Setup timing info
+#-----------------------------------------------------------------------------
+
+pfset TimingInfo.BaseUnit		1.0
+pfset TimingInfo.StartCount		0
+pfset TimingInfo.StartTime		0.0
+pfset TimingInfo.StopTime               2592000.0
+pfset TimingInfo.StopTime               86400.0
+pfset TimingInfo.DumpInterval	        43200.0
+pfset TimeStep.Type                     Constant
+pfset TimeStep.Value                    8640.0
+
+#-----------------------------------------------------------------------------
+# Porosity
+#-----------------------------------------------------------------------------
+
+pfset Geom.Porosity.GeomNames           $Zones
+
+pfset Geom.zone1.Porosity.Type          Constant
+pfset Geom.zone1.Porosity.Value         0.3680
+
+pfset Geom.zone2.Porosity.Type          Constant
+pfset Geom.zone2.Porosity.Value         0.3510
+
+pfset Geom.zone3above4.Porosity.Type    Constant
+pfset Geom.zone3above4.Porosity.Value   0.3250
+
+pfset Geom.zone3left4.Porosity.Type     Constant
+pfset Geom.zone3left4.Porosity.Value    0.3250
+
+pfset Geom.zone3right4.Porosity.Type    Constant
+pfset Geom.zone3right4.Porosity.Value   0.3250
+
+pfset Geom.zone3below4.Porosity.Type    Constant
+pfset Geom.zone3below4.Porosity.Value   0.3250
+
+pfset Geom.zone4.Porosity.Type          Constant
+pfset Geom.zone4.Porosity.Value         0.3250
+
+#-----------------------------------------------------------------------------
+# Domain
+#-----------------------------------------------------------------------------
+
+pfset Domain.GeomName domain
+
+#-----------------------------------------------------------------------------
+# Relative Permeability
+#-----------------------------------------------------------------------------
+
+pfset Phase.RelPerm.Type               VanGenuchten
+pfset Phase.RelPerm.GeomNames          $Zones
+
+pfset Geom.zone1.RelPerm.Alpha         0.0334
+pfset Geom.zone1.RelPerm.N             1.982 
+
+pfset Geom.zone2.RelPerm.Alpha         0.0363
+pfset Geom.zone2.RelPerm.N             1.632 
+
+pfset Geom.zone3above4.RelPerm.Alpha   0.0345
+pfset Geom.zone3above4.RelPerm.N       1.573 
+
+pfset Geom.zone3left4.RelPerm.Alpha    0.0345
+pfset Geom.zone3left4.RelPerm.N        1.573 
+
+pfset Geom.zone3right4.RelPerm.Alpha   0.0345
+pfset Geom.zone3right4.RelPerm.N       1.573 
+
+pfset Geom.zone3below4.RelPerm.Alpha   0.0345
+pfset Geom.zone3below4.RelPerm.N       1.573 
+
+pfset Geom.zone4.RelPerm.Alpha         0.0345
+pfset Geom.zone4.RelPerm.N             1.573 
+
+#---------------------------------------------------------
+# Saturation
+#---------------------------------------------------------
+
+pfset Phase.Saturation.Type              VanGenuchten
+pfset Phase.Saturation.GeomNames         $Zones
+
+pfset Geom.zone1.Saturation.Alpha        0.0334
+pfset Geom.zone1.Saturation.N            1.982
+pfset Geom.zone1.Saturation.SRes         0.2771
+pfset Geom.zone1.Saturation.SSat         1.0
+
+pfset Geom.zone2.Saturation.Alpha        0.0363
+pfset Geom.zone2.Saturation.N            1.632
+pfset Geom.zone2.Saturation.SRes         0.2806
+pfset Geom.zone2.Saturation.SSat         1.0
+
+pfset Geom.zone3above4.Saturation.Alpha  0.0345
+pfset Geom.zone3above4.Saturation.N      1.573
+pfset Geom.zone3above4.Saturation.SRes   0.2643
+pfset Geom.zone3above4.Saturation.SSat   1.0
+
+pfset Geom.zone3left4.Saturation.Alpha   0.0345
+pfset Geom.zone3left4.Saturation.N       1.573
+pfset Geom.zone3left4.Saturation.SRes    0.2643
+pfset Geom.zone3left4.Saturation.SSat    1.0
+
+pfset Geom.zone3right4.Saturation.Alpha  0.0345
+pfset Geom.zone3right4.Saturation.N      1.573
+pfset Geom.zone3right4.Saturation.SRes   0.2643
+pfset Geom.zone3right4.Saturation.SSat   1.0
+
+pfset Geom.zone3below4.Saturation.Alpha  0.0345
+pfset Geom.zone3below4.Saturation.N      1.573
+pfset Geom.zone3below4.Saturation.SRes   0.2643
+pfset Geom.zone3below4.Saturation.SSat   1.0
+
+pfset Geom.zone3below4.Saturation.Alpha  0.0345
+pfset Geom.zone3below4.Saturation.N      1.573
+pfset Geom.zone3below4.Saturation.SRes   0.2643
+pfset Geom.zone3below4.Saturation.SSat   1.0
+
+pfset Geom.zone4.Saturation.Alpha        0.0345
+pfset Geom.zone4.Saturation.N            1.573
+pfset Geom.zone4.Saturation.SRes         0.2643
+pfset Geom.zone4.Saturation.SSat         1.0
+
+#-----------------------------------------------------------------------------
+# Wells
+#-----------------------------------------------------------------------------
+pfset Wells.Names                           ""
+
+#-----------------------------------------------------------------------------
+# Time Cycles
+#-----------------------------------------------------------------------------
+pfset Cycle.Names constant
+pfset Cycle.constant.Names		"alltime"
+pfset Cycle.constant.alltime.Length	 1
+pfset Cycle.constant.Repeat		-1
+
+#-----------------------------------------------------------------------------
+# Boundary Conditions: Pressure
+#-----------------------------------------------------------------------------
+pfset BCPressure.PatchNames                   [pfget Geom.domain.Patches]
+
+pfset Patch.infiltration.BCPressure.Type	      FluxConst
+pfset Patch.infiltration.BCPressure.Cycle	      "constant"
+pfset Patch.infiltration.BCPressure.alltime.Value     -2.3148e-5
+
+pfset Patch.x-lower.BCPressure.Type		      FluxConst
+pfset Patch.x-lower.BCPressure.Cycle		      "constant"
+pfset Patch.x-lower.BCPressure.alltime.Value	      0.0
+
+pfset Patch.y-lower.BCPressure.Type		      FluxConst
+pfset Patch.y-lower.BCPressure.Cycle		      "constant"
+pfset Patch.y-lower.BCPressure.alltime.Value	      0.0
+
+pfset Patch.z-lower.BCPressure.Type		      FluxConst
+pfset Patch.z-lower.BCPressure.Cycle		      "constant"
+pfset Patch.z-lower.BCPressure.alltime.Value	      0.0
+
+pfset Patch.x-upper.BCPressure.Type		      FluxConst
+pfset Patch.x-upper.BCPressure.Cycle		      "constant"
+pfset Patch.x-upper.BCPressure.alltime.Value	      0.0
+
+pfset Patch.y-upper.BCPressure.Type		      FluxConst
+pfset Patch.y-upper.BCPressure.Cycle		      "constant"
+pfset Patch.y-upper.BCPressure.alltime.Value	      0.0
+
+pfset Patch.z-upper.BCPressure.Type		      FluxConst
+pfset Patch.z-upper.BCPressure.Cycle		      "constant"
+pfset Patch.z-upper.BCPressure.alltime.Value	      0.0
+
+#---------------------------------------------------------
+# Topo slopes in x-direction
+#---------------------------------------------------------
+
+pfset TopoSlopesX.Type "Constant"
+pfset TopoSlopesX.GeomNames ""
+
+pfset TopoSlopesX.Geom.domain.Value 0.0
+
+#---------------------------------------------------------
+# Topo slopes in y-direction
+#---------------------------------------------------------
+
+pfset TopoSlopesY.Type "Constant"
+pfset TopoSlopesY.GeomNames ""
+
+pfset TopoSlopesY.Geom.domain.Value 0.0
+
+#---------------------------------------------------------
+# Mannings coefficient 
+#---------------------------------------------------------
+
+pfset Mannings.Type "Constant"
+pfset Mannings.GeomNames ""
+pfset Mannings.Geom.domain.Value 0.
+
+#---------------------------------------------------------
+# Initial conditions: water pressure
+#---------------------------------------------------------
+
+pfset ICPressure.Type                                   Constant
+pfset ICPressure.GeomNames                              domain
+pfset Geom.domain.ICPressure.Value                      -734.0
+
+#-----------------------------------------------------------------------------
+# Phase sources:
+#-----------------------------------------------------------------------------
+
+pfset PhaseSources.water.Type                         Constant
+pfset PhaseSources.water.GeomNames                    background
+pfset PhaseSources.water.Geom.background.Value        0.0
+
+
+#-----------------------------------------------------------------------------
+# Exact solution specification for error calculations
+#-----------------------------------------------------------------------------
+
+pfset KnownSolution                                    NoKnownSolution
+
+#-----------------------------------------------------------------------------
+# Set solver parameters
+#-----------------------------------------------------------------------------
+pfset Solver                                             Richards
+pfset Solver.MaxIter                                     10000
+
+pfset Solver.Nonlinear.MaxIter                           15
+pfset Solver.Nonlinear.ResidualTol                       1e-9
+pfset Solver.Nonlinear.StepTol                           1e-9
+pfset Solver.Nonlinear.EtaValue                          1e-5
+pfset Solver.Nonlinear.UseJacobian                       True
+pfset Solver.Nonlinear.DerivativeEpsilon                 1e-7
+
+pfset Solver.Linear.KrylovDimension                      25
+pfset Solver.Linear.MaxRestarts                          2
+
+pfset Solver.Linear.Preconditioner                       MGSemi
+pfset Solver.Linear.Preconditioner.MGSemi.MaxIter        1
+pfset Solver.Linear.Preconditioner.MGSemi.MaxLevels      100
+pfset Solver.Linear.Preconditioner.ReuseNewtonIter       15
+pfset Solver.Linear.Preconditioner.ReuseTimeSteps        5
+pfset Solver.Linear.Preconditioner.ReuseLinIterRatio     100.0
+
+#-----------------------------------------------------------------------------
+# The steps in which the preconditioner was set up, from the KINSOL log
+#-----------------------------------------------------------------------------
+proc pcSetupSteps {runname} {
+    set steps {}
+    set step 0
+    set file [open $runname.out.kinsol.log r]
+    while {[gets $file line] >= 0} {
+	if [string match "KINSOL starting step*" $line] {
+	    incr step
+	} elseif {[string match "PC Evals.:*" $line] && [lindex $line 2] > 0} {
+	    lappend steps $step
+	}
+    }
+    close $file
+    return $steps
+}
+
+#-----------------------------------------------------------------------------
+# Run and Unload the ParFlow output files
+#-----------------------------------------------------------------------------
+pfrun forsyth2_pcreuse
+pfundist forsyth2_pcreuse
+
+set age_steps [pcSetupSteps forsyth2_pcreuse]
+
+source pftest.tcl
+set passed 1
+
+if ![pftestFile forsyth2_pcreuse.out.perm_x.pfb "Max difference in perm_x" $sig_digits] {
+    set passed 0
+}
+if ![pftestFile forsyth2_pcreuse.out.perm_y.pfb "Max difference in perm_y" $sig_digits] {
+    set passed 0
+}
+if ![pftestFile forsyth2_pcreuse.out.perm_z.pfb "Max difference in perm_z" $sig_digits] {
+    set passed 0
+}
+
+foreach i "00000 00001 00002" {
+    if ![pftestFile forsyth2_pcreuse.out.press.$i.pfb "Max difference in Pressure for timestep $i" $sig_digits] {
+    set passed 0
+}
+    if ![pftestFile forsyth2_pcreuse.out.satur.$i.pfb "Max difference in Saturation for timestep $i" $sig_digits] {
+    set passed 0
+}
+}
+
+#-----------------------------------------------------------------------------
+# Set the preconditioner up again when the linear iterations grow
+#-----------------------------------------------------------------------------
+pfset Solver.Linear.Preconditioner.ReuseLinIterRatio     1.0
+
+pfrun forsyth2_pcreuse
+pfundist forsyth2_pcreuse
+
+set ratio_steps [pcSetupSteps forsyth2_pcreuse]
+
+foreach i "00001 00002" {
+    if ![pftestFile forsyth2_pcreuse.out.press.$i.pfb "Max difference in Pressure for timestep $i with ratio 1" $sig_digits] {
+    set passed 0
+}
+    if ![pftestFile forsyth2_pcreuse.out.satur.$i.pfb "Max difference in Saturation for timestep $i with ratio 1" $sig_digits] {
+    set passed 0
+}
+}
+
+#
+# Tests of the preconditioner set ups
+#
+if {$age_steps != "1 6"} {
+    puts "FAILED : preconditioner set up in steps $age_steps, not 1 6"
+    set passed 0
+}
+if {$ratio_steps != "1 3 5 7 9"} {
+    puts "FAILED : preconditioner set up in steps $ratio_steps with ratio 1, not 1 3 5 7 9"
+    set passed 0
+}
+
+
+if $passed {
+    puts "forsyth2_pcreuse : PASSED"
+} {
+    puts "forsyth2_pcreuse : FAILED"
+}